@@ -108,6 +108,12 @@ class PartialReduxExpr : ei_no_assignment_operator,
         return m_functor(m_matrix.row(index));
     }
 
+    /** \returns the nested expression */
+    const _MatrixTypeNested& nestedExpression() const { return m_matrix; }
+
+    /** \returns the member functor */
+    const MemberOp& functor() const { return m_functor; }
+
   protected:
     const MatrixTypeNested m_matrix;
     const MemberOp m_functor;
@@ -155,6 +161,159 @@ struct ei_member_redux {
   const BinaryOp m_functor;
 };
 
+/** \internal
+  * Describes how the member functor \a MemberOp can be evaluated on a whole set of vectors at once:
+  * the result is initialized by init() with the first vector, then updated by update() with each
+  * following vector, and finally adjusted by finalize() knowing the number of vectors.
+  */
+template<typename MemberOp> struct ei_member_accumulator
+{
+  enum { Supported = 0 };
+};
+
+/** \internal accumulates the vectors coefficient-wise with the binary functor \a BinaryOp */
+template<typename MemberOp, typename BinaryOp> struct ei_member_accumulator_binary
+{
+  enum { Supported = 1 };
+  template<typename Acc, typename Vec> static void init(const MemberOp&, Acc& acc, const Vec& v)
+  { acc = v; }
+  template<typename Acc, typename Vec> static void update(const MemberOp&, Acc& acc, const Vec& v)
+  { acc = CwiseBinaryOp<BinaryOp, Acc, Vec>(acc, v); }
+  template<typename Acc> static void finalize(const MemberOp&, Acc&, int) {}
+};
+
+template<typename ResultType> struct ei_member_accumulator<ei_member_sum<ResultType> >
+  : ei_member_accumulator_binary<ei_member_sum<ResultType>, ei_scalar_sum_op<ResultType> > {};
+template<typename ResultType> struct ei_member_accumulator<ei_member_prod<ResultType> >
+  : ei_member_accumulator_binary<ei_member_prod<ResultType>, ei_scalar_product_op<ResultType> > {};
+template<typename ResultType> struct ei_member_accumulator<ei_member_minCoeff<ResultType> >
+  : ei_member_accumulator_binary<ei_member_minCoeff<ResultType>, ei_scalar_min_op<ResultType> > {};
+template<typename ResultType> struct ei_member_accumulator<ei_member_maxCoeff<ResultType> >
+  : ei_member_accumulator_binary<ei_member_maxCoeff<ResultType>, ei_scalar_max_op<ResultType> > {};
+
+template<typename ResultType> struct ei_member_accumulator<ei_member_mean<ResultType> >
+  : ei_member_accumulator_binary<ei_member_mean<ResultType>, ei_scalar_sum_op<ResultType> >
+{
+  template<typename Acc> static void finalize(const ei_member_mean<ResultType>&, Acc& acc, int count)
+  { acc /= ResultType(count); }
+};
+
+template<typename ResultType> struct ei_member_accumulator<ei_member_squaredNorm<ResultType> >
+{
+  // the result type of ei_member_squaredNorm is complex for complex coefficients
+  enum { Supported = !NumTraits<ResultType>::IsComplex };
+  template<typename Acc, typename Vec> static void init(const ei_member_squaredNorm<ResultType>&, Acc& acc, const Vec& v)
+  { acc = CwiseUnaryOp<ei_scalar_abs2_op<typename Vec::Scalar>, Vec>(v); }
+  template<typename Acc, typename Vec> static void update(const ei_member_squaredNorm<ResultType>&, Acc& acc, const Vec& v)
+  { acc += CwiseUnaryOp<ei_scalar_abs2_op<typename Vec::Scalar>, Vec>(v); }
+  template<typename Acc> static void finalize(const ei_member_squaredNorm<ResultType>&, Acc&, int) {}
+};
+
+template<typename ResultType> struct ei_member_accumulator<ei_member_norm<ResultType> >
+{
+  // the result type of ei_member_norm is complex for complex coefficients
+  enum { Supported = !NumTraits<ResultType>::IsComplex };
+  template<typename Acc, typename Vec> static void init(const ei_member_norm<ResultType>&, Acc& acc, const Vec& v)
+  { acc = CwiseUnaryOp<ei_scalar_abs2_op<typename Vec::Scalar>, Vec>(v); }
+  template<typename Acc, typename Vec> static void update(const ei_member_norm<ResultType>&, Acc& acc, const Vec& v)
+  { acc += CwiseUnaryOp<ei_scalar_abs2_op<typename Vec::Scalar>, Vec>(v); }
+  template<typename Acc> static void finalize(const ei_member_norm<ResultType>&, Acc& acc, int)
+  { acc = CwiseUnaryOp<ei_scalar_sqrt_op<ResultType>, Acc>(acc); }
+};
+
+template<typename BinaryOp, typename Scalar> struct ei_member_accumulator<ei_member_redux<BinaryOp, Scalar> >
+{
+  enum { Supported = 1 };
+  template<typename Acc, typename Vec> static void init(const ei_member_redux<BinaryOp, Scalar>&, Acc& acc, const Vec& v)
+  { acc = v; }
+  template<typename Acc, typename Vec> static void update(const ei_member_redux<BinaryOp, Scalar>& op, Acc& acc, const Vec& v)
+  { acc = CwiseBinaryOp<BinaryOp, Acc, Vec>(acc, v, op.m_functor); }
+  template<typename Acc> static void finalize(const ei_member_redux<BinaryOp, Scalar>&, Acc&, int) {}
+};
+
+/** \internal
+  * \brief Evaluates a partial redux whose result is contiguous in the nested expression
+  *
+  * This is the case of rowwise() on a column-major expression and of colwise() on a row-major one.
+  * Rather than reducing each row (resp. column) with a stride, the columns (resp. rows) are accumulated
+  * one after the other into the result, which is vectorized. When OpenMP is enabled, the result is split
+  * into slices accumulated by different threads, so that it does not depend on the number of threads.
+  */
+template<typename MatrixType, typename MemberOp, int Direction>
+struct ei_partial_redux_outer
+{
+  typedef PartialReduxExpr<MatrixType, MemberOp, Direction> XprType;
+  typedef typename XprType::_MatrixTypeNested _MatrixTypeNested;
+  typedef typename ei_plain_matrix_type<XprType>::type PlainObject;
+  typedef typename ei_meta_if<Direction==Horizontal,
+                              typename _MatrixTypeNested::ColXpr,
+                              typename _MatrixTypeNested::RowXpr>::ret OuterVector;
+  typedef ei_member_accumulator<MemberOp> Accumulator;
+  enum {
+    Enabled = Accumulator::Supported
+           && int(MatrixType::SizeAtCompileTime) == Dynamic
+           && (Direction==Horizontal) == !(int(_MatrixTypeNested::Flags)&RowMajorBit),
+    PacketSize = ei_packet_traits<typename XprType::Scalar>::size
+  };
+
+  // accumulates the coefficients \a start to \a start+size of all the outer vectors into \a res
+  static void run(const XprType& xpr, PlainObject& res, int start, int size)
+  {
+    const _MatrixTypeNested& mat = xpr.nestedExpression();
+    const int outerSize = Direction==Horizontal ? mat.cols() : mat.rows();
+    VectorBlock<PlainObject> acc(res, start, size);
+    Accumulator::init(xpr.functor(), acc, OuterVector(mat, 0).segment(start, size));
+    for(int j = 1; j < outerSize; ++j)
+      Accumulator::update(xpr.functor(), acc, OuterVector(mat, j).segment(start, size));
+    Accumulator::finalize(xpr.functor(), acc, outerSize);
+  }
+
+  template<typename Dest>
+  static void run(Dest& dst, const XprType& xpr)
+  {
+    const int size = xpr.size();
+    // the result is accumulated in a temporary since dst may alias the nested expression
+    PlainObject res(xpr.rows(), xpr.cols());
+    int threads = 1;
+#ifdef EIGEN_HAS_OPENMP
+    const int outerSize = Direction==Horizontal ? xpr.nestedExpression().cols() : xpr.nestedExpression().rows();
+    if(double(size) * double(outerSize) >= double(EIGEN_REDUX_CHUNK_SIZE) && omp_get_num_threads() == 1)
+      threads = std::max(1, std::min<int>(omp_get_max_threads(), size / (4*PacketSize)));
+    #pragma omp parallel for schedule(static,1) num_threads(threads) if(threads > 1)
+#endif
+    for(int t = 0; t < threads; ++t)
+    {
+      const int start = (int(double(size) * t / threads) / PacketSize) * PacketSize;
+      const int end = t+1 == threads ? size : (int(double(size) * (t+1) / threads) / PacketSize) * PacketSize;
+      if(end > start)
+        run(xpr, res, start, end - start);
+    }
+    dst.lazyAssign(res);
+  }
+};
+
+template<typename Outer, bool Enabled> struct ei_partial_redux_outer_selector
+{
+  template<typename Dest, typename XprType> static void run(Dest& dst, const XprType& xpr) { Outer::run(dst, xpr); }
+};
+
+template<typename Outer> struct ei_partial_redux_outer_selector<Outer, false>
+{
+  template<typename Dest, typename XprType> static void run(Dest&, const XprType&) {}
+};
+
+template<typename Derived>
+template<typename MatrixType, typename MemberOp, int Direction>
+Derived& DenseBase<Derived>::lazyAssign(const PartialReduxExpr<MatrixType, MemberOp, Direction>& other)
+{
+  typedef ei_partial_redux_outer<MatrixType, MemberOp, Direction> Outer;
+  if(Outer::Enabled && other.nestedExpression().size() > 0)
+    ei_partial_redux_outer_selector<Outer, Outer::Enabled>::run(derived(), other);
+  else
+    lazyAssign(static_cast<const DenseBase<PartialReduxExpr<MatrixType, MemberOp, Direction> >&>(other));
+  return derived();
+}
+
 /** \array_module \ingroup Array_Module
   *
   * \class VectorwiseOp
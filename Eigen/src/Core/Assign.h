@@ -129,6 +129,101 @@ public:
 #endif
 };
 
+#if defined(EIGEN_HAS_OPENMP) && defined(EIGEN_PARALLELIZE_ASSIGN)
+#define EIGEN_ASSIGN_USE_OPENMP
+#endif
+
+// Expressions whose coefficients have to be evaluated in traversal order, such as the sequential
+// LinSpaced, or which are not repeatable, such as Random which calls std::rand(), are never
+// assigned in parallel. Neither are the expressions nesting them, which are looked through below.
+template<typename Derived> struct ei_assign_in_order { enum { ret = 0 }; };
+template<typename NullaryOp, typename Derived>
+struct ei_assign_in_order<CwiseNullaryOp<NullaryOp, Derived> >
+{ enum { ret = !ei_functor_traits<NullaryOp>::IsRepeatable }; };
+template<typename Scalar, typename Derived>
+struct ei_assign_in_order<CwiseNullaryOp<ei_linspaced_op<Scalar,false>, Derived> > { enum { ret = 1 }; };
+template<typename UnaryOp, typename MatrixType>
+struct ei_assign_in_order<CwiseUnaryOp<UnaryOp, MatrixType> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+template<typename BinaryOp, typename Lhs, typename Rhs>
+struct ei_assign_in_order<CwiseBinaryOp<BinaryOp, Lhs, Rhs> >
+{ enum { ret = ei_assign_in_order<Lhs>::ret || ei_assign_in_order<Rhs>::ret }; };
+template<typename ViewOp, typename MatrixType>
+struct ei_assign_in_order<CwiseUnaryView<ViewOp, MatrixType> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+template<typename XprType, int BlockRows, int BlockCols, bool HasDirectAccess>
+struct ei_assign_in_order<Block<XprType, BlockRows, BlockCols, HasDirectAccess> >
+{ enum { ret = ei_assign_in_order<XprType>::ret }; };
+template<typename MatrixType, int Size>
+struct ei_assign_in_order<VectorBlock<MatrixType, Size> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+template<typename MatrixType>
+struct ei_assign_in_order<Transpose<MatrixType> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+template<typename MatrixType, int Index>
+struct ei_assign_in_order<Diagonal<MatrixType, Index> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+#ifdef EIGEN2_SUPPORT
+template<typename MatrixType>
+struct ei_assign_in_order<Minor<MatrixType> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+#endif
+template<typename ExpressionType>
+struct ei_assign_in_order<ArrayWrapper<ExpressionType> >
+{ enum { ret = ei_assign_in_order<ExpressionType>::ret }; };
+template<typename ExpressionType>
+struct ei_assign_in_order<MatrixWrapper<ExpressionType> >
+{ enum { ret = ei_assign_in_order<ExpressionType>::ret }; };
+template<typename ExpressionType>
+struct ei_assign_in_order<NestByValue<ExpressionType> >
+{ enum { ret = ei_assign_in_order<ExpressionType>::ret }; };
+template<typename ExpressionType>
+struct ei_assign_in_order<ForceAlignedAccess<ExpressionType> >
+{ enum { ret = ei_assign_in_order<ExpressionType>::ret }; };
+template<typename ExpressionType, unsigned int Added, unsigned int Removed>
+struct ei_assign_in_order<Flagged<ExpressionType, Added, Removed> >
+{ enum { ret = ei_assign_in_order<ExpressionType>::ret }; };
+template<typename MatrixType, int RowFactor, int ColFactor>
+struct ei_assign_in_order<Replicate<MatrixType, RowFactor, ColFactor> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+template<typename MatrixType, int Direction>
+struct ei_assign_in_order<Reverse<MatrixType, Direction> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+template<typename MatrixType, typename BinaryOp, int Direction>
+struct ei_assign_in_order<PartialReduxExpr<MatrixType, BinaryOp, Direction> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret }; };
+template<typename ConditionMatrixType, typename ThenMatrixType, typename ElseMatrixType>
+struct ei_assign_in_order<Select<ConditionMatrixType, ThenMatrixType, ElseMatrixType> >
+{ enum { ret = ei_assign_in_order<ConditionMatrixType>::ret || ei_assign_in_order<ThenMatrixType>::ret
+            || ei_assign_in_order<ElseMatrixType>::ret }; };
+template<typename _DiagonalVectorType>
+struct ei_assign_in_order<DiagonalWrapper<_DiagonalVectorType> >
+{ enum { ret = ei_assign_in_order<_DiagonalVectorType>::ret }; };
+template<typename MatrixType, typename DiagonalType, int ProductOrder>
+struct ei_assign_in_order<DiagonalProduct<MatrixType, DiagonalType, ProductOrder> >
+{ enum { ret = ei_assign_in_order<MatrixType>::ret || ei_assign_in_order<DiagonalType>::ret }; };
+template<typename Lhs, typename Rhs, int NestingFlags>
+struct ei_assign_in_order<CoeffBasedProduct<Lhs, Rhs, NestingFlags> >
+{ enum { ret = ei_assign_in_order<Lhs>::ret || ei_assign_in_order<Rhs>::ret }; };
+
+/** \internal \returns whether the assignment of \a size coefficients of an expression of type \a Derived2
+  * is worth being split over several threads. This is only the case if EIGEN_PARALLELIZE_ASSIGN is defined,
+  * OpenMP is enabled, we are not already in a parallel region, and the amount of work is larger than
+  * EIGEN_PARALLEL_ASSIGN_THRESHOLD.
+  */
+template<typename Derived2>
+inline bool ei_assign_in_parallel(int size)
+{
+#ifdef EIGEN_ASSIGN_USE_OPENMP
+  return (!ei_assign_in_order<Derived2>::ret)
+      && double(size) * double(std::max<int>(1, Derived2::CoeffReadCost)) >= double(EIGEN_PARALLEL_ASSIGN_THRESHOLD)
+      && omp_get_num_threads() == 1 && omp_get_max_threads() > 1;
+#else
+  (void)size;
+  return false;
+#endif
+}
+
 /***************************************************************************
 * Part 2 : meta-unrollers
 ***************************************************************************/
@@ -258,6 +353,9 @@ struct ei_assign_impl<Derived1, Derived2, DefaultTraversal, NoUnrolling>
   {
     const int innerSize = dst.innerSize();
     const int outerSize = dst.outerSize();
+#ifdef EIGEN_ASSIGN_USE_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_assign_in_parallel<Derived2>(dst.size()))
+#endif
     for(int outer = 0; outer < outerSize; ++outer)
       for(int inner = 0; inner < innerSize; ++inner)
         dst.copyCoeffByOuterInner(outer, inner, src);
@@ -280,6 +378,9 @@ struct ei_assign_impl<Derived1, Derived2, DefaultTraversal, InnerUnrolling>
   EIGEN_STRONG_INLINE static void run(Derived1 &dst, const Derived2 &src)
   {
     const int outerSize = dst.outerSize();
+#ifdef EIGEN_ASSIGN_USE_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_assign_in_parallel<Derived2>(dst.size()))
+#endif
     for(int outer = 0; outer < outerSize; ++outer)
       ei_assign_DefaultTraversal_InnerUnrolling<Derived1, Derived2, 0, Derived1::InnerSizeAtCompileTime>
         ::run(dst, src, outer);
@@ -296,6 +397,9 @@ struct ei_assign_impl<Derived1, Derived2, LinearTraversal, NoUnrolling>
   inline static void run(Derived1 &dst, const Derived2 &src)
   {
     const int size = dst.size();
+#ifdef EIGEN_ASSIGN_USE_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_assign_in_parallel<Derived2>(size))
+#endif
     for(int i = 0; i < size; ++i)
       dst.copyCoeff(i, src);
   }
@@ -323,6 +427,9 @@ struct ei_assign_impl<Derived1, Derived2, InnerVectorizedTraversal, NoUnrolling>
     const int innerSize = dst.innerSize();
     const int outerSize = dst.outerSize();
     const int packetSize = ei_packet_traits<typename Derived1::Scalar>::size;
+#ifdef EIGEN_ASSIGN_USE_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_assign_in_parallel<Derived2>(dst.size()))
+#endif
     for(int outer = 0; outer < outerSize; ++outer)
       for(int inner = 0; inner < innerSize; inner+=packetSize)
         dst.template copyPacketByOuterInner<Derived2, Aligned, Aligned>(outer, inner, src);
@@ -345,6 +452,9 @@ struct ei_assign_impl<Derived1, Derived2, InnerVectorizedTraversal, InnerUnrolli
   EIGEN_STRONG_INLINE static void run(Derived1 &dst, const Derived2 &src)
   {
     const int outerSize = dst.outerSize();
+#ifdef EIGEN_ASSIGN_USE_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_assign_in_parallel<Derived2>(dst.size()))
+#endif
     for(int outer = 0; outer < outerSize; ++outer)
       ei_assign_innervec_InnerUnrolling<Derived1, Derived2, 0, Derived1::InnerSizeAtCompileTime>
         ::run(dst, src, outer);
@@ -393,6 +503,10 @@ struct ei_assign_impl<Derived1, Derived2, LinearVectorizedTraversal, NoUnrolling
 
     ei_unaligned_assign_impl<ei_assign_traits<Derived1,Derived2>::DstIsAligned!=0>::run(src,dst,0,alignedStart);
 
+    // the static schedule gives each thread a contiguous range of whole packets
+#ifdef EIGEN_ASSIGN_USE_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_assign_in_parallel<Derived2>(size))
+#endif
     for(int index = alignedStart; index < alignedEnd; index += packetSize)
     {
       dst.template copyPacket<Derived2, Aligned, ei_assign_traits<Derived1,Derived2>::JointAlignment>(index, src);
@@ -430,11 +544,17 @@ struct ei_assign_impl<Derived1, Derived2, SliceVectorizedTraversal, NoUnrolling>
     const int innerSize = dst.innerSize();
     const int outerSize = dst.outerSize();
     const int alignedStep = (packetSize - dst.outerStride() % packetSize) & packetAlignedMask;
-    int alignedStart = ei_assign_traits<Derived1,Derived2>::DstIsAligned ? 0
-                     : ei_first_aligned(&dst.coeffRef(0,0), innerSize);
+    const int firstAlignedStart = bool(ei_assign_traits<Derived1,Derived2>::DstIsAligned) ? 0
+                                : ei_first_aligned(&dst.coeffRef(0,0), innerSize);
 
+#ifdef EIGEN_ASSIGN_USE_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_assign_in_parallel<Derived2>(dst.size()))
+#endif
     for(int outer = 0; outer < outerSize; ++outer)
     {
+      // the alignment of each inner vector is shifted by alignedStep
+      const int alignedStart = outer==0 ? firstAlignedStart
+                             : std::min<int>((firstAlignedStart + alignedStep*(outer%packetSize)) % packetSize, innerSize);
       const int alignedEnd = alignedStart + ((innerSize-alignedStart) & ~packetAlignedMask);
       // do the non-vectorizable part of the assignment
       for(int inner = 0; inner<alignedStart ; ++inner)
@@ -447,8 +567,6 @@ struct ei_assign_impl<Derived1, Derived2, SliceVectorizedTraversal, NoUnrolling>
       // do the non-vectorizable part of the assignment
       for(int inner = alignedEnd; inner<innerSize ; ++inner)
         dst.copyCoeffByOuterInner(outer, inner, src);
-
-      alignedStart = std::min<int>((alignedStart+alignedStep)%packetSize, innerSize);
     }
   }
 };
@@ -453,7 +453,7 @@ EIGEN_STRONG_INLINE void DenseBase<Derived>::copyPacketByOuterInner(int outer, i
   const int row = Derived::rowIndexByOuterInner(outer,inner);
   const int col = Derived::colIndexByOuterInner(outer,inner);
   // derived() is important here: copyCoeff() may be reimplemented in Derived!
-  derived().copyPacket<OtherDerived, StoreMode, LoadMode>(row, col, other);
+  derived().template copyPacket<OtherDerived, StoreMode, LoadMode>(row, col, other);
 }
 
 template<typename Derived, bool JustReturnZero>
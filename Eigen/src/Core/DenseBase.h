@@ -291,6 +291,9 @@ template<typename Derived> class DenseBase
     /** Copies \a other into *this without evaluating other. \returns a reference to *this. */
     template<typename OtherDerived>
     Derived& lazyAssign(const DenseBase<OtherDerived>& other);
+
+    template<typename MatrixType, typename MemberOp, int Direction>
+    Derived& lazyAssign(const PartialReduxExpr<MatrixType, MemberOp, Direction>& other);
 #endif // not EIGEN_PARSED_BY_DOXYGEN
 
     /** \returns the pointer increment between two consecutive elements within a slice in the inner direction.
@@ -564,6 +567,8 @@ template<typename Derived> class DenseBase
     template<bool Enable> inline typename ei_meta_if<Enable,ForceAlignedAccess<Derived>,Derived&>::ret forceAlignedAccessIf();
 
     Scalar sum() const;
+    Scalar sum(Pairwise_t) const;
+    Scalar sum(Kahan_t) const;
     Scalar mean() const;
     Scalar trace() const;
 
@@ -581,6 +586,9 @@ template<typename Derived> class DenseBase
     template<typename BinaryOp>
     typename ei_result_of<BinaryOp(typename ei_traits<Derived>::Scalar)>::type
     redux(const BinaryOp& func) const;
+    template<typename BinaryOp>
+    typename ei_result_of<BinaryOp(typename ei_traits<Derived>::Scalar)>::type
+    redux(const BinaryOp& func, Pairwise_t) const;
 
     template<typename Visitor>
     void visit(Visitor& func) const;
@@ -43,6 +43,12 @@ struct ei_dot_nocheck
   {
     return a.conjugate().cwiseProduct(b).sum();
   }
+
+  template<typename Mode>
+  static inline typename ei_traits<T>::Scalar run(const MatrixBase<T>& a, const MatrixBase<U>& b, Mode mode)
+  {
+    return a.conjugate().cwiseProduct(b).sum(mode);
+  }
 };
 
 template<typename T, typename U>
@@ -52,6 +58,12 @@ struct ei_dot_nocheck<T, U, true>
   {
     return a.adjoint().cwiseProduct(b).sum();
   }
+
+  template<typename Mode>
+  static inline typename ei_traits<T>::Scalar run(const MatrixBase<T>& a, const MatrixBase<U>& b, Mode mode)
+  {
+    return a.adjoint().cwiseProduct(b).sum(mode);
+  }
 };
 
 /** \returns the dot product of *this with other.
@@ -80,6 +92,53 @@ MatrixBase<Derived>::dot(const MatrixBase<OtherDerived>& other) const
   return ei_dot_nocheck<Derived,OtherDerived>::run(*this, other);
 }
 
+/** \returns the dot product of *this with other, computed by pairwise summation in an order
+  * which depends neither on the alignment of the data nor on the number of threads, see sum(Pairwise_t).
+  *
+  * \only_for_vectors
+  *
+  * \sa dot(const MatrixBase<OtherDerived>&) const, dot(const MatrixBase<OtherDerived>&, Kahan_t) const
+  */
+template<typename Derived>
+template<typename OtherDerived>
+typename ei_traits<Derived>::Scalar
+MatrixBase<Derived>::dot(const MatrixBase<OtherDerived>& other, Pairwise_t) const
+{
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(OtherDerived)
+  EIGEN_STATIC_ASSERT_SAME_VECTOR_SIZE(Derived,OtherDerived)
+  EIGEN_STATIC_ASSERT((ei_is_same_type<Scalar, typename OtherDerived::Scalar>::ret),
+    YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+
+  ei_assert(size() == other.size());
+
+  return ei_dot_nocheck<Derived,OtherDerived>::run(*this, other, Pairwise);
+}
+
+/** \returns the dot product of *this with other, computed with Kahan's compensated summation
+  * in an order which depends neither on the alignment of the data nor on the number of threads,
+  * see sum(Kahan_t).
+  *
+  * \only_for_vectors
+  *
+  * \sa dot(const MatrixBase<OtherDerived>&) const, dot(const MatrixBase<OtherDerived>&, Pairwise_t) const
+  */
+template<typename Derived>
+template<typename OtherDerived>
+typename ei_traits<Derived>::Scalar
+MatrixBase<Derived>::dot(const MatrixBase<OtherDerived>& other, Kahan_t) const
+{
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+  EIGEN_STATIC_ASSERT_VECTOR_ONLY(OtherDerived)
+  EIGEN_STATIC_ASSERT_SAME_VECTOR_SIZE(Derived,OtherDerived)
+  EIGEN_STATIC_ASSERT((ei_is_same_type<Scalar, typename OtherDerived::Scalar>::ret),
+    YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+
+  ei_assert(size() == other.size());
+
+  return ei_dot_nocheck<Derived,OtherDerived>::run(*this, other, Kahan);
+}
+
 /** \returns the squared \em l2 norm of *this, i.e., for vectors, the dot product of *this with itself.
   *
   * \sa dot(), norm()
@@ -90,6 +149,26 @@ inline typename NumTraits<typename ei_traits<Derived>::Scalar>::Real MatrixBase<
   return ei_real((*this).cwiseAbs2().sum());
 }
 
+/** \returns the squared \em l2 norm of *this computed by pairwise summation, see sum(Pairwise_t).
+  *
+  * \sa squaredNorm(), norm(Pairwise_t)
+  */
+template<typename Derived>
+inline typename NumTraits<typename ei_traits<Derived>::Scalar>::Real MatrixBase<Derived>::squaredNorm(Pairwise_t) const
+{
+  return ei_real((*this).cwiseAbs2().sum(Pairwise));
+}
+
+/** \returns the squared \em l2 norm of *this computed with Kahan's compensated summation, see sum(Kahan_t).
+  *
+  * \sa squaredNorm(), norm(Kahan_t)
+  */
+template<typename Derived>
+inline typename NumTraits<typename ei_traits<Derived>::Scalar>::Real MatrixBase<Derived>::squaredNorm(Kahan_t) const
+{
+  return ei_real((*this).cwiseAbs2().sum(Kahan));
+}
+
 /** \returns the \em l2 norm of *this, i.e., for vectors, the square root of the dot product of *this with itself.
   *
   * \sa dot(), squaredNorm()
@@ -100,6 +179,26 @@ inline typename NumTraits<typename ei_traits<Derived>::Scalar>::Real MatrixBase<
   return ei_sqrt(squaredNorm());
 }
 
+/** \returns the \em l2 norm of *this computed by pairwise summation, see squaredNorm(Pairwise_t).
+  *
+  * \sa norm()
+  */
+template<typename Derived>
+inline typename NumTraits<typename ei_traits<Derived>::Scalar>::Real MatrixBase<Derived>::norm(Pairwise_t) const
+{
+  return ei_sqrt(squaredNorm(Pairwise));
+}
+
+/** \returns the \em l2 norm of *this computed with Kahan's compensated summation, see squaredNorm(Kahan_t).
+  *
+  * \sa norm()
+  */
+template<typename Derived>
+inline typename NumTraits<typename ei_traits<Derived>::Scalar>::Real MatrixBase<Derived>::norm(Kahan_t) const
+{
+  return ei_sqrt(squaredNorm(Kahan));
+}
+
 /** \returns an expression of the quotient of *this by its own norm.
   *
   * \only_for_vectors
@@ -58,8 +58,11 @@ struct ei_default_packet_traits
     HasMul    = 1,
     HasNegate = 1,
     HasAbs    = 1,
+    HasAbs2   = 1,
     HasMin    = 1,
     HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 1,
 
     HasDiv    = 0,
     HasSqrt   = 0,
@@ -105,6 +108,10 @@ ei_psub(const Packet& a,
 template<typename Packet> inline Packet
 ei_pnegate(const Packet& a) { return -a; }
 
+/** \internal \returns conj(a) (coeff-wise) */
+template<typename Packet> inline Packet
+ei_pconj(const Packet& a) { return ei_conj(a); }
+
 /** \internal \returns a * b (coeff-wise) */
 template<typename Packet> inline Packet
 ei_pmul(const Packet& a,
@@ -205,6 +212,12 @@ template<typename Packet> inline typename ei_unpacket_traits<Packet>::type ei_pr
 template<typename Packet> inline Packet ei_preverse(const Packet& a)
 { return a; }
 
+/** \internal \returns \a a with the two halves of each pair of consecutive coefficients swapped, i.e.
+  * (a1,a0,a3,a2,...). When the packet holds interleaved complex numbers, this swaps their real
+  * and imaginary parts. The default implementation is only valid for packets of size 1 or 2. */
+template<typename Packet> inline Packet ei_pcplxflip(const Packet& a)
+{ return ei_preverse(a); }
+
 /**************************
 * Special math functions
 ***************************/
@@ -0,0 +1,257 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_HALF_H
+#define EIGEN_HALF_H
+
+/** \internal \returns the bits of the IEEE half precision number nearest to \a f, ties to even */
+inline unsigned short ei_float_to_half_bits(float f)
+{
+  union { float f; unsigned int u; } in;
+  in.f = f;
+  const unsigned int sign = in.u & 0x80000000u;
+  in.u ^= sign;
+  unsigned short res;
+  if(in.u >= (127u+16u)<<23)
+  {
+    // overflow to infinity, NaN stays a (quiet) NaN
+    res = in.u > 255u<<23 ? 0x7e00 : 0x7c00;
+  }
+  else if(in.u < (127u-14u)<<23)
+  {
+    // denormal or zero: let the FPU round the mantissa by aligning it with a magic number
+    union { float f; unsigned int u; } magic;
+    magic.u = ((127u-15u) + (23u-10u) + 1u) << 23;
+    in.f += magic.f;
+    res = static_cast<unsigned short>(in.u - magic.u);
+  }
+  else
+  {
+    const unsigned int mantissaOdd = (in.u >> 13) & 1;
+    in.u -= (127u-15u) << 23;
+    in.u += 0xfff + mantissaOdd;
+    res = static_cast<unsigned short>(in.u >> 13);
+  }
+  return res | static_cast<unsigned short>(sign >> 16);
+}
+
+/** \internal \returns the float equal to the IEEE half precision number of bits \a h */
+inline float ei_half_bits_to_float(unsigned short h)
+{
+  union { float f; unsigned int u; } res, magic;
+  const unsigned int shiftedExponent = 0x7c00u << 13;
+  res.u = (h & 0x7fffu) << 13;
+  const unsigned int exponent = shiftedExponent & res.u;
+  res.u += (127u-15u) << 23;
+  if(exponent == shiftedExponent)
+  {
+    // infinity or NaN
+    res.u += (128u-16u) << 23;
+  }
+  else if(exponent == 0)
+  {
+    // zero or denormal, renormalized by the FPU
+    magic.u = 113u << 23;
+    res.u += 1u << 23;
+    res.f -= magic.f;
+  }
+  res.u |= (h & 0x8000u) << 16;
+  return res.f;
+}
+
+/** \internal \returns the bits of the bfloat16 number nearest to \a f, ties to even */
+inline unsigned short ei_float_to_bfloat16_bits(float f)
+{
+  union { float f; unsigned int u; } in;
+  in.f = f;
+  if(f != f)
+    return static_cast<unsigned short>((in.u >> 16) | 0x0040);
+  in.u += 0x7fff + ((in.u >> 16) & 1);
+  return static_cast<unsigned short>(in.u >> 16);
+}
+
+/** \internal \returns the float equal to the bfloat16 number of bits \a b */
+inline float ei_bfloat16_bits_to_float(unsigned short b)
+{
+  union { float f; unsigned int u; } res;
+  res.u = static_cast<unsigned int>(b) << 16;
+  return res.f;
+}
+
+/** \class half
+  *
+  * \brief IEEE 754 half precision floating point number
+  *
+  * A half is stored in 16 bits: 1 sign bit, 5 exponent bits and 10 mantissa bits, which gives about
+  * 3 significant decimal digits in the range [6e-5, 65504]. It is meant to store large matrices at
+  * half the size of float: a half converts implicitly to float, and the arithmetic operators compute
+  * in float and round the result to half.
+  *
+  * The matrix products of half matrices widen the coefficients to float in registers and accumulate
+  * in float, so that the result is rounded only once, see ei_product_accumulator.
+  *
+  * \sa class bfloat16
+  */
+class half
+{
+  public:
+    half() {}
+    explicit half(float f) : m_bits(ei_float_to_half_bits(f)) {}
+    operator float() const { return ei_half_bits_to_float(m_bits); }
+
+    /** \returns the half of bits \a bits */
+    static half fromBits(unsigned short bits) { half res; res.m_bits = bits; return res; }
+    /** \returns the bits of \c *this */
+    unsigned short bits() const { return m_bits; }
+
+  protected:
+    unsigned short m_bits;
+};
+
+/** \class bfloat16
+  *
+  * \brief Brain floating point number: the 16 upper bits of a float
+  *
+  * A bfloat16 has the same 8 exponent bits, and therefore the same range, as a float, but only 7
+  * mantissa bits, i.e., between 2 and 3 significant decimal digits. Converting to float is exact
+  * and almost free. Otherwise it behaves as half.
+  *
+  * \sa class half
+  */
+class bfloat16
+{
+  public:
+    bfloat16() {}
+    explicit bfloat16(float f) : m_bits(ei_float_to_bfloat16_bits(f)) {}
+    operator float() const { return ei_bfloat16_bits_to_float(m_bits); }
+
+    /** \returns the bfloat16 of bits \a bits */
+    static bfloat16 fromBits(unsigned short bits) { bfloat16 res; res.m_bits = bits; return res; }
+    /** \returns the bits of \c *this */
+    unsigned short bits() const { return m_bits; }
+
+  protected:
+    unsigned short m_bits;
+};
+
+#define EIGEN_MAKE_REDUCED_PRECISION_OPERATORS(T) \
+  inline T operator+(const T& a, const T& b) { return T(float(a) + float(b)); } \
+  inline T operator-(const T& a, const T& b) { return T(float(a) - float(b)); } \
+  inline T operator*(const T& a, const T& b) { return T(float(a) * float(b)); } \
+  inline T operator/(const T& a, const T& b) { return T(float(a) / float(b)); } \
+  inline T operator-(const T& a) { return T::fromBits(a.bits() ^ 0x8000); } \
+  inline T& operator+=(T& a, const T& b) { return a = a + b; } \
+  inline T& operator-=(T& a, const T& b) { return a = a - b; } \
+  inline T& operator*=(T& a, const T& b) { return a = a * b; } \
+  inline T& operator/=(T& a, const T& b) { return a = a / b; }
+
+EIGEN_MAKE_REDUCED_PRECISION_OPERATORS(half)
+EIGEN_MAKE_REDUCED_PRECISION_OPERATORS(bfloat16)
+
+#undef EIGEN_MAKE_REDUCED_PRECISION_OPERATORS
+
+template<> struct NumTraits<half>
+  : GenericNumTraits<half>
+{
+  enum {
+    IsInteger = 0,
+    IsSigned = 1
+  };
+  inline static half epsilon() { return half::fromBits(0x1400); }          // 2^-10
+  inline static half dummy_precision() { return half(1e-2f); }
+  inline static half highest() { return half::fromBits(0x7bff); }          // 65504
+  inline static half lowest() { return half::fromBits(0x0400); }           // 2^-14
+};
+
+template<> struct NumTraits<bfloat16>
+  : GenericNumTraits<bfloat16>
+{
+  enum {
+    IsInteger = 0,
+    IsSigned = 1
+  };
+  inline static bfloat16 epsilon() { return bfloat16::fromBits(0x3c00); }  // 2^-7
+  inline static bfloat16 dummy_precision() { return bfloat16(8e-2f); }
+  inline static bfloat16 highest() { return bfloat16::fromBits(0x7f7f); }
+  inline static bfloat16 lowest() { return bfloat16::fromBits(0x0080); }   // 2^-126
+};
+
+// the math functions are evaluated in float
+#define EIGEN_MAKE_REDUCED_PRECISION_FUNCTION(T, FUNC) \
+  template<> struct ei_##FUNC##_impl<T> { \
+    static inline T run(const T& x) { return T(std::FUNC(float(x))); } \
+  };
+
+#define EIGEN_MAKE_REDUCED_PRECISION_FUNCTIONS(T) \
+  EIGEN_MAKE_REDUCED_PRECISION_FUNCTION(T, abs) \
+  EIGEN_MAKE_REDUCED_PRECISION_FUNCTION(T, sqrt) \
+  EIGEN_MAKE_REDUCED_PRECISION_FUNCTION(T, exp) \
+  EIGEN_MAKE_REDUCED_PRECISION_FUNCTION(T, log) \
+  EIGEN_MAKE_REDUCED_PRECISION_FUNCTION(T, cos) \
+  EIGEN_MAKE_REDUCED_PRECISION_FUNCTION(T, sin) \
+  template<> struct ei_pow_impl<T> { \
+    static inline T run(const T& x, const T& y) { return T(std::pow(float(x), float(y))); } \
+  }; \
+  template<> struct ei_random_impl<T> { \
+    static inline T run(const T& x, const T& y) { return T(ei_random<float>(x, y)); } \
+    static inline T run() { return T(ei_random<float>()); } \
+  };
+
+EIGEN_MAKE_REDUCED_PRECISION_FUNCTIONS(half)
+EIGEN_MAKE_REDUCED_PRECISION_FUNCTIONS(bfloat16)
+
+#undef EIGEN_MAKE_REDUCED_PRECISION_FUNCTIONS
+#undef EIGEN_MAKE_REDUCED_PRECISION_FUNCTION
+
+/** \internal
+  * The scalar type in which the matrix products of \a Scalar are accumulated. The factors of a product
+  * of half or bfloat16 are widened to float in registers, see ei_ploadu_widen(), and the result is
+  * rounded to the reduced precision type once.
+  */
+template<typename Scalar> struct ei_product_accumulator { typedef Scalar type; };
+template<> struct ei_product_accumulator<half> { typedef float type; };
+template<> struct ei_product_accumulator<bfloat16> { typedef float type; };
+
+// the specializations are keyed on the scalar type of the packet rather than on the packet type,
+// whose vector attributes would be ignored as a template argument
+template<typename AccScalar, typename Scalar> struct ei_pwiden_impl
+{
+  typedef typename ei_packet_traits<AccScalar>::type Packet;
+  static inline Packet run(const Scalar* from)
+  {
+    enum { PacketSize = ei_packet_traits<AccScalar>::size };
+    EIGEN_ALIGN16 AccScalar values[PacketSize];
+    for(int k=0; k<PacketSize; ++k)
+      values[k] = AccScalar(from[k]);
+    return ei_pload(values);
+  }
+};
+
+/** \internal \returns the packet of the higher precision type \a AccScalar whose coefficients are
+  * converted from the (unaligned) reduced precision coefficients \a from */
+template<typename AccScalar, typename Scalar>
+EIGEN_STRONG_INLINE typename ei_packet_traits<AccScalar>::type ei_ploadu_widen(const Scalar* from)
+{
+  return ei_pwiden_impl<AccScalar,Scalar>::run(from);
+}
+
+#endif // EIGEN_HALF_H
@@ -79,7 +79,8 @@ struct ei_traits<Map<PlainObjectType, MapOptions, StrideType> >
 {
   typedef typename PlainObjectType::Scalar Scalar;
   enum {
-    InnerStrideAtCompileTime = StrideType::InnerStrideAtCompileTime,
+    // an inner stride of 0 means that the coefficients are contiguous
+    InnerStrideAtCompileTime = StrideType::InnerStrideAtCompileTime == 0 ? 1 : int(StrideType::InnerStrideAtCompileTime),
     OuterStrideAtCompileTime = StrideType::OuterStrideAtCompileTime,
     HasNoInnerStride = InnerStrideAtCompileTime <= 1,
     HasNoOuterStride = OuterStrideAtCompileTime == 0,
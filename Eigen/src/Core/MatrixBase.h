@@ -194,8 +194,16 @@ template<typename Derived> class MatrixBase
 
     template<typename OtherDerived>
     Scalar dot(const MatrixBase<OtherDerived>& other) const;
+    template<typename OtherDerived>
+    Scalar dot(const MatrixBase<OtherDerived>& other, Pairwise_t) const;
+    template<typename OtherDerived>
+    Scalar dot(const MatrixBase<OtherDerived>& other, Kahan_t) const;
     RealScalar squaredNorm() const;
+    RealScalar squaredNorm(Pairwise_t) const;
+    RealScalar squaredNorm(Kahan_t) const;
     RealScalar norm() const;
+    RealScalar norm(Pairwise_t) const;
+    RealScalar norm(Kahan_t) const;
     RealScalar stableNorm() const;
     RealScalar blueNorm() const;
     RealScalar hypotNorm() const;
@@ -321,6 +329,7 @@ template<typename Derived> class MatrixBase
 /////////// SVD module ///////////
 
     SVD<PlainObject> svd() const;
+    BDCSVD<PlainObject> bdcSvd(unsigned int computationOptions = ComputeFullU | ComputeFullV) const;
 
 /////////// Geometry module ///////////
 
@@ -265,6 +265,9 @@ struct ei_traits<GeneralProduct<Lhs,Rhs,GemvProduct> >
 template<int Side, int StorageOrder, bool BlasCompatible>
 struct ei_gemv_selector;
 
+template<int Side, int StorageOrder, bool BlasCompatible>
+struct ei_widening_gemv_selector;
+
 template<typename Lhs, typename Rhs>
 class GeneralProduct<Lhs, Rhs, GemvProduct>
   : public ProductBase<GeneralProduct<Lhs,Rhs,GemvProduct>, Lhs, Rhs>
@@ -284,9 +287,23 @@ class GeneralProduct<Lhs, Rhs, GemvProduct>
     template<typename Dest> void scaleAndAddTo(Dest& dst, Scalar alpha) const
     {
       ei_assert(m_lhs.rows() == dst.rows() && m_rhs.cols() == dst.cols());
+      _scaleAndAddTo(dst, alpha, typename ei_meta_if<ei_is_same_type<typename ei_product_accumulator<Scalar>::type,Scalar>::ret,
+                                                     ei_meta_true, ei_meta_false>::ret());
+    }
+
+  protected:
+    template<typename Dest> void _scaleAndAddTo(Dest& dst, Scalar alpha, const ei_meta_true&) const
+    {
       ei_gemv_selector<Side,(int(MatrixType::Flags)&RowMajorBit) ? RowMajor : ColMajor,
                        bool(ei_blas_traits<MatrixType>::HasUsableDirectAccess)>::run(*this, dst, alpha);
     }
+
+    // reduced precision scalars, e.g. half, are accumulated in a higher precision type, see ei_product_accumulator
+    template<typename Dest> void _scaleAndAddTo(Dest& dst, Scalar alpha, const ei_meta_false&) const
+    {
+      ei_widening_gemv_selector<Side,(int(MatrixType::Flags)&RowMajorBit) ? RowMajor : ColMajor,
+                                bool(ei_blas_traits<MatrixType>::HasUsableDirectAccess)>::run(*this, dst, alpha);
+    }
 };
 
 // The vector is on the left => transposition
@@ -311,9 +328,10 @@ template<> struct ei_gemv_selector<OnTheRight,ColMajor,true>
   {
     typedef typename ProductType::Scalar Scalar;
     typedef typename ProductType::ActualLhsType ActualLhsType;
-    typedef typename ProductType::ActualRhsType ActualRhsType;
     typedef typename ProductType::LhsBlasTraits LhsBlasTraits;
     typedef typename ProductType::RhsBlasTraits RhsBlasTraits;
+    // the coefficients of the rhs are read one by one, so that it does not need to be evaluated
+    typedef typename RhsBlasTraits::ExtractType ActualRhsType;
 
     ActualLhsType actualLhs = LhsBlasTraits::extract(prod.lhs());
     ActualRhsType actualRhs = RhsBlasTraits::extract(prod.rhs());
@@ -413,6 +431,90 @@ template<> struct ei_gemv_selector<OnTheRight,RowMajor,false>
   }
 };
 
+// The vector is on the left => transposition
+template<int StorageOrder, bool BlasCompatible>
+struct ei_widening_gemv_selector<OnTheLeft,StorageOrder,BlasCompatible>
+{
+  template<typename ProductType, typename Dest>
+  static void run(const ProductType& prod, Dest& dest, typename ProductType::Scalar alpha)
+  {
+    Transpose<Dest> destT(dest);
+    enum { OtherStorageOrder = StorageOrder == RowMajor ? ColMajor : RowMajor };
+    ei_widening_gemv_selector<OnTheRight,OtherStorageOrder,BlasCompatible>
+      ::run(GeneralProduct<Transpose<typename ProductType::_RhsNested>,Transpose<typename ProductType::_LhsNested>, GemvProduct>
+        (prod.rhs().transpose(), prod.lhs().transpose()), destT, alpha);
+  }
+};
+
+// the matrix cannot be read directly => same as for other scalar types
+template<int StorageOrder>
+struct ei_widening_gemv_selector<OnTheRight,StorageOrder,false> : ei_gemv_selector<OnTheRight,StorageOrder,false> {};
+
+template<> struct ei_widening_gemv_selector<OnTheRight,ColMajor,true>
+{
+  template<typename ProductType, typename Dest>
+  static void run(const ProductType& prod, Dest& dest, typename ProductType::Scalar alpha)
+  {
+    typedef typename ProductType::Scalar Scalar;
+    typedef typename ei_product_accumulator<Scalar>::type AccScalar;
+    typedef typename ProductType::ActualLhsType ActualLhsType;
+    typedef typename ProductType::LhsBlasTraits LhsBlasTraits;
+    typedef typename ProductType::RhsBlasTraits RhsBlasTraits;
+    typedef typename RhsBlasTraits::ExtractType ActualRhsType;
+    typedef Map<Matrix<AccScalar,Dynamic,1>, Aligned> AccVector;
+
+    ActualLhsType actualLhs = LhsBlasTraits::extract(prod.lhs());
+    ActualRhsType actualRhs = RhsBlasTraits::extract(prod.rhs());
+
+    AccScalar actualAlpha = AccScalar(alpha * LhsBlasTraits::extractScalarFactor(prod.lhs())
+                                            * RhsBlasTraits::extractScalarFactor(prod.rhs()));
+
+    // the result is accumulated in AccScalar, and rounded once
+    AccScalar* acc = ei_aligned_stack_new(AccScalar, dest.size());
+    AccVector(acc, dest.size()) = dest.template cast<AccScalar>();
+
+    ei_widening_product_colmajor_times_vector(
+      dest.size(),
+      &actualLhs.const_cast_derived().coeffRef(0,0), actualLhs.outerStride(),
+      actualRhs, acc, actualAlpha);
+
+    dest = AccVector(acc, dest.size()).template cast<Scalar>();
+    ei_aligned_stack_delete(AccScalar, acc, dest.size());
+  }
+};
+
+template<> struct ei_widening_gemv_selector<OnTheRight,RowMajor,true>
+{
+  template<typename ProductType, typename Dest>
+  static void run(const ProductType& prod, Dest& dest, typename ProductType::Scalar alpha)
+  {
+    typedef typename ProductType::Scalar Scalar;
+    typedef typename ei_product_accumulator<Scalar>::type AccScalar;
+    typedef typename ProductType::ActualLhsType ActualLhsType;
+    typedef typename ProductType::LhsBlasTraits LhsBlasTraits;
+    typedef typename ProductType::RhsBlasTraits RhsBlasTraits;
+    typedef typename RhsBlasTraits::ExtractType ActualRhsType;
+    typedef Map<Matrix<AccScalar,Dynamic,1>, Aligned> AccVector;
+
+    ActualLhsType actualLhs = LhsBlasTraits::extract(prod.lhs());
+    ActualRhsType actualRhs = RhsBlasTraits::extract(prod.rhs());
+
+    AccScalar actualAlpha = AccScalar(alpha * LhsBlasTraits::extractScalarFactor(prod.lhs())
+                                            * RhsBlasTraits::extractScalarFactor(prod.rhs()));
+
+    // the rhs is read once per row, so it is converted to AccScalar once
+    const int rhsSize = prod.rhs().size();
+    AccScalar* rhs = ei_aligned_stack_new(AccScalar, rhsSize);
+    AccVector(rhs, rhsSize) = actualRhs.template cast<AccScalar>();
+
+    ei_widening_product_rowmajor_times_vector(
+      &actualLhs.const_cast_derived().coeffRef(0,0), actualLhs.outerStride(),
+      rhs, rhsSize, dest, actualAlpha);
+
+    ei_aligned_stack_delete(AccScalar, rhs, rhsSize);
+  }
+};
+
 /***************************************************************************
 * Implementation of matrix base methods
 ***************************************************************************/
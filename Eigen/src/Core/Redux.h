@@ -294,6 +294,357 @@ struct ei_redux_impl<Func, Derived, LinearVectorizedTraversal, CompleteUnrolling
   }
 };
 
+/***************************************************************************
+* Part 4 : reproducible reductions
+***************************************************************************/
+
+// The reductions below visit the coefficients in storage order and split them into chunks of
+// EIGEN_REDUX_CHUNK_SIZE coefficients. Each chunk is reduced on its own, and the partial results
+// are combined in a fixed order. The order of the operations therefore does not depend on the
+// alignment of the data nor on the number of threads reducing the chunks. It does depend on the
+// kind of expression: the ranges of an expression without linear access (e.g., a block) stop at
+// the end of each inner vector, and they are reduced by packets only if the expression has packet
+// access. A block and a plain matrix holding the same coefficients may thus round differently.
+
+/** \internal \returns whether the \a chunkCount chunks of a reproducible reduction should be
+  * reduced on several threads */
+inline bool ei_redux_in_parallel(int chunkCount)
+{
+#ifdef EIGEN_HAS_OPENMP
+  return chunkCount > 1 && omp_get_num_threads() == 1 && omp_get_max_threads() > 1;
+#else
+  (void)chunkCount;
+  return false;
+#endif
+}
+
+/** \internal reads a range of consecutive coefficients: anywhere in \a mat if it has linear access,
+  * and within the inner vector \a outer otherwise */
+template<typename Derived, bool LinearAccess = bool(int(Derived::Flags)&LinearAccessBit)>
+struct ei_redux_range_access
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename ei_packet_traits<Scalar>::type PacketScalar;
+
+  ei_redux_range_access(const Derived& mat, int outer) : m_mat(mat), m_outer(outer) {}
+  EIGEN_STRONG_INLINE Scalar coeff(int inner) const { return m_mat.coeffByOuterInner(m_outer, inner); }
+  EIGEN_STRONG_INLINE PacketScalar packet(int inner) const
+  { return m_mat.template packetByOuterInner<Unaligned>(m_outer, inner); }
+
+  const Derived& m_mat;
+  const int m_outer;
+};
+
+template<typename Derived>
+struct ei_redux_range_access<Derived, true>
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename ei_packet_traits<Scalar>::type PacketScalar;
+
+  ei_redux_range_access(const Derived& mat, int) : m_mat(mat) {}
+  EIGEN_STRONG_INLINE Scalar coeff(int index) const { return m_mat.coeff(index); }
+  EIGEN_STRONG_INLINE PacketScalar packet(int index) const { return m_mat.template packet<Unaligned>(index); }
+
+  const Derived& m_mat;
+};
+
+/** \internal calls \a visitor on each piece of the coefficients \a start to \a end (in storage order)
+  * which can be read through a single ei_redux_range_access */
+template<typename Derived, bool LinearAccess = bool(int(Derived::Flags)&LinearAccessBit)>
+struct ei_redux_visit_ranges
+{
+  template<typename Visitor>
+  static void run(const Derived& mat, int start, int end, Visitor& visitor)
+  {
+    const int innerSize = mat.innerSize();
+    int outer = start / innerSize;
+    int inner = start % innerSize;
+    while(start < end)
+    {
+      const int innerEnd = std::min(innerSize, inner + (end - start));
+      visitor(ei_redux_range_access<Derived>(mat, outer), inner, innerEnd);
+      start += innerEnd - inner;
+      inner = 0;
+      ++outer;
+    }
+  }
+};
+
+template<typename Derived>
+struct ei_redux_visit_ranges<Derived, true>
+{
+  template<typename Visitor>
+  static void run(const Derived& mat, int start, int end, Visitor& visitor)
+  {
+    visitor(ei_redux_range_access<Derived>(mat, 0), start, end);
+  }
+};
+
+/** \internal reduces the non empty range [begin,end) of \a access from left to right */
+template<typename Func, typename Derived,
+         bool Vectorize = int(ei_redux_traits<Func, Derived>::Traversal) != int(DefaultTraversal)>
+struct ei_redux_range
+{
+  typedef typename Derived::Scalar Scalar;
+
+  template<typename Access>
+  static Scalar run(const Access& access, const Func& func, int begin, int end)
+  {
+    Scalar res = access.coeff(begin);
+    for(int index = begin + 1; index < end; ++index)
+      res = func(res, access.coeff(index));
+    return res;
+  }
+};
+
+template<typename Func, typename Derived>
+struct ei_redux_range<Func, Derived, true>
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename ei_packet_traits<Scalar>::type PacketScalar;
+  enum { PacketSize = ei_packet_traits<Scalar>::size };
+
+  template<typename Access>
+  static Scalar run(const Access& access, const Func& func, int begin, int end)
+  {
+    const int size = end - begin;
+    if(size < PacketSize)
+      return ei_redux_range<Func, Derived, false>::run(access, func, begin, end);
+
+    // packets are loaded relative to begin, so that the lanes do not depend on the alignment
+    const int packetEnd = begin + (size/PacketSize)*PacketSize;
+    PacketScalar packet_res = access.packet(begin);
+    int index = begin + PacketSize;
+    if(size >= 4*PacketSize)
+    {
+      const int blockEnd = begin + (size/(4*PacketSize))*(4*PacketSize);
+      PacketScalar packet_res1 = access.packet(index);
+      PacketScalar packet_res2 = access.packet(index + PacketSize);
+      PacketScalar packet_res3 = access.packet(index + 2*PacketSize);
+      for(index += 3*PacketSize; index < blockEnd; index += 4*PacketSize)
+      {
+        packet_res  = func.packetOp(packet_res,  access.packet(index));
+        packet_res1 = func.packetOp(packet_res1, access.packet(index + PacketSize));
+        packet_res2 = func.packetOp(packet_res2, access.packet(index + 2*PacketSize));
+        packet_res3 = func.packetOp(packet_res3, access.packet(index + 3*PacketSize));
+      }
+      packet_res = func.packetOp(func.packetOp(packet_res, packet_res1), func.packetOp(packet_res2, packet_res3));
+    }
+    for(; index < packetEnd; index += PacketSize)
+      packet_res = func.packetOp(packet_res, access.packet(index));
+
+    Scalar res = func.predux(packet_res);
+    for(; index < end; ++index)
+      res = func(res, access.coeff(index));
+    return res;
+  }
+};
+
+template<typename Func, typename Derived>
+struct ei_redux_pairwise
+{
+  typedef typename Derived::Scalar Scalar;
+  enum {
+    // number of coefficients reduced from left to right at the leaves of the tree
+    LeafSize = 32 * ei_packet_traits<Scalar>::size
+  };
+
+  struct LeafVisitor
+  {
+    LeafVisitor(const Func& func) : m_func(func), m_res(Scalar(0)), m_empty(true) {}
+    template<typename Access> void operator()(const Access& access, int begin, int end)
+    {
+      Scalar res = ei_redux_range<Func, Derived>::run(access, m_func, begin, end);
+      m_res = m_empty ? res : m_func(m_res, res);
+      m_empty = false;
+    }
+    const Func& m_func;
+    Scalar m_res;
+    bool m_empty;
+  };
+
+  /** \internal reduces the coefficients \a start to \a end by recursive halving */
+  static Scalar run(const Derived& mat, const Func& func, int start, int end)
+  {
+    const int size = end - start;
+    if(size <= LeafSize)
+    {
+      LeafVisitor visitor(func);
+      ei_redux_visit_ranges<Derived>::run(mat, start, end, visitor);
+      return visitor.m_res;
+    }
+    const int half = LeafSize * (((size + LeafSize - 1) / LeafSize + 1) / 2);
+    return func(run(mat, func, start, start + half), run(mat, func, start + half, end));
+  }
+
+  /** \internal combines the partial results \a partials by recursive halving */
+  static Scalar combine(const Scalar* partials, int count, const Func& func)
+  {
+    if(count == 1)
+      return partials[0];
+    const int half = (count + 1) / 2;
+    return func(combine(partials, half, func), combine(partials + half, count - half, func));
+  }
+
+  static Scalar run(const Derived& mat, const Func& func)
+  {
+    const int size = mat.size();
+    const int chunkSize = EIGEN_REDUX_CHUNK_SIZE;
+    if(size <= chunkSize)
+      return run(mat, func, 0, size);
+
+    const int chunkCount = (size + chunkSize - 1) / chunkSize;
+    Scalar* partials = ei_aligned_stack_new(Scalar, chunkCount);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_redux_in_parallel(chunkCount))
+#endif
+    for(int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+      const int start = chunk * chunkSize;
+      partials[chunk] = run(mat, func, start, start + std::min(chunkSize, size - start));
+    }
+    Scalar res = combine(partials, chunkCount, func);
+    ei_aligned_stack_delete(Scalar, partials, chunkCount);
+    return res;
+  }
+};
+
+/** \internal compensated (Kahan) summation: the running sum is m_sum - m_compensation */
+template<typename Scalar>
+struct ei_kahan_sum
+{
+  ei_kahan_sum() : m_sum(0), m_compensation(0) {}
+
+  EIGEN_STRONG_INLINE void add(const Scalar& x)
+  {
+    const Scalar y = x - m_compensation;
+    const Scalar t = m_sum + y;
+    m_compensation = (t - m_sum) - y;
+    m_sum = t;
+  }
+
+  void add(const ei_kahan_sum& other)
+  {
+    add(other.m_sum);
+    add(-other.m_compensation);
+  }
+
+  Scalar value() const { return m_sum - m_compensation; }
+
+  Scalar m_sum, m_compensation;
+};
+
+/** \internal adds the non empty range [begin,end) of \a access to \a acc from left to right */
+template<typename Derived,
+         bool Vectorize = int(ei_redux_traits<ei_scalar_sum_op<typename Derived::Scalar>, Derived>::Traversal)
+                       != int(DefaultTraversal)>
+struct ei_redux_kahan_range
+{
+  typedef typename Derived::Scalar Scalar;
+
+  template<typename Access>
+  static void run(const Access& access, ei_kahan_sum<Scalar>& acc, int begin, int end)
+  {
+    for(int index = begin; index < end; ++index)
+      acc.add(access.coeff(index));
+  }
+};
+
+template<typename Derived>
+struct ei_redux_kahan_range<Derived, true>
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename ei_packet_traits<Scalar>::type PacketScalar;
+  enum { PacketSize = ei_packet_traits<Scalar>::size };
+
+  static EIGEN_STRONG_INLINE void add(PacketScalar& sum, PacketScalar& compensation, const PacketScalar& x)
+  {
+    const PacketScalar y = ei_psub(x, compensation);
+    const PacketScalar t = ei_padd(sum, y);
+    compensation = ei_psub(ei_psub(t, sum), y);
+    sum = t;
+  }
+
+  static void flush(ei_kahan_sum<Scalar>& acc, const PacketScalar& sum, const PacketScalar& compensation)
+  {
+    EIGEN_ALIGN16 Scalar sums[PacketSize];
+    EIGEN_ALIGN16 Scalar compensations[PacketSize];
+    ei_pstore(sums, sum);
+    ei_pstore(compensations, compensation);
+    for(int k = 0; k < PacketSize; ++k)
+    {
+      acc.add(sums[k]);
+      acc.add(-compensations[k]);
+    }
+  }
+
+  template<typename Access>
+  static void run(const Access& access, ei_kahan_sum<Scalar>& acc, int begin, int end)
+  {
+    const int size = end - begin;
+    int index = begin;
+    if(size >= 2*PacketSize)
+    {
+      // two independent accumulators to hide the latency of the compensation
+      const int blockEnd = begin + (size/(2*PacketSize))*(2*PacketSize);
+      PacketScalar sum0 = ei_pset1(Scalar(0)), compensation0 = sum0, sum1 = sum0, compensation1 = sum0;
+      for(; index < blockEnd; index += 2*PacketSize)
+      {
+        add(sum0, compensation0, access.packet(index));
+        add(sum1, compensation1, access.packet(index + PacketSize));
+      }
+      flush(acc, sum0, compensation0);
+      flush(acc, sum1, compensation1);
+    }
+    for(; index < end; ++index)
+      acc.add(access.coeff(index));
+  }
+};
+
+template<typename Derived>
+struct ei_redux_kahan
+{
+  typedef typename Derived::Scalar Scalar;
+
+  struct Visitor
+  {
+    template<typename Access> void operator()(const Access& access, int begin, int end)
+    { ei_redux_kahan_range<Derived>::run(access, m_acc, begin, end); }
+    ei_kahan_sum<Scalar> m_acc;
+  };
+
+  static ei_kahan_sum<Scalar> run(const Derived& mat, int start, int end)
+  {
+    Visitor visitor;
+    ei_redux_visit_ranges<Derived>::run(mat, start, end, visitor);
+    return visitor.m_acc;
+  }
+
+  static Scalar run(const Derived& mat)
+  {
+    const int size = mat.size();
+    const int chunkSize = EIGEN_REDUX_CHUNK_SIZE;
+    if(size <= chunkSize)
+      return run(mat, 0, size).value();
+
+    const int chunkCount = (size + chunkSize - 1) / chunkSize;
+    ei_kahan_sum<Scalar>* partials = ei_aligned_stack_new(ei_kahan_sum<Scalar>, chunkCount);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(static) if(ei_redux_in_parallel(chunkCount))
+#endif
+    for(int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+      const int start = chunk * chunkSize;
+      partials[chunk] = run(mat, start, start + std::min(chunkSize, size - start));
+    }
+    ei_kahan_sum<Scalar> acc;
+    for(int chunk = 0; chunk < chunkCount; ++chunk)
+      acc.add(partials[chunk]);
+    ei_aligned_stack_delete(ei_kahan_sum<Scalar>, partials, chunkCount);
+    return acc.value();
+  }
+};
+
 
 /** \returns the result of a full redux operation on the whole matrix or vector using \a func
   *
@@ -312,6 +663,29 @@ DenseBase<Derived>::redux(const Func& func) const
             ::run(derived(), func);
 }
 
+/** \returns the result of a full redux operation on the whole matrix or vector using \a func,
+  * in an order which does not depend on the alignment of the data nor on the number of threads.
+  *
+  * The coefficients are taken in storage order and split into chunks of EIGEN_REDUX_CHUNK_SIZE
+  * coefficients. Each chunk is reduced by recursive halving, and the results of the chunks are
+  * combined the same way. For a given expression type and size, the result is thus reproducible
+  * bit for bit, and for sums the rounding error grows only logarithmically with the size.
+  * The coefficients of expressions without linear access, such as blocks, are reduced inner vector
+  * by inner vector, so that a block may not round like a plain matrix holding the same coefficients.
+  * When OpenMP is enabled, the chunks are reduced in parallel.
+  *
+  * \sa redux(const BinaryOp&) const, sum(Pairwise_t) const
+  */
+template<typename Derived>
+template<typename Func>
+inline typename ei_result_of<Func(typename ei_traits<Derived>::Scalar)>::type
+DenseBase<Derived>::redux(const Func& func, Pairwise_t) const
+{
+  typedef typename ei_cleantype<typename Derived::Nested>::type ThisNested;
+  ei_assert(this->rows()>0 && this->cols()>0 && "you are using an empty matrix");
+  return ei_redux_pairwise<Func, ThisNested>::run(derived(), func);
+}
+
 /** \returns the minimum of all coefficients of *this
   */
 template<typename Derived>
@@ -341,6 +715,42 @@ DenseBase<Derived>::sum() const
   return this->redux(Eigen::ei_scalar_sum_op<Scalar>());
 }
 
+/** \returns the sum of all coefficients of *this, computed by pairwise summation in an order
+  * which depends neither on the alignment of the data nor on the number of threads, see
+  * redux(const BinaryOp&, Pairwise_t) const.
+  *
+  * \sa redux(const BinaryOp&, Pairwise_t) const, sum(Kahan_t) const
+  */
+template<typename Derived>
+inline typename ei_traits<Derived>::Scalar
+DenseBase<Derived>::sum(Pairwise_t) const
+{
+  if(this->size() == 0)
+    return Scalar(0);
+  return this->redux(Eigen::ei_scalar_sum_op<Scalar>(), Pairwise);
+}
+
+/** \returns the sum of all coefficients of *this, computed with Kahan's compensated summation
+  * in an order which depends neither on the alignment of the data nor on the number of threads.
+  *
+  * This is more accurate than sum(Pairwise_t), at roughly twice the cost. Like sum(Pairwise_t),
+  * the result is reproducible bit for bit whatever the number of threads.
+  *
+  * \warning The compensation is optimized away by compilers allowed to reassociate floating
+  * point operations, e.g., with \c -ffast-math.
+  *
+  * \sa sum(Pairwise_t) const
+  */
+template<typename Derived>
+inline typename ei_traits<Derived>::Scalar
+DenseBase<Derived>::sum(Kahan_t) const
+{
+  if(this->size() == 0)
+    return Scalar(0);
+  typedef typename ei_cleantype<typename Derived::Nested>::type ThisNested;
+  return ei_redux_kahan<ThisNested>::run(derived());
+}
+
 /** \returns the mean of all coefficients of *this
 *
 * \sa trace(), prod(), sum()
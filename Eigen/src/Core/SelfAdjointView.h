@@ -130,6 +130,10 @@ template<typename MatrixType, unsigned int UpLo> class SelfAdjointView
       * a adjoint expression without any overhead. Only the meaningful triangular
       * part of the matrix is updated, the rest is left unchanged.
       *
+      * \a u and \a v can also be matrices with the same number of columns, in which case
+      * the rank 2k update is performed with the level 3 selfadjoint product kernel
+      * (this corresponds to the SYR2K Blas routine).
+      *
       * \sa rankUpdate(const MatrixBase<DerivedU>&, Scalar)
       */
     template<typename DerivedU, typename DerivedV>
@@ -63,6 +63,130 @@ struct ei_visitor_impl<Visitor, Derived, Dynamic>
   }
 };
 
+/** \internal
+  * \brief Visits the coefficients of \a Derived for a search visitor, such as ei_min_coeff_visitor.
+  *
+  * The coefficients are visited in storage order, by chunks of EIGEN_REDUX_CHUNK_SIZE coefficients which are
+  * searched in parallel when OpenMP is enabled. Within a chunk, the extremum of each block of BlockSize
+  * coefficients is computed with packets by Visitor::ReduxOp, and only the blocks improving on the current
+  * candidate, or holding a NaN, are visited again coefficient by coefficient to locate it.
+  */
+template<typename Visitor, typename Derived>
+struct ei_visitor_search
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename Visitor::ReduxOp ReduxOp;
+  enum {
+    Vectorize = int(ei_redux_traits<ReduxOp, Derived>::Traversal) != int(DefaultTraversal),
+    BlockSize = 32 * ei_packet_traits<Scalar>::size
+  };
+
+  // searches the ranges of coefficients, starting at the coefficient \a start in storage order
+  struct RangeVisitor
+  {
+    RangeVisitor(int start) : m_position(start), m_empty(true) {}
+
+    template<typename Access> void operator()(const Access& access, int begin, int end)
+    {
+      int index = begin;
+      if(m_empty)
+      {
+        m_res = access.coeff(index);
+        m_index = m_position;
+        m_empty = false;
+        ++index;
+      }
+      if(Vectorize)
+      {
+        for(; index + BlockSize <= end; index += BlockSize)
+          if(Visitor::improves(ei_redux_range<ReduxOp, Derived>::run(access, ReduxOp(), index, index + BlockSize), m_res)
+             || m_res != m_res || hasNaN(access, index, index + BlockSize))
+            scan(access, begin, index, index + BlockSize);
+      }
+      scan(access, begin, index, end);
+      m_position += end - begin;
+    }
+
+    template<typename Access> void scan(const Access& access, int begin, int from, int to)
+    {
+      for(int index = from; index < to; ++index)
+      {
+        const Scalar value = access.coeff(index);
+        // like the plain visitor, only a NaN first coefficient is kept as candidate, while a NaN
+        // at the start of any other chunk is replaced by the next coefficient
+        if(Visitor::improves(value, m_res) || (m_res != m_res && m_index != 0))
+        {
+          m_res = value;
+          m_index = m_position + index - begin;
+        }
+      }
+    }
+
+    // The packet min/max of a block holding a NaN may drop the other coefficients of its lane, and so
+    // miss the extremum, while a NaN always propagates through the sum.
+    template<typename Access> static bool hasNaN(const Access& access, int from, int to)
+    {
+      if(NumTraits<Scalar>::IsInteger)
+        return false;
+      const Scalar sum = ei_redux_range<ei_scalar_sum_op<Scalar>, Derived>::run(access, ei_scalar_sum_op<Scalar>(), from, to);
+      return sum != sum;
+    }
+
+    Scalar m_res;
+    int m_index;
+    int m_position;
+    bool m_empty;
+  };
+
+  static void run(const Derived& mat, Visitor& visitor)
+  {
+    const int size = mat.size();
+    ei_assert(size>0 && "you are using an empty matrix");
+    const int chunkSize = EIGEN_REDUX_CHUNK_SIZE;
+    const int chunkCount = (size + chunkSize - 1) / chunkSize;
+    Scalar res;
+    int index;
+    if(chunkCount <= 1)
+    {
+      RangeVisitor search(0);
+      ei_redux_visit_ranges<Derived>::run(mat, 0, size, search);
+      res = search.m_res;
+      index = search.m_index;
+    }
+    else
+    {
+      Scalar* values = ei_aligned_stack_new(Scalar, chunkCount);
+      int* indices = ei_aligned_stack_new(int, chunkCount);
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp parallel for schedule(static) if(ei_redux_in_parallel(chunkCount))
+#endif
+      for(int chunk = 0; chunk < chunkCount; ++chunk)
+      {
+        const int start = chunk * chunkSize;
+        RangeVisitor search(start);
+        ei_redux_visit_ranges<Derived>::run(mat, start, start + std::min(chunkSize, size - start), search);
+        values[chunk] = search.m_res;
+        indices[chunk] = search.m_index;
+      }
+      // the chunks are merged in order, so that the first of several equal candidates is kept
+      res = values[0];
+      index = indices[0];
+      for(int chunk = 1; chunk < chunkCount; ++chunk)
+        if(Visitor::improves(values[chunk], res))
+        {
+          res = values[chunk];
+          index = indices[chunk];
+        }
+      ei_aligned_stack_delete(Scalar, values, chunkCount);
+      ei_aligned_stack_delete(int, indices, chunkCount);
+    }
+
+    const int innerSize = mat.innerSize();
+    visitor.res = res;
+    visitor.row = Derived::IsRowMajor ? index / innerSize : index % innerSize;
+    visitor.col = Derived::IsRowMajor ? index % innerSize : index / innerSize;
+  }
+};
 
 /** Applies the visitor \a visitor to the whole coefficients of the matrix or vector.
   *
@@ -79,18 +203,29 @@ struct ei_visitor_impl<Visitor, Derived, Dynamic>
   * \note compared to one or two \em for \em loops, visitors offer automatic
   * unrolling for small fixed size matrix.
   *
+  * \note The search visitors used by minCoeff(int*,int*) and maxCoeff(int*,int*) are not called for each
+  * coefficient of large expressions: the coefficients are filtered by blocks using packets, and searched
+  * in parallel when OpenMP is enabled.
+  *
   * \sa minCoeff(int*,int*), maxCoeff(int*,int*), DenseBase::redux()
   */
 template<typename Derived>
 template<typename Visitor>
 void DenseBase<Derived>::visit(Visitor& visitor) const
 {
-  const bool unroll = SizeAtCompileTime * CoeffReadCost
-                    + (SizeAtCompileTime-1) * ei_functor_traits<Visitor>::Cost
-                    <= EIGEN_UNROLLING_LIMIT;
-  return ei_visitor_impl<Visitor, Derived,
-      unroll ? int(SizeAtCompileTime) : Dynamic
-    >::run(derived(), visitor);
+  enum {
+    Unroll = SizeAtCompileTime != Dynamic
+          && SizeAtCompileTime * CoeffReadCost + (SizeAtCompileTime-1) * ei_functor_traits<Visitor>::Cost
+             <= EIGEN_UNROLLING_LIMIT,
+    // searching in storage order only gives the same coordinates when it matches the column by column order
+    Search = ei_functor_traits<Visitor>::PacketAccess && !Unroll && (IsVectorAtCompileTime || !IsRowMajor)
+  };
+  typedef typename ei_cleantype<typename Derived::Nested>::type ThisNested;
+  typedef typename ei_meta_if<Search,
+                              ei_visitor_search<Visitor, ThisNested>,
+                              ei_visitor_impl<Visitor, Derived, Unroll ? int(SizeAtCompileTime) : Dynamic>
+                             >::ret Impl;
+  return Impl::run(derived(), visitor);
 }
 
 /** \internal
@@ -117,9 +252,12 @@ struct ei_coeff_visitor
 template <typename Scalar>
 struct ei_min_coeff_visitor : ei_coeff_visitor<Scalar>
 {
+  typedef ei_scalar_min_op<Scalar> ReduxOp;
+  static inline bool improves(const Scalar& value, const Scalar& res) { return value < res; }
+
   void operator() (const Scalar& value, int i, int j)
   {
-    if(value < this->res)
+    if(improves(value, this->res))
     {
       this->res = value;
       this->row = i;
@@ -131,7 +269,8 @@ struct ei_min_coeff_visitor : ei_coeff_visitor<Scalar>
 template<typename Scalar>
 struct ei_functor_traits<ei_min_coeff_visitor<Scalar> > {
   enum {
-    Cost = NumTraits<Scalar>::AddCost
+    Cost = NumTraits<Scalar>::AddCost,
+    PacketAccess = true
   };
 };
 
@@ -143,9 +282,12 @@ struct ei_functor_traits<ei_min_coeff_visitor<Scalar> > {
 template <typename Scalar>
 struct ei_max_coeff_visitor : ei_coeff_visitor<Scalar>
 {
+  typedef ei_scalar_max_op<Scalar> ReduxOp;
+  static inline bool improves(const Scalar& value, const Scalar& res) { return value > res; }
+
   void operator() (const Scalar& value, int i, int j)
   {
-    if(value > this->res)
+    if(improves(value, this->res))
     {
       this->res = value;
       this->row = i;
@@ -157,7 +299,8 @@ struct ei_max_coeff_visitor : ei_coeff_visitor<Scalar>
 template<typename Scalar>
 struct ei_functor_traits<ei_max_coeff_visitor<Scalar> > {
   enum {
-    Cost = NumTraits<Scalar>::AddCost
+    Cost = NumTraits<Scalar>::AddCost,
+    PacketAccess = true
   };
 };
 
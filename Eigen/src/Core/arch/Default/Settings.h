@@ -62,6 +62,60 @@
 #define EIGEN_TUNE_TRIANGULAR_PANEL_WIDTH 8
 #endif
 
+/** Defines the size below which the divide-and-conquer tridiagonal eigen solver
+  * stops splitting and falls back to implicit QR iterations. The default is 32.
+  */
+#ifndef EIGEN_TUNE_TRIDIAGONAL_DC_THRESHOLD
+#define EIGEN_TUNE_TRIDIAGONAL_DC_THRESHOLD 32
+#endif
+
+/** Defines the size below which the divide-and-conquer bidiagonal SVD of BDCSVD
+  * stops splitting and falls back to JacobiSVD. The default is 16, and it must be at least 3.
+  */
+#ifndef EIGEN_TUNE_BIDIAGONAL_DC_THRESHOLD
+#define EIGEN_TUNE_BIDIAGONAL_DC_THRESHOLD 16
+#endif
+
+/** Defines the number of columns of the panels factorized at once by HouseholderQR.
+  * Matrices having less than twice as many columns and rows are factorized without blocking.
+  * The default is 48.
+  */
+#ifndef EIGEN_TUNE_QR_BLOCK_SIZE
+#define EIGEN_TUNE_QR_BLOCK_SIZE 48
+#endif
+
+/** Defines the number of columns of the panels reduced at once by Tridiagonalization.
+  * The trailing 4*EIGEN_TUNE_TRIDIAGONALIZATION_BLOCK_SIZE columns, where the panel updates do not pay off,
+  * are reduced without blocking. The default is 32, as the block size returned by LAPACK's ILAENV for xSYTRD.
+  */
+#ifndef EIGEN_TUNE_TRIDIAGONALIZATION_BLOCK_SIZE
+#define EIGEN_TUNE_TRIDIAGONALIZATION_BLOCK_SIZE 32
+#endif
+
+/** Defines the number of columns of the panels reduced at once by UpperBidiagonalization.
+  * The trailing 4*EIGEN_TUNE_BIDIAGONALIZATION_BLOCK_SIZE columns, where the panel updates do not pay off,
+  * are reduced without blocking. The default is 32, as the block size returned by LAPACK's ILAENV for xGEBRD.
+  */
+#ifndef EIGEN_TUNE_BIDIAGONALIZATION_BLOCK_SIZE
+#define EIGEN_TUNE_BIDIAGONALIZATION_BLOCK_SIZE 32
+#endif
+
+/** Defines the minimal amount of work, measured as the number of coefficients times the read cost
+  * of the assigned expression, above which a coefficient-wise assignment is split over several threads.
+  * This is only used when EIGEN_PARALLELIZE_ASSIGN is defined and OpenMP is enabled.
+  */
+#ifndef EIGEN_PARALLEL_ASSIGN_THRESHOLD
+#define EIGEN_PARALLEL_ASSIGN_THRESHOLD 262144
+#endif
+
+/** Defines the number of consecutive coefficients reduced together by the reproducible reductions,
+  * e.g., sum(Pairwise) or dot(other, Kahan). These chunks are reduced in parallel when OpenMP is enabled.
+  * The result of these reductions depends on this value, but not on the number of threads.
+  */
+#ifndef EIGEN_REDUX_CHUNK_SIZE
+#define EIGEN_REDUX_CHUNK_SIZE 16384
+#endif
+
 
 /** Defines the default number of registers available for that architecture.
   * Currently it must be 8 or 16. Other values will fail.
@@ -0,0 +1,61 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_HALF_SSE_H
+#define EIGEN_HALF_SSE_H
+
+template<> struct ei_pwiden_impl<float, half>
+{
+  static EIGEN_STRONG_INLINE Packet4f run(const half* from)
+  {
+#ifdef EIGEN_VECTORIZE_F16C
+    return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from)));
+#else
+    // zero extends the 4 halves to 32 bits
+    Packet4i h = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from)), _mm_setzero_si128());
+
+    // the exponent and the mantissa are shifted in place and rebiased by a multiplication,
+    // which also renormalizes the denormals
+    Packet4i exponentMantissa = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+    Packet4f res = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)),
+                              _mm_castsi128_ps(_mm_set1_epi32((254-15)<<23)));
+
+    // infinity and NaN keep the maximal exponent
+    Packet4i isInfNan = _mm_cmpgt_epi32(exponentMantissa, _mm_set1_epi32(0x7bff));
+    res = _mm_or_ps(res, _mm_and_ps(_mm_castsi128_ps(isInfNan), _mm_castsi128_ps(_mm_set1_epi32(255<<23))));
+
+    Packet4i sign = _mm_slli_epi32(_mm_xor_si128(h, exponentMantissa), 16);
+    return _mm_or_ps(res, _mm_castsi128_ps(sign));
+#endif
+  }
+};
+
+template<> struct ei_pwiden_impl<float, bfloat16>
+{
+  static EIGEN_STRONG_INLINE Packet4f run(const bfloat16* from)
+  {
+    // a bfloat16 is the upper half of a float
+    return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from))));
+  }
+};
+
+#endif // EIGEN_HALF_SSE_H
@@ -118,6 +118,10 @@ template<> EIGEN_STRONG_INLINE Packet4i ei_pnegate(const Packet4i& a)
   return ei_psub(_mm_setr_epi32(0,0,0,0), a);
 }
 
+template<> EIGEN_STRONG_INLINE Packet4f ei_pconj(const Packet4f& a) { return a; }
+template<> EIGEN_STRONG_INLINE Packet2d ei_pconj(const Packet2d& a) { return a; }
+template<> EIGEN_STRONG_INLINE Packet4i ei_pconj(const Packet4i& a) { return a; }
+
 template<> EIGEN_STRONG_INLINE Packet4f ei_pmul<Packet4f>(const Packet4f& a, const Packet4f& b) { return _mm_mul_ps(a,b); }
 template<> EIGEN_STRONG_INLINE Packet2d ei_pmul<Packet2d>(const Packet2d& a, const Packet2d& b) { return _mm_mul_pd(a,b); }
 template<> EIGEN_STRONG_INLINE Packet4i ei_pmul<Packet4i>(const Packet4i& a, const Packet4i& b)
@@ -261,6 +265,9 @@ template<> EIGEN_STRONG_INLINE Packet2d ei_preverse(const Packet2d& a)
 template<> EIGEN_STRONG_INLINE Packet4i ei_preverse(const Packet4i& a)
 { return _mm_shuffle_epi32(a,0x1B); }
 
+template<> EIGEN_STRONG_INLINE Packet4f ei_pcplxflip(const Packet4f& a)
+{ return _mm_shuffle_ps(a,a,0xB1); }
+
 
 template<> EIGEN_STRONG_INLINE Packet4f ei_pabs(const Packet4f& a)
 {
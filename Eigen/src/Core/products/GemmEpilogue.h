@@ -0,0 +1,239 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_GEMM_EPILOGUE_H
+#define EIGEN_GEMM_EPILOGUE_H
+
+template<typename Epilogue> struct ei_gemm_epilogue_panel;
+
+/** \internal
+  * Default epilogue of ei_gebp_kernel: the product \a acc of a block is added to the
+  * destination \a dst. An epilogue is passed to ei_general_matrix_matrix_product as is,
+  * and its panel() is passed to the kernel which calls packet() and coeff() with the
+  * coordinates of the block relative to the destination pointer it has been given.
+  */
+struct ei_gemm_no_epilogue
+{
+  EIGEN_STRONG_INLINE const ei_gemm_no_epilogue& block(int, int) const { return *this; }
+  EIGEN_STRONG_INLINE const ei_gemm_no_epilogue& transpose() const { return *this; }
+  EIGEN_STRONG_INLINE const ei_gemm_no_epilogue& panel(int, int, bool, bool) const { return *this; }
+
+  template<typename Packet>
+  EIGEN_STRONG_INLINE Packet packet(const Packet& acc, const Packet& dst, int, int) const { return ei_padd(dst, acc); }
+  template<typename Scalar>
+  EIGEN_STRONG_INLINE Scalar coeff(const Scalar& acc, const Scalar& dst, int, int) const { return dst + acc; }
+};
+
+/** \internal identity function, the default of GemmEpilogue */
+template<typename Scalar> struct ei_gemm_identity_op {
+  EIGEN_EMPTY_STRUCT_CTOR(ei_gemm_identity_op)
+  EIGEN_STRONG_INLINE const Scalar& operator() (const Scalar& a) const { return a; }
+  template<typename PacketScalar>
+  EIGEN_STRONG_INLINE const PacketScalar& packetOp(const PacketScalar& a) const { return a; }
+};
+template<typename Scalar>
+struct ei_functor_traits<ei_gemm_identity_op<Scalar> >
+{ enum { Cost = 0, PacketAccess = true }; };
+
+/** \internal applies \a func to a packet, one coefficient at a time if \a func cannot be vectorized */
+template<typename Scalar, typename UnaryOp, bool PacketAccess = ei_functor_traits<UnaryOp>::PacketAccess>
+struct ei_gemm_epilogue_packet_op
+{
+  template<typename Packet>
+  static EIGEN_STRONG_INLINE Packet run(const UnaryOp& func, const Packet& x) { return func.packetOp(x); }
+};
+
+template<typename Scalar, typename UnaryOp>
+struct ei_gemm_epilogue_packet_op<Scalar, UnaryOp, false>
+{
+  template<typename Packet>
+  static EIGEN_STRONG_INLINE Packet run(const UnaryOp& func, const Packet& x)
+  {
+    enum { PacketSize = ei_packet_traits<Scalar>::size };
+    EIGEN_ALIGN16 Scalar values[PacketSize];
+    ei_pstore(values, x);
+    for(int k=0; k<PacketSize; ++k)
+      values[k] = func(values[k]);
+    return ei_pload(values);
+  }
+};
+
+/** \class GemmEpilogue
+  *
+  * \brief Operations fused with the evaluation of a matrix-matrix product
+  *
+  * \param _Scalar the scalar type of the product
+  * \param UnaryOp the type of the coefficient-wise function applied last, the identity by default
+  *
+  * This class is passed to GeneralProduct::evalTo(Dest&, const Epilogue&) to evaluate
+  * \code dst = f(lhs * rhs + beta * dst + bias) \endcode
+  * in a single pass over \c dst, where the bias is a vector broadcast along the rows and/or
+  * the columns of the product. The product kernel applies these operations to each block
+  * of the result while it is still held in registers, instead of evaluating the product
+  * in a temporary and running one or more coefficient-wise passes over it. A scalar factor
+  * \c alpha of the product is handled as usual, e.g., by writing <tt>(alpha * lhs) * rhs</tt>.
+  *
+  * Example:
+  * \code
+  * GemmEpilogue<float, MyRelu> epilogue;
+  * epilogue.setRowBias(bias);
+  * (weights * input).evalTo(output, epilogue);
+  * \endcode
+  *
+  * The function \a UnaryOp is vectorized if ei_functor_traits<UnaryOp>::PacketAccess is true,
+  * in which case it must have a packetOp() method, as the functors of CwiseUnaryOp.
+  * The bias vectors are referenced, and not copied, by the epilogue.
+  */
+template<typename _Scalar, typename UnaryOp = ei_gemm_identity_op<_Scalar> >
+class GemmEpilogue
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef typename ei_packet_traits<Scalar>::type Packet;
+
+    GemmEpilogue(const UnaryOp& func = UnaryOp())
+      : m_func(func), m_beta(0), m_rowBias(0), m_colBias(0)
+    {}
+
+    /** Sets the factor of the previous value of the destination which is added to the product.
+      * The default is 0, in which case the destination is not read. */
+    GemmEpilogue& setBeta(const Scalar& beta) { m_beta = beta; return *this; }
+
+    /** Adds \a bias(i) to each coefficient of the row \a i of the product.
+      * \a bias must be a vector with contiguous storage, e.g., a VectorXf, and must remain
+      * alive until the product is evaluated. */
+    template<typename Derived>
+    GemmEpilogue& setRowBias(const MatrixBase<Derived>& bias)
+    {
+      m_rowBias = biasData(bias);
+      return *this;
+    }
+
+    /** Adds \a bias(j) to each coefficient of the column \a j of the product.
+      * \sa setRowBias() */
+    template<typename Derived>
+    GemmEpilogue& setColBias(const MatrixBase<Derived>& bias)
+    {
+      m_colBias = biasData(bias);
+      return *this;
+    }
+
+    const Scalar& beta() const { return m_beta; }
+    const Scalar* rowBias() const { return m_rowBias; }
+    const Scalar* colBias() const { return m_colBias; }
+    const UnaryOp& functor() const { return m_func; }
+
+    /** \internal \returns the epilogue of the block of the product starting at (\a row, \a col) */
+    GemmEpilogue block(int row, int col) const
+    {
+      GemmEpilogue res(*this);
+      if(m_rowBias) res.m_rowBias += row;
+      if(m_colBias) res.m_colBias += col;
+      return res;
+    }
+
+    /** \internal \returns the epilogue of the transposed product */
+    GemmEpilogue transpose() const
+    {
+      GemmEpilogue res(*this);
+      std::swap(res.m_rowBias, res.m_colBias);
+      return res;
+    }
+
+    /** \internal \returns the epilogue applied by the kernel on a panel of the depth of the product */
+    ei_gemm_epilogue_panel<GemmEpilogue> panel(int row, int col, bool first, bool last) const
+    {
+      return ei_gemm_epilogue_panel<GemmEpilogue>(block(row,col), first, last);
+    }
+
+    /** \internal adds the biases to the coefficients (\a row, \a col) to (\a row+PacketSize-1, \a col) and applies the function */
+    EIGEN_STRONG_INLINE Packet packetOp(Packet x, int row, int col) const
+    {
+      if(m_rowBias) x = ei_padd(x, ei_ploadu(m_rowBias+row));
+      if(m_colBias) x = ei_padd(x, ei_pset1(m_colBias[col]));
+      return ei_gemm_epilogue_packet_op<Scalar,UnaryOp>::run(m_func, x);
+    }
+
+    /** \internal adds the biases to the coefficient (\a row, \a col) and applies the function */
+    EIGEN_STRONG_INLINE Scalar coeffOp(Scalar x, int row, int col) const
+    {
+      if(m_rowBias) x += m_rowBias[row];
+      if(m_colBias) x += m_colBias[col];
+      return m_func(x);
+    }
+
+  protected:
+    template<typename Derived>
+    static const Scalar* biasData(const MatrixBase<Derived>& bias)
+    {
+      EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+      EIGEN_STATIC_ASSERT((int(ei_traits<Derived>::Flags)&DirectAccessBit)!=0,
+                          THIS_METHOD_IS_ONLY_FOR_EXPRESSIONS_WITH_DIRECT_MEMORY_ACCESS_SUCH_AS_MAP_OR_PLAIN_MATRICES)
+      EIGEN_STATIC_ASSERT(bool(ei_is_same_type<typename Derived::Scalar, Scalar>::ret),
+                          YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+      ei_assert(bias.innerStride()==1 && "the bias must be stored contiguously");
+      return bias.derived().data();
+    }
+
+    UnaryOp m_func;
+    Scalar m_beta;
+    const Scalar* m_rowBias;
+    const Scalar* m_colBias;
+};
+
+/** \internal
+  * Epilogue of ei_gebp_kernel for one panel of the depth of a product with a GemmEpilogue:
+  * the previous value of the destination is scaled by beta on the first panel,
+  * and the biases and the function are applied on the last one.
+  */
+template<typename Epilogue>
+struct ei_gemm_epilogue_panel
+{
+  typedef typename Epilogue::Scalar Scalar;
+  typedef typename Epilogue::Packet Packet;
+
+  ei_gemm_epilogue_panel(const Epilogue& epilogue, bool first, bool last)
+    : m_epilogue(epilogue), m_last(last),
+      m_dropDst(first && epilogue.beta()==Scalar(0)), m_scaleDst(first && epilogue.beta()!=Scalar(1)),
+      m_beta(epilogue.beta()), m_pbeta(ei_pset1(epilogue.beta()))
+  {}
+
+  EIGEN_STRONG_INLINE Packet packet(const Packet& acc, const Packet& dst, int row, int col) const
+  {
+    Packet x = m_dropDst ? acc : ei_padd(m_scaleDst ? ei_pmul(m_pbeta, dst) : dst, acc);
+    return m_last ? m_epilogue.packetOp(x, row, col) : x;
+  }
+
+  EIGEN_STRONG_INLINE Scalar coeff(const Scalar& acc, const Scalar& dst, int row, int col) const
+  {
+    Scalar x = m_dropDst ? acc : (m_scaleDst ? m_beta * dst : dst) + acc;
+    return m_last ? m_epilogue.coeffOp(x, row, col) : x;
+  }
+
+  protected:
+    const Epilogue m_epilogue;
+    const bool m_last, m_dropDst, m_scaleDst;
+    const Scalar m_beta;
+    const Packet m_pbeta;
+};
+
+#endif // EIGEN_GEMM_EPILOGUE_H
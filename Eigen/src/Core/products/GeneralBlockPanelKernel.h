@@ -38,8 +38,16 @@
 template<typename Scalar, int mr, int nr, typename Conj>
 struct ei_gebp_kernel
 {
-  void operator()(Scalar* res, int resStride, const Scalar* blockA, const Scalar* blockB, int rows, int depth, int cols,
+  EIGEN_STRONG_INLINE void operator()(Scalar* res, int resStride, const Scalar* blockA, const Scalar* blockB, int rows, int depth, int cols,
                   int strideA=-1, int strideB=-1, int offsetA=0, int offsetB=0, Scalar* unpackedB = 0)
+  {
+    run(ei_gemm_no_epilogue(), res, resStride, blockA, blockB, rows, depth, cols, strideA, strideB, offsetA, offsetB, unpackedB);
+  }
+
+  // same as operator(), but each block of res is written as epilogue.packet(product, res, i, j), see ei_gemm_no_epilogue
+  template<typename Epilogue>
+  void run(const Epilogue& epilogue, Scalar* res, int resStride, const Scalar* blockA, const Scalar* blockB, int rows, int depth, int cols,
+           int strideA=-1, int strideB=-1, int offsetA=0, int offsetB=0, Scalar* unpackedB = 0)
   {
     typedef typename ei_packet_traits<Scalar>::type PacketType;
     enum { PacketSize = ei_packet_traits<Scalar>::size };
@@ -308,14 +316,14 @@ struct ei_gebp_kernel
         if(nr==4) R6 = ei_ploadu(r2 + PacketSize);
         if(nr==4) R7 = ei_ploadu(r3 + PacketSize);
 
-                  C0 = ei_padd(R0, C0);
-                  C1 = ei_padd(R1, C1);
-        if(nr==4) C2 = ei_padd(R2, C2);
-        if(nr==4) C3 = ei_padd(R3, C3);
-                  C4 = ei_padd(R4, C4);
-                  C5 = ei_padd(R5, C5);
-        if(nr==4) C6 = ei_padd(R6, C6);
-        if(nr==4) C7 = ei_padd(R7, C7);
+                  C0 = epilogue.packet(C0, R0, i, j2+0);
+                  C1 = epilogue.packet(C1, R1, i, j2+1);
+        if(nr==4) C2 = epilogue.packet(C2, R2, i, j2+2);
+        if(nr==4) C3 = epilogue.packet(C3, R3, i, j2+3);
+                  C4 = epilogue.packet(C4, R4, i+PacketSize, j2+0);
+                  C5 = epilogue.packet(C5, R5, i+PacketSize, j2+1);
+        if(nr==4) C6 = epilogue.packet(C6, R6, i+PacketSize, j2+2);
+        if(nr==4) C7 = epilogue.packet(C7, R7, i+PacketSize, j2+3);
 
                   ei_pstoreu(r0, C0);
                   ei_pstoreu(r1, C1);
@@ -334,10 +342,10 @@ struct ei_gebp_kernel
 
         // gets res block as register
         PacketType C0, C1, C2, C3;
-                  C0 = ei_ploadu(&res[(j2+0)*resStride + i]);
-                  C1 = ei_ploadu(&res[(j2+1)*resStride + i]);
-        if(nr==4) C2 = ei_ploadu(&res[(j2+2)*resStride + i]);
-        if(nr==4) C3 = ei_ploadu(&res[(j2+3)*resStride + i]);
+                  C0 = ei_pset1(Scalar(0));
+                  C1 = ei_pset1(Scalar(0));
+        if(nr==4) C2 = ei_pset1(Scalar(0));
+        if(nr==4) C3 = ei_pset1(Scalar(0));
 
         // performs "inner" product
         const Scalar* blB = unpackedB;
@@ -450,10 +458,10 @@ struct ei_gebp_kernel
           blA += PacketSize;
         }
 
-                  ei_pstoreu(&res[(j2+0)*resStride + i], C0);
-                  ei_pstoreu(&res[(j2+1)*resStride + i], C1);
-        if(nr==4) ei_pstoreu(&res[(j2+2)*resStride + i], C2);
-        if(nr==4) ei_pstoreu(&res[(j2+3)*resStride + i], C3);
+                  ei_pstoreu(&res[(j2+0)*resStride + i], epilogue.packet(C0, ei_ploadu(&res[(j2+0)*resStride + i]), i, j2+0));
+                  ei_pstoreu(&res[(j2+1)*resStride + i], epilogue.packet(C1, ei_ploadu(&res[(j2+1)*resStride + i]), i, j2+1));
+        if(nr==4) ei_pstoreu(&res[(j2+2)*resStride + i], epilogue.packet(C2, ei_ploadu(&res[(j2+2)*resStride + i]), i, j2+2));
+        if(nr==4) ei_pstoreu(&res[(j2+3)*resStride + i], epilogue.packet(C3, ei_ploadu(&res[(j2+3)*resStride + i]), i, j2+3));
       }
       for(int i=peeled_mc2; i<rows; i++)
       {
@@ -495,10 +503,10 @@ struct ei_gebp_kernel
 
           blB += nr*PacketSize;
         }
-        res[(j2+0)*resStride + i] += C0;
-        res[(j2+1)*resStride + i] += C1;
-        if(nr==4) res[(j2+2)*resStride + i] += C2;
-        if(nr==4) res[(j2+3)*resStride + i] += C3;
+                  res[(j2+0)*resStride + i] = epilogue.coeff(C0, res[(j2+0)*resStride + i], i, j2+0);
+                  res[(j2+1)*resStride + i] = epilogue.coeff(C1, res[(j2+1)*resStride + i], i, j2+1);
+        if(nr==4) res[(j2+2)*resStride + i] = epilogue.coeff(C2, res[(j2+2)*resStride + i], i, j2+2);
+        if(nr==4) res[(j2+3)*resStride + i] = epilogue.coeff(C3, res[(j2+3)*resStride + i], i, j2+3);
       }
     }
 
@@ -522,8 +530,8 @@ struct ei_gebp_kernel
 
         // get res block as registers
         PacketType C0, C4;
-        C0 = ei_ploadu(&res[(j2+0)*resStride + i]);
-        C4 = ei_ploadu(&res[(j2+0)*resStride + i + PacketSize]);
+        C0 = ei_pset1(Scalar(0));
+        C4 = ei_pset1(Scalar(0));
 
         const Scalar* blB = unpackedB;
         for(int k=0; k<depth; k++)
@@ -540,8 +548,8 @@ struct ei_gebp_kernel
           blA += mr;
         }
 
-        ei_pstoreu(&res[(j2+0)*resStride + i], C0);
-        ei_pstoreu(&res[(j2+0)*resStride + i + PacketSize], C4);
+        ei_pstoreu(&res[(j2+0)*resStride + i], epilogue.packet(C0, ei_ploadu(&res[(j2+0)*resStride + i]), i, j2));
+        ei_pstoreu(&res[(j2+0)*resStride + i + PacketSize], epilogue.packet(C4, ei_ploadu(&res[(j2+0)*resStride + i + PacketSize]), i+PacketSize, j2));
       }
       if(rows-peeled_mc>=PacketSize)
       {
@@ -549,7 +557,7 @@ struct ei_gebp_kernel
         const Scalar* blA = &blockA[i*strideA+offsetA*PacketSize];
         ei_prefetch(&blA[0]);
 
-        PacketType C0 = ei_ploadu(&res[(j2+0)*resStride + i]);
+        PacketType C0 = ei_pset1(Scalar(0));
 
         const Scalar* blB = unpackedB;
         for(int k=0; k<depth; k++)
@@ -559,7 +567,7 @@ struct ei_gebp_kernel
           blA += PacketSize;
         }
 
-        ei_pstoreu(&res[(j2+0)*resStride + i], C0);
+        ei_pstoreu(&res[(j2+0)*resStride + i], epilogue.packet(C0, ei_ploadu(&res[(j2+0)*resStride + i]), i, j2));
       }
       for(int i=peeled_mc2; i<rows; i++)
       {
@@ -572,7 +580,7 @@ struct ei_gebp_kernel
         const Scalar* blB = unpackedB;
         for(int k=0; k<depth; k++)
           C0 = cj.pmadd(blA[k], blB[k*PacketSize], C0);
-        res[(j2+0)*resStride + i] += C0;
+        res[(j2+0)*resStride + i] = epilogue.coeff(C0, res[(j2+0)*resStride + i], i, j2);
       }
     }
   }
@@ -597,13 +605,15 @@ struct ei_gebp_kernel
 template<typename Scalar, int mr, int StorageOrder, bool Conjugate, bool PanelMode>
 struct ei_gemm_pack_lhs
 {
-  void operator()(Scalar* blockA, const Scalar* EIGEN_RESTRICT _lhs, int lhsStride, int depth, int rows,
+  // the coefficients of the lhs are converted to Scalar if they have a reduced precision type, see ei_product_accumulator
+  template<typename LhsScalar>
+  void operator()(Scalar* blockA, const LhsScalar* EIGEN_RESTRICT _lhs, int lhsStride, int depth, int rows,
                   int stride=0, int offset=0)
   {
     enum { PacketSize = ei_packet_traits<Scalar>::size };
     ei_assert(((!PanelMode) && stride==0 && offset==0) || (PanelMode && stride>=depth && offset<=stride));
     ei_conj_if<NumTraits<Scalar>::IsComplex && Conjugate> cj;
-    ei_const_blas_data_mapper<Scalar, StorageOrder> lhs(_lhs,lhsStride);
+    ei_const_blas_data_mapper<LhsScalar, StorageOrder> lhs(_lhs,lhsStride);
     int count = 0;
     int peeled_mc = (rows/mr)*mr;
     for(int i=0; i<peeled_mc; i+=mr)
@@ -645,7 +655,8 @@ struct ei_gemm_pack_rhs<Scalar, nr, ColMajor, PanelMode>
 {
   typedef typename ei_packet_traits<Scalar>::type Packet;
   enum { PacketSize = ei_packet_traits<Scalar>::size };
-  void operator()(Scalar* blockB, const Scalar* rhs, int rhsStride, Scalar alpha, int depth, int cols,
+  template<typename RhsScalar>
+  void operator()(Scalar* blockB, const RhsScalar* rhs, int rhsStride, Scalar alpha, int depth, int cols,
                   int stride=0, int offset=0)
   {
     ei_assert(((!PanelMode) && stride==0 && offset==0) || (PanelMode && stride>=depth && offset<=stride));
@@ -656,10 +667,10 @@ struct ei_gemm_pack_rhs<Scalar, nr, ColMajor, PanelMode>
     {
       // skip what we have before
       if(PanelMode) count += nr * offset;
-      const Scalar* b0 = &rhs[(j2+0)*rhsStride];
-      const Scalar* b1 = &rhs[(j2+1)*rhsStride];
-      const Scalar* b2 = &rhs[(j2+2)*rhsStride];
-      const Scalar* b3 = &rhs[(j2+3)*rhsStride];
+      const RhsScalar* b0 = &rhs[(j2+0)*rhsStride];
+      const RhsScalar* b1 = &rhs[(j2+1)*rhsStride];
+      const RhsScalar* b2 = &rhs[(j2+2)*rhsStride];
+      const RhsScalar* b3 = &rhs[(j2+3)*rhsStride];
       if (hasAlpha)
         for(int k=0; k<depth; k++)
         {
@@ -686,7 +697,7 @@ struct ei_gemm_pack_rhs<Scalar, nr, ColMajor, PanelMode>
     for(int j2=packet_cols; j2<cols; ++j2)
     {
       if(PanelMode) count += offset;
-      const Scalar* b0 = &rhs[(j2+0)*rhsStride];
+      const RhsScalar* b0 = &rhs[(j2+0)*rhsStride];
       if (hasAlpha)
         for(int k=0; k<depth; k++)
         {
@@ -709,7 +720,8 @@ template<typename Scalar, int nr, bool PanelMode>
 struct ei_gemm_pack_rhs<Scalar, nr, RowMajor, PanelMode>
 {
   enum { PacketSize = ei_packet_traits<Scalar>::size };
-  void operator()(Scalar* blockB, const Scalar* rhs, int rhsStride, Scalar alpha, int depth, int cols,
+  template<typename RhsScalar>
+  void operator()(Scalar* blockB, const RhsScalar* rhs, int rhsStride, Scalar alpha, int depth, int cols,
                   int stride=0, int offset=0)
   {
     ei_assert(((!PanelMode) && stride==0 && offset==0) || (PanelMode && stride>=depth && offset<=stride));
@@ -724,7 +736,7 @@ struct ei_gemm_pack_rhs<Scalar, nr, RowMajor, PanelMode>
       {
         for(int k=0; k<depth; k++)
         {
-          const Scalar* b0 = &rhs[k*rhsStride + j2];
+          const RhsScalar* b0 = &rhs[k*rhsStride + j2];
                     blockB[count+0] = alpha*b0[0];
                     blockB[count+1] = alpha*b0[1];
           if(nr==4) blockB[count+2] = alpha*b0[2];
@@ -736,7 +748,7 @@ struct ei_gemm_pack_rhs<Scalar, nr, RowMajor, PanelMode>
       {
         for(int k=0; k<depth; k++)
         {
-          const Scalar* b0 = &rhs[k*rhsStride + j2];
+          const RhsScalar* b0 = &rhs[k*rhsStride + j2];
                     blockB[count+0] = b0[0];
                     blockB[count+1] = b0[1];
           if(nr==4) blockB[count+2] = b0[2];
@@ -751,7 +763,7 @@ struct ei_gemm_pack_rhs<Scalar, nr, RowMajor, PanelMode>
     for(int j2=packet_cols; j2<cols; ++j2)
     {
       if(PanelMode) count += offset;
-      const Scalar* b0 = &rhs[j2];
+      const RhsScalar* b0 = &rhs[j2];
       for(int k=0; k<depth; k++)
       {
         blockB[count] = alpha*b0[k*rhsStride];
@@ -27,6 +27,15 @@
 
 #ifndef EIGEN_EXTERN_INSTANTIATIONS
 
+// applies the epilogue of a product of depth 0 to the destination
+template<typename Scalar, typename Epilogue>
+void ei_gemm_apply_epilogue(const Epilogue& epilogue, Scalar* res, int resStride, int rows, int cols)
+{
+  for(int j=0; j<cols; ++j)
+    for(int i=0; i<rows; ++i)
+      res[j*resStride+i] = epilogue.coeff(Scalar(0), res[j*resStride+i], i, j);
+}
+
 /* Specialization for a row-major destination matrix => simple transposition of the product */
 template<
   typename Scalar,
@@ -41,6 +50,19 @@ struct ei_general_matrix_matrix_product<Scalar,LhsStorageOrder,ConjugateLhs,RhsS
     Scalar* res, int resStride,
     Scalar alpha,
     GemmParallelInfo<Scalar>* info = 0)
+  {
+    run(rows,cols,depth,lhs,lhsStride,rhs,rhsStride,res,resStride,alpha,info,ei_gemm_no_epilogue());
+  }
+
+  template<typename FactorScalar, typename Epilogue>
+  static EIGEN_STRONG_INLINE void run(
+    int rows, int cols, int depth,
+    const FactorScalar* lhs, int lhsStride,
+    const FactorScalar* rhs, int rhsStride,
+    Scalar* res, int resStride,
+    Scalar alpha,
+    GemmParallelInfo<Scalar>* info,
+    const Epilogue& epilogue)
   {
     // transpose the product such that the result is column major
     ei_general_matrix_matrix_product<Scalar,
@@ -49,7 +71,7 @@ struct ei_general_matrix_matrix_product<Scalar,LhsStorageOrder,ConjugateLhs,RhsS
       LhsStorageOrder==RowMajor ? ColMajor : RowMajor,
       ConjugateLhs,
       ColMajor>
-    ::run(cols,rows,depth,rhs,rhsStride,lhs,lhsStride,res,resStride,alpha,info);
+    ::run(cols,rows,depth,rhs,rhsStride,lhs,lhsStride,res,resStride,alpha,info,epilogue.transpose());
   }
 };
 
@@ -62,14 +84,28 @@ template<
 struct ei_general_matrix_matrix_product<Scalar,LhsStorageOrder,ConjugateLhs,RhsStorageOrder,ConjugateRhs,ColMajor>
 {
 static void run(int rows, int cols, int depth,
-  const Scalar* _lhs, int lhsStride,
-  const Scalar* _rhs, int rhsStride,
+  const Scalar* lhs, int lhsStride,
+  const Scalar* rhs, int rhsStride,
   Scalar* res, int resStride,
   Scalar alpha,
   GemmParallelInfo<Scalar>* info = 0)
 {
-  ei_const_blas_data_mapper<Scalar, LhsStorageOrder> lhs(_lhs,lhsStride);
-  ei_const_blas_data_mapper<Scalar, RhsStorageOrder> rhs(_rhs,rhsStride);
+  run(rows,cols,depth,lhs,lhsStride,rhs,rhsStride,res,resStride,alpha,info,ei_gemm_no_epilogue());
+}
+
+// same as above, but the result is written through \a epilogue, see ei_gemm_no_epilogue and GemmEpilogue.
+// The factors may also have a reduced precision type, e.g. half, which is widened to Scalar while packing them.
+template<typename FactorScalar, typename Epilogue>
+static void run(int rows, int cols, int depth,
+  const FactorScalar* _lhs, int lhsStride,
+  const FactorScalar* _rhs, int rhsStride,
+  Scalar* res, int resStride,
+  Scalar alpha,
+  GemmParallelInfo<Scalar>* info,
+  const Epilogue& epilogue)
+{
+  ei_const_blas_data_mapper<FactorScalar, LhsStorageOrder> lhs(_lhs,lhsStride);
+  ei_const_blas_data_mapper<FactorScalar, RhsStorageOrder> rhs(_rhs,rhsStride);
 
   if (ConjugateRhs)
     alpha = ei_conj(alpha);
@@ -84,6 +120,13 @@ static void run(int rows, int cols, int depth,
   ei_gemm_pack_lhs<Scalar, Blocking::mr, LhsStorageOrder> pack_lhs;
   ei_gebp_kernel<Scalar, Blocking::mr, Blocking::nr, ei_conj_helper<ConjugateLhs,ConjugateRhs> > gebp;
 
+  // an empty product still has to go through the epilogue
+  if(depth==0)
+  {
+    ei_gemm_apply_epilogue(epilogue.panel(0,0,true,true), res, resStride, rows, cols);
+    return;
+  }
+
 #ifdef EIGEN_HAS_OPENMP
   if(info)
   {
@@ -91,9 +134,10 @@ static void run(int rows, int cols, int depth,
     int tid = omp_get_thread_num();
     int threads = omp_get_num_threads();
 
-    Scalar* blockA = ei_aligned_stack_new(Scalar, kc*mc);
+    // the workspace of the thread is allocated by the calling thread, see ei_gemm_functor::threadWorkspaceSize()
     std::size_t sizeW = kc*Blocking::PacketSize*Blocking::nr*8;
-    Scalar* w = ei_aligned_stack_new(Scalar, sizeW);
+    Scalar* w = info[tid].workspace;
+    Scalar* blockA = w + sizeW;
     Scalar* blockB = (Scalar*)info[tid].blockB;
 
     // For each horizontal panel of the rhs, and corresponding panel of the lhs...
@@ -131,7 +175,8 @@ static void run(int rows, int cols, int depth,
         if(shift>0)
           while(info[j].sync!=k) {}
 
-        gebp(res+info[j].rhs_start*resStride, resStride, blockA, blockB+info[j].rhs_start*kc, mc, actual_kc, info[j].rhs_length, -1,-1,0,0, w);
+        gebp.run(epilogue.panel(0,info[j].rhs_start,k==0,k+actual_kc==depth),
+                 res+info[j].rhs_start*resStride, resStride, blockA, blockB+info[j].rhs_start*kc, mc, actual_kc, info[j].rhs_length, -1,-1,0,0, w);
       }
 
       // Then keep going as usual with the remaining A'
@@ -143,7 +188,8 @@ static void run(int rows, int cols, int depth,
         pack_lhs(blockA, &lhs(i,k), lhsStride, actual_kc, actual_mc);
 
         // C_i += A' * B'
-        gebp(res+i, resStride, blockA, blockB, actual_mc, actual_kc, cols, -1,-1,0,0, w);
+        gebp.run(epilogue.panel(i,0,k==0,k+actual_kc==depth),
+                 res+i, resStride, blockA, blockB, actual_mc, actual_kc, cols, -1,-1,0,0, w);
       }
 
       // Release all the sub blocks B'_j of B' for the current thread,
@@ -153,8 +199,6 @@ static void run(int rows, int cols, int depth,
         --(info[j].users);
     }
 
-    ei_aligned_stack_delete(Scalar, blockA, kc*mc);
-    ei_aligned_stack_delete(Scalar, w, sizeW);
   }
   else
 #endif // EIGEN_HAS_OPENMP
@@ -191,7 +235,7 @@ static void run(int rows, int cols, int depth,
         pack_lhs(blockA, &lhs(i2,k2), lhsStride, actual_kc, actual_mc);
 
         // Everything is packed, we can now call the block * panel kernel:
-        gebp(res+i2, resStride, blockA, blockB, actual_mc, actual_kc, cols);
+        gebp.run(epilogue.panel(i2,0,k2==0,k2+actual_kc==depth), res+i2, resStride, blockA, blockB, actual_mc, actual_kc, cols);
 
       }
     }
@@ -215,13 +259,13 @@ struct ei_traits<GeneralProduct<Lhs,Rhs,GemmProduct> >
  : ei_traits<ProductBase<GeneralProduct<Lhs,Rhs,GemmProduct>, Lhs, Rhs> >
 {};
 
-template<typename Scalar, typename Gemm, typename Lhs, typename Rhs, typename Dest>
+template<typename Scalar, typename Gemm, typename Lhs, typename Rhs, typename Dest, typename Epilogue = ei_gemm_no_epilogue>
 struct ei_gemm_functor
 {
-  typedef typename Rhs::Scalar BlockBScalar;
+  typedef Scalar BlockBScalar;
 
-  ei_gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, Scalar actualAlpha)
-    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha)
+  ei_gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, Scalar actualAlpha, const Epilogue& epilogue = Epilogue())
+    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_actualAlpha(actualAlpha), m_epilogue(epilogue)
   {}
 
   void operator() (int row, int rows, int col=0, int cols=-1, GemmParallelInfo<BlockBScalar>* info=0) const
@@ -229,24 +273,38 @@ struct ei_gemm_functor
     if(cols==-1)
       cols = m_rhs.cols();
     Gemm::run(rows, cols, m_lhs.cols(),
-              (const Scalar*)&(m_lhs.const_cast_derived().coeffRef(row,0)), m_lhs.outerStride(),
-              (const Scalar*)&(m_rhs.const_cast_derived().coeffRef(0,col)), m_rhs.outerStride(),
+              (const typename Lhs::Scalar*)&(m_lhs.const_cast_derived().coeffRef(row,0)), m_lhs.outerStride(),
+              (const typename Rhs::Scalar*)&(m_rhs.const_cast_derived().coeffRef(0,col)), m_rhs.outerStride(),
               (Scalar*)&(m_dest.coeffRef(row,col)), m_dest.outerStride(),
               m_actualAlpha,
-              info);
+              info,
+              m_epilogue.block(row,col));
   }
 
 
   int sharedBlockBSize() const
   {
-    return std::min<int>(ei_product_blocking_traits<Scalar>::Max_kc,m_rhs.rows()) * m_rhs.cols();
+    // the packed rhs of a product with a row-major destination is its transposed lhs
+    return std::min<int>(ei_product_blocking_traits<Scalar>::Max_kc,m_rhs.rows()) * std::max(m_lhs.rows(),m_rhs.cols());
+  }
+
+  // size of the packed block of the lhs and of the buffer of the kernel used by each thread
+  int threadWorkspaceSize() const
+  {
+    typedef ei_product_blocking_traits<Scalar> Blocking;
+    int kc = std::min<int>(Blocking::Max_kc,m_lhs.cols());
+    int mc = std::min<int>(Blocking::Max_mc,std::max(m_lhs.rows(),m_rhs.cols()));
+    int size = kc*Blocking::PacketSize*Blocking::nr*8 + kc*mc;
+    // round up such that the workspace of each thread is aligned
+    return ((size+Blocking::PacketSize-1)/Blocking::PacketSize)*Blocking::PacketSize;
   }
 
   protected:
     const Lhs& m_lhs;
     const Rhs& m_rhs;
-    mutable Dest& m_dest;
+    Dest& m_dest;
     Scalar m_actualAlpha;
+    Epilogue m_epilogue;
 };
 
 template<typename Lhs, typename Rhs>
@@ -256,16 +314,61 @@ class GeneralProduct<Lhs, Rhs, GemmProduct>
   public:
     EIGEN_PRODUCT_PUBLIC_INTERFACE(GeneralProduct)
 
+    enum { IsQuantized = bool(ei_is_quantized_product<typename Lhs::Scalar, typename Rhs::Scalar>::ret) };
+
     GeneralProduct(const Lhs& lhs, const Rhs& rhs) : Base(lhs,rhs)
     {
-      EIGEN_STATIC_ASSERT((ei_is_same_type<typename Lhs::Scalar, typename Rhs::Scalar>::ret),
+      EIGEN_STATIC_ASSERT((bool(ei_is_same_type<typename Lhs::Scalar, typename Rhs::Scalar>::ret) || bool(IsQuantized)),
         YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
     }
 
+    using Base::evalTo;
+
+    /** Evaluates the product into \a dst through \a epilogue, i.e.:
+      * \code dst = f(*this + beta * dst + bias) \endcode
+      * where \a epilogue is a GemmEpilogue holding the factor \c beta, the biases, and the function \c f.
+      * As with noalias(), \a dst must not alias the factors of the product.
+      * \sa class GemmEpilogue */
+    template<typename Dest, typename Epilogue> void evalTo(Dest& dst, const Epilogue& epilogue) const
+    {
+      scaleAndAddTo(dst, Scalar(1), epilogue);
+    }
+
+    /** Evaluates the quantized product into \a dst, subtracting the zero points \a zeroPoints from its factors.
+      * \sa class GemmZeroPoints */
+    template<typename Dest> void evalTo(Dest& dst, const GemmZeroPoints& zeroPoints) const
+    {
+      evalTo(dst, zeroPoints, GemmEpilogue<Scalar>());
+    }
+
+    /** Evaluates the quantized product into \a dst through \a epilogue, subtracting the zero points
+      * \a zeroPoints from its factors.
+      * \sa class GemmZeroPoints, class GemmEpilogue */
+    template<typename Dest, typename Epilogue> void evalTo(Dest& dst, const GemmZeroPoints& zeroPoints, const Epilogue& epilogue) const
+    {
+      EIGEN_STATIC_ASSERT(bool(IsQuantized),YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+      ei_assert(dst.rows()==m_lhs.rows() && dst.cols()==m_rhs.cols());
+      _scaleAndAddTo(dst, Scalar(1), epilogue, zeroPoints);
+    }
+
     template<typename Dest> void scaleAndAddTo(Dest& dst, Scalar alpha) const
+    {
+      scaleAndAddTo(dst, alpha, ei_gemm_no_epilogue());
+    }
+
+    template<typename Dest, typename Epilogue> void scaleAndAddTo(Dest& dst, Scalar alpha, const Epilogue& epilogue) const
     {
       ei_assert(dst.rows()==m_lhs.rows() && dst.cols()==m_rhs.cols());
+      _scaleAndAddTo(dst, alpha, epilogue,
+                     typename ei_meta_if<IsQuantized, GemmZeroPoints,
+                       typename ei_meta_if<ei_is_same_type<AccScalar,Scalar>::ret, ei_meta_true, ei_meta_false>::ret>::ret());
+    }
 
+  protected:
+    typedef typename ei_product_accumulator<Scalar>::type AccScalar;
+
+    template<typename Dest, typename Epilogue> void _scaleAndAddTo(Dest& dst, Scalar alpha, const Epilogue& epilogue, const ei_meta_true&) const
+    {
       const ActualLhsType lhs = LhsBlasTraits::extract(m_lhs);
       const ActualRhsType rhs = RhsBlasTraits::extract(m_rhs);
 
@@ -281,9 +384,76 @@ class GeneralProduct<Lhs, Rhs, GemmProduct>
           (Dest::Flags&RowMajorBit) ? RowMajor : ColMajor>,
         _ActualLhsType,
         _ActualRhsType,
-        Dest> GemmFunctor;
+        Dest,
+        Epilogue> GemmFunctor;
+
+      ei_parallelize_gemm<(Dest::MaxRowsAtCompileTime>32)>(GemmFunctor(lhs, rhs, dst, actualAlpha, epilogue), this->rows(), this->cols(), Dest::Flags&RowMajorBit);
+    }
 
-      ei_parallelize_gemm<(Dest::MaxRowsAtCompileTime>32)>(GemmFunctor(lhs, rhs, dst, actualAlpha), this->rows(), this->cols());
+    // Product of reduced precision scalars, e.g. half: the factors are widened to AccScalar while they are packed,
+    // the product is accumulated in a temporary of AccScalar, and each coefficient is rounded to Scalar once
+    // when it is combined with dst through the epilogue.
+    template<typename Dest, typename Epilogue> void _scaleAndAddTo(Dest& dst, Scalar alpha, const Epilogue& epilogue, const ei_meta_false&) const
+    {
+      enum { DestOrder = (Dest::Flags&RowMajorBit) ? RowMajor : ColMajor };
+      typedef Map<Matrix<AccScalar,Dynamic,Dynamic,DestOrder> > AccDest;
+
+      const ActualLhsType lhs = LhsBlasTraits::extract(m_lhs);
+      const ActualRhsType rhs = RhsBlasTraits::extract(m_rhs);
+
+      AccScalar actualAlpha = AccScalar(alpha * LhsBlasTraits::extractScalarFactor(m_lhs)
+                                              * RhsBlasTraits::extractScalarFactor(m_rhs));
+
+      const int size = dst.rows()*dst.cols();
+      AccScalar* accData = ei_aligned_stack_new(AccScalar, size);
+      AccDest acc(accData, dst.rows(), dst.cols());
+      acc.setZero();
+
+      typedef ei_gemm_functor<
+        AccScalar,
+        ei_general_matrix_matrix_product<
+          AccScalar,
+          (_ActualLhsType::Flags&RowMajorBit) ? RowMajor : ColMajor, false,
+          (_ActualRhsType::Flags&RowMajorBit) ? RowMajor : ColMajor, false,
+          DestOrder>,
+        _ActualLhsType,
+        _ActualRhsType,
+        AccDest> GemmFunctor;
+
+      ei_parallelize_gemm<(Dest::MaxRowsAtCompileTime>32)>(GemmFunctor(lhs, rhs, acc, actualAlpha), this->rows(), this->cols(), Dest::Flags&RowMajorBit);
+
+      roundTo(dst, acc, epilogue.panel(0,0,true,true));
+
+      ei_aligned_stack_delete(AccScalar, accData, size);
+    }
+
+    // Quantized product, e.g., of unsigned char and signed char matrices, see ei_quantized_matrix_matrix_product
+    template<typename Dest, typename Epilogue> void _scaleAndAddTo(Dest& dst, Scalar alpha, const Epilogue& epilogue, const GemmZeroPoints& zeroPoints) const
+    {
+      const ActualLhsType lhs = LhsBlasTraits::extract(m_lhs);
+      const ActualRhsType rhs = RhsBlasTraits::extract(m_rhs);
+
+      Scalar actualAlpha = alpha * LhsBlasTraits::extractScalarFactor(m_lhs)
+                                 * RhsBlasTraits::extractScalarFactor(m_rhs);
+
+      ei_quantized_matrix_matrix_product<
+        typename _ActualLhsType::Scalar, (_ActualLhsType::Flags&RowMajorBit) ? RowMajor : ColMajor,
+        typename _ActualRhsType::Scalar, (_ActualRhsType::Flags&RowMajorBit) ? RowMajor : ColMajor,
+        (Dest::Flags&RowMajorBit) ? RowMajor : ColMajor>
+      ::run(this->rows(), this->cols(), lhs.cols(),
+            &(lhs.const_cast_derived().coeffRef(0,0)), lhs.outerStride(),
+            &(rhs.const_cast_derived().coeffRef(0,0)), rhs.outerStride(),
+            &(dst.coeffRef(0,0)), dst.outerStride(),
+            actualAlpha, zeroPoints, epilogue);
+    }
+
+    template<typename Dest, typename AccDest, typename Panel>
+    static void roundTo(Dest& dst, const AccDest& acc, const Panel& panel)
+    {
+      const int rows = dst.rows(), cols = dst.cols();
+      for(int j=0; j<cols; ++j)
+        for(int i=0; i<rows; ++i)
+          dst.coeffRef(i,j) = panel.coeff(Scalar(acc.coeff(i,j)), dst.coeff(i,j), i, j);
     }
 };
 
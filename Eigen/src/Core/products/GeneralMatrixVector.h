@@ -57,7 +57,6 @@ void ei_cache_friendly_product_colmajor_times_vector(
   if(ConjugateRhs)
     alpha = ei_conj(alpha);
 
-  typedef typename NumTraits<Scalar>::Real RealScalar;
   typedef typename ei_packet_traits<Scalar>::type Packet;
   const int PacketSize = sizeof(Packet)/sizeof(Scalar);
 
@@ -84,7 +83,7 @@ void ei_cache_friendly_product_colmajor_times_vector(
   // find how many columns do we have to skip to be aligned with the result (if possible)
   int skipColumns = 0;
   // if the data cannot be aligned (TODO add some compile time tests when possible, e.g. for floats)
-  if( (size_t(lhs)%sizeof(RealScalar)) || (size_t(res)%sizeof(RealScalar)) )
+  if( (size_t(lhs)%sizeof(Scalar)) || (size_t(res)%sizeof(Scalar)) )
   {
     alignedSize = 0;
     alignedStart = 0;
@@ -268,7 +267,6 @@ static EIGEN_DONT_INLINE void ei_cache_friendly_product_rowmajor_times_vector(
 
   ei_conj_helper<ConjugateLhs,ConjugateRhs> cj;
 
-  typedef typename NumTraits<Scalar>::Real RealScalar;
   typedef typename ei_packet_traits<Scalar>::type Packet;
   const int PacketSize = sizeof(Packet)/sizeof(Scalar);
 
@@ -297,7 +295,7 @@ static EIGEN_DONT_INLINE void ei_cache_friendly_product_rowmajor_times_vector(
   // find how many rows do we have to skip to be aligned with rhs (if possible)
   int skipRows = 0;
   // if the data cannot be aligned (TODO add some compile time tests when possible, e.g. for floats)
-  if( (size_t(lhs)%sizeof(RealScalar)) || (size_t(rhs)%sizeof(RealScalar)) )
+  if( (size_t(lhs)%sizeof(Scalar)) || (size_t(rhs)%sizeof(Scalar)) )
   {
     alignedSize = 0;
     alignedStart = 0;
@@ -473,4 +471,88 @@ static EIGEN_DONT_INLINE void ei_cache_friendly_product_rowmajor_times_vector(
   #undef _EIGEN_ACCUMULATE_PACKETS
 }
 
+/* Col-major matrix * vector product of reduced precision scalars, e.g. half (see ei_product_accumulator):
+ * the coefficients of the matrix are widened to AccScalar in registers by ei_ploadu_widen(),
+ * and the result is accumulated in res, which has to be aligned.
+ * As above, 4 columns are processed at once to reduce the number of load/stores of the result.
+ */
+template<typename Scalar, typename AccScalar, typename RhsType>
+static EIGEN_DONT_INLINE
+void ei_widening_product_colmajor_times_vector(
+  int size,
+  const Scalar* lhs, int lhsStride,
+  const RhsType& rhs,
+  AccScalar* res,
+  AccScalar alpha)
+{
+  typedef typename ei_packet_traits<AccScalar>::type Packet;
+  const int PacketSize = sizeof(Packet)/sizeof(AccScalar);
+  const int peeledSize = (size/PacketSize)*PacketSize;
+  const int cols = rhs.size();
+  const int peeledCols = (cols/4)*4;
+
+  for(int j=0; j<peeledCols; j+=4)
+  {
+    AccScalar tmp0 = alpha*AccScalar(rhs.coeff(j+0)), tmp1 = alpha*AccScalar(rhs.coeff(j+1)),
+              tmp2 = alpha*AccScalar(rhs.coeff(j+2)), tmp3 = alpha*AccScalar(rhs.coeff(j+3));
+    Packet ptmp0 = ei_pset1(tmp0), ptmp1 = ei_pset1(tmp1), ptmp2 = ei_pset1(tmp2), ptmp3 = ei_pset1(tmp3);
+    const Scalar *lhs0 = lhs + (j+0)*lhsStride, *lhs1 = lhs + (j+1)*lhsStride,
+                 *lhs2 = lhs + (j+2)*lhsStride, *lhs3 = lhs + (j+3)*lhsStride;
+
+    for(int i=0; i<peeledSize; i+=PacketSize)
+      ei_pstore(&res[i], ei_padd(ei_pload(&res[i]),
+        ei_padd(ei_padd(ei_pmul(ei_ploadu_widen<AccScalar>(&lhs0[i]), ptmp0), ei_pmul(ei_ploadu_widen<AccScalar>(&lhs1[i]), ptmp1)),
+                ei_padd(ei_pmul(ei_ploadu_widen<AccScalar>(&lhs2[i]), ptmp2), ei_pmul(ei_ploadu_widen<AccScalar>(&lhs3[i]), ptmp3)))));
+    for(int i=peeledSize; i<size; ++i)
+      res[i] += tmp0*AccScalar(lhs0[i]) + tmp1*AccScalar(lhs1[i]) + tmp2*AccScalar(lhs2[i]) + tmp3*AccScalar(lhs3[i]);
+  }
+
+  for(int j=peeledCols; j<cols; ++j)
+  {
+    AccScalar tmp0 = alpha*AccScalar(rhs.coeff(j));
+    Packet ptmp0 = ei_pset1(tmp0);
+    const Scalar* lhs0 = lhs + j*lhsStride;
+    for(int i=0; i<peeledSize; i+=PacketSize)
+      ei_pstore(&res[i], ei_pmadd(ei_ploadu_widen<AccScalar>(&lhs0[i]), ptmp0, ei_pload(&res[i])));
+    for(int i=peeledSize; i<size; ++i)
+      res[i] += tmp0*AccScalar(lhs0[i]);
+  }
+}
+
+/* Row-major matrix * vector product of reduced precision scalars, e.g. half:
+ * each row of the matrix is widened in registers and multiplied by the rhs,
+ * which has been converted to AccScalar and has to be aligned.
+ */
+template<typename Scalar, typename AccScalar, typename ResType>
+static EIGEN_DONT_INLINE
+void ei_widening_product_rowmajor_times_vector(
+  const Scalar* lhs, int lhsStride,
+  const AccScalar* rhs, int rhsSize,
+  ResType& res,
+  AccScalar alpha)
+{
+  typedef typename ei_packet_traits<AccScalar>::type Packet;
+  const int PacketSize = sizeof(Packet)/sizeof(AccScalar);
+  const int peeledSize = (rhsSize/PacketSize)*PacketSize;
+  const int rows = res.size();
+
+  for(int i=0; i<rows; ++i)
+  {
+    const Scalar* lhs0 = lhs + i*lhsStride;
+    Packet ptmp0 = ei_pset1(AccScalar(0)), ptmp1 = ei_pset1(AccScalar(0));
+    int j = 0;
+    for(; j+PacketSize<peeledSize; j+=2*PacketSize)
+    {
+      ptmp0 = ei_pmadd(ei_ploadu_widen<AccScalar>(&lhs0[j]), ei_pload(&rhs[j]), ptmp0);
+      ptmp1 = ei_pmadd(ei_ploadu_widen<AccScalar>(&lhs0[j+PacketSize]), ei_pload(&rhs[j+PacketSize]), ptmp1);
+    }
+    if(j<peeledSize)
+      ptmp0 = ei_pmadd(ei_ploadu_widen<AccScalar>(&lhs0[j]), ei_pload(&rhs[j]), ptmp0);
+    AccScalar tmp0 = ei_predux(ei_padd(ptmp0, ptmp1));
+    for(j=peeledSize; j<rhsSize; ++j)
+      tmp0 += AccScalar(lhs0[j]) * rhs[j];
+    res.coeffRef(i) = typename ResType::Scalar(AccScalar(res.coeff(i)) + alpha*tmp0);
+  }
+}
+
 #endif // EIGEN_GENERAL_MATRIX_VECTOR_H
@@ -27,7 +27,7 @@
 
 template<typename BlockBScalar> struct GemmParallelInfo
 {
-  GemmParallelInfo() : sync(-1), users(0), rhs_start(0), rhs_length(0), blockB(0) {}
+  GemmParallelInfo() : sync(-1), users(0), rhs_start(0), rhs_length(0), blockB(0), workspace(0) {}
 
   int volatile sync;
   int volatile users;
@@ -35,12 +35,14 @@ template<typename BlockBScalar> struct GemmParallelInfo
   int rhs_start;
   int rhs_length;
   BlockBScalar* blockB;
+  BlockBScalar* workspace;
 };
 
 template<bool Condition,typename Functor>
-void ei_parallelize_gemm(const Functor& func, int rows, int cols)
+void ei_parallelize_gemm(const Functor& func, int rows, int cols, bool transpose = false)
 {
 #ifndef EIGEN_HAS_OPENMP
+  (void) transpose;
   func(0,rows, 0,cols);
 #else
 
@@ -55,6 +57,12 @@ void ei_parallelize_gemm(const Functor& func, int rows, int cols)
   if((!Condition) || (omp_get_num_threads()>1))
     return func(0,rows, 0,cols);
 
+  // a product with a row-major destination is evaluated as its transpose,
+  // so the threads have to share the columns of the product instead of its rows
+  int actualRows = rows, actualCols = cols;
+  if(transpose)
+    std::swap(rows,cols);
+
   // 2- compute the maximal number of threads from the size of the product:
   // FIXME this has to be fine tuned
   int max_threads = std::max(1,rows / 32);
@@ -63,15 +71,19 @@ void ei_parallelize_gemm(const Functor& func, int rows, int cols)
   int threads = std::min(omp_get_max_threads(), max_threads);
 
   if(threads==1)
-    return func(0,rows, 0,cols);
+    return func(0,actualRows, 0,actualCols);
 
   int blockCols = (cols / threads) & ~0x3;
   int blockRows = (rows / threads) & ~0x7;
 
   typedef typename Functor::BlockBScalar BlockBScalar;
-  BlockBScalar* sharedBlockB = new BlockBScalar[func.sharedBlockBSize()];
+  BlockBScalar* sharedBlockB = ei_aligned_stack_new(BlockBScalar, func.sharedBlockBSize());
+
+  // the workspaces of all the threads are taken from the calling thread
+  int threadWorkspaceSize = func.threadWorkspaceSize();
+  BlockBScalar* workspaces = ei_aligned_stack_new(BlockBScalar, threads*threadWorkspaceSize);
 
-  GemmParallelInfo<BlockBScalar>* info = new GemmParallelInfo<BlockBScalar>[threads];
+  GemmParallelInfo<BlockBScalar>* info = ei_aligned_stack_new(GemmParallelInfo<BlockBScalar>, threads);
 
   #pragma omp parallel for schedule(static,1) num_threads(threads)
   for(int i=0; i<threads; ++i)
@@ -85,12 +97,17 @@ void ei_parallelize_gemm(const Functor& func, int rows, int cols)
     info[i].rhs_start = c0;
     info[i].rhs_length = actualBlockCols;
     info[i].blockB = sharedBlockB;
+    info[i].workspace = workspaces + i*threadWorkspaceSize;
 
-    func(r0, actualBlockRows, 0,cols, info);
+    if(transpose)
+      func(0,cols, r0, actualBlockRows, info);
+    else
+      func(r0, actualBlockRows, 0,cols, info);
   }
 
-  delete[] sharedBlockB;
-  delete[] info;
+  ei_aligned_stack_delete(GemmParallelInfo<BlockBScalar>, info, threads);
+  ei_aligned_stack_delete(BlockBScalar, workspaces, threads*threadWorkspaceSize);
+  ei_aligned_stack_delete(BlockBScalar, sharedBlockB, func.sharedBlockBSize());
 #endif
 }
 
@@ -0,0 +1,362 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_QUANTIZED_MATRIX_MATRIX_H
+#define EIGEN_QUANTIZED_MATRIX_MATRIX_H
+
+/** \class GemmZeroPoints
+  *
+  * \brief Zero points of the factors of a quantized matrix-matrix product
+  *
+  * A quantized product is a product of two matrices of 8 or 16 bit integers of different types,
+  * e.g., an unsigned char matrix times a signed char matrix, which is accumulated in int.
+  * This class is passed to GeneralProduct::evalTo(Dest&, const GemmZeroPoints&) to evaluate
+  * \code dst = (lhs - lhsZero) * (rhs - rhsZero) \endcode
+  * where the zero point of the lhs is either a single value or a value per row, and the zero
+  * point of the rhs is either a single value or a value per column. The zero points are not
+  * subtracted from the factors: the product of the factors is corrected using the sums of the
+  * rows of the lhs and of the columns of the rhs.
+  *
+  * Example:
+  * \code
+  * Map<Matrix<signed char,Dynamic,Dynamic> > weights(weightsData, rows, depth);
+  * Map<Matrix<unsigned char,Dynamic,Dynamic> > input(inputData, depth, batch);
+  * MatrixXi output(rows, batch);
+  * (weights * input).evalTo(output, GemmZeroPoints().setRhsZeroPoint(128));
+  * \endcode
+  *
+  * The vectors of zero points are referenced, and not copied.
+  */
+class GemmZeroPoints
+{
+  public:
+    GemmZeroPoints() : m_lhsZero(0), m_rhsZero(0), m_lhsZeros(0), m_rhsZeros(0) {}
+
+    /** Sets the zero point of all the coefficients of the lhs. The default is 0. */
+    GemmZeroPoints& setLhsZeroPoint(int zero) { m_lhsZero = zero; m_lhsZeros = 0; return *this; }
+
+    /** Sets the zero point \a zeros(i) of each row \a i of the lhs.
+      * \a zeros must be a vector of int with contiguous storage, e.g., a VectorXi, and must remain
+      * alive until the product is evaluated. */
+    template<typename Derived>
+    GemmZeroPoints& setLhsZeroPoints(const MatrixBase<Derived>& zeros)
+    {
+      m_lhsZeros = zeroPointsData(zeros);
+      return *this;
+    }
+
+    /** Sets the zero point of all the coefficients of the rhs. The default is 0. */
+    GemmZeroPoints& setRhsZeroPoint(int zero) { m_rhsZero = zero; m_rhsZeros = 0; return *this; }
+
+    /** Sets the zero point \a zeros(j) of each column \a j of the rhs.
+      * \sa setLhsZeroPoints() */
+    template<typename Derived>
+    GemmZeroPoints& setRhsZeroPoints(const MatrixBase<Derived>& zeros)
+    {
+      m_rhsZeros = zeroPointsData(zeros);
+      return *this;
+    }
+
+    /** \internal \returns whether the zero points of the lhs are not all 0 */
+    bool hasLhs() const { return m_lhsZeros || m_lhsZero!=0; }
+    /** \internal \returns whether the zero points of the rhs are not all 0 */
+    bool hasRhs() const { return m_rhsZeros || m_rhsZero!=0; }
+
+    /** \internal \returns the zero point of the row \a i of the lhs */
+    int lhs(int i) const { return m_lhsZeros ? m_lhsZeros[i] : m_lhsZero; }
+    /** \internal \returns the zero point of the column \a j of the rhs */
+    int rhs(int j) const { return m_rhsZeros ? m_rhsZeros[j] : m_rhsZero; }
+
+  protected:
+    template<typename Derived>
+    static const int* zeroPointsData(const MatrixBase<Derived>& zeros)
+    {
+      EIGEN_STATIC_ASSERT_VECTOR_ONLY(Derived)
+      EIGEN_STATIC_ASSERT((int(ei_traits<Derived>::Flags)&DirectAccessBit)!=0,
+                          THIS_METHOD_IS_ONLY_FOR_EXPRESSIONS_WITH_DIRECT_MEMORY_ACCESS_SUCH_AS_MAP_OR_PLAIN_MATRICES)
+      EIGEN_STATIC_ASSERT(bool(ei_is_same_type<typename Derived::Scalar, int>::ret),
+                          YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+      ei_assert(zeros.innerStride()==1 && "the zero points must be stored contiguously");
+      return zeros.derived().data();
+    }
+
+    int m_lhsZero;
+    int m_rhsZero;
+    const int* m_lhsZeros;
+    const int* m_rhsZeros;
+};
+
+/** \internal
+  * Computes the mr x nr block \a tile (column major) of the product of a packed panel of mr rows of the lhs
+  * and of a packed panel of nr columns of the rhs, where \a pairs is half the depth of the panels.
+  * Each 32 bit word of the panels holds two consecutive coefficients along the depth widened to 16 bits,
+  * such that a multiply-add of pairs (pmaddwd with SSE2) accumulates them in 32 bits without any overflow.
+  * Note that pmaddubsw, which multiplies unsigned and signed bytes directly, saturates its sums of pairs
+  * in 16 bits and thus cannot be used for an exact product.
+  */
+EIGEN_STRONG_INLINE void ei_quantized_gebp_micro_kernel(const short* blA, const short* blB, int pairs, int* tile)
+{
+  // the sizes of the panels, see ei_quantized_matrix_matrix_product
+  enum { mr = 8, nr = 4 };
+#ifdef EIGEN_VECTORIZE_SSE
+  __m128i C0 = _mm_setzero_si128(), C1 = C0, C2 = C0, C3 = C0, C4 = C0, C5 = C0, C6 = C0, C7 = C0;
+  for(int p=0; p<pairs; ++p)
+  {
+    __m128i A0 = _mm_load_si128(reinterpret_cast<const __m128i*>(blA));
+    __m128i A1 = _mm_load_si128(reinterpret_cast<const __m128i*>(blA+8));
+    __m128i B  = _mm_load_si128(reinterpret_cast<const __m128i*>(blB));
+    __m128i b;
+    b = _mm_shuffle_epi32(B, 0x00);
+    C0 = _mm_add_epi32(C0, _mm_madd_epi16(A0, b));
+    C1 = _mm_add_epi32(C1, _mm_madd_epi16(A1, b));
+    b = _mm_shuffle_epi32(B, 0x55);
+    C2 = _mm_add_epi32(C2, _mm_madd_epi16(A0, b));
+    C3 = _mm_add_epi32(C3, _mm_madd_epi16(A1, b));
+    b = _mm_shuffle_epi32(B, 0xaa);
+    C4 = _mm_add_epi32(C4, _mm_madd_epi16(A0, b));
+    C5 = _mm_add_epi32(C5, _mm_madd_epi16(A1, b));
+    b = _mm_shuffle_epi32(B, 0xff);
+    C6 = _mm_add_epi32(C6, _mm_madd_epi16(A0, b));
+    C7 = _mm_add_epi32(C7, _mm_madd_epi16(A1, b));
+    blA += 2*mr;
+    blB += 2*nr;
+  }
+  __m128i* dst = reinterpret_cast<__m128i*>(tile);
+  _mm_store_si128(dst+0, C0); _mm_store_si128(dst+1, C1);
+  _mm_store_si128(dst+2, C2); _mm_store_si128(dst+3, C3);
+  _mm_store_si128(dst+4, C4); _mm_store_si128(dst+5, C5);
+  _mm_store_si128(dst+6, C6); _mm_store_si128(dst+7, C7);
+#else
+  for(int k=0; k<mr*nr; ++k)
+    tile[k] = 0;
+  for(int p=0; p<pairs; ++p)
+  {
+    for(int j=0; j<nr; ++j)
+      for(int i=0; i<mr; ++i)
+        tile[j*mr+i] += int(blA[2*i])*int(blB[2*j]) + int(blA[2*i+1])*int(blB[2*j+1]);
+    blA += 2*mr;
+    blB += 2*nr;
+  }
+#endif
+}
+
+/* Quantized matrix-matrix product:
+ *   res = epilogue(alpha * (lhs - lhsZero) * (rhs - rhsZero), res)
+ * where lhs and rhs are matrices of 8 or 16 bit integers, and res is accumulated in int.
+ * The factors are widened to 16 bits while they are packed, with two consecutive coefficients
+ * along the depth per 32 bit word, see ei_quantized_gebp_micro_kernel. An odd depth is padded
+ * with zeros. The zero points are applied to the result, when the last panel of the depth is stored,
+ * using the sums of the rows of lhs and of the columns of rhs.
+ */
+template<typename LhsScalar, int LhsStorageOrder, typename RhsScalar, int RhsStorageOrder, int ResStorageOrder>
+struct ei_quantized_matrix_matrix_product
+{
+  enum { mr = 8, nr = 4 };
+  typedef ei_const_blas_data_mapper<LhsScalar, LhsStorageOrder> LhsMapper;
+  typedef ei_const_blas_data_mapper<RhsScalar, RhsStorageOrder> RhsMapper;
+  typedef ei_blas_data_mapper<int, ResStorageOrder> ResMapper;
+
+  template<typename Epilogue>
+  static void run(int rows, int cols, int depth,
+    const LhsScalar* _lhs, int lhsStride,
+    const RhsScalar* _rhs, int rhsStride,
+    int* _res, int resStride,
+    int alpha,
+    const GemmZeroPoints& zeroPoints,
+    const Epilogue& epilogue)
+  {
+    LhsMapper lhs(_lhs,lhsStride);
+    RhsMapper rhs(_rhs,rhsStride);
+    ResMapper res(_res,resStride);
+
+    // an empty product still has to go through the epilogue
+    if(depth==0)
+    {
+      store(res, 0, 0, rows, cols, 0, alpha, epilogue.panel(0,0,true,true), zeroPoints, 0, 0);
+      return;
+    }
+
+    // lhsSums(i) = sum_k lhs(i,k) - depth*lhsZero(i) is multiplied by the zero points of the rhs,
+    // and rhsSums(j) = sum_k rhs(k,j) by the zero points of the lhs
+    int* lhsSums = 0;
+    int* rhsSums = 0;
+    if(zeroPoints.hasRhs())
+    {
+      lhsSums = ei_aligned_stack_new(int, rows);
+      for(int i=0; i<rows; ++i)
+        lhsSums[i] = -depth*zeroPoints.lhs(i);
+      // follow the storage order of the lhs
+      if(LhsStorageOrder==RowMajor)
+      {
+        for(int i=0; i<rows; ++i)
+          for(int k=0; k<depth; ++k)
+            lhsSums[i] += int(lhs(i,k));
+      }
+      else
+      {
+        for(int k=0; k<depth; ++k)
+          for(int i=0; i<rows; ++i)
+            lhsSums[i] += int(lhs(i,k));
+      }
+    }
+    if(zeroPoints.hasLhs())
+    {
+      rhsSums = ei_aligned_stack_new(int, cols);
+      for(int j=0; j<cols; ++j)
+        rhsSums[j] = 0;
+      if(RhsStorageOrder==ColMajor)
+      {
+        for(int j=0; j<cols; ++j)
+          for(int k=0; k<depth; ++k)
+            rhsSums[j] += int(rhs(k,j));
+      }
+      else
+      {
+        for(int k=0; k<depth; ++k)
+          for(int j=0; j<cols; ++j)
+            rhsSums[j] += int(rhs(k,j));
+      }
+    }
+
+    typedef ei_product_blocking_traits<short> Blocking;
+    int kc = std::min<int>(Blocking::Max_kc,depth);
+    kc += kc&1;
+
+    // the blocks of the lhs are shared by the threads
+    int threads = 1;
+#ifdef EIGEN_HAS_OPENMP
+    if(omp_get_num_threads()==1)
+      threads = std::max(1, std::min(omp_get_max_threads(), rows/32));
+#endif
+    const int mc = std::min<int>(Blocking::Max_mc, (((rows+threads-1)/threads+mr-1)/mr)*mr);
+
+    const int paddedCols = ((cols+nr-1)/nr)*nr;
+    const std::size_t sizeA = kc*mc;
+    const std::size_t sizeB = kc*paddedCols;
+    short* blockA = ei_aligned_stack_new(short, threads*sizeA);
+    short* blockB = ei_aligned_stack_new(short, sizeB);
+
+    for(int k2=0; k2<depth; k2+=kc)
+    {
+      const int actual_kc = std::min(k2+kc,depth)-k2;
+      const bool last = k2+actual_kc==depth;
+      const int pairs = (actual_kc+1)/2;
+
+      const int panelsB = paddedCols/nr;
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp parallel for num_threads(threads) if(threads>1)
+#endif
+      for(int j2=0; j2<panelsB; ++j2)
+        packRhs(blockB+j2*nr*2*pairs, rhs, k2, actual_kc, j2*nr, std::min<int>(nr,cols-j2*nr));
+
+      const int blocksA = (rows+mc-1)/mc;
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp parallel for num_threads(threads) if(threads>1)
+#endif
+      for(int i2=0; i2<blocksA; ++i2)
+      {
+#ifdef EIGEN_HAS_OPENMP
+        short* threadBlockA = blockA + (threads>1 ? omp_get_thread_num() : 0)*sizeA;
+#else
+        short* threadBlockA = blockA;
+#endif
+        const int i = i2*mc;
+        const int actual_mc = std::min(i+mc,rows)-i;
+        packLhs(threadBlockA, lhs, i, actual_mc, k2, actual_kc);
+        kernel(res, threadBlockA, blockB, i, actual_mc, cols, pairs, alpha, epilogue.panel(0,0,k2==0,last), zeroPoints,
+               last ? lhsSums : 0, last ? rhsSums : 0);
+      }
+    }
+
+    ei_aligned_stack_delete(short, blockA, threads*sizeA);
+    ei_aligned_stack_delete(short, blockB, sizeB);
+    if(lhsSums) ei_aligned_stack_delete(int, lhsSums, rows);
+    if(rhsSums) ei_aligned_stack_delete(int, rhsSums, cols);
+  }
+
+  // packs the rows i to i+actual_mc-1 of the lhs into panels of mr rows with pairs of coefficients along the depth
+  static void packLhs(short* blockA, const LhsMapper& lhs, int i, int actual_mc, int k, int actual_kc)
+  {
+    for(int i2=0; i2<actual_mc; i2+=mr)
+    {
+      const int actual_mr = std::min<int>(mr,actual_mc-i2);
+      for(int k2=0; k2<actual_kc; k2+=2)
+      {
+        const bool hasPair = k2+1<actual_kc;
+        for(int r=0; r<mr; ++r)
+        {
+          blockA[0] = r<actual_mr ? short(lhs(i+i2+r,k+k2)) : short(0);
+          blockA[1] = r<actual_mr && hasPair ? short(lhs(i+i2+r,k+k2+1)) : short(0);
+          blockA += 2;
+        }
+      }
+    }
+  }
+
+  // packs the columns j to j+actual_nr-1 of the rhs into one panel of nr columns
+  static void packRhs(short* blockB, const RhsMapper& rhs, int k, int actual_kc, int j, int actual_nr)
+  {
+    for(int k2=0; k2<actual_kc; k2+=2)
+    {
+      const bool hasPair = k2+1<actual_kc;
+      for(int c=0; c<nr; ++c)
+      {
+        blockB[0] = c<actual_nr ? short(rhs(k+k2,j+c)) : short(0);
+        blockB[1] = c<actual_nr && hasPair ? short(rhs(k+k2+1,j+c)) : short(0);
+        blockB += 2;
+      }
+    }
+  }
+
+  template<typename Panel>
+  static void kernel(ResMapper& res, const short* blockA, const short* blockB, int i, int actual_mc, int cols, int pairs,
+                     int alpha, const Panel& panel, const GemmZeroPoints& zeroPoints, const int* lhsSums, const int* rhsSums)
+  {
+    EIGEN_ALIGN16 int tile[mr*nr];
+    for(int j2=0; j2<cols; j2+=nr)
+    {
+      const int actual_nr = std::min<int>(nr,cols-j2);
+      for(int i2=0; i2<actual_mc; i2+=mr)
+      {
+        ei_quantized_gebp_micro_kernel(blockA+i2*2*pairs, blockB+j2*2*pairs, pairs, tile);
+        store(res, i+i2, j2, std::min<int>(mr,actual_mc-i2), actual_nr, tile, alpha, panel, zeroPoints, lhsSums, rhsSums);
+      }
+    }
+  }
+
+  // stores the block \a tile of the product, of leading dimension mr, at (\a i, \a j) through \a panel
+  template<typename Panel>
+  static EIGEN_STRONG_INLINE void store(ResMapper& res, int i, int j, int rows, int cols, const int* tile, int alpha,
+                                        const Panel& panel, const GemmZeroPoints& zeroPoints, const int* lhsSums, const int* rhsSums)
+  {
+    for(int c=0; c<cols; ++c)
+      for(int r=0; r<rows; ++r)
+      {
+        int acc = tile ? tile[c*mr+r] : 0;
+        if(lhsSums) acc -= zeroPoints.rhs(j+c) * lhsSums[i+r];
+        if(rhsSums) acc -= zeroPoints.lhs(i+r) * rhsSums[j+c];
+        res(i+r,j+c) = panel.coeff(alpha*acc, res(i+r,j+c), i+r, j+c);
+      }
+  }
+};
+
+#endif // EIGEN_QUANTIZED_MATRIX_MATRIX_H
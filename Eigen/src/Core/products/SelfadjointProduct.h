@@ -29,6 +29,8 @@
 * This file implement a self adjoint product: C += A A^T updating only
 * an half of the selfadjoint matrix C.
 * It corresponds to the level 3 SYRK Blas routine.
+* The same kernel also evaluates C += A B^T for two different factors,
+* which is used for the rank 2k updates (SYR2K).
 **********************************************************************/
 
 // forward declarations (defined at the end of this file)
@@ -50,6 +52,13 @@ struct ei_selfadjoint_product<Scalar,MatStorageOrder, RowMajor, AAT, UpLo>
     ei_selfadjoint_product<Scalar, MatStorageOrder, ColMajor, !AAT, UpLo==Lower?Upper:Lower>
       ::run(size, depth, mat, matStride, res, resStride, alpha);
   }
+
+  static EIGEN_STRONG_INLINE void run(int size, int depth, const Scalar* lhs, int lhsStride, const Scalar* rhs, int rhsStride,
+                                      Scalar* res, int resStride, Scalar alpha)
+  {
+    ei_selfadjoint_product<Scalar, MatStorageOrder, ColMajor, !AAT, UpLo==Lower?Upper:Lower>
+      ::run(size, depth, rhs, rhsStride, lhs, lhsStride, res, resStride, alpha);
+  }
 };
 
 template <typename Scalar,
@@ -57,13 +66,21 @@ template <typename Scalar,
 struct ei_selfadjoint_product<Scalar,MatStorageOrder, ColMajor, AAT, UpLo>
 {
 
+  static EIGEN_STRONG_INLINE void run(int size, int depth, const Scalar* mat, int matStride, Scalar* res, int resStride, Scalar alpha)
+  {
+    run(size, depth, mat, matStride, mat, matStride, res, resStride, alpha);
+  }
+
+  // general version where the lhs and the transposed rhs factors differ
   static EIGEN_DONT_INLINE void run(
     int size, int depth,
-    const Scalar* _mat, int matStride,
+    const Scalar* _lhs, int lhsStride,
+    const Scalar* _rhs, int rhsStride,
     Scalar* res,        int resStride,
     Scalar alpha)
   {
-    ei_const_blas_data_mapper<Scalar, MatStorageOrder> mat(_mat,matStride);
+    ei_const_blas_data_mapper<Scalar, MatStorageOrder> lhs(_lhs,lhsStride);
+    ei_const_blas_data_mapper<Scalar, MatStorageOrder> rhs(_rhs,rhsStride);
 
     if(AAT)
       alpha = ei_conj(alpha);
@@ -91,13 +108,13 @@ struct ei_selfadjoint_product<Scalar,MatStorageOrder, ColMajor, AAT, UpLo>
       const int actual_kc = std::min(k2+kc,depth)-k2;
 
       // note that the actual rhs is the transpose/adjoint of mat
-      pack_rhs(blockB, &mat(0,k2), matStride, alpha, actual_kc, size);
+      pack_rhs(blockB, &rhs(0,k2), rhsStride, alpha, actual_kc, size);
 
       for(int i2=0; i2<size; i2+=mc)
       {
         const int actual_mc = std::min(i2+mc,size)-i2;
 
-        pack_lhs(blockA, &mat(i2, k2), matStride, actual_kc, actual_mc);
+        pack_lhs(blockA, &lhs(i2, k2), lhsStride, actual_kc, actual_mc);
 
         // the selected actual_mc * size panel of res is split into three different part:
         //  1 - before the diagonal => processed with gebp or skipped
@@ -148,6 +165,57 @@ SelfAdjointView<MatrixType,UpLo>& SelfAdjointView<MatrixType,UpLo>
   return *this;
 }
 
+// rank 2k update: C += alpha (U V^* + V U^*), evaluated as two
+// selfadjoint products sharing the same kernel. Both factors are read by the
+// same packing routines, so they must have the same storage order and conjugation,
+// otherwise they are evaluated first.
+template<typename MatrixType, unsigned int UpLo, typename DerivedU, typename DerivedV,
+         bool Direct = int(ei_cleantype<typename ei_blas_traits<DerivedU>::DirectLinearAccessType>::type::Flags&RowMajorBit)
+                    == int(ei_cleantype<typename ei_blas_traits<DerivedV>::DirectLinearAccessType>::type::Flags&RowMajorBit)
+                    && int(ei_blas_traits<DerivedU>::NeedToConjugate) == int(ei_blas_traits<DerivedV>::NeedToConjugate)>
+struct ei_selfadjoint_rank2k_update
+{
+  typedef typename MatrixType::Scalar Scalar;
+  static void run(MatrixType& mat, const DerivedU& u, const DerivedV& v, Scalar alpha)
+  {
+    typedef Matrix<Scalar,Dynamic,Dynamic> PlainMatrixType;
+    PlainMatrixType actualU(u), actualV(v);
+    ei_selfadjoint_rank2k_update<MatrixType,UpLo,PlainMatrixType,PlainMatrixType>::run(mat, actualU, actualV, alpha);
+  }
+};
+
+template<typename MatrixType, unsigned int UpLo, typename DerivedU, typename DerivedV>
+struct ei_selfadjoint_rank2k_update<MatrixType,UpLo,DerivedU,DerivedV,true>
+{
+  typedef typename MatrixType::Scalar Scalar;
+  static void run(MatrixType& mat, const DerivedU& u, const DerivedV& v, Scalar alpha)
+  {
+    typedef ei_blas_traits<DerivedU> UBlasTraits;
+    typedef typename UBlasTraits::DirectLinearAccessType ActualUType;
+    typedef typename ei_cleantype<ActualUType>::type _ActualUType;
+    const ActualUType actualU = UBlasTraits::extract(u);
+
+    typedef ei_blas_traits<DerivedV> VBlasTraits;
+    typedef typename VBlasTraits::DirectLinearAccessType ActualVType;
+    const ActualVType actualV = VBlasTraits::extract(v);
+
+    Scalar actualAlpha = alpha * UBlasTraits::extractScalarFactor(u)
+                               * VBlasTraits::extractScalarFactor(v);
+
+    enum {
+      MatStorageOrder = _ActualUType::Flags&RowMajorBit ? RowMajor : ColMajor,
+      ResStorageOrder = ei_traits<MatrixType>::Flags&RowMajorBit ? RowMajor : ColMajor,
+      AAT = !UBlasTraits::NeedToConjugate
+    };
+    typedef ei_selfadjoint_product<Scalar, MatStorageOrder, ResStorageOrder, AAT, UpLo> Product;
+
+    Product::run(mat.cols(), actualU.cols(), &actualU.coeff(0,0), actualU.outerStride(),
+                 &actualV.coeff(0,0), actualV.outerStride(), const_cast<Scalar*>(mat.data()), mat.outerStride(), actualAlpha);
+    Product::run(mat.cols(), actualU.cols(), &actualV.coeff(0,0), actualV.outerStride(),
+                 &actualU.coeff(0,0), actualU.outerStride(), const_cast<Scalar*>(mat.data()), mat.outerStride(), actualAlpha);
+  }
+};
+
 
 // Optimized SYmmetric packed Block * packed Block product kernel.
 // This kernel is built on top of the gebp kernel:
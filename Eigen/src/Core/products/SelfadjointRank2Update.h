@@ -65,11 +65,38 @@ template<bool Cond, typename T> struct ei_conj_expr_if
       CwiseUnaryOp<ei_scalar_conjugate_op<typename ei_traits<T>::Scalar>,T> > {};
 
 
+template<typename MatrixType, unsigned int UpLo, typename DerivedU, typename DerivedV,
+         bool IsVector = DerivedU::ColsAtCompileTime==1 && DerivedV::ColsAtCompileTime==1>
+struct ei_selfadjoint_rank2_update_dispatcher
+{
+  // matrix factors => level 3 rank 2k update
+  static void run(MatrixType& mat, const DerivedU& u, const DerivedV& v, typename MatrixType::Scalar alpha)
+  {
+    ei_selfadjoint_rank2k_update<MatrixType,UpLo,DerivedU,DerivedV>::run(mat, u, v, alpha);
+  }
+};
+
+template<typename MatrixType, unsigned int UpLo, typename DerivedU, typename DerivedV>
+struct ei_selfadjoint_rank2_update_dispatcher<MatrixType,UpLo,DerivedU,DerivedV,true>
+{
+  static void run(MatrixType& mat, const DerivedU& u, const DerivedV& v, typename MatrixType::Scalar alpha);
+};
+
 template<typename MatrixType, unsigned int UpLo>
 template<typename DerivedU, typename DerivedV>
 SelfAdjointView<MatrixType,UpLo>& SelfAdjointView<MatrixType,UpLo>
 ::rankUpdate(const MatrixBase<DerivedU>& u, const MatrixBase<DerivedV>& v, Scalar alpha)
 {
+  ei_selfadjoint_rank2_update_dispatcher<MatrixType,UpLo,DerivedU,DerivedV>
+    ::run(const_cast<MatrixType&>(_expression()), u.derived(), v.derived(), alpha);
+  return *this;
+}
+
+template<typename MatrixType, unsigned int UpLo, typename DerivedU, typename DerivedV>
+void ei_selfadjoint_rank2_update_dispatcher<MatrixType,UpLo,DerivedU,DerivedV,true>
+::run(MatrixType& mat, const DerivedU& u, const DerivedV& v, typename MatrixType::Scalar alpha)
+{
+  typedef typename MatrixType::Scalar Scalar;
   typedef ei_blas_traits<DerivedU> UBlasTraits;
   typedef typename UBlasTraits::DirectLinearAccessType ActualUType;
   typedef typename ei_cleantype<ActualUType>::type _ActualUType;
@@ -88,9 +115,7 @@ SelfAdjointView<MatrixType,UpLo>& SelfAdjointView<MatrixType,UpLo>
     typename ei_cleantype<typename ei_conj_expr_if<IsRowMajor ^ UBlasTraits::NeedToConjugate,_ActualUType>::ret>::type,
     typename ei_cleantype<typename ei_conj_expr_if<IsRowMajor ^ VBlasTraits::NeedToConjugate,_ActualVType>::ret>::type,
     (IsRowMajor ? int(UpLo==Upper ? Lower : Upper) : UpLo)>
-    ::run(const_cast<Scalar*>(_expression().data()),_expression().outerStride(),actualU,actualV,actualAlpha);
-
-  return *this;
+    ::run(const_cast<Scalar*>(mat.data()),mat.outerStride(),actualU,actualV,actualAlpha);
 }
 
 #endif // EIGEN_SELFADJOINTRANK2UPTADE_H
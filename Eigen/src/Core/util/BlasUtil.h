@@ -53,8 +53,18 @@ template<bool ConjugateLhs, bool ConjugateRhs, typename Scalar, typename ResType
 static void ei_cache_friendly_product_rowmajor_times_vector(
   const Scalar* lhs, int lhsStride, const Scalar* rhs, int rhsSize, ResType& res, Scalar alpha);
 
+template<typename Scalar, typename AccScalar, typename RhsType>
+static void ei_widening_product_colmajor_times_vector(
+  int size, const Scalar* lhs, int lhsStride, const RhsType& rhs, AccScalar* res, AccScalar alpha);
+
+template<typename Scalar, typename AccScalar, typename ResType>
+static void ei_widening_product_rowmajor_times_vector(
+  const Scalar* lhs, int lhsStride, const AccScalar* rhs, int rhsSize, ResType& res, AccScalar alpha);
+
 // Provides scalar/packet-wise product and product with accumulation
 // with optional conjugation of the arguments.
+// The generic versions work on packets through ei_pconj, while the
+// std::complex overloads avoid the explicit conjugation for scalars.
 template<bool ConjLhs, bool ConjRhs> struct ei_conj_helper;
 
 template<> struct ei_conj_helper<false,false>
@@ -67,6 +77,11 @@ template<> struct ei_conj_helper<false,false>
 
 template<> struct ei_conj_helper<false,true>
 {
+  template<typename T>
+  EIGEN_STRONG_INLINE T pmadd(const T& x, const T& y, const T& c) const { return ei_padd(c, pmul(x,y)); }
+  template<typename T>
+  EIGEN_STRONG_INLINE T pmul(const T& x, const T& y) const { return ei_pmul(x, ei_pconj(y)); }
+
   template<typename T> std::complex<T>
   pmadd(const std::complex<T>& x, const std::complex<T>& y, const std::complex<T>& c) const
   { return c + pmul(x,y); }
@@ -77,6 +92,11 @@ template<> struct ei_conj_helper<false,true>
 
 template<> struct ei_conj_helper<true,false>
 {
+  template<typename T>
+  EIGEN_STRONG_INLINE T pmadd(const T& x, const T& y, const T& c) const { return ei_padd(c, pmul(x,y)); }
+  template<typename T>
+  EIGEN_STRONG_INLINE T pmul(const T& x, const T& y) const { return ei_pmul(ei_pconj(x), y); }
+
   template<typename T> std::complex<T>
   pmadd(const std::complex<T>& x, const std::complex<T>& y, const std::complex<T>& c) const
   { return c + pmul(x,y); }
@@ -87,6 +107,11 @@ template<> struct ei_conj_helper<true,false>
 
 template<> struct ei_conj_helper<true,true>
 {
+  template<typename T>
+  EIGEN_STRONG_INLINE T pmadd(const T& x, const T& y, const T& c) const { return ei_padd(c, pmul(x,y)); }
+  template<typename T>
+  EIGEN_STRONG_INLINE T pmul(const T& x, const T& y) const { return ei_pconj(ei_pmul(x,y)); }
+
   template<typename T> std::complex<T>
   pmadd(const std::complex<T>& x, const std::complex<T>& y, const std::complex<T>& c) const
   { return c + pmul(x,y); }
@@ -218,6 +218,15 @@ enum {
   Square = AtLeastAsManyRowsAsCols | AtLeastAsManyColsAsRows
 };
 
+// runtime options for BDCSVD decomposition: which unitaries are computed, and whether they are
+// full (square) or thin (only the first min(rows,cols) columns)
+enum {
+  ComputeFullU = 0x10,
+  ComputeThinU = 0x20,
+  ComputeFullV = 0x40,
+  ComputeThinV = 0x80
+};
+
 /* the following could as well be written:
  *   enum NoChange_t { NoChange };
  * but it feels dangerous to disambiguate overloaded functions on enum/integer types.
@@ -239,6 +248,16 @@ namespace {
   EIGEN_UNUSED Default_t Default;
 }
 
+struct Pairwise_t {};
+namespace {
+  EIGEN_UNUSED Pairwise_t Pairwise;
+}
+
+struct Kahan_t {};
+namespace {
+  EIGEN_UNUSED Kahan_t Kahan;
+}
+
 enum {
   IsDense         = 0,
   IsSparse
@@ -178,6 +178,15 @@
 #define EIGEN_ASM_COMMENT(X)
 #endif
 
+// thread-local storage of a POD variable, required by EIGEN_USE_WORKSPACE_ARENA
+#ifndef EIGEN_THREAD_LOCAL
+  #if (defined __GNUC__) || (defined __SUNPRO_CC)
+    #define EIGEN_THREAD_LOCAL __thread
+  #elif (defined _MSC_VER)
+    #define EIGEN_THREAD_LOCAL __declspec(thread)
+  #endif
+#endif
+
 /* EIGEN_ALIGN_TO_BOUNDARY(n) forces data to be n-byte aligned. This is used to satisfy SIMD requirements.
  * However, we do that EVEN if vectorization (EIGEN_VECTORIZE) is disabled,
  * so that vectorization doesn't affect binary compatibility.
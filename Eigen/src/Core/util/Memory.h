@@ -158,6 +158,40 @@ inline void* ei_generic_aligned_realloc(void* ptr, size_t size, size_t old_size)
   return newptr;
 }
 
+/*****************************************************************************
+*** Implementation of the checks that the heap is not used                 ***
+*****************************************************************************/
+
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+/** \internal Stores whether heap allocations are currently allowed, and updates it if \a update is true */
+inline bool ei_is_malloc_allowed_impl(bool update, bool new_value = false)
+{
+  static bool value = true;
+  if(update)
+    value = new_value;
+  return value;
+}
+
+/** \returns whether heap allocations are currently allowed. Only available when EIGEN_RUNTIME_NO_MALLOC is defined. */
+inline bool ei_is_malloc_allowed() { return ei_is_malloc_allowed_impl(false); }
+
+/** Allows or forbids heap allocations, which then trigger an assertion, and returns \a new_value.
+  * This makes it possible to check that a real-time loop does not touch the heap.
+  * Only available when EIGEN_RUNTIME_NO_MALLOC is defined.
+  */
+inline bool ei_set_is_malloc_allowed(bool new_value) { return ei_is_malloc_allowed_impl(true, new_value); }
+#endif
+
+/** \internal Asserts that heap allocations are allowed, see EIGEN_NO_MALLOC and EIGEN_RUNTIME_NO_MALLOC */
+inline void ei_check_that_malloc_is_allowed()
+{
+  #if defined(EIGEN_NO_MALLOC)
+    ei_assert(false && "heap allocation is forbidden (EIGEN_NO_MALLOC is defined)");
+  #elif defined(EIGEN_RUNTIME_NO_MALLOC)
+    ei_assert(ei_is_malloc_allowed() && "heap allocation is forbidden (EIGEN_RUNTIME_NO_MALLOC is defined and ei_is_malloc_allowed() is false)");
+  #endif
+}
+
 /*****************************************************************************
 *** Implementation of portable aligned versions of malloc/free/realloc     ***
 *****************************************************************************/
@@ -167,9 +201,7 @@ inline void* ei_generic_aligned_realloc(void* ptr, size_t size, size_t old_size)
   */
 inline void* ei_aligned_malloc(size_t size)
 {
-  #ifdef EIGEN_NO_MALLOC
-    ei_assert(false && "heap allocation is forbidden (EIGEN_NO_MALLOC is defined)");
-  #endif
+  ei_check_that_malloc_is_allowed();
 
   void *result;
   #if !EIGEN_ALIGN
@@ -219,6 +251,7 @@ inline void ei_aligned_free(void *ptr)
 inline void* ei_aligned_realloc(void *ptr, size_t new_size, size_t old_size)
 {
   (void)old_size; // Suppress 'unused variable' warning. Seen in boost tee.
+  ei_check_that_malloc_is_allowed();
 
   void *result;
 #if !EIGEN_ALIGN
@@ -263,9 +296,7 @@ template<bool Align> inline void* ei_conditional_aligned_malloc(size_t size)
 
 template<> inline void* ei_conditional_aligned_malloc<false>(size_t size)
 {
-  #ifdef EIGEN_NO_MALLOC
-    ei_assert(false && "heap allocation is forbidden (EIGEN_NO_MALLOC is defined)");
-  #endif
+  ei_check_that_malloc_is_allowed();
 
   void *result = std::malloc(size);
   #ifdef EIGEN_EXCEPTIONS
@@ -292,6 +323,7 @@ template<bool Align> inline void* ei_conditional_aligned_realloc(void* ptr, size
 
 template<> inline void* ei_conditional_aligned_realloc<false>(void* ptr, size_t new_size, size_t)
 {
+  ei_check_that_malloc_is_allowed();
   return std::realloc(ptr, new_size);
 }
 
@@ -408,6 +440,177 @@ inline static Integer ei_first_aligned(const Scalar* array, Integer size)
   }
 }
 
+/*****************************************************************************
+*** Implementation of the thread-local workspace arena                     ***
+*****************************************************************************/
+
+#ifdef EIGEN_USE_WORKSPACE_ARENA
+
+#ifndef EIGEN_THREAD_LOCAL
+  #error EIGEN_USE_WORKSPACE_ARENA requires thread-local storage, please define EIGEN_THREAD_LOCAL for your compiler
+#endif
+
+/** \internal State of the workspace arena of a thread. It is a POD so that it can be thread-local. */
+struct ei_workspace_arena_state
+{
+  unsigned char* buffer;   // the workspaces are carved out of this buffer
+  size_t capacity;         // size of buffer in bytes
+  size_t used;             // offset of the first free byte of buffer
+  size_t bufferBytesInUse; // number of bytes of buffer in use, less than used if some workspaces were freed out of order
+  bool userBuffer;         // whether buffer is owned by the user
+  size_t bytesInUse;       // number of bytes in use, including the workspaces which did not fit in buffer
+  size_t peakBytes;
+  size_t allocations;
+  size_t heapAllocations;
+};
+
+/** \internal \returns the workspace arena of the calling thread */
+inline ei_workspace_arena_state& ei_workspace_arena()
+{
+  static EIGEN_THREAD_LOCAL ei_workspace_arena_state arena; // zero-initialized
+  return arena;
+}
+
+/** \internal Replaces the buffer of \a arena by one of \a size bytes allocated on the heap */
+inline void ei_workspace_arena_grow(ei_workspace_arena_state& arena, size_t size)
+{
+  ei_assert(arena.used == 0 && "the workspace arena cannot be resized while in use");
+  if(!arena.userBuffer)
+    ei_aligned_free(arena.buffer);
+  arena.buffer = static_cast<unsigned char*>(ei_aligned_malloc(size));
+  arena.capacity = size;
+  arena.userBuffer = false;
+  ++arena.heapAllocations;
+}
+
+/** \internal Allocates \a size bytes from the workspace arena of the calling thread, or on the heap
+  * if they do not fit. The returned pointer is 16-byte aligned, and must be freed by ei_workspace_arena_free()
+  * with the same size. The space of a workspace freed before the ones allocated after it is only reclaimed
+  * once these are freed too.
+  */
+inline void* ei_workspace_arena_alloc(size_t size)
+{
+  ei_workspace_arena_state& arena = ei_workspace_arena();
+  size = (size + 15) & ~size_t(15);
+  void* result;
+  if(arena.used + size <= arena.capacity)
+  {
+    result = arena.buffer + arena.used;
+    arena.used += size;
+    arena.bufferBytesInUse += size;
+  }
+  else
+  {
+    result = ei_aligned_malloc(size);
+    ++arena.heapAllocations;
+  }
+  ++arena.allocations;
+  arena.bytesInUse += size;
+  arena.peakBytes = std::max(arena.peakBytes, arena.bytesInUse);
+  return result;
+}
+
+/** \internal Frees \a size bytes allocated by ei_workspace_arena_alloc(). Once the arena is not in use anymore,
+  * its buffer is enlarged such that the largest set of workspaces seen so far fits in it.
+  */
+inline void ei_workspace_arena_free(void* ptr, size_t size)
+{
+  ei_workspace_arena_state& arena = ei_workspace_arena();
+  size = (size + 15) & ~size_t(15);
+  unsigned char* data = static_cast<unsigned char*>(ptr);
+  if(data >= arena.buffer && data < arena.buffer + arena.capacity)
+  {
+    arena.bufferBytesInUse -= size;
+    if(arena.bufferBytesInUse == 0)
+      arena.used = 0;
+    else if(data + size == arena.buffer + arena.used)
+      arena.used -= size;
+  }
+  else
+    ei_aligned_free(ptr);
+  arena.bytesInUse -= size;
+  if(arena.bytesInUse == 0 && arena.peakBytes > arena.capacity && !arena.userBuffer)
+    ei_workspace_arena_grow(arena, arena.peakBytes);
+}
+
+/** \class WorkspaceArena
+  *
+  * \brief Per-thread buffer from which %Eigen draws its internal workspaces
+  *
+  * When EIGEN_USE_WORKSPACE_ARENA is defined, the temporary buffers which %Eigen allocates internally and which
+  * are too large for the stack, e.g., the packed blocks of the matrix products, are carved out of a buffer owned
+  * by the calling thread instead of being allocated on the heap. This buffer grows to the largest amount of
+  * workspace used at once, so that repeating the same computations does not allocate anymore.
+  * Together with EIGEN_RUNTIME_NO_MALLOC, this allows to check that a real-time loop does not use the heap.
+  *
+  * All the functions of this class apply to the arena of the calling thread. The workspaces of the matrix
+  * products which are parallelized with OpenMP are all taken from the arena of the calling thread.
+  */
+class WorkspaceArena
+{
+  public:
+    /** Makes sure that \a bytes of workspace can be used without heap allocation. The arena must not be in use. */
+    static void reserve(size_t bytes)
+    {
+      ei_workspace_arena_state& arena = ei_workspace_arena();
+      if(bytes > arena.capacity)
+        ei_workspace_arena_grow(arena, bytes);
+    }
+
+    /** Carves the workspaces out of the \a bytes pointed to by \a data, which must be 16-byte aligned and remain
+      * valid until release() or another call to setBuffer(). This buffer is never enlarged: the workspaces
+      * which do not fit in it are allocated on the heap. The arena must not be in use.
+      */
+    static void setBuffer(void* data, size_t bytes)
+    {
+      ei_workspace_arena_state& arena = ei_workspace_arena();
+      ei_assert(arena.used == 0 && "the workspace arena cannot be resized while in use");
+      ei_assert((size_t(data) & 15) == 0 && "the buffer of the workspace arena must be 16-byte aligned");
+      if(!arena.userBuffer)
+        ei_aligned_free(arena.buffer);
+      arena.buffer = static_cast<unsigned char*>(data);
+      arena.capacity = bytes;
+      arena.userBuffer = true;
+    }
+
+    /** Frees the buffer, or forgets it if it was set by setBuffer(). The arena must not be in use. */
+    static void release()
+    {
+      ei_workspace_arena_state& arena = ei_workspace_arena();
+      ei_assert(arena.used == 0 && "the workspace arena cannot be released while in use");
+      if(!arena.userBuffer)
+        ei_aligned_free(arena.buffer);
+      arena.buffer = 0;
+      arena.capacity = 0;
+      arena.userBuffer = false;
+    }
+
+    /** \returns the size in bytes of the buffer */
+    static size_t capacity() { return ei_workspace_arena().capacity; }
+
+    /** \returns the largest number of bytes of workspace used at once since the last call to resetStatistics() */
+    static size_t peakBytes() { return ei_workspace_arena().peakBytes; }
+
+    /** \returns the number of workspaces allocated since the last call to resetStatistics() */
+    static size_t allocationCount() { return ei_workspace_arena().allocations; }
+
+    /** \returns the number of heap allocations made since the last call to resetStatistics(), either for workspaces
+      * which did not fit in the buffer, or to enlarge the buffer.
+      */
+    static size_t heapAllocationCount() { return ei_workspace_arena().heapAllocations; }
+
+    /** Resets the statistics returned by peakBytes(), allocationCount() and heapAllocationCount(). */
+    static void resetStatistics()
+    {
+      ei_workspace_arena_state& arena = ei_workspace_arena();
+      arena.peakBytes = arena.bytesInUse;
+      arena.allocations = 0;
+      arena.heapAllocations = 0;
+    }
+};
+
+#endif // EIGEN_USE_WORKSPACE_ARENA
+
 /*****************************************************************************
 *** Implementation of runtime stack allocation (falling back to malloc)    ***
 *****************************************************************************/
@@ -415,7 +618,8 @@ inline static Integer ei_first_aligned(const Scalar* array, Integer size)
 /** \internal
   * Allocates an aligned buffer of SIZE bytes on the stack if SIZE is smaller than
   * EIGEN_STACK_ALLOCATION_LIMIT, and if stack allocation is supported by the platform
-  * (currently, this is Linux only). Otherwise the memory is allocated on the heap.
+  * (currently, this is Linux only). Otherwise the memory is allocated on the heap, or
+  * taken from the WorkspaceArena of the calling thread if EIGEN_USE_WORKSPACE_ARENA is defined.
   * Data allocated with ei_aligned_stack_alloc \b must be freed by calling
   * ei_aligned_stack_free(PTR,SIZE).
   * \code
@@ -424,19 +628,27 @@ inline static Integer ei_first_aligned(const Scalar* array, Integer size)
   * ei_aligned_stack_free(data,float,array.size());
   * \endcode
   */
+#ifdef EIGEN_USE_WORKSPACE_ARENA
+  #define ei_aligned_stack_heap_alloc(SIZE) ei_workspace_arena_alloc(SIZE)
+  #define ei_aligned_stack_heap_free(PTR,SIZE) ei_workspace_arena_free(PTR,SIZE)
+#else
+  #define ei_aligned_stack_heap_alloc(SIZE) ei_aligned_malloc(SIZE)
+  #define ei_aligned_stack_heap_free(PTR,SIZE) ei_aligned_free(PTR)
+#endif
+
 #if (defined __linux__)
   #define ei_aligned_stack_alloc(SIZE) (SIZE<=EIGEN_STACK_ALLOCATION_LIMIT) \
                                     ? alloca(SIZE) \
-                                    : ei_aligned_malloc(SIZE)
-  #define ei_aligned_stack_free(PTR,SIZE) if(SIZE>EIGEN_STACK_ALLOCATION_LIMIT) ei_aligned_free(PTR)
+                                    : ei_aligned_stack_heap_alloc(SIZE)
+  #define ei_aligned_stack_free(PTR,SIZE) if(SIZE>EIGEN_STACK_ALLOCATION_LIMIT) ei_aligned_stack_heap_free(PTR,SIZE)
 #elif defined(_MSC_VER)
   #define ei_aligned_stack_alloc(SIZE) (SIZE<=EIGEN_STACK_ALLOCATION_LIMIT) \
                                     ? _alloca(SIZE) \
-                                    : ei_aligned_malloc(SIZE)
-  #define ei_aligned_stack_free(PTR,SIZE) if(SIZE>EIGEN_STACK_ALLOCATION_LIMIT) ei_aligned_free(PTR)
+                                    : ei_aligned_stack_heap_alloc(SIZE)
+  #define ei_aligned_stack_free(PTR,SIZE) if(SIZE>EIGEN_STACK_ALLOCATION_LIMIT) ei_aligned_stack_heap_free(PTR,SIZE)
 #else
-  #define ei_aligned_stack_alloc(SIZE) ei_aligned_malloc(SIZE)
-  #define ei_aligned_stack_free(PTR,SIZE) ei_aligned_free(PTR)
+  #define ei_aligned_stack_alloc(SIZE) ei_aligned_stack_heap_alloc(SIZE)
+  #define ei_aligned_stack_free(PTR,SIZE) ei_aligned_stack_heap_free(PTR,SIZE)
 #endif
 
 #define ei_aligned_stack_new(TYPE,SIZE) ei_construct_elements_of_array(reinterpret_cast<TYPE*>(ei_aligned_stack_alloc(sizeof(TYPE)*SIZE)), SIZE)
@@ -182,6 +182,24 @@ template<typename T> struct ei_scalar_product_traits<std::complex<T>, T>
   typedef std::complex<T> ReturnType;
 };
 
+/** \internal determines whether the product of two matrices of scalar types \a T and \a U
+  * is a quantized product, see ei_quantized_matrix_matrix_product */
+template<typename T, typename U> struct ei_is_quantized_product
+{ enum { ret = false }; };
+
+// the products of 8 and 16 bit integers of different types are accumulated in int
+#define EIGEN_MAKE_QUANTIZED_PRODUCT_TRAITS(T,U) \
+  template<> struct ei_scalar_product_traits<T,U> { typedef int ReturnType; }; \
+  template<> struct ei_scalar_product_traits<U,T> { typedef int ReturnType; }; \
+  template<> struct ei_is_quantized_product<T,U> { enum { ret = true }; }; \
+  template<> struct ei_is_quantized_product<U,T> { enum { ret = true }; };
+
+EIGEN_MAKE_QUANTIZED_PRODUCT_TRAITS(unsigned char, signed char)
+EIGEN_MAKE_QUANTIZED_PRODUCT_TRAITS(unsigned char, short)
+EIGEN_MAKE_QUANTIZED_PRODUCT_TRAITS(signed char, short)
+
+#undef EIGEN_MAKE_QUANTIZED_PRODUCT_TRAITS
+
 // FIXME quick workaround around current limitation of ei_result_of
 template<typename Scalar, typename ArgType0, typename ArgType1>
 struct ei_result_of<ei_scalar_product_op<Scalar>(ArgType0,ArgType1)> {
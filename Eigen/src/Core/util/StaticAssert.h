@@ -99,7 +99,7 @@
     #else
 
       #define EIGEN_STATIC_ASSERT(CONDITION,MSG) \
-        if (Eigen::ei_static_assert<CONDITION ? true : false>::MSG) {}
+        if (Eigen::ei_static_assert<CONDITION ? true : false>::MSG!=0) {}
 
     #endif
 
@@ -0,0 +1,235 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_PARTIALSELFADJOINTEIGENSOLVER_H
+#define EIGEN_PARTIALSELFADJOINTEIGENSOLVER_H
+
+/** \eigenvalues_module \ingroup Eigenvalues_Module
+  * \nonstableyet
+  *
+  * \class PartialSelfAdjointEigenSolver
+  *
+  * \brief Computes the largest eigenvalues and eigenvectors of a large selfadjoint matrix
+  *
+  * \param MatrixType the type of the selfadjoint matrix. It can be a dense Matrix or a
+  *                   SparseMatrix: the matrix is only accessed through matrix-vector products,
+  *                   and hence both its lower and upper triangular parts must be stored.
+  *
+  * Contrary to SelfAdjointEigenSolver, which always computes the full eigen decomposition
+  * at a cost of \f$ O(n^3) \f$, this class only computes the \a k largest eigenvalues of a
+  * \a n x \a n selfadjoint matrix, and the corresponding eigenvectors, in about \f$ O(nk) \f$
+  * matrix-vector products plus \f$ O(nk^2) \f$ operations per restart.
+  *
+  * The eigenpairs are approximated by the Ritz pairs of a Krylov subspace of dimension about
+  * \a 2k, built by the Lanczos algorithm with full reorthogonalization. When some of the
+  * wanted Ritz pairs have not converged yet, the Krylov subspace is thick restarted from the
+  * best Ritz vectors.
+  *
+  * Implemented from Wu and Simon's "Thick-restart Lanczos method for large symmetric
+  * eigenvalue problems", SIAM J. Matrix Anal. Appl. 22 (2000).
+  *
+  * \sa class SelfAdjointEigenSolver, class RandomizedSVD
+  */
+template<typename _MatrixType> class PartialSelfAdjointEigenSolver
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Matrix<Scalar,Dynamic,Dynamic> EigenvectorsType;
+    typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+    PartialSelfAdjointEigenSolver()
+      : m_maxIterations(1000), m_iterations(0), m_converged(false), m_isInitialized(false), m_eigenvectorsOk(false)
+    {}
+
+    /** Constructor computing the \a nbEigenvalues largest eigenvalues of the selfadjoint
+      * matrix \a matrix, as well as the eigenvectors if \a computeEigenvectors is true.
+      *
+      * \sa compute()
+      */
+    PartialSelfAdjointEigenSolver(const MatrixType& matrix, int nbEigenvalues, bool computeEigenvectors = true)
+      : m_maxIterations(1000), m_iterations(0), m_converged(false), m_isInitialized(false), m_eigenvectorsOk(false)
+    {
+      compute(matrix, nbEigenvalues, computeEigenvectors);
+    }
+
+    PartialSelfAdjointEigenSolver& compute(const MatrixType& matrix, int nbEigenvalues, bool computeEigenvectors = true);
+
+    /** Sets the maximal number of restarts of the Lanczos iterations (1000 by default). */
+    PartialSelfAdjointEigenSolver& setMaxIterations(int maxIterations)
+    {
+      ei_assert(maxIterations > 0);
+      m_maxIterations = maxIterations;
+      return *this;
+    }
+
+    /** \returns the computed eigenvectors as a \a n x \a k matrix of column vectors */
+    const EigenvectorsType& eigenvectors() const
+    {
+      ei_assert(m_isInitialized && "PartialSelfAdjointEigenSolver is not initialized.");
+      ei_assert(m_eigenvectorsOk && "The eigenvectors have not been computed.");
+      return m_eivec;
+    }
+
+    /** \returns the \a k largest eigenvalues, sorted in increasing order as in SelfAdjointEigenSolver */
+    const RealVectorType& eigenvalues() const
+    {
+      ei_assert(m_isInitialized && "PartialSelfAdjointEigenSolver is not initialized.");
+      return m_eivalues;
+    }
+
+    /** \returns whether all the requested eigenpairs converged within the maximal number of iterations */
+    bool converged() const
+    {
+      ei_assert(m_isInitialized && "PartialSelfAdjointEigenSolver is not initialized.");
+      return m_converged;
+    }
+
+    /** \returns the number of restarts of the Lanczos iterations performed by the last call to compute() */
+    int iterations() const
+    {
+      ei_assert(m_isInitialized && "PartialSelfAdjointEigenSolver is not initialized.");
+      return m_iterations;
+    }
+
+  protected:
+    EigenvectorsType m_eivec;
+    RealVectorType m_eivalues;
+    int m_maxIterations;
+    int m_iterations;
+    bool m_converged;
+    bool m_isInitialized;
+    bool m_eigenvectorsOk;
+};
+
+#ifndef EIGEN_HIDE_HEAVY_CODE
+
+template<typename MatrixType>
+PartialSelfAdjointEigenSolver<MatrixType>&
+PartialSelfAdjointEigenSolver<MatrixType>::compute(const MatrixType& matrix, int nbEigenvalues, bool computeEigenvectors)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> WorkVectorType;
+
+  const int n = matrix.rows();
+  const int k = nbEigenvalues;
+  ei_assert(matrix.cols() == n && k >= 0 && k <= n);
+
+  m_isInitialized = true;
+  m_eigenvectorsOk = computeEigenvectors;
+  m_iterations = 0;
+  m_converged = true;
+  m_eivalues.resize(k);
+  if (computeEigenvectors)
+    m_eivec.resize(n, k);
+  if (k==0)
+    return *this;
+
+  // dimension of the Krylov subspace, and number of Ritz vectors kept at restarts
+  const int m = std::min(n, std::max(2*k+1, k+20));
+  const int keep = std::min(k + (m-k)/2, m-1);
+  const RealScalar tol = NumTraits<RealScalar>::dummy_precision();
+
+  WorkMatrixType basis(n, m+1);
+  WorkMatrixType projected = WorkMatrixType::Zero(m, m);
+  WorkVectorType w(n), h(m);
+  SelfAdjointEigenSolver<WorkMatrixType> ritz(m);
+
+  basis.col(0) = WorkVectorType::Random(n).normalized();
+  RealScalar normEstimate = 0;
+  int start = 0;
+  for (;;)
+  {
+    // extend the Lanczos factorization A V_j = V_j H_j + w e_j^* up to j = m
+    RealScalar beta = 0;
+    for (int j = start; j < m; ++j)
+    {
+      w.noalias() = matrix * basis.col(j);
+      normEstimate = std::max(normEstimate, w.norm());
+
+      // full reorthogonalization against the current basis, twice is enough
+      h.head(j+1).noalias() = basis.leftCols(j+1).adjoint() * w;
+      w.noalias() -= basis.leftCols(j+1) * h.head(j+1);
+      projected.row(j).head(j+1) = h.head(j+1).adjoint();
+      RealScalar firstNorm = w.norm();
+      h.head(j+1).noalias() = basis.leftCols(j+1).adjoint() * w;
+      w.noalias() -= basis.leftCols(j+1) * h.head(j+1);
+      projected.row(j).head(j+1) += h.head(j+1).adjoint();
+      beta = w.norm();
+
+      if (beta > RealScalar(0.5) * firstNorm && beta > RealScalar(0))
+        basis.col(j+1) = w / beta;
+      else
+      {
+        // the Krylov subspace is invariant: continue with a random vector orthogonal to it
+        beta = 0;
+        if (j+1 < m)
+        {
+          w = WorkVectorType::Random(n);
+          for (int pass = 0; pass < 2; ++pass)
+          {
+            h.head(j+1).noalias() = basis.leftCols(j+1).adjoint() * w;
+            w.noalias() -= basis.leftCols(j+1) * h.head(j+1);
+          }
+          basis.col(j+1) = w.normalized();
+        }
+        else
+          basis.col(j+1).setZero();
+      }
+    }
+
+    // Ritz pairs, the largest ones being the last
+    ritz.compute(projected);
+    const RealVectorType& theta = ritz.eigenvalues();
+    const WorkMatrixType& y = ritz.eigenvectors();
+
+    // the residual of the Ritz pair (theta_i, V y_i) is |beta y_i(m-1)|
+    bool converged = true;
+    for (int i = m-k; i < m && converged; ++i)
+      converged = ei_abs(beta * y.coeff(m-1,i)) <= tol * normEstimate;
+
+    if (converged || m_iterations == m_maxIterations)
+    {
+      m_converged = converged;
+      m_eivalues = theta.tail(k);
+      if (computeEigenvectors)
+        m_eivec.noalias() = basis.leftCols(m) * y.rightCols(k);
+      return *this;
+    }
+
+    // thick restart from the largest Ritz vectors, A V_keep = V_keep diag(theta) + w s^*
+    ++m_iterations;
+    WorkMatrixType ritzVectors(n, keep);
+    ritzVectors.noalias() = basis.leftCols(m) * y.rightCols(keep);
+    basis.leftCols(keep) = ritzVectors;
+    basis.col(keep) = basis.col(m);
+    projected.setZero();
+    projected.diagonal().head(keep) = theta.tail(keep).template cast<Scalar>();
+    start = keep;
+  }
+}
+
+#endif // EIGEN_HIDE_HEAVY_CODE
+
+#endif // EIGEN_PARTIALSELFADJOINTEIGENSOLVER_H
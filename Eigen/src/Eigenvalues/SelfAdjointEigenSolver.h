@@ -165,6 +165,39 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
 template<typename RealScalar, typename Scalar>
 static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, int start, int end, Scalar* matrixQ, int n);
 
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Diagonalizes the symmetric tridiagonal matrix represented by \a diag and \a subdiag
+  * using implicit QR steps. The rotations are accumulated into the \a n x \a n matrix
+  * \a matrixQ if it is not null. The eigenvalues are returned unsorted in \a diag.
+  */
+template<typename RealScalar, typename Scalar>
+static void ei_tridiagonal_qr(RealScalar* diag, RealScalar* subdiag, int n, Scalar* matrixQ);
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Computes the eigen decomposition \f$ T = Z D Z^T \f$ of the symmetric tridiagonal
+  * matrix \f$ T \f$ of size \a n represented by \a diag and \a subdiag using Cuppen's
+  * divide-and-conquer algorithm. On return \a diag contains the eigenvalues in increasing
+  * order and \a matrixZ (a column major \a n x \a n matrix) the corresponding eigenvectors.
+  * The content of \a subdiag is destroyed.
+  *
+  * The matrix is recursively torn into independent halves by rank one modifications until
+  * the blocks are smaller than EIGEN_TUNE_TRIDIAGONAL_DC_THRESHOLD, which are diagonalized
+  * with ei_tridiagonal_qr(). The blocks are then merged back by solving secular equations,
+  * the eigenvectors being updated with a matrix-matrix product. Independent sub-problems
+  * are processed in parallel when OpenMP is enabled.
+  *
+  * Implemented from Gu and Eisenstat's "A divide-and-conquer algorithm for the symmetric
+  * tridiagonal eigenproblem", SIAM J. Matrix Anal. Appl. 16 (1995), and LAPACK's xSTEDC.
+  */
+template<typename RealScalar>
+static void ei_tridiagonal_divide_and_conquer(RealScalar* diag, RealScalar* subdiag, int n, RealScalar* matrixZ);
+
 /** Computes the eigenvalues of the selfadjoint matrix \a matrix,
   * as well as the eigenvectors if \a computeEigenvectors is true.
   *
@@ -197,26 +230,18 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>::compute(
   m_subdiag.resize(n-1);
   TridiagonalizationType::decomposeInPlace(m_eivec, diag, m_subdiag, computeEigenvectors);
 
-  int end = n-1;
-  int start = 0;
-  while (end>0)
+  if (computeEigenvectors && n>EIGEN_TUNE_TRIDIAGONAL_DC_THRESHOLD)
   {
-    for (int i = start; i<end; ++i)
-      if (ei_isMuchSmallerThan(ei_abs(m_subdiag[i]),(ei_abs(diag[i])+ei_abs(diag[i+1]))))
-        m_subdiag[i] = 0;
-
-    // find the largest unreduced block
-    while (end>0 && m_subdiag[end-1]==0)
-      end--;
-    if (end<=0)
-      break;
-    start = end - 1;
-    while (start>0 && m_subdiag[start-1]!=0)
-      start--;
-
-    ei_tridiagonal_qr_step(diag.data(), m_subdiag.data(), start, end, computeEigenvectors ? m_eivec.data() : (Scalar*)0, n);
+    // the eigenvectors of the tridiagonal matrix are computed apart, and then
+    // applied to the orthogonal matrix of the tridiagonalization at once
+    Matrix<RealScalar,Size,Size,Options & ~RowMajor,MaxColsAtCompileTime,MaxColsAtCompileTime> matZ(n,n);
+    ei_tridiagonal_divide_and_conquer(diag.data(), m_subdiag.data(), n, matZ.data());
+    m_eivec = m_eivec * matZ.template cast<Scalar>();
+    return *this;
   }
 
+  ei_tridiagonal_qr(diag.data(), m_subdiag.data(), n, computeEigenvectors ? m_eivec.data() : (Scalar*)0);
+
   // Sort eigenvalues and corresponding vectors.
   // TODO make the sort optional ?
   // TODO use a better sort algorithm !!
@@ -373,6 +398,357 @@ static void ei_tridiagonal_qr_step(RealScalar* diag, RealScalar* subdiag, int st
     }
   }
 }
+
+template<typename RealScalar, typename Scalar>
+static void ei_tridiagonal_qr(RealScalar* diag, RealScalar* subdiag, int n, Scalar* matrixQ)
+{
+  int end = n-1;
+  int start = 0;
+  while (end>0)
+  {
+    for (int i = start; i<end; ++i)
+      if (ei_isMuchSmallerThan(ei_abs(subdiag[i]),(ei_abs(diag[i])+ei_abs(diag[i+1]))))
+        subdiag[i] = 0;
+
+    // find the largest unreduced block
+    while (end>0 && subdiag[end-1]==0)
+      end--;
+    if (end<=0)
+      break;
+    start = end - 1;
+    while (start>0 && subdiag[start-1]!=0)
+      start--;
+
+    ei_tridiagonal_qr_step(diag, subdiag, start, end, matrixQ, n);
+  }
+}
+
+/** \internal
+  * Diagonalizes the independent block of size \a size starting at \a start with QR iterations,
+  * sorts its eigenvalues, and stores its eigenvectors in the respective diagonal block of \a matZ.
+  */
+template<typename RealScalar>
+static void ei_tridiagonal_dc_leaf(RealScalar* diag, RealScalar* subdiag, int start, int size, Map<Matrix<RealScalar,Dynamic,Dynamic> >& matZ)
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> RealMatrix;
+  RealMatrix q = RealMatrix::Identity(size,size);
+  ei_tridiagonal_qr(diag+start, subdiag+start, size, q.data());
+
+  RealScalar* d = diag+start;
+  for (int i = 0; i < size-1; ++i)
+  {
+    int k;
+    Map<Matrix<RealScalar,Dynamic,1> >(d+i, size-i).minCoeff(&k);
+    if (k > 0)
+    {
+      std::swap(d[i], d[k+i]);
+      q.col(i).swap(q.col(k+i));
+    }
+  }
+  matZ.block(start,start,size,size) = q;
+}
+
+/** \internal
+  * Gives the differences \f$ d_j - d_o \f$ between the poles \a d of a secular equation.
+  */
+template<typename RealScalar> struct ei_secular_poles
+{
+  ei_secular_poles(const RealScalar* d) : m_d(d) {}
+  RealScalar operator()(int j, int o) const { return m_d[j]-m_d[o]; }
+  const RealScalar* m_d;
+};
+
+/** \internal
+  * Returns the \a i -th root of the secular equation
+  *   \f$ 1 + \rho \sum_j z_j^2 / (d_j - \lambda) = 0 \f$
+  * where the \a k poles \f$ d \f$ are sorted in increasing order and \a rho is positive.
+  * The poles are only accessed through their differences \a poles(j,o) \f$ = d_j - d_o \f$,
+  * see ei_secular_poles. In order to preserve the relative accuracy of the gaps between the
+  * root and the poles, the root is returned as an offset from the closest pole \f$ d_{*origin} \f$.
+  */
+template<typename RealScalar, typename Poles>
+static RealScalar ei_secular_equation_root(const Poles& poles, const RealScalar* z, int k, RealScalar rho, int i, int* origin)
+{
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  RealScalar lo, hi;
+  int o;
+  if (i<k-1)
+  {
+    // find out which half of ]d_i,d_i+1[ contains the root
+    RealScalar mid = poles(i+1,i)/RealScalar(2);
+    RealScalar f = 1;
+    for (int j = 0; j<k; ++j)
+      f += rho * z[j]*z[j] / (poles(j,i) - mid);
+    if (f>=0) { o = i;   lo = 0;    hi = mid; }
+    else      { o = i+1; lo = -mid; hi = 0;   }
+  }
+  else
+  {
+    // the last root lies in ]d_k-1, d_k-1 + rho * z^T z]
+    o = k-1;
+    lo = 0;
+    hi = rho * Map<Matrix<RealScalar,Dynamic,1> >(const_cast<RealScalar*>(z),k).squaredNorm();
+  }
+
+  // Safeguarded iterations approximating separately the parts of the secular function
+  // having their poles on the left and on the right of the root by simple rational
+  // functions, as in Bunch, Nielsen and Sorensen's method. Steps falling outside the
+  // current bracket are replaced by bisection steps.
+  RealScalar tau = (lo+hi)/RealScalar(2);
+  for (int iter = 0; iter<100; ++iter)
+  {
+    RealScalar psi = 0, dpsi = 0, phi = 0, dphi = 0;
+    for (int j = 0; j<=i; ++j)
+    {
+      RealScalar t = z[j] / (poles(j,o) - tau);
+      psi += z[j]*t;
+      dpsi += t*t;
+    }
+    for (int j = i+1; j<k; ++j)
+    {
+      RealScalar t = z[j] / (poles(j,o) - tau);
+      phi += z[j]*t;
+      dphi += t*t;
+    }
+    RealScalar f = RealScalar(1) + rho*(psi+phi);
+    if (f<0) lo = tau;
+    else     hi = tau;
+    if (ei_abs(f) <= RealScalar(8)*k*eps*(RealScalar(1) + rho*(ei_abs(psi)+ei_abs(phi)))
+     || hi-lo <= RealScalar(2)*eps*std::max(ei_abs(lo),ei_abs(hi)))
+      break;
+
+    // poles relative to the current iterate
+    RealScalar a = poles(i,o) - tau;
+    RealScalar A = rho*dpsi*a*a;
+    RealScalar h;
+    bool ok = false;
+    if (i<k-1)
+    {
+      RealScalar b = poles(i+1,o) - tau;
+      RealScalar B = rho*dphi*b*b;
+      RealScalar C = f - A/a - B/b;
+      // roots of C (a-h)(b-h) + A (b-h) + B (a-h) = 0
+      RealScalar qb = C*(a+b) + A + B;
+      RealScalar qc = a*b*f;
+      RealScalar disc = qb*qb - RealScalar(4)*C*qc;
+      if (disc>=0)
+      {
+        RealScalar q = (qb + (qb<0 ? -ei_sqrt(disc) : ei_sqrt(disc))) / RealScalar(2);
+        if (q!=0)
+        {
+          h = qc/q;
+          ok = h>a && h<b;
+          if (!ok && C!=0)
+          {
+            h = q/C;
+            ok = h>a && h<b;
+          }
+        }
+      }
+    }
+    else
+    {
+      // C + A/(a-h) = 0
+      RealScalar C = f - A/a;
+      if (C>0)
+      {
+        h = a + A/C;
+        ok = true;
+      }
+    }
+    RealScalar next = ok ? tau+h : lo;
+    tau = (next>lo && next<hi) ? next : (lo+hi)/RealScalar(2);
+  }
+  *origin = o;
+  return tau;
+}
+
+template<typename RealScalar> struct ei_tridiagonal_dc_compare
+{
+  ei_tridiagonal_dc_compare(const RealScalar* values) : m_values(values) {}
+  bool operator()(int a, int b) const { return m_values[a] < m_values[b]; }
+  const RealScalar* m_values;
+};
+
+/** \internal
+  * Merges the two adjacent diagonalized blocks of sizes \a n1 and \a n2 starting at \a start,
+  * which have been torn apart by removing the off-diagonal coefficient \a beta.
+  */
+template<typename RealScalar>
+static void ei_tridiagonal_dc_merge(RealScalar* diag, RealScalar beta, int start, int n1, int n2, Map<Matrix<RealScalar,Dynamic,Dynamic> >& matZ)
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> RealMatrix;
+  typedef Matrix<RealScalar,Dynamic,1> RealVector;
+  typedef Matrix<int,Dynamic,1> IntVector;
+  const int n = n1+n2;
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  Block<Map<RealMatrix> > q(matZ, start, start, n, n);
+  RealScalar* d = diag+start;
+
+  // the rank one modification in the basis of the two blocks
+  RealVector z(n);
+  z.head(n1) = q.row(n1-1).head(n1).transpose();
+  z.tail(n2) = q.row(n1).tail(n2).transpose();
+  if (beta<0)
+    z.tail(n2) = -z.tail(n2);
+  RealScalar rho = ei_abs(beta) * z.squaredNorm();
+  z.normalize();
+
+  // merge the two sorted sets of eigenvalues
+  IntVector perm(n);
+  for (int i = 0, i1 = 0, i2 = n1; i<n; ++i)
+    perm[i] = (i2==n || (i1<n1 && d[i1]<=d[i2])) ? i1++ : i2++;
+  RealVector dp(n), zp(n);
+  RealMatrix qp(n,n);
+  for (int i = 0; i<n; ++i)
+  {
+    dp[i] = d[perm[i]];
+    zp[i] = z[perm[i]];
+    qp.col(i) = q.col(perm[i]);
+  }
+
+  // deflation: eigenpairs with a negligible component in z, or a pole too close to the
+  // previous one are kept as is, the latter after a rotation zeroing its z component
+  RealScalar tol = RealScalar(8)*eps*std::max(dp.cwiseAbs().maxCoeff(), rho*zp.cwiseAbs().maxCoeff());
+  IntVector kept(n), deflated(n);
+  int k = 0, nbDeflated = 0, prev = -1;
+  for (int j = 0; j<n; ++j)
+  {
+    if (rho*ei_abs(zp[j]) <= tol)
+    {
+      deflated[nbDeflated++] = j;
+      continue;
+    }
+    if (prev>=0)
+    {
+      RealScalar tau = ei_hypot(zp[prev], zp[j]);
+      RealScalar c = zp[j]/tau;
+      RealScalar s = zp[prev]/tau;
+      if (ei_abs(c*s*(dp[j]-dp[prev])) <= tol)
+      {
+        zp[j] = tau;
+        zp[prev] = 0;
+        qp.applyOnTheRight(prev, j, PlanarRotation<RealScalar>(c,s));
+        RealScalar t = c*c*dp[prev] + s*s*dp[j];
+        dp[j] = s*s*dp[prev] + c*c*dp[j];
+        dp[prev] = t;
+        deflated[nbDeflated++] = prev;
+      }
+      else
+        kept[k++] = prev;
+    }
+    prev = j;
+  }
+  if (prev>=0)
+    kept[k++] = prev;
+
+  RealVector values(n);
+  RealMatrix vectors(n,n);
+  if (k>0)
+  {
+    RealVector dk(k), zk(k);
+    RealMatrix qk(n,k);
+    for (int i = 0; i<k; ++i)
+    {
+      dk[i] = dp[kept[i]];
+      zk[i] = zp[kept[i]];
+      qk.col(i) = qp.col(kept[i]);
+    }
+
+    IntVector origin(k);
+    RealVector tau(k);
+    for (int i = 0; i<k; ++i)
+    {
+      tau[i] = ei_secular_equation_root(ei_secular_poles<RealScalar>(dk.data()), zk.data(), k, rho, i, &origin.coeffRef(i));
+      values[i] = dk[origin[i]] + tau[i];
+    }
+
+    // recompute z from the computed roots (Loewner's formula) such that the
+    // eigenvectors are numerically orthogonal
+    for (int j = 0; j<k; ++j)
+    {
+      RealScalar w = (tau[j] - (dk[j]-dk[origin[j]])) / rho;
+      for (int i = 0; i<k; ++i)
+        if (i!=j)
+          w *= (tau[i] - (dk[j]-dk[origin[i]])) / (dk[i]-dk[j]);
+      zk[j] = zk[j]<0 ? -ei_sqrt(ei_abs(w)) : ei_sqrt(ei_abs(w));
+    }
+
+    RealMatrix u(k,k);
+    for (int i = 0; i<k; ++i)
+    {
+      for (int j = 0; j<k; ++j)
+        u(j,i) = zk[j] / ((dk[j]-dk[origin[i]]) - tau[i]);
+      u.col(i).normalize();
+    }
+    vectors.leftCols(k).noalias() = qk * u;
+  }
+  for (int i = 0; i<nbDeflated; ++i)
+  {
+    values[k+i] = dp[deflated[i]];
+    vectors.col(k+i) = qp.col(deflated[i]);
+  }
+
+  // sort the eigenpairs
+  for (int i = 0; i<n; ++i)
+    perm[i] = i;
+  std::sort(perm.data(), perm.data()+n, ei_tridiagonal_dc_compare<RealScalar>(values.data()));
+  for (int i = 0; i<n; ++i)
+  {
+    d[i] = values[perm[i]];
+    q.col(i) = vectors.col(perm[i]);
+  }
+}
+
+template<typename RealScalar>
+static void ei_tridiagonal_divide_and_conquer(RealScalar* diag, RealScalar* subdiag, int n, RealScalar* matrixZ)
+{
+  Map<Matrix<RealScalar,Dynamic,Dynamic> > z(matrixZ,n,n);
+  z.setZero();
+
+  // recursively split the matrix into 2^levels blocks of (almost) equal sizes
+  int levels = 0;
+  while (((n-1)>>levels)+1 > EIGEN_TUNE_TRIDIAGONAL_DC_THRESHOLD)
+    ++levels;
+  const int leaves = 1<<levels;
+  Matrix<int,Dynamic,1> bounds(leaves+1);
+  bounds[0] = 0;
+  bounds[leaves] = n;
+  for (int step = leaves; step>1; step/=2)
+    for (int j = 0; j<leaves; j+=step)
+      bounds[j+step/2] = bounds[j] + (bounds[j+step]-bounds[j])/2;
+
+  // tear the blocks apart: T = diag(T1,T2) + |beta| u u^T with u = (0,...,0,1,sign(beta),0,...,0)
+  for (int i = 1; i<leaves; ++i)
+  {
+    RealScalar rho = ei_abs(subdiag[bounds[i]-1]);
+    diag[bounds[i]-1] -= rho;
+    diag[bounds[i]] -= rho;
+  }
+
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for schedule(dynamic) if(leaves>1)
+  #endif
+  for (int i = 0; i<leaves; ++i)
+    ei_tridiagonal_dc_leaf(diag, subdiag, bounds[i], bounds[i+1]-bounds[i], z);
+
+  for (int level = levels-1; level>=0; --level)
+  {
+    const int nodes = 1<<level;
+    const int stride = leaves>>level;
+    // the last merge runs alone, and thus lets the matrix product use all the threads
+    #ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic) if(nodes>1)
+    #endif
+    for (int j = 0; j<nodes; ++j)
+    {
+      int start = bounds[j*stride];
+      int split = bounds[j*stride+stride/2];
+      int end   = bounds[(j+1)*stride];
+      ei_tridiagonal_dc_merge(diag, subdiag[split-1], start, split-start, end-split, z);
+    }
+  }
+}
 #endif
 
 #endif // EIGEN_SELFADJOINTEIGENSOLVER_H
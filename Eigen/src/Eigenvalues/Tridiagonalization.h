@@ -135,6 +135,8 @@ template<typename _MatrixType> class Tridiagonalization
 
   protected:
 
+    static int _computeBlocked(MatrixType& matA, CoeffVectorType& hCoeffs);
+
     static void _decomposeInPlace3x3(MatrixType& mat, DiagonalType& diag, SubDiagonalType& subdiag, bool extractQ = true);
 
     MatrixType m_matrix;
@@ -191,6 +193,7 @@ Tridiagonalization<MatrixType>::matrixT(void) const
   * The result is written in the lower triangular part of \a matA.
   *
   * Implemented from Golub's "Matrix Computations", algorithm 8.3.1.
+  * Large matrices are first reduced per panel of columns, see _computeBlocked().
   *
   * \sa packedMatrix()
   */
@@ -199,7 +202,8 @@ void Tridiagonalization<MatrixType>::_compute(MatrixType& matA, CoeffVectorType&
 {
   assert(matA.rows()==matA.cols());
   int n = matA.rows();
-  for (int i = 0; i<n-1; ++i)
+  int i = _computeBlocked(matA, hCoeffs);
+  for (; i<n-1; ++i)
   {
     int remainingSize = n-i-1;
     RealScalar beta;
@@ -223,6 +227,83 @@ void Tridiagonalization<MatrixType>::_compute(MatrixType& matA, CoeffVectorType&
   }
 }
 
+/** \internal
+  * Performs the blocked part of the tridiagonal decomposition of \a matA in place,
+  * and returns the number of columns which have been reduced. The remaining
+  * bottom-right corner is left to the unblocked algorithm of _compute().
+  *
+  * The Householder reflectors of a panel of columns are computed one after the other
+  * as in the unblocked algorithm, but the remaining part of the matrix is updated only
+  * once per panel by a selfadjoint rank 2k update \f$ A = A - V W^* - W V^* \f$,
+  * where \f$ V \f$ are the Householder vectors of the panel. Meanwhile, the pending
+  * updates are applied on the fly to the current column and to the matrix-vector
+  * products.
+  *
+  * Implemented from LAPACK's xSYTRD and xLATRD.
+  */
+template<typename MatrixType>
+int Tridiagonalization<MatrixType>::_computeBlocked(MatrixType& matA, CoeffVectorType& hCoeffs)
+{
+  const int blockSize = EIGEN_TUNE_TRIDIAGONALIZATION_BLOCK_SIZE;
+  const int unblockedSize = 4*blockSize;
+
+  int n = matA.rows();
+  if (n<=unblockedSize)
+    return 0;
+
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> WorkVectorType;
+  WorkMatrixType matW(n,blockSize);
+  WorkVectorType tmp(blockSize);
+  Matrix<RealScalar,Dynamic,1> betas(blockSize);
+
+  int i = 0;
+  for (; n-i>unblockedSize; i+=blockSize)
+  {
+    for (int j = 0; j<blockSize; ++j)
+    {
+      int k = i+j;
+      int remainingSize = n-k-1;
+
+      // apply the pending updates of the panel to the current column
+      if (j>0)
+      {
+        matA.col(k).tail(n-k).noalias() -= matA.block(k,i,n-k,j) * matW.block(k,0,1,j).adjoint();
+        matA.col(k).tail(n-k).noalias() -= matW.block(k,0,n-k,j) * matA.block(k,i,1,j).adjoint();
+      }
+
+      Scalar h;
+      matA.col(k).tail(remainingSize).makeHouseholderInPlace(h, betas.coeffRef(j));
+      // the unit coefficient of the Householder vector is kept until the end of the panel
+      matA.col(k).coeffRef(k+1) = 1;
+      hCoeffs.coeffRef(k) = h;
+
+      // w = conj(h) * (A - V W^* - W V^*) v
+      Block<WorkMatrixType,Dynamic,1> w(matW, k+1, j, remainingSize, 1);
+      w.noalias() = matA.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>()
+                  * matA.col(k).tail(remainingSize);
+      if (j>0)
+      {
+        tmp.head(j).noalias() = matW.block(k+1,0,remainingSize,j).adjoint() * matA.col(k).tail(remainingSize);
+        w.noalias() -= matA.block(k+1,i,remainingSize,j) * tmp.head(j);
+        tmp.head(j).noalias() = matA.block(k+1,i,remainingSize,j).adjoint() * matA.col(k).tail(remainingSize);
+        w.noalias() -= matW.block(k+1,0,remainingSize,j) * tmp.head(j);
+      }
+      w *= ei_conj(h);
+      w += (ei_conj(h)*Scalar(-0.5)*(w.dot(matA.col(k).tail(remainingSize)))) * matA.col(k).tail(remainingSize);
+    }
+
+    // update of the trailing matrix: A = A - V W^* - W V^*
+    int trailingSize = n-i-blockSize;
+    matA.bottomRightCorner(trailingSize,trailingSize).template selfadjointView<Lower>()
+      .rankUpdate(matA.block(i+blockSize,i,trailingSize,blockSize), matW.block(i+blockSize,0,trailingSize,blockSize), -1);
+
+    for (int j = 0; j<blockSize; ++j)
+      matA.coeffRef(i+j+1,i+j) = betas.coeff(j);
+  }
+  return i;
+}
+
 /** reconstructs and returns the matrix Q */
 template<typename MatrixType>
 typename Tridiagonalization<MatrixType>::MatrixType
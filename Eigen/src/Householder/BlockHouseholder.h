@@ -0,0 +1,109 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_BLOCK_HOUSEHOLDER_H
+#define EIGEN_BLOCK_HOUSEHOLDER_H
+
+/** \internal
+  * Computes the upper triangular factor \a triFactor of the block reflector
+  * \f$ H = H_0 H_1 \cdots H_{k-1} = I - V T V^* \f$, where \f$ H_i = I - h_i v_i v_i^* \f$,
+  * the \a k columns of \a vectors are the Householder vectors \f$ v_i \f$, including their
+  * unit coefficient and the zeros above it, and \a hCoeffs are the coefficients \f$ h_i \f$.
+  *
+  * Implemented from LAPACK's xLARFT.
+  */
+template<typename TriangularFactorType, typename VectorsType, typename CoeffsType>
+void ei_make_block_householder_triangular_factor(TriangularFactorType& triFactor, const VectorsType& vectors, const CoeffsType& hCoeffs)
+{
+  typedef typename TriangularFactorType::Scalar Scalar;
+  const int rows = vectors.rows();
+  const int nbVecs = vectors.cols();
+  ei_assert(triFactor.rows() == nbVecs && triFactor.cols() == nbVecs && hCoeffs.size() >= nbVecs);
+
+  Matrix<Scalar,Dynamic,1> tmp(nbVecs);
+  for (int i = 0; i < nbVecs; ++i)
+  {
+    triFactor.coeffRef(i,i) = hCoeffs.coeff(i);
+    triFactor.col(i).tail(nbVecs-i-1).setZero();
+    if (i>0)
+    {
+      tmp.head(i).noalias() = vectors.block(i,0,rows-i,i).adjoint() * vectors.col(i).tail(rows-i);
+      tmp.head(i) = -hCoeffs.coeff(i) * (triFactor.topLeftCorner(i,i).template triangularView<Upper>() * tmp.head(i));
+      triFactor.col(i).head(i) = tmp.head(i);
+    }
+  }
+}
+
+/** \internal
+  * Applies the block reflector \f$ H = H_0 H_1 \cdots H_{k-1} \f$ on the left of \a mat,
+  * that is \f$ mat = (I - V T V^*) mat \f$ with matrix-matrix products only, or its adjoint
+  * \f$ H^* = I - V T^* V^* \f$ if \a forward is false.
+  * See ei_make_block_householder_triangular_factor() for the meaning of \a vectors and \a hCoeffs.
+  */
+template<typename MatrixType, typename VectorsType, typename CoeffsType>
+void ei_apply_block_householder_on_the_left(MatrixType& mat, const VectorsType& vectors, const CoeffsType& hCoeffs, bool forward = true)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  const int nbVecs = vectors.cols();
+  ei_assert(vectors.rows() == mat.rows());
+
+  Matrix<Scalar,Dynamic,Dynamic> triFactor(nbVecs,nbVecs);
+  ei_make_block_householder_triangular_factor(triFactor, vectors, hCoeffs);
+
+  Matrix<Scalar,Dynamic,Dynamic> tmp(nbVecs,mat.cols());
+  tmp.noalias() = vectors.adjoint() * mat;
+  if (forward)
+    tmp = triFactor.template triangularView<Upper>() * tmp;
+  else
+    tmp = triFactor.adjoint().template triangularView<Lower>() * tmp;
+  mat.noalias() -= vectors * tmp;
+}
+
+/** \internal
+  * Applies the product of Householder reflectors \f$ H = H_0 H_1 \cdots H_{k-1} \f$ on the left of
+  * \a mat per blocks of \a blockSize reflectors. As in HouseholderSequence, the essential parts of
+  * the Householder vectors are stored below the diagonal of \a vectors, whose diagonal and upper
+  * part are not referenced, and \a hCoeffs are the Householder coefficients.
+  */
+template<typename MatrixType, typename VectorsType, typename CoeffsType>
+void ei_apply_householder_sequence_on_the_left_by_blocks(MatrixType& mat, const VectorsType& vectors, const CoeffsType& hCoeffs, int blockSize = 32)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  const int rows = vectors.rows();
+  const int nbVecs = vectors.cols();
+  ei_assert(mat.rows() == rows);
+  if (nbVecs==0)
+    return;
+
+  Matrix<Scalar,Dynamic,Dynamic> panel;
+  for (int k = ((nbVecs-1)/blockSize)*blockSize; k>=0; k-=blockSize)
+  {
+    int bs = std::min(blockSize, nbVecs-k);
+    panel = vectors.block(k,k,rows-k,bs);
+    panel.topRows(bs).template triangularView<StrictlyUpper>().setZero();
+    panel.diagonal().setOnes();
+    Block<MatrixType,Dynamic,Dynamic> bottom(mat, k, 0, rows-k, mat.cols());
+    ei_apply_block_householder_on_the_left(bottom, panel, hCoeffs.segment(k,bs));
+  }
+}
+
+#endif // EIGEN_BLOCK_HOUSEHOLDER_H
@@ -67,6 +67,18 @@ void MatrixBase<Derived>::makeHouseholder(
   
   RealScalar tailSqNorm = size()==1 ? 0 : tail.squaredNorm();
   Scalar c0 = coeff(0);
+  RealScalar scale = RealScalar(1);
+
+  // a squared norm this small may have underflowed: recompute it on the vector scaled by its
+  // largest coefficient, so that a tiny but nonzero tail still gives a unitary reflector
+  if(size()>1 && tailSqNorm < (std::numeric_limits<RealScalar>::min)() / NumTraits<RealScalar>::epsilon())
+  {
+    scale = std::max(tail.cwiseAbs().maxCoeff(), ei_abs(c0));
+    if(scale > RealScalar(0))
+      tailSqNorm = (tail / scale).squaredNorm();
+    else
+      scale = RealScalar(1);
+  }
 
   if(tailSqNorm == RealScalar(0) && ei_imag(c0)==RealScalar(0))
   {
@@ -75,7 +87,7 @@ void MatrixBase<Derived>::makeHouseholder(
   }
   else
   {
-    beta = ei_sqrt(ei_abs2(c0) + tailSqNorm);
+    beta = scale * ei_sqrt(ei_abs2(c0 / scale) + tailSqNorm);
     if (ei_real(c0)>=0.)
       beta = -beta;
     essential = tail / (c0 - beta);
@@ -194,6 +194,96 @@ typename MatrixType::RealScalar HouseholderQR<MatrixType>::logAbsDeterminant() c
   return m_qr.diagonal().cwiseAbs().array().log().sum();
 }
 
+/** \internal
+  * Performs the unblocked Householder QR factorization of \a mat in place: on return the upper
+  * triangular part of \a mat holds R, the essential parts of the Householder vectors are stored
+  * below the diagonal and their coefficients in \a hCoeffs. \a tempData must point to a
+  * workspace of at least mat.cols() scalars.
+  */
+template<typename MatrixQR, typename HCoeffs>
+void ei_householder_qr_inplace_unblocked(MatrixQR& mat, HCoeffs& hCoeffs, typename MatrixQR::Scalar* tempData)
+{
+  typedef typename MatrixQR::RealScalar RealScalar;
+  int rows = mat.rows();
+  int cols = mat.cols();
+  int size = std::min(rows,cols);
+
+  for(int k = 0; k < size; ++k)
+  {
+    int remainingRows = rows - k;
+    int remainingCols = cols - k - 1;
+
+    RealScalar beta;
+    mat.col(k).tail(remainingRows).makeHouseholderInPlace(hCoeffs.coeffRef(k), beta);
+    mat.coeffRef(k,k) = beta;
+
+    // apply H to remaining part of mat from the left
+    mat.bottomRightCorner(remainingRows, remainingCols)
+        .applyHouseholderOnTheLeft(mat.col(k).tail(remainingRows-1), hCoeffs.coeffRef(k), tempData+k+1);
+  }
+}
+
+/** \internal
+  * Blocked version of ei_householder_qr_inplace_unblocked(), in the spirit of LAPACK's xGEQRF:
+  * panels of \a maxBlockSize columns are factorized with the unblocked algorithm, and the
+  * remaining columns are updated with the corresponding block reflector, that is with
+  * matrix-matrix products.
+  */
+template<typename MatrixQR, typename HCoeffs>
+void ei_householder_qr_inplace_blocked(MatrixQR& mat, HCoeffs& hCoeffs, int maxBlockSize, typename MatrixQR::Scalar* tempData)
+{
+  typedef typename MatrixQR::Scalar Scalar;
+  typedef Block<MatrixQR,Dynamic,Dynamic> BlockType;
+
+  int rows = mat.rows();
+  int cols = mat.cols();
+  int size = std::min(rows,cols);
+
+  Matrix<Scalar,Dynamic,Dynamic> panelVectors;
+  for(int k = 0; k < size; k += maxBlockSize)
+  {
+    int bs = std::min(size-k, maxBlockSize);
+    int tcols = cols - k - bs;
+    int brows = rows - k;
+
+    BlockType panel(mat, k, k, brows, bs);
+    VectorBlock<HCoeffs,Dynamic> panelCoeffs(hCoeffs, k, bs);
+    ei_householder_qr_inplace_unblocked(panel, panelCoeffs, tempData);
+
+    if(tcols)
+    {
+      // the panel reflectors are applied in the order H_{bs-1} ... H_0 = (H_0^* ... H_{bs-1}^*)^*
+      panelVectors = panel;
+      panelVectors.topRows(bs).template triangularView<StrictlyUpper>().setZero();
+      panelVectors.diagonal().setOnes();
+      BlockType trailing(mat, k, k+bs, brows, tcols);
+      ei_apply_block_householder_on_the_left(trailing, panelVectors, panelCoeffs.conjugate(), false);
+    }
+  }
+}
+
+template<typename MatrixQR, typename HCoeffs,
+         bool Blocked = MatrixQR::MaxRowsAtCompileTime==Dynamic && MatrixQR::MaxColsAtCompileTime==Dynamic>
+struct ei_householder_qr_inplace_selector
+{
+  static void run(MatrixQR& mat, HCoeffs& hCoeffs, typename MatrixQR::Scalar* tempData)
+  {
+    ei_householder_qr_inplace_unblocked(mat, hCoeffs, tempData);
+  }
+};
+
+template<typename MatrixQR, typename HCoeffs>
+struct ei_householder_qr_inplace_selector<MatrixQR, HCoeffs, true>
+{
+  static void run(MatrixQR& mat, HCoeffs& hCoeffs, typename MatrixQR::Scalar* tempData)
+  {
+    if(std::min(mat.rows(),mat.cols()) < 2*EIGEN_TUNE_QR_BLOCK_SIZE)
+      ei_householder_qr_inplace_unblocked(mat, hCoeffs, tempData);
+    else
+      ei_householder_qr_inplace_blocked(mat, hCoeffs, EIGEN_TUNE_QR_BLOCK_SIZE, tempData);
+  }
+};
+
 template<typename MatrixType>
 HouseholderQR<MatrixType>& HouseholderQR<MatrixType>::compute(const MatrixType& matrix)
 {
@@ -206,19 +296,8 @@ HouseholderQR<MatrixType>& HouseholderQR<MatrixType>::compute(const MatrixType&
 
   m_temp.resize(cols);
 
-  for(int k = 0; k < size; ++k)
-  {
-    int remainingRows = rows - k;
-    int remainingCols = cols - k - 1;
+  ei_householder_qr_inplace_selector<MatrixType, HCoeffsType>::run(m_qr, m_hCoeffs, m_temp.data());
 
-    RealScalar beta;
-    m_qr.col(k).tail(remainingRows).makeHouseholderInPlace(m_hCoeffs.coeffRef(k), beta);
-    m_qr.coeffRef(k,k) = beta;
-
-    // apply H to remaining part of m_qr from the left
-    m_qr.bottomRightCorner(remainingRows, remainingCols)
-        .applyHouseholderOnTheLeft(m_qr.col(k).tail(remainingRows-1), m_hCoeffs.coeffRef(k), &m_temp.coeffRef(k+1));
-  }
   m_isInitialized = true;
   return *this;
 }
@@ -0,0 +1,591 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_BDCSVD_H
+#define EIGEN_BDCSVD_H
+
+/** \ingroup SVD_Module
+  * \nonstableyet
+  *
+  * \class BDCSVD
+  *
+  * \brief Bidiagonal divide and conquer SVD decomposition of a matrix
+  *
+  * \param MatrixType the type of the matrix of which we are computing the SVD decomposition
+  *
+  * This class computes the SVD decomposition \f$ A = U S V^* \f$ of a \a m x \a n matrix \f$ A \f$.
+  * It is meant for large matrices, for which it is much faster than JacobiSVD: the matrix is
+  * first reduced to a real upper bidiagonal matrix by blocked Householder transformations (see
+  * class UpperBidiagonalization), the SVD of the bidiagonal matrix is then computed by a divide
+  * and conquer algorithm, and the Householder transformations are finally applied to its singular
+  * vectors per blocks of reflectors. The singular values are sorted in decreasing order.
+  *
+  * Which unitaries are computed is specified at runtime by the \a computationOptions passed to
+  * the constructor or to compute(): a combination of at most one of \c ComputeFullU and
+  * \c ComputeThinU, and at most one of \c ComputeFullV and \c ComputeThinV. The thin unitaries
+  * only have min(\a m, \a n) columns, which is enough to reconstruct \f$ A \f$ and much cheaper
+  * for very rectangular matrices. Pass 0 to only compute the singular values.
+  *
+  * \sa MatrixBase::bdcSvd(), class JacobiSVD
+  */
+template<typename _MatrixType> class BDCSVD
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    enum {
+      RowsAtCompileTime = MatrixType::RowsAtCompileTime,
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      MaxRowsAtCompileTime = MatrixType::MaxRowsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime,
+      MatrixOptions = MatrixType::Options
+    };
+
+    typedef Matrix<Scalar, RowsAtCompileTime, Dynamic,
+                   MatrixOptions, MaxRowsAtCompileTime, MaxRowsAtCompileTime> MatrixUType;
+    typedef Matrix<Scalar, ColsAtCompileTime, Dynamic,
+                   MatrixOptions, MaxColsAtCompileTime, MaxColsAtCompileTime> MatrixVType;
+    typedef typename ei_plain_diag_type<MatrixType, RealScalar>::type SingularValuesType;
+
+    /** \brief Default Constructor.
+      *
+      * The default constructor is useful in cases in which the user intends to
+      * perform decompositions via BDCSVD::compute(const MatrixType&, unsigned int).
+      */
+    BDCSVD() : m_computationOptions(0), m_isInitialized(false) {}
+
+    BDCSVD(const MatrixType& matrix, unsigned int computationOptions = ComputeFullU | ComputeFullV)
+      : m_computationOptions(0), m_isInitialized(false)
+    {
+      compute(matrix, computationOptions);
+    }
+
+    BDCSVD& compute(const MatrixType& matrix, unsigned int computationOptions = ComputeFullU | ComputeFullV);
+
+    /** \returns the unitary \a U, of size \a m x \a m if \c ComputeFullU was requested,
+      * or \a m x min(\a m, \a n) if \c ComputeThinU was requested.
+      */
+    const MatrixUType& matrixU() const
+    {
+      ei_assert(m_isInitialized && "BDCSVD is not initialized.");
+      ei_assert(computeU() && "This BDCSVD decomposition didn't compute U. Did you ask for it?");
+      return m_matrixU;
+    }
+
+    /** \returns the singular values, sorted in decreasing order */
+    const SingularValuesType& singularValues() const
+    {
+      ei_assert(m_isInitialized && "BDCSVD is not initialized.");
+      return m_singularValues;
+    }
+
+    /** \returns the unitary \a V, of size \a n x \a n if \c ComputeFullV was requested,
+      * or \a n x min(\a m, \a n) if \c ComputeThinV was requested.
+      */
+    const MatrixVType& matrixV() const
+    {
+      ei_assert(m_isInitialized && "BDCSVD is not initialized.");
+      ei_assert(computeV() && "This BDCSVD decomposition didn't compute V. Did you ask for it?");
+      return m_matrixV;
+    }
+
+    inline bool computeU() const { return (m_computationOptions & (ComputeFullU|ComputeThinU)) != 0; }
+    inline bool computeV() const { return (m_computationOptions & (ComputeFullV|ComputeThinV)) != 0; }
+
+  protected:
+    typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+
+    MatrixUType m_matrixU;
+    MatrixVType m_matrixV;
+    SingularValuesType m_singularValues;
+    unsigned int m_computationOptions;
+    bool m_isInitialized;
+};
+
+#ifndef EIGEN_HIDE_HEAVY_CODE
+
+/** \internal
+  *
+  * Computes the SVD decomposition \f$ B = U S V^T \f$ of the upper bidiagonal matrix \f$ B \f$
+  * of size \a n represented by \a diag and \a superdiag. On return \a diag contains the singular
+  * values in decreasing order, and \a matrixU and \a matrixV (column major \a n x \a n matrices)
+  * the corresponding singular vectors. The content of \a superdiag is destroyed.
+  *
+  * The bidiagonal matrix is recursively split into two independent bidiagonal matrices having
+  * one more column than rows by removing one of its rows, until their size is below
+  * EIGEN_TUNE_BIDIAGONAL_DC_THRESHOLD. These small blocks are diagonalized with JacobiSVD, and
+  * merged back by solving secular equations, the singular vectors being updated with
+  * matrix-matrix products. Independent sub-problems are processed in parallel when OpenMP is enabled.
+  *
+  * Implemented from Gu and Eisenstat's "A divide-and-conquer algorithm for the bidiagonal SVD",
+  * SIAM J. Matrix Anal. Appl. 16 (1995), and LAPACK's xBDSDC.
+  */
+template<typename RealScalar>
+static void ei_bidiagonal_divide_and_conquer(RealScalar* diag, RealScalar* superdiag, int n, RealScalar* matrixU, RealScalar* matrixV);
+
+/** Computes the SVD decomposition of \a matrix, with the unitaries specified by \a computationOptions.
+  *
+  * \returns a reference to *this
+  */
+template<typename MatrixType>
+BDCSVD<MatrixType>& BDCSVD<MatrixType>::compute(const MatrixType& matrix, unsigned int computationOptions)
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> RealMatrixType;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  ei_assert(!((computationOptions & ComputeFullU) && (computationOptions & ComputeThinU))
+         && "BDCSVD: you can't ask for both full and thin U");
+  ei_assert(!((computationOptions & ComputeFullV) && (computationOptions & ComputeThinV))
+         && "BDCSVD: you can't ask for both full and thin V");
+  m_computationOptions = computationOptions;
+
+  const int rows = matrix.rows();
+  const int cols = matrix.cols();
+  const int diagSize = std::min(rows, cols);
+
+  // a wide matrix is decomposed through its adjoint, A^* = V S U^*
+  const bool transposed = cols > rows;
+  const bool computeLeft  = transposed ? computeV() : computeU();
+  const bool computeRight = transposed ? computeU() : computeV();
+  const bool fullLeft = (m_computationOptions & (transposed ? ComputeFullV : ComputeFullU)) != 0;
+  const int m = std::max(rows, cols);
+  const int n = diagSize;
+
+  if (n==0)
+  {
+    m_singularValues.resize(0);
+    if (computeU()) m_matrixU.setIdentity(rows, (m_computationOptions & ComputeFullU) ? rows : 0);
+    if (computeV()) m_matrixV.setIdentity(cols, (m_computationOptions & ComputeFullV) ? cols : 0);
+    m_isInitialized = true;
+    return *this;
+  }
+
+  WorkMatrixType work;
+  if (transposed)
+    work = matrix.adjoint();
+  else
+    work = matrix;
+  UpperBidiagonalization<WorkMatrixType> bidiagonalization(work);
+
+  // scale the bidiagonal matrix to avoid overflows and underflows in the secular equations
+  RealVectorType diag = bidiagonalization.bidiagonal().template diagonal<0>();
+  RealVectorType superdiag(n);
+  superdiag.head(n-1) = bidiagonalization.bidiagonal().template diagonal<1>();
+  superdiag.coeffRef(n-1) = 0;
+  RealScalar scale = std::max(diag.cwiseAbs().maxCoeff(), superdiag.cwiseAbs().maxCoeff());
+  if (scale==RealScalar(0))
+    scale = 1;
+  diag /= scale;
+  superdiag /= scale;
+
+  RealMatrixType naiveU(n,n), naiveV(n,n);
+  ei_bidiagonal_divide_and_conquer(diag.data(), superdiag.data(), n, naiveU.data(), naiveV.data());
+  m_singularValues = diag * scale;
+
+  WorkMatrixType left, right;
+  if (computeLeft)
+  {
+    // U = H_0 ... H_{n-1} [U_B 0; 0 I] where the H_i are the left Householder reflectors
+    left.setZero(m, fullLeft ? m : n);
+    left.topLeftCorner(n,n) = naiveU.template cast<Scalar>();
+    if (fullLeft)
+      left.bottomRightCorner(m-n,m-n).setIdentity();
+    ei_apply_householder_sequence_on_the_left_by_blocks(left, bidiagonalization.householder(),
+                                                        bidiagonalization.householder().diagonal().conjugate());
+  }
+  if (computeRight)
+  {
+    // V = [1 0; 0 H'_0 ... H'_{n-2}] V_B where the H'_i are the right Householder reflectors
+    right = naiveV.template cast<Scalar>();
+    Block<WorkMatrixType,Dynamic,Dynamic> bottom(right, 1, 0, n-1, n);
+    ei_apply_householder_sequence_on_the_left_by_blocks(bottom, bidiagonalization.householder().block(0,1,n-1,n-1).adjoint(),
+                                                        bidiagonalization.householder().template diagonal<1>());
+  }
+
+  if (transposed)
+  {
+    if (computeU()) m_matrixU = right;
+    if (computeV()) m_matrixV = left;
+  }
+  else
+  {
+    if (computeU()) m_matrixU = left;
+    if (computeV()) m_matrixV = right;
+  }
+
+  m_isInitialized = true;
+  return *this;
+}
+
+#endif // EIGEN_HIDE_HEAVY_CODE
+
+#ifndef EIGEN_EXTERN_INSTANTIATIONS
+
+/** \internal
+  * Gives the differences \f$ d_j^2 - d_o^2 \f$ between the squares of the poles \a d of the secular
+  * equation of the bidiagonal SVD, without cancellation.
+  */
+template<typename RealScalar> struct ei_secular_squared_poles
+{
+  ei_secular_squared_poles(const RealScalar* d) : m_d(d) {}
+  RealScalar operator()(int j, int o) const { return (m_d[j]-m_d[o])*(m_d[j]+m_d[o]); }
+  const RealScalar* m_d;
+};
+
+/** \internal
+  * Computes the SVD decomposition of the independent block having \a size rows and starting at
+  * \a start, which has one more column than rows unless its last superdiagonal coefficient is zero.
+  * Its singular values are stored in increasing order in \a diag, and its singular vectors in the
+  * respective diagonal blocks of \a matU and \a matV, the last column of the latter spanning the
+  * null space of the block.
+  */
+template<typename RealScalar>
+static void ei_bidiagonal_dc_leaf(RealScalar* diag, const RealScalar* superdiag, int start, int size,
+                                  Map<Matrix<RealScalar,Dynamic,Dynamic> >& matU, Map<Matrix<RealScalar,Dynamic,Dynamic> >& matV)
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> RealMatrix;
+  typedef Matrix<RealScalar,Dynamic,1> RealVector;
+  RealMatrix block = RealMatrix::Zero(size, size+1);
+  for (int i = 0; i<size; ++i)
+  {
+    block.coeffRef(i,i) = diag[start+i];
+    block.coeffRef(i,i+1) = superdiag[start+i];
+  }
+
+  RealMatrix u, v;
+  RealVector values;
+  if (superdiag[start+size-1]==RealScalar(0))
+  {
+    JacobiSVD<RealMatrix> svd(block.leftCols(size));
+    u = svd.matrixU();
+    v.setZero(size+1,size+1);
+    v.topLeftCorner(size,size) = svd.matrixV();
+    v.coeffRef(size,size) = 1;
+    values = svd.singularValues();
+  }
+  else
+  {
+    // the last column of the full U of the transpose spans the null space
+    JacobiSVD<RealMatrix> svd(block.transpose());
+    u = svd.matrixV();
+    v = svd.matrixU();
+    values = svd.singularValues();
+  }
+
+  // JacobiSVD sorts the singular values in decreasing order
+  for (int i = 0; i<size; ++i)
+  {
+    diag[start+i] = values.coeff(size-1-i);
+    matU.col(start+i).segment(start,size) = u.col(size-1-i);
+    matV.col(start+i).segment(start,size+1) = v.col(size-1-i);
+  }
+  matV.col(start+size).segment(start,size+1) = v.col(size);
+}
+
+/** \internal
+  * Merges the two adjacent diagonalized blocks of sizes \a n1 and \a n2 starting at \a start,
+  * which have been split apart by removing the row \a start + \a n1 in between.
+  */
+template<typename RealScalar>
+static void ei_bidiagonal_dc_merge(RealScalar* diag, const RealScalar* superdiag, int start, int n1, int n2,
+                                   Map<Matrix<RealScalar,Dynamic,Dynamic> >& matU, Map<Matrix<RealScalar,Dynamic,Dynamic> >& matV)
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> RealMatrix;
+  typedef Matrix<RealScalar,Dynamic,1> RealVector;
+  typedef Matrix<int,Dynamic,1> IntVector;
+  const int n = n1+1+n2;
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  Block<Map<RealMatrix> > u(matU, start, start, n, n);
+  Block<Map<RealMatrix> > v(matV, start, start, n+1, n+1);
+  RealScalar* d = diag+start;
+  const RealScalar alpha = d[n1];
+  const RealScalar beta = superdiag[start+n1];
+
+  // In the basis of the singular vectors of the two blocks, the merged block reads
+  //   [ z_0 z_1 ... z_n-1 0 ]
+  //   [  0  d_1           0 ]
+  //   [  0        d_n-1   0 ]
+  // where the first column is the combination of the null vectors of the blocks
+  // which is not orthogonal to the removed row, and the last one the other combination.
+  RealVector z(n), dp(n);
+  RealMatrix up = RealMatrix::Zero(n,n), vp = RealMatrix::Zero(n+1,n);
+  RealVector nullVector = RealVector::Zero(n+1);
+  {
+    RealScalar z1 = alpha * v.coeff(n1,n1);
+    RealScalar z2 = beta * v.coeff(n1+1,n);
+    RealScalar r = ei_hypot(z1, z2);
+    RealScalar c = 1, s = 0;
+    if (r!=RealScalar(0))
+    {
+      c = z1/r;
+      s = z2/r;
+    }
+    z[0] = r;
+    dp[0] = 0;
+    up.coeffRef(n1,0) = 1;
+    vp.col(0).head(n1+1) = c * v.col(n1).head(n1+1);
+    vp.col(0).tail(n2+1) = s * v.col(n).tail(n2+1);
+    nullVector.head(n1+1) = -s * v.col(n1).head(n1+1);
+    nullVector.tail(n2+1) = c * v.col(n).tail(n2+1);
+  }
+  // merge the two sorted sets of singular values
+  for (int i = 1, i1 = 0, i2 = 0; i<n; ++i)
+  {
+    if (i2==n2 || (i1<n1 && d[i1]<=d[n1+1+i2]))
+    {
+      dp[i] = d[i1];
+      z[i] = alpha * v.coeff(n1,i1);
+      up.col(i).head(n1) = u.col(i1).head(n1);
+      vp.col(i).head(n1+1) = v.col(i1).head(n1+1);
+      ++i1;
+    }
+    else
+    {
+      dp[i] = d[n1+1+i2];
+      z[i] = beta * v.coeff(n1+1,n1+1+i2);
+      up.col(i).tail(n2) = u.col(n1+1+i2).tail(n2);
+      vp.col(i).tail(n2+1) = v.col(n1+1+i2).tail(n2+1);
+      ++i2;
+    }
+  }
+
+  // scale the problem to avoid underflows when squaring the singular values
+  RealScalar scale = std::max(std::max(ei_abs(alpha), ei_abs(beta)), dp.maxCoeff());
+  if (scale==RealScalar(0))
+    scale = 1;
+  dp /= scale;
+  z /= scale;
+
+  // deflation: singular values with a negligible component in z, or too close to zero
+  // or to the previous one are kept as is, after a rotation zeroing their z component
+  RealScalar tol = RealScalar(8)*eps*std::max(std::max(ei_abs(alpha), ei_abs(beta))/scale, dp.maxCoeff());
+  if (ei_abs(z[0])<=tol)
+    z[0] = tol;
+  IntVector kept(n), deflated(n);
+  int k = 1, nbDeflated = 0, prev = -1;
+  kept[0] = 0;
+  for (int j = 1; j<n; ++j)
+  {
+    if (ei_abs(z[j])<=tol)
+    {
+      deflated[nbDeflated++] = j;
+      continue;
+    }
+    if (dp[j]<=tol)
+    {
+      // rotate the column into the first one
+      RealScalar tau = ei_hypot(z[0], z[j]);
+      RealScalar c = z[0]/tau;
+      RealScalar s = z[j]/tau;
+      RealVector tmp = c*vp.col(0) + s*vp.col(j);
+      vp.col(j) = c*vp.col(j) - s*vp.col(0);
+      vp.col(0) = tmp;
+      z[0] = tau;
+      z[j] = 0;
+      dp[j] = 0;
+      deflated[nbDeflated++] = j;
+      continue;
+    }
+    if (prev>=0)
+    {
+      RealScalar tau = ei_hypot(z[prev], z[j]);
+      RealScalar c = z[j]/tau;
+      RealScalar s = z[prev]/tau;
+      if (ei_abs(c*s*(dp[j]-dp[prev])) <= tol)
+      {
+        // same rotation on both sides, which leaves the (almost) scalar diagonal block unchanged
+        z[j] = tau;
+        z[prev] = 0;
+        up.applyOnTheRight(prev, j, PlanarRotation<RealScalar>(c,s));
+        vp.applyOnTheRight(prev, j, PlanarRotation<RealScalar>(c,s));
+        RealScalar t = c*c*dp[prev] + s*s*dp[j];
+        dp[j] = s*s*dp[prev] + c*c*dp[j];
+        dp[prev] = t;
+        deflated[nbDeflated++] = prev;
+      }
+      else
+        kept[k++] = prev;
+    }
+    prev = j;
+  }
+  if (prev>=0)
+    kept[k++] = prev;
+
+  RealVector values(n);
+  RealMatrix leftVectors(n,n), rightVectors(n+1,n);
+  if (k==1)
+  {
+    // all the other singular values have been deflated
+    values[0] = ei_abs(z[0]);
+    leftVectors.col(0) = up.col(0);
+    rightVectors.col(0) = vp.col(0);
+  }
+  else
+  {
+    RealVector dk(k), zk(k);
+    for (int i = 0; i<k; ++i)
+    {
+      dk[i] = dp[kept[i]];
+      zk[i] = z[kept[i]];
+    }
+    ei_secular_squared_poles<RealScalar> poles(dk.data());
+
+    // the roots are the squared singular values, represented by their offsets from the
+    // closest squared pole
+    IntVector origin(k);
+    RealVector tau(k);
+    for (int i = 0; i<k; ++i)
+    {
+      tau[i] = ei_secular_equation_root(poles, zk.data(), k, RealScalar(1), i, &origin.coeffRef(i));
+      RealScalar o = dk[origin[i]];
+      values[i] = o + tau[i] / (o + ei_sqrt(o*o + tau[i]));
+    }
+
+    // recompute z from the computed roots (Loewner's formula) such that the
+    // singular vectors are numerically orthogonal
+    for (int j = 0; j<k; ++j)
+    {
+      RealScalar w = tau[j] - poles(j,origin[j]);
+      for (int i = 0; i<k; ++i)
+        if (i!=j)
+          w *= (tau[i] - poles(j,origin[i])) / poles(i,j);
+      zk[j] = zk[j]<0 ? -ei_sqrt(ei_abs(w)) : ei_sqrt(ei_abs(w));
+    }
+
+    RealMatrix uk(k,k), vk(k,k);
+    for (int i = 0; i<k; ++i)
+    {
+      for (int j = 0; j<k; ++j)
+      {
+        vk(j,i) = zk[j] / (poles(j,origin[i]) - tau[i]);
+        uk(j,i) = dk[j] * vk(j,i);
+      }
+      uk(0,i) = -1;
+      uk.col(i).normalize();
+      vk.col(i).normalize();
+    }
+
+    RealMatrix basis(n,k);
+    for (int i = 0; i<k; ++i)
+      basis.col(i) = up.col(kept[i]);
+    leftVectors.leftCols(k).noalias() = basis * uk;
+    basis.resize(n+1,k);
+    for (int i = 0; i<k; ++i)
+      basis.col(i) = vp.col(kept[i]);
+    rightVectors.leftCols(k).noalias() = basis * vk;
+  }
+  for (int i = 0; i<nbDeflated; ++i)
+  {
+    values[k+i] = dp[deflated[i]];
+    leftVectors.col(k+i) = up.col(deflated[i]);
+    rightVectors.col(k+i) = vp.col(deflated[i]);
+  }
+
+  values *= scale;
+
+  // sort the singular triplets
+  IntVector perm(n);
+  for (int i = 0; i<n; ++i)
+    perm[i] = i;
+  std::sort(perm.data(), perm.data()+n, ei_tridiagonal_dc_compare<RealScalar>(values.data()));
+  for (int i = 0; i<n; ++i)
+  {
+    d[i] = values[perm[i]];
+    u.col(i) = leftVectors.col(perm[i]);
+    v.col(i) = rightVectors.col(perm[i]);
+  }
+  v.col(n) = nullVector;
+}
+
+template<typename RealScalar>
+static void ei_bidiagonal_divide_and_conquer(RealScalar* diag, RealScalar* superdiag, int n, RealScalar* matrixU, RealScalar* matrixV)
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> RealMatrix;
+  Map<RealMatrix> u(matrixU,n,n);
+  u.setZero();
+  // the bidiagonal matrix is seen as a n x n+1 matrix having a zero last column
+  RealMatrix vWork = RealMatrix::Zero(n+1,n+1);
+  Map<RealMatrix> v(vWork.data(),n+1,n+1);
+  superdiag[n-1] = 0;
+
+  // recursively split the matrix into 2^levels blocks of (almost) equal sizes; the blocks
+  // are stored as a binary heap: the children of the node i are the nodes 2i and 2i+1
+  int levels = 0;
+  for (int size = n; size>EIGEN_TUNE_BIDIAGONAL_DC_THRESHOLD; size/=2)
+    ++levels;
+  const int leaves = 1<<levels;
+  Matrix<int,Dynamic,1> starts(2*leaves), sizes(2*leaves);
+  starts[1] = 0;
+  sizes[1] = n;
+  for (int i = 1; i<leaves; ++i)
+  {
+    int n1 = (sizes[i]-1)/2;
+    starts[2*i] = starts[i];
+    sizes[2*i] = n1;
+    starts[2*i+1] = starts[i]+n1+1;
+    sizes[2*i+1] = sizes[i]-n1-1;
+  }
+
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for schedule(dynamic) if(leaves>1)
+  #endif
+  for (int i = leaves; i<2*leaves; ++i)
+    ei_bidiagonal_dc_leaf(diag, superdiag, starts[i], sizes[i], u, v);
+
+  for (int level = levels-1; level>=0; --level)
+  {
+    const int first = 1<<level;
+    // the last merge runs alone, and thus lets the matrix products use all the threads
+    #ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic) if(first>1)
+    #endif
+    for (int i = first; i<2*first; ++i)
+      ei_bidiagonal_dc_merge(diag, superdiag, starts[i], sizes[2*i], sizes[2*i+1], u, v);
+  }
+
+  // back to decreasing order
+  for (int i = 0; i<n/2; ++i)
+  {
+    std::swap(diag[i], diag[n-1-i]);
+    u.col(i).swap(u.col(n-1-i));
+    v.col(i).swap(v.col(n-1-i));
+  }
+  Map<RealMatrix>(matrixV,n,n) = v.topLeftCorner(n,n);
+}
+
+#endif // EIGEN_EXTERN_INSTANTIATIONS
+
+/** \svd_module
+  * \returns the BDCSVD decomposition of \c *this, with the unitaries specified by \a computationOptions
+  *
+  * \sa class BDCSVD
+  */
+template<typename Derived>
+BDCSVD<typename MatrixBase<Derived>::PlainObject>
+MatrixBase<Derived>::bdcSvd(unsigned int computationOptions) const
+{
+  return BDCSVD<PlainObject>(derived(), computationOptions);
+}
+
+#endif // EIGEN_BDCSVD_H
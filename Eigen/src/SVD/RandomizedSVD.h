@@ -0,0 +1,230 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_RANDOMIZEDSVD_H
+#define EIGEN_RANDOMIZEDSVD_H
+
+/** \internal \returns a random number drawn from the standard normal distribution,
+  * using the Box-Muller transform on top of ei_random(). For complex scalars, the real
+  * and imaginary parts are independent with variance 1/2.
+  */
+template<typename Scalar> struct ei_random_gaussian_impl
+{
+  static Scalar run()
+  {
+    Scalar u;
+    do { u = ei_random<Scalar>(Scalar(0), Scalar(1)); } while (u <= Scalar(0));
+    return ei_sqrt(Scalar(-2) * ei_log(u)) * ei_cos(Scalar(6.28318530717958647692) * ei_random<Scalar>(Scalar(0), Scalar(1)));
+  }
+};
+
+template<typename RealScalar> struct ei_random_gaussian_impl<std::complex<RealScalar> >
+{
+  static std::complex<RealScalar> run()
+  {
+    return ei_sqrt(RealScalar(0.5)) * std::complex<RealScalar>(ei_random_gaussian_impl<RealScalar>::run(),
+                                                               ei_random_gaussian_impl<RealScalar>::run());
+  }
+};
+
+/** \ingroup SVD_Module
+  * \nonstableyet
+  *
+  * \class RandomizedSVD
+  *
+  * \brief Truncated SVD decomposition of a matrix by randomized range finding
+  *
+  * \param MatrixType the type of the matrix of which we are computing the decomposition. It can
+  *                   be a dense Matrix or a SparseMatrix: the matrix is only accessed through
+  *                   products of itself and of its adjoint with dense matrices.
+  *
+  * This class computes an approximation \f$ A \approx U S V^* \f$ of rank \a k of a \a m x \a n
+  * matrix \f$ A \f$ made of its \a k largest singular values and the corresponding singular
+  * vectors, in \f$ O(mnk) \f$ operations instead of the \f$ O(mn \min(m,n)) \f$ of a full SVD.
+  *
+  * The range of \f$ A \f$ is sampled by the product \f$ Y = A \Omega \f$ with a \a n x \a l
+  * Gaussian matrix \f$ \Omega \f$, where \a l is \a k plus a few oversampling columns. A few
+  * power iterations \f$ Y = (A A^*)^q A \Omega \f$, reorthonormalized by HouseholderQR at each
+  * step, sharpen the decay of the spectrum. Given an orthonormal basis \f$ Q \f$ of \f$ Y \f$,
+  * the small \a l x \a n matrix \f$ Q^* A \f$ is finally decomposed by BDCSVD. All the products
+  * are matrix-matrix products.
+  *
+  * The accuracy of the result depends on the decay of the singular values: it is exact up to
+  * the rounding errors for matrices of rank at most \a l, and the error on \f$ \sigma_i \f$ is
+  * in the order of \f$ \sigma_{l+1} (\sigma_{l+1}/\sigma_i)^{2q} \f$ otherwise.
+  *
+  * \note For sparse matrices, only real scalar types are supported.
+  *
+  * Implemented from Halko, Martinsson and Tropp's "Finding structure with randomness:
+  * probabilistic algorithms for constructing approximate matrix decompositions",
+  * SIAM Review 53 (2011), algorithms 4.4 and 5.1.
+  *
+  * \sa class BDCSVD, class PartialSelfAdjointEigenSolver
+  */
+template<typename _MatrixType> class RandomizedSVD
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixUType;
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixVType;
+    typedef Matrix<RealScalar,Dynamic,1> SingularValuesType;
+
+    /** \brief Default Constructor.
+      *
+      * The default constructor is useful in cases in which the user intends to
+      * perform decompositions via RandomizedSVD::compute(const MatrixType&, int, unsigned int).
+      */
+    RandomizedSVD() : m_oversampling(10), m_powerIterations(2), m_computationOptions(0), m_isInitialized(false) {}
+
+    RandomizedSVD(const MatrixType& matrix, int rank, unsigned int computationOptions = ComputeThinU | ComputeThinV)
+      : m_oversampling(10), m_powerIterations(2), m_computationOptions(0), m_isInitialized(false)
+    {
+      compute(matrix, rank, computationOptions);
+    }
+
+    /** Computes the \a rank largest singular values of \a matrix, as well as the corresponding
+      * left and right singular vectors if \c ComputeThinU and \c ComputeThinV are respectively
+      * set in \a computationOptions.
+      */
+    RandomizedSVD& compute(const MatrixType& matrix, int rank, unsigned int computationOptions = ComputeThinU | ComputeThinV);
+
+    /** Sets the number of extra random samples of the range of the matrix (10 by default). */
+    RandomizedSVD& setOversampling(int oversampling)
+    {
+      ei_assert(oversampling >= 0);
+      m_oversampling = oversampling;
+      return *this;
+    }
+
+    /** Sets the number of power iterations (2 by default). Use more iterations for matrices
+      * whose singular values decay slowly.
+      */
+    RandomizedSVD& setPowerIterations(int powerIterations)
+    {
+      ei_assert(powerIterations >= 0);
+      m_powerIterations = powerIterations;
+      return *this;
+    }
+
+    /** \returns the \a m x \a k matrix of the left singular vectors */
+    const MatrixUType& matrixU() const
+    {
+      ei_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+      ei_assert(computeU() && "This RandomizedSVD decomposition didn't compute U. Did you ask for it?");
+      return m_matrixU;
+    }
+
+    /** \returns the \a k largest singular values, sorted in decreasing order */
+    const SingularValuesType& singularValues() const
+    {
+      ei_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+      return m_singularValues;
+    }
+
+    /** \returns the \a n x \a k matrix of the right singular vectors */
+    const MatrixVType& matrixV() const
+    {
+      ei_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+      ei_assert(computeV() && "This RandomizedSVD decomposition didn't compute V. Did you ask for it?");
+      return m_matrixV;
+    }
+
+    inline bool computeU() const { return (m_computationOptions & ComputeThinU) != 0; }
+    inline bool computeV() const { return (m_computationOptions & ComputeThinV) != 0; }
+
+  protected:
+    typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+
+    void orthonormalize(WorkMatrixType& mat);
+
+    MatrixUType m_matrixU;
+    MatrixVType m_matrixV;
+    SingularValuesType m_singularValues;
+    HouseholderQR<WorkMatrixType> m_qr;
+    int m_oversampling;
+    int m_powerIterations;
+    unsigned int m_computationOptions;
+    bool m_isInitialized;
+};
+
+#ifndef EIGEN_HIDE_HEAVY_CODE
+
+/** \internal replaces \a mat by an orthonormal basis of its range */
+template<typename MatrixType>
+void RandomizedSVD<MatrixType>::orthonormalize(WorkMatrixType& mat)
+{
+  m_qr.compute(mat);
+  mat.setIdentity();
+  ei_apply_householder_sequence_on_the_left_by_blocks(mat, m_qr.matrixQR(), m_qr.hCoeffs().conjugate());
+}
+
+template<typename MatrixType>
+RandomizedSVD<MatrixType>& RandomizedSVD<MatrixType>::compute(const MatrixType& matrix, int rank, unsigned int computationOptions)
+{
+  ei_assert(!(computationOptions & (ComputeFullU|ComputeFullV))
+            && "RandomizedSVD only computes the thin unitaries.");
+  const int m = matrix.rows();
+  const int n = matrix.cols();
+  const int diagSize = std::min(m,n);
+  ei_assert(rank >= 0 && rank <= diagSize);
+  const int samples = std::min(rank + m_oversampling, diagSize);
+  m_computationOptions = computationOptions;
+
+  // sample the range of the matrix: Y = A Omega
+  WorkMatrixType omega(n, samples);
+  for (int j = 0; j < samples; ++j)
+    for (int i = 0; i < n; ++i)
+      omega.coeffRef(i,j) = ei_random_gaussian_impl<Scalar>::run();
+  WorkMatrixType basis(m, samples);
+  basis.noalias() = matrix * omega;
+  orthonormalize(basis);
+
+  // power iterations, Y = (A A^*)^q A Omega
+  for (int q = 0; q < m_powerIterations; ++q)
+  {
+    omega.noalias() = matrix.adjoint() * basis;
+    orthonormalize(omega);
+    basis.noalias() = matrix * omega;
+    orthonormalize(basis);
+  }
+
+  // SVD of B^* = A^* Q = U_B S V_B^*, so that A ~ Q B = (Q V_B) S U_B^*
+  omega.noalias() = matrix.adjoint() * basis;
+  unsigned int smallOptions = (computeU() ? ComputeThinV : 0) | (computeV() ? ComputeThinU : 0);
+  BDCSVD<WorkMatrixType> svd(omega, smallOptions);
+
+  m_singularValues = svd.singularValues().head(rank);
+  if (computeU())
+    m_matrixU.noalias() = basis * svd.matrixV().leftCols(rank);
+  if (computeV())
+    m_matrixV = svd.matrixU().leftCols(rank);
+
+  m_isInitialized = true;
+  return *this;
+}
+
+#endif // EIGEN_HIDE_HEAVY_CODE
+
+#endif // EIGEN_RANDOMIZEDSVD_H
@@ -87,6 +87,8 @@ template<typename _MatrixType> class UpperBidiagonalization
     }
     
   protected:
+    int _computeBlocked();
+
     MatrixType m_householder;
     BidiagonalType m_bidiagonal;
     bool m_isInitialized;
@@ -104,7 +106,7 @@ UpperBidiagonalization<_MatrixType>& UpperBidiagonalization<_MatrixType>::comput
 
   ColVectorType temp(rows);
 
-  for (int k = 0; /* breaks at k==cols-1 below */ ; ++k)
+  for (int k = _computeBlocked(); /* breaks at k==cols-1 below */ ; ++k)
   {
     int remainingRows = rows - k;
     int remainingCols = cols - k - 1;
@@ -135,6 +137,116 @@ UpperBidiagonalization<_MatrixType>& UpperBidiagonalization<_MatrixType>::comput
   return *this;
 }
 
+/** \internal
+  * Performs the blocked part of the bidiagonalization of m_householder in place, and returns
+  * the number of columns which have been reduced. The remaining bottom-right corner is left
+  * to the unblocked loop of compute().
+  *
+  * The left and right Householder reflectors of a panel of columns and rows are computed one
+  * after the other as in the unblocked algorithm, but the remaining part of the matrix is
+  * updated only once per panel by \f$ A = A - U Y^* - X V \f$, where the columns of \f$ U \f$
+  * and the rows of \f$ V \f$ are the Householder vectors of the panel. Meanwhile, the pending
+  * updates are applied on the fly to the current column and row, and to the matrix-vector products.
+  *
+  * Implemented from LAPACK's xGEBRD and xLABRD.
+  */
+template<typename _MatrixType>
+int UpperBidiagonalization<_MatrixType>::_computeBlocked()
+{
+  const int blockSize = EIGEN_TUNE_BIDIAGONALIZATION_BLOCK_SIZE;
+  const int unblockedSize = 4*blockSize;
+
+  int rows = m_householder.rows();
+  int cols = m_householder.cols();
+  if (cols<=unblockedSize)
+    return 0;
+
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> WorkVectorType;
+  WorkMatrixType matX(rows,blockSize), matY(cols,blockSize);
+  WorkVectorType tmp(blockSize), leftCoeffs(blockSize), rightCoeffs(blockSize), rowUpdate(cols);
+
+  int p = 0;
+  for (; cols-p>unblockedSize; p+=blockSize)
+  {
+    for (int i = 0; i<blockSize; ++i)
+    {
+      int k = p+i;
+      int remainingRows = rows - k;
+      int remainingCols = cols - k - 1;
+      // the Householder vectors of the panel computed so far
+      Block<MatrixType,Dynamic,Dynamic> U(m_householder, k, p, remainingRows, i);
+      Block<MatrixType,Dynamic,Dynamic> V(m_householder, p, k+1, i, remainingCols);
+
+      // apply the pending updates of the panel to the current column
+      if (i>0)
+      {
+        m_householder.col(k).tail(remainingRows).noalias() -= U * matY.block(k,0,1,i).adjoint();
+        m_householder.col(k).tail(remainingRows).noalias() -= matX.block(k,0,remainingRows,i) * m_householder.block(p,k,i,1);
+      }
+
+      // left Householder reflector, the unit coefficient being kept until the end of the panel
+      m_householder.col(k).tail(remainingRows)
+                   .makeHouseholderInPlace(leftCoeffs.coeffRef(i), m_bidiagonal.template diagonal<0>().coeffRef(k));
+      m_householder.coeffRef(k,k) = 1;
+      Block<MatrixType,Dynamic,1> u(m_householder, k, k, remainingRows, 1);
+
+      // y = conj(tau) (A - U Y^* - X V)^* u
+      Block<WorkMatrixType,Dynamic,1> y(matY, k+1, i, remainingCols, 1);
+      y.noalias() = m_householder.block(k,k+1,remainingRows,remainingCols).adjoint() * u;
+      if (i>0)
+      {
+        tmp.head(i).noalias() = U.adjoint() * u;
+        y.noalias() -= matY.block(k+1,0,remainingCols,i) * tmp.head(i);
+        tmp.head(i).noalias() = matX.block(k,0,remainingRows,i).adjoint() * u;
+        y.noalias() -= V.adjoint() * tmp.head(i);
+      }
+      y *= ei_conj(leftCoeffs.coeff(i));
+
+      // apply the pending updates of the panel to the current row
+      tmp.head(i+1) = m_householder.block(k,p,1,i+1).transpose();
+      rowUpdate.head(remainingCols).noalias() = matY.block(k+1,0,remainingCols,i+1).conjugate() * tmp.head(i+1);
+      if (i>0)
+      {
+        tmp.head(i) = matX.block(k,0,1,i).transpose();
+        rowUpdate.head(remainingCols).noalias() += V.transpose() * tmp.head(i);
+      }
+      m_householder.row(k).tail(remainingCols) -= rowUpdate.head(remainingCols).transpose();
+
+      // right Householder reflector
+      m_householder.row(k).tail(remainingCols)
+                   .makeHouseholderInPlace(rightCoeffs.coeffRef(i), m_bidiagonal.template diagonal<1>().coeffRef(k));
+      m_householder.coeffRef(k,k+1) = 1;
+
+      // x = tau (A - U Y^* - X V) conj(v)
+      Block<WorkMatrixType,Dynamic,1> x(matX, k+1, i, remainingRows-1, 1);
+      x.noalias() = m_householder.block(k+1,k+1,remainingRows-1,remainingCols) * m_householder.row(k).tail(remainingCols).adjoint();
+      tmp.head(i+1).noalias() = matY.block(k+1,0,remainingCols,i+1).adjoint() * m_householder.row(k).tail(remainingCols).adjoint();
+      x.noalias() -= m_householder.block(k+1,p,remainingRows-1,i+1) * tmp.head(i+1);
+      if (i>0)
+      {
+        tmp.head(i).noalias() = V * m_householder.row(k).tail(remainingCols).adjoint();
+        x.noalias() -= matX.block(k+1,0,remainingRows-1,i) * tmp.head(i);
+      }
+      x *= rightCoeffs.coeff(i);
+    }
+
+    // update of the trailing matrix: A = A - U Y^* - X V
+    int q = p+blockSize;
+    m_householder.bottomRightCorner(rows-q,cols-q).noalias()
+      -= m_householder.block(q,p,rows-q,blockSize) * matY.block(q,0,cols-q,blockSize).adjoint();
+    m_householder.bottomRightCorner(rows-q,cols-q).noalias()
+      -= matX.block(q,0,rows-q,blockSize) * m_householder.block(p,q,blockSize,cols-q);
+
+    for (int i = 0; i<blockSize; ++i)
+    {
+      m_householder.coeffRef(p+i,p+i) = leftCoeffs.coeff(i);
+      m_householder.coeffRef(p+i,p+i+1) = rightCoeffs.coeff(i);
+    }
+  }
+  return p;
+}
+
 #if 0
 /** \return the Householder QR decomposition of \c *this.
   *
@@ -147,7 +147,8 @@ class SparseLDLT
     /** Perform a symbolic factorization */
     void _symbolic(const MatrixType& matrix);
     /** Perform the actual factorization using the previously
-      * computed symbolic factorization */
+      * computed symbolic factorization, \a matrix must have the same nonzero pattern
+      * \returns true on success */
     bool _numeric(const MatrixType& matrix);
 
     /** \returns the lower triangular matrix L */
@@ -167,7 +168,8 @@ class SparseLDLT
     VectorType m_diag;
     VectorXi m_parent; // elimination tree
     VectorXi m_nonZerosPerCol;
-//     VectorXi m_w; // workspace
+    Matrix<Scalar,Dynamic,1> m_workspace;
+    VectorXi m_workspaceIndices;
     RealScalar m_precision;
     int m_flags;
     mutable int m_status;
@@ -181,7 +183,7 @@ template<typename MatrixType, int Backend>
 void SparseLDLT<MatrixType,Backend>::compute(const MatrixType& a)
 {
   _symbolic(a);
-  m_succeeded = _numeric(a);
+  _numeric(a);
 }
 
 template<typename MatrixType, int Backend>
@@ -257,9 +259,12 @@ bool SparseLDLT<MatrixType,Backend>::_numeric(const MatrixType& a)
   Scalar* Lx = m_matrix._valuePtr();
   m_diag.resize(size);
 
-  Scalar * y = ei_aligned_stack_new(Scalar, size);
-  int * pattern = ei_aligned_stack_new(int, size);
-  int * tags = ei_aligned_stack_new(int, size);
+  // the workspace is kept for the next factorization of a matrix of the same size
+  m_workspace.resize(size);
+  m_workspaceIndices.resize(2*size);
+  Scalar * y = m_workspace.data();
+  int * pattern = m_workspaceIndices.data();
+  int * tags = m_workspaceIndices.data() + size;
 
   const int* P = 0;
   const int* Pinv = 0;
@@ -315,10 +320,7 @@ bool SparseLDLT<MatrixType,Backend>::_numeric(const MatrixType& a)
     }
   }
 
-  ei_aligned_stack_delete(Scalar, y, size);
-  ei_aligned_stack_delete(int, pattern, size);
-  ei_aligned_stack_delete(int, tags, size);
-
+  m_succeeded = ok;
   return ok;  /* success, diagonal of D is all nonzero */
 }
 
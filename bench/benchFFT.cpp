@@ -53,16 +53,17 @@ template <> string nameof<long double>() {return "long double";}
 
 using namespace Eigen;
 
-template <typename T>
-void bench(int nfft,bool fwd,bool unscaled=false, bool halfspec=false)
+template <typename T,typename Impl>
+double bench(const char * path,int nfft,bool fwd,bool unscaled=false, bool halfspec=false)
 {
     typedef typename NumTraits<T>::Real Scalar;
     typedef typename std::complex<Scalar> Complex;
     int nits = NDATA/nfft;
     vector<T> inbuf(nfft);
     vector<Complex > outbuf(nfft);
-    FFT< Scalar > fft;
+    FFT< Scalar, Impl > fft;
 
+    cout << path << " ";
     if (unscaled) {
         fft.SetFlag(fft.Unscaled);
         cout << "unscaled ";
@@ -90,12 +91,12 @@ void bench(int nfft,bool fwd,bool unscaled=false, bool halfspec=false)
     }
 
     cout << nameof<Scalar>() << " ";
-    double mflops = 5.*nfft*log2((double)nfft) / (1e6 * timer.value() / (double)nits );
+    double gflops = 5.*nfft*log2((double)nfft) / (1e9 * timer.value() / (double)nits );
     if ( NumTraits<T>::IsComplex ) {
         cout << "complex";
     }else{
         cout << "real   ";
-        mflops /= 2;
+        gflops /= 2;
     }
 
 
@@ -104,7 +105,20 @@ void bench(int nfft,bool fwd,bool unscaled=false, bool halfspec=false)
     else
         cout << " inv";
 
-    cout << " NFFT=" << nfft << "  " << (double(1e-6*nfft*nits)/timer.value()) << " MS/s  " << mflops << "MFLOPS\n";
+    cout << " NFFT=" << nfft << "  " << (double(1e-6*nfft*nits)/timer.value()) << " MS/s  " << gflops << " GFLOPS\n";
+    return gflops;
+}
+
+template <typename T>
+void bench(int nfft,bool fwd,bool unscaled=false, bool halfspec=false)
+{
+    typedef typename NumTraits<T>::Real Scalar;
+    double gflops = bench<T,default_fft_impl<Scalar> >("default",nfft,fwd,unscaled,halfspec);
+#if !defined(EIGEN_FFTW_DEFAULT) && !defined(EIGEN_MKL_DEFAULT)
+    // compare with the scalar butterflies of kissfft
+    double scalarGflops = bench<T,ei_kissfft_impl<Scalar,false> >("scalar ",nfft,fwd,unscaled,halfspec);
+    cout << "        speedup over the scalar path: " << gflops/scalarGflops << "\n";
+#endif
 }
 
 int main(int argc,char ** argv)
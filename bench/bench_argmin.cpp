@@ -0,0 +1,60 @@
+// g++ -O3 -DNDEBUG -I.. bench_argmin.cpp -o bench_argmin && ./bench_argmin
+// add -fopenmp to search large vectors on several threads
+// Compares minCoeff() to minCoeff(&i), which also locates the minimum, and to a plain loop.
+
+#include <iostream>
+#include <Eigen/Core>
+#include "BenchTimer.h"
+
+using namespace Eigen;
+using namespace std;
+
+#ifndef SCALAR
+#define SCALAR float
+#endif
+
+#ifndef SIZE
+#define SIZE 10000000
+#endif
+
+#ifndef REPEAT
+#define REPEAT 10
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+typedef Matrix<SCALAR,Dynamic,1> Vec;
+
+EIGEN_DONT_INLINE SCALAR loopArgMin(const Vec& v, int* index)
+{
+  SCALAR res = v.coeff(0);
+  *index = 0;
+  for(int i = 1; i < v.size(); ++i)
+    if(v.coeff(i) < res)
+    {
+      res = v.coeff(i);
+      *index = i;
+    }
+  return res;
+}
+
+int main()
+{
+  Vec v = Vec::Random(SIZE);
+  int index = 0;
+  SCALAR acc = 0;
+
+  BenchTimer timerMin, timerArgMin, timerLoop;
+  BENCH(timerMin,    TRIES, REPEAT, acc += v.minCoeff());
+  BENCH(timerArgMin, TRIES, REPEAT, acc += v.minCoeff(&index));
+  BENCH(timerLoop,   TRIES, REPEAT, acc += loopArgMin(v, &index));
+
+  cout << "size " << SIZE << ", best of " << TRIES << " times " << REPEAT << " searches:\n";
+  cout << "  minCoeff()     " << timerMin.best(REAL_TIMER) << "s\n";
+  cout << "  minCoeff(&i)   " << timerArgMin.best(REAL_TIMER) << "s\n";
+  cout << "  loop           " << timerLoop.best(REAL_TIMER) << "s\n";
+  cout << acc << " " << index << "\n";
+  return 0;
+}
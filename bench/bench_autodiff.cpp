@@ -0,0 +1,97 @@
+// g++ -O3 -DNDEBUG -I.. bench_autodiff.cpp -o bench_autodiff && ./bench_autodiff
+// Compares the jacobian of a functor computed by forward finite differences (NumericalDiff), by automatic
+// differentiation with heap allocated derivatives (VectorXd), and with fixed-capacity derivatives.
+
+#include <iostream>
+#include <Eigen/Core>
+#include <unsupported/Eigen/AutoDiff>
+#include <unsupported/Eigen/NumericalDiff>
+#include "BenchTimer.h"
+
+using namespace Eigen;
+
+#ifndef NINPUTS
+#define NINPUTS 8
+#endif
+
+#ifndef NVALUES
+#define NVALUES 200
+#endif
+
+#ifndef REPEAT
+#define REPEAT 2000
+#endif
+
+// a chain of arithmetic and transcendental operations mixing all the inputs
+struct ChainFunctor
+{
+  typedef double Scalar;
+  enum {
+    InputsAtCompileTime = Dynamic,
+    ValuesAtCompileTime = Dynamic
+  };
+  typedef Matrix<Scalar,InputsAtCompileTime,1> InputType;
+  typedef Matrix<Scalar,ValuesAtCompileTime,1> ValueType;
+  typedef Matrix<Scalar,ValuesAtCompileTime,InputsAtCompileTime> JacobianType;
+
+  int inputs() const { return NINPUTS; }
+  int values() const { return NVALUES; }
+
+  template<typename T>
+  void operator() (const Matrix<T,Dynamic,1>& x, Matrix<T,Dynamic,1>* _v) const
+  {
+    Matrix<T,Dynamic,1>& v = *_v;
+    const int n = x.size();
+    for (int i = 0; i < v.size(); ++i)
+    {
+      T a = x[i%n] * x[(i+1)%n];
+      T b = a * x[(i+2)%n] + std::sin(x[(i+3)%n]) - a / (x[i%n]*x[i%n] + 1.);
+      v[i] = b * b + std::exp(-0.5 * a);
+    }
+  }
+
+  // interface of NumericalDiff
+  int operator() (const InputType& x, ValueType& v) const
+  {
+    (*this)(x, &v);
+    return 0;
+  }
+};
+
+template<typename Jacobian>
+double benchAutoDiff(const ChainFunctor::InputType& x, ChainFunctor::JacobianType& jac)
+{
+  Jacobian autoj;
+  ChainFunctor::ValueType v(NVALUES);
+  BenchTimer t;
+  t.start();
+  for (int k = 0; k < REPEAT; ++k)
+    autoj(x, &v, &jac);
+  t.stop();
+  return t.value();
+}
+
+int main()
+{
+  ChainFunctor::InputType x = ChainFunctor::InputType::Random(NINPUTS);
+  ChainFunctor::JacobianType jac(NVALUES, NINPUTS), ref(NVALUES, NINPUTS), num(NVALUES, NINPUTS);
+
+  NumericalDiff<ChainFunctor> numDiff;
+  BenchTimer t;
+  t.start();
+  for (int k = 0; k < REPEAT; ++k)
+    numDiff.df(x, num);
+  t.stop();
+  double numTime = t.value();
+
+  double dynTime = benchAutoDiff<AutoDiffJacobian<ChainFunctor> >(x, ref);
+  double fixedTime = benchAutoDiff<AutoDiffJacobian<ChainFunctor, (NINPUTS+1)/2*2> >(x, jac);
+
+  std::cout << NVALUES << " x " << NINPUTS << " jacobian, " << REPEAT << " evaluations\n";
+  std::cout << "NumericalDiff (forward)         : " << numTime << " s, relative error "
+            << (num-ref).norm() / ref.norm() << "\n";
+  std::cout << "AutoDiffJacobian, VectorXd      : " << dynTime << " s\n";
+  std::cout << "AutoDiffJacobian, fixed capacity: " << fixedTime << " s, speedup " << dynTime / fixedTime
+            << ", relative difference " << (jac-ref).norm() / ref.norm() << "\n";
+  return 0;
+}
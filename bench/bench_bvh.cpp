@@ -0,0 +1,146 @@
+// g++ -O3 -DNDEBUG -fopenmp -I.. bench_bvh.cpp -o bench_bvh && ./bench_bvh
+// Measures the construction of KdBVH's and a broad phase collision query between two of them (all the pairs of
+// overlapping boxes), serially and with one intersector per thread, as well as batched point queries.
+
+#include <iostream>
+#include <vector>
+#include <Eigen/Core>
+#include <unsupported/Eigen/BVH>
+#include "BenchTimer.h"
+
+using namespace Eigen;
+
+#ifndef NOBJECTS
+#define NOBJECTS 1000000
+#endif
+
+#ifndef NQUERIES
+#define NQUERIES 1000000
+#endif
+
+#ifndef REPEAT
+#define REPEAT 3
+#endif
+
+typedef AlignedBox<float, 3> Box;
+typedef std::vector<Box, aligned_allocator<Box> > BoxList;
+typedef KdBVH<float, 3, int> Tree; //the objects are indices into a box list
+
+struct BoxPairCounter
+{
+  BoxPairCounter() : boxes1(0), boxes2(0), count(0) {}
+  BoxPairCounter(const BoxList *b1, const BoxList *b2) : boxes1(b1), boxes2(b2), count(0) {}
+
+  bool intersectVolumeVolume(const Box &v1, const Box &v2) { return !v1.intersection(v2).isNull(); }
+  bool intersectVolumeObject(const Box &v1, int o2) { return !v1.intersection((*boxes2)[o2]).isNull(); }
+  bool intersectObjectVolume(int o1, const Box &v2) { return !(*boxes1)[o1].intersection(v2).isNull(); }
+  bool intersectObjectObject(int o1, int o2)
+  {
+    if(!(*boxes1)[o1].intersection((*boxes2)[o2]).isNull())
+      ++count;
+    return false;
+  }
+
+  const BoxList *boxes1, *boxes2;
+  long count;
+};
+
+struct PointQuery
+{
+  PointQuery() : boxes(0), count(0) {}
+  PointQuery(const BoxList *b, const Vector3f &p) : boxes(b), point(p), count(0) {}
+
+  bool intersectVolume(const Box &v) { return v.contains(point); }
+  bool intersectObject(int o)
+  {
+    if((*boxes)[o].contains(point))
+      ++count;
+    return false;
+  }
+
+  const BoxList *boxes;
+  Vector3f point;
+  int count;
+};
+
+void makeBoxes(int n, BoxList &boxes, std::vector<int> &indices)
+{
+  //boxes of average size such that each of them overlaps a few others
+  float size = 2.f * std::pow(float(n), -1.f / 3.f);
+  boxes.resize(n);
+  indices.resize(n);
+  for(int i = 0; i < n; ++i) {
+    Vector3f c = Vector3f::Random();
+    Vector3f h = size * (Vector3f::Random().cwiseAbs() + Vector3f::Constant(0.1f));
+    boxes[i] = Box(c - h, c + h);
+    indices[i] = i;
+  }
+}
+
+int main()
+{
+  BoxList boxes1, boxes2;
+  std::vector<int> indices1, indices2;
+  makeBoxes(NOBJECTS, boxes1, indices1);
+  makeBoxes(NOBJECTS, boxes2, indices2);
+
+  int threads = 1;
+  #ifdef EIGEN_HAS_OPENMP
+  threads = omp_get_max_threads();
+  #endif
+  std::cout << NOBJECTS << " objects per tree, " << threads << " threads\n";
+
+  BenchTimer timer;
+  Tree tree1, tree2;
+  for(int k = 0; k < REPEAT; ++k) {
+    timer.start();
+    tree1.init(indices1.begin(), indices1.end(), boxes1.begin(), boxes1.end());
+    timer.stop();
+  }
+  tree2.init(indices2.begin(), indices2.end(), boxes2.begin(), boxes2.end());
+  std::cout << "build:                  " << timer.best(REAL_TIMER) << "s\n";
+
+  long count = 0;
+  timer.reset();
+  for(int k = 0; k < REPEAT; ++k) {
+    BoxPairCounter counter(&boxes1, &boxes2);
+    timer.start();
+    BVIntersect(tree1, tree2, counter);
+    timer.stop();
+    count = counter.count;
+  }
+  std::cout << "tandem query, serial:   " << timer.best(REAL_TIMER) << "s (" << count << " pairs)\n";
+
+  timer.reset();
+  for(int k = 0; k < REPEAT; ++k) {
+    std::vector<BoxPairCounter> counters(threads, BoxPairCounter(&boxes1, &boxes2));
+    timer.start();
+    BVIntersect(tree1, tree2, counters.begin(), counters.end());
+    timer.stop();
+    count = 0;
+    for(int i = 0; i < threads; ++i)
+      count += counters[i].count;
+  }
+  std::cout << "tandem query, parallel: " << timer.best(REAL_TIMER) << "s (" << count << " pairs)\n";
+
+  std::vector<PointQuery> queries(NQUERIES);
+  for(int i = 0; i < NQUERIES; ++i)
+    queries[i] = PointQuery(&boxes1, Vector3f::Random());
+  timer.reset();
+  for(int k = 0; k < REPEAT; ++k) {
+    timer.start();
+    for(int i = 0; i < NQUERIES; ++i)
+      BVIntersect(tree1, queries[i]);
+    timer.stop();
+  }
+  std::cout << "point queries, serial:  " << timer.best(REAL_TIMER) << "s\n";
+  timer.reset();
+  for(int k = 0; k < REPEAT; ++k) {
+    timer.start();
+    BVBatchIntersect(tree1, queries.begin(), queries.end());
+    timer.stop();
+  }
+  std::cout << "point queries, batched: " << timer.best(REAL_TIMER) << "s\n";
+
+  return 0;
+}
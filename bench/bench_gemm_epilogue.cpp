@@ -0,0 +1,69 @@
+// g++ -O3 -DNDEBUG -I.. bench_gemm_epilogue.cpp -o bench_gemm_epilogue && ./bench_gemm_epilogue
+// add -fopenmp to run the products on several threads
+// Times a dense layer, relu(A*B + bias + beta*C), evaluated with a GemmEpilogue in one pass
+// over the result, and with the product followed by the equivalent coefficient-wise expressions.
+
+#include <iostream>
+#include <Eigen/Core>
+#include <Eigen/Array>
+#include "BenchTimer.h"
+
+using namespace Eigen;
+using namespace std;
+
+#ifndef SCALAR
+#define SCALAR float
+#endif
+
+#ifndef ROWS
+#define ROWS 1024
+#endif
+
+#ifndef COLS
+#define COLS 1024
+#endif
+
+// the epilogue matters most when the depth of the product is small
+#ifndef DEPTH
+#define DEPTH 64
+#endif
+
+#ifndef REPEAT
+#define REPEAT 10
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+typedef Matrix<SCALAR,Dynamic,Dynamic> Mat;
+typedef Matrix<SCALAR,Dynamic,1> Vec;
+
+struct Relu {
+  SCALAR operator() (const SCALAR& a) const { return std::max(a, SCALAR(0)); }
+  template<typename Packet>
+  Packet packetOp(const Packet& a) const { return ei_pmax(a, ei_pset1(SCALAR(0))); }
+};
+namespace Eigen {
+template<> struct ei_functor_traits<Relu> { enum { Cost = 1, PacketAccess = true }; };
+}
+
+int main()
+{
+  Mat a = Mat::Random(ROWS,DEPTH), b = Mat::Random(DEPTH,COLS), c = Mat::Random(ROWS,COLS), d = c;
+  Mat zero = Mat::Zero(ROWS,COLS);
+  Vec bias = Vec::Random(ROWS);
+
+  GemmEpilogue<SCALAR,Relu> epilogue;
+  epilogue.setBeta(SCALAR(0.5)).setRowBias(bias);
+
+  BenchTimer timerFused, timerSplit;
+  BENCH(timerFused, TRIES, REPEAT, (a*b).evalTo(c, epilogue));
+  BENCH(timerSplit, TRIES, REPEAT, d *= SCALAR(0.5); d.noalias() += a*b; d.colwise() += bias; d = d.array().max(zero.array()).matrix());
+
+  cout << ROWS << "x" << DEPTH << " * " << DEPTH << "x" << COLS << ", best of " << TRIES << " times " << REPEAT << " products:\n";
+  cout << "  fused epilogue      " << timerFused.best(REAL_TIMER) << "s\n";
+  cout << "  separate passes     " << timerSplit.best(REAL_TIMER) << "s\n";
+  cout << c.sum() + d.sum() << "\n";
+  return 0;
+}
@@ -0,0 +1,65 @@
+// g++ -O3 -DNDEBUG -I.. bench_half.cpp -o bench_half && ./bench_half
+// add -mf16c to convert half precision numbers with the F16C instructions
+// Times matrix * vector and matrix * matrix products of half and bfloat16 matrices, which are
+// accumulated in float, and compares them to the same products of float matrices.
+
+#include <iostream>
+#include <Eigen/Core>
+#include "BenchTimer.h"
+
+using namespace Eigen;
+using namespace std;
+
+#ifndef ROWS
+#define ROWS 4096
+#endif
+
+#ifndef COLS
+#define COLS 4096
+#endif
+
+// cols of the rhs of the matrix * matrix product
+#ifndef PANEL
+#define PANEL 64
+#endif
+
+#ifndef REPEAT
+#define REPEAT 10
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+template<typename Scalar> void bench(const char* name)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> Mat;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMat;
+  typedef Matrix<Scalar,Dynamic,1> Vec;
+  Mat m = Matrix<float,Dynamic,Dynamic>::Random(ROWS,COLS).template cast<Scalar>();
+  RowMat mr = m;
+  Mat b = Matrix<float,Dynamic,Dynamic>::Random(COLS,PANEL).template cast<Scalar>();
+  Vec v = Matrix<float,Dynamic,1>::Random(COLS).template cast<Scalar>();
+  Vec r(ROWS);
+  Mat c(ROWS,PANEL);
+
+  BenchTimer timerGemv, timerGemvRowMajor, timerGemm;
+  BENCH(timerGemv,         TRIES, REPEAT, r.noalias() = m * v);
+  BENCH(timerGemvRowMajor, TRIES, REPEAT, r.noalias() = mr * v);
+  BENCH(timerGemm,         TRIES, 1,      c.noalias() = m * b);
+
+  cout << name << ":\n";
+  cout << "  col-major matrix * vector   " << timerGemv.best(REAL_TIMER) << "s\n";
+  cout << "  row-major matrix * vector   " << timerGemvRowMajor.best(REAL_TIMER) << "s\n";
+  cout << "  matrix * matrix             " << timerGemm.best(REAL_TIMER) << "s\n";
+  cout << "  (" << float(r.sum()) + float(c.sum()) << ")\n";
+}
+
+int main()
+{
+  cout << ROWS << "x" << COLS << " matrix, best of " << TRIES << " times " << REPEAT << " products\n";
+  bench<float>("float");
+  bench<half>("half");
+  bench<bfloat16>("bfloat16");
+  return 0;
+}
@@ -0,0 +1,70 @@
+// g++ -O3 -DNDEBUG -I.. bench_matrix_file.cpp -o bench_matrix_file && ./bench_matrix_file
+// Times the loading of a large matrix from a binary matrix file: mapping it with a MappedMatrixFile,
+// mapping it and reading all its coefficients, and reading it into a MatrixXf with std::ifstream.
+
+#include <iostream>
+#include <cstdio>
+#include <unsupported/Eigen/MatrixFile>
+#include "BenchTimer.h"
+
+using namespace Eigen;
+using namespace std;
+
+#ifndef ROWS
+#define ROWS 8192
+#endif
+
+#ifndef COLS
+#define COLS 8192
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+int main()
+{
+  const char* filename = "bench_matrix_file.bin";
+  {
+    MatrixXf m = MatrixXf::Random(ROWS,COLS);
+    writeMatrixFile(filename, m);
+  }
+
+  float acc = 0;
+  BenchTimer timerMap, timerMapSum, timerRead;
+  for(int t=0; t<TRIES; ++t)
+  {
+    timerMap.start();
+    {
+      MappedMatrixFile file(filename);
+      Map<MatrixXf,Aligned> m = file.map<MatrixXf>();
+      acc += m(0,0);
+    }
+    timerMap.stop();
+
+    timerMapSum.start();
+    {
+      MappedMatrixFile file(filename);
+      acc += file.map<MatrixXf>().sum();
+    }
+    timerMapSum.stop();
+
+    timerRead.start();
+    {
+      MatrixXf m(ROWS,COLS);
+      ifstream stream(filename, ios::in | ios::binary);
+      stream.seekg(MatrixFileAlignment*((sizeof(ei_matrix_file_header)+MatrixFileAlignment-1)/MatrixFileAlignment));
+      stream.read(reinterpret_cast<char*>(m.data()), sizeof(float)*ROWS*COLS);
+      acc += m.sum();
+    }
+    timerRead.stop();
+  }
+  std::remove(filename);
+
+  cout << ROWS << "x" << COLS << " float matrix (" << sizeof(float)*ROWS*COLS/(1024*1024) << " MB), best of " << TRIES << ":\n";
+  cout << "  map                 " << timerMap.best(REAL_TIMER) << "s\n";
+  cout << "  map and sum         " << timerMapSum.best(REAL_TIMER) << "s\n";
+  cout << "  read and sum        " << timerRead.best(REAL_TIMER) << "s\n";
+  cout << acc << "\n";
+  return 0;
+}
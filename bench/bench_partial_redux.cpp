@@ -0,0 +1,60 @@
+// g++ -O3 -DNDEBUG -I.. bench_partial_redux.cpp -o bench_partial_redux && ./bench_partial_redux
+// add -fopenmp to reduce large matrices on several threads
+// Times rowwise() reductions of a column-major matrix, which run across the contiguous direction,
+// and compares them to the colwise() ones of the same matrix.
+
+#include <iostream>
+#include <Eigen/Core>
+#include <Eigen/Array>
+#include "BenchTimer.h"
+
+using namespace Eigen;
+using namespace std;
+
+#ifndef SCALAR
+#define SCALAR float
+#endif
+
+#ifndef ROWS
+#define ROWS 1000
+#endif
+
+#ifndef COLS
+#define COLS 1000
+#endif
+
+#ifndef REPEAT
+#define REPEAT 10
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+typedef Matrix<SCALAR,Dynamic,Dynamic> Mat;
+typedef Matrix<SCALAR,Dynamic,1> Vec;
+typedef Matrix<SCALAR,1,Dynamic> RowVec;
+
+int main()
+{
+  Mat m = Mat::Random(ROWS,COLS);
+  Vec r(ROWS);
+  RowVec c(COLS);
+  SCALAR acc = 0;
+
+  BenchTimer timerSum, timerMean, timerNorm, timerMax, timerColSum;
+  BENCH(timerSum,    TRIES, REPEAT, r = m.rowwise().sum());      acc += r.sum();
+  BENCH(timerMean,   TRIES, REPEAT, r = m.rowwise().mean());     acc += r.sum();
+  BENCH(timerNorm,   TRIES, REPEAT, r = m.rowwise().norm());     acc += r.sum();
+  BENCH(timerMax,    TRIES, REPEAT, r = m.rowwise().maxCoeff()); acc += r.sum();
+  BENCH(timerColSum, TRIES, REPEAT, c = m.colwise().sum());      acc += c.sum();
+
+  cout << ROWS << "x" << COLS << ", best of " << TRIES << " times " << REPEAT << " reductions:\n";
+  cout << "  rowwise().sum()      " << timerSum.best(REAL_TIMER) << "s\n";
+  cout << "  rowwise().mean()     " << timerMean.best(REAL_TIMER) << "s\n";
+  cout << "  rowwise().norm()     " << timerNorm.best(REAL_TIMER) << "s\n";
+  cout << "  rowwise().maxCoeff() " << timerMax.best(REAL_TIMER) << "s\n";
+  cout << "  colwise().sum()      " << timerColSum.best(REAL_TIMER) << "s\n";
+  cout << acc << "\n";
+  return 0;
+}
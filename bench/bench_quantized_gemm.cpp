@@ -0,0 +1,64 @@
+// g++ -O3 -DNDEBUG -I.. bench_quantized_gemm.cpp -o bench_quantized_gemm && ./bench_quantized_gemm
+// add -fopenmp to run the products on several threads
+// Times a quantized product of an unsigned char matrix by a signed char matrix accumulated in int,
+// with and without zero points, and compares it to the float and int products of the same size.
+
+#include <iostream>
+#include <Eigen/Core>
+#include "BenchTimer.h"
+
+using namespace Eigen;
+using namespace std;
+
+#ifndef ROWS
+#define ROWS 1024
+#endif
+
+#ifndef COLS
+#define COLS 1024
+#endif
+
+#ifndef DEPTH
+#define DEPTH 1024
+#endif
+
+#ifndef REPEAT
+#define REPEAT 4
+#endif
+
+#ifndef TRIES
+#define TRIES 4
+#endif
+
+typedef Matrix<unsigned char,Dynamic,Dynamic> MatrixXuc;
+typedef Matrix<signed char,Dynamic,Dynamic> MatrixXsc;
+
+int main()
+{
+  MatrixXf af = (MatrixXf::Random(ROWS,DEPTH).array()+1.f)*127.f, bf = MatrixXf::Random(DEPTH,COLS)*127.f;
+  MatrixXuc a = af.cast<unsigned char>();
+  MatrixXsc b = bf.cast<signed char>();
+  MatrixXi ai = a.cast<int>(), bi = b.cast<int>();
+  MatrixXi c(ROWS,COLS), ci(ROWS,COLS), cz(ROWS,COLS);
+  MatrixXf cf(ROWS,COLS);
+
+  Map<MatrixXuc> ma(a.data(), ROWS, DEPTH);
+  Map<MatrixXsc> mb(b.data(), DEPTH, COLS);
+  GemmZeroPoints zeroPoints;
+  zeroPoints.setLhsZeroPoint(128).setRhsZeroPoint(3);
+
+  BenchTimer timerQuantized, timerZeroPoints, timerInt, timerFloat;
+  BENCH(timerQuantized,  TRIES, REPEAT, c.noalias() = ma * mb);
+  BENCH(timerZeroPoints, TRIES, REPEAT, (ma * mb).evalTo(cz, zeroPoints));
+  BENCH(timerInt,        TRIES, REPEAT, ci.noalias() = ai * bi);
+  BENCH(timerFloat,      TRIES, REPEAT, cf.noalias() = af * bf);
+
+  double ops = 2. * ROWS * COLS * DEPTH * 1e-9;
+  cout << ROWS << "x" << DEPTH << " * " << DEPTH << "x" << COLS << ", best of " << TRIES << " times " << REPEAT << " products:\n";
+  cout << "  unsigned char * signed char   " << timerQuantized.best(REAL_TIMER) << "s  " << ops*REPEAT/timerQuantized.best(REAL_TIMER) << " GOPS\n";
+  cout << "    with zero points            " << timerZeroPoints.best(REAL_TIMER) << "s  " << ops*REPEAT/timerZeroPoints.best(REAL_TIMER) << " GOPS\n";
+  cout << "  int * int                     " << timerInt.best(REAL_TIMER) << "s  " << ops*REPEAT/timerInt.best(REAL_TIMER) << " GOPS\n";
+  cout << "  float * float                 " << timerFloat.best(REAL_TIMER) << "s  " << ops*REPEAT/timerFloat.best(REAL_TIMER) << " GFLOPS\n";
+  cout << (c == ci ? "ok" : "MISMATCH") << " " << cz.sum() << " " << cf.sum() << "\n";
+  return 0;
+}
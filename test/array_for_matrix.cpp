@@ -129,6 +129,71 @@ template<typename MatrixType> void comparisons(const MatrixType& m)
   VERIFY_IS_APPROX(((m1.array().abs()+1)>RealScalar(0.1)).matrix().rowwise().count(), VectorXi::Constant(rows, cols));
 }
 
+template<typename MatrixType> void checkPartialRedux(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,1,Dynamic> RowVectorType;
+
+  // coefficient-wise references, one reduction per inner vector
+  VectorType rsum(m.rows()), rmin(m.rows()), rmax(m.rows()), rnorm(m.rows());
+  for(int i = 0; i < m.rows(); ++i)
+  {
+    rsum(i) = m.row(i).sum();
+    rmin(i) = m.row(i).minCoeff();
+    rmax(i) = m.row(i).maxCoeff();
+    rnorm(i) = m.row(i).norm();
+  }
+  RowVectorType csum(m.cols());
+  for(int j = 0; j < m.cols(); ++j)
+    csum(j) = m.col(j).sum();
+
+  VERIFY_IS_APPROX(m.rowwise().sum(), rsum);
+  VERIFY_IS_APPROX(m.rowwise().mean(), rsum / Scalar(m.cols()));
+  VERIFY_IS_APPROX(m.rowwise().redux(ei_scalar_sum_op<Scalar>()), rsum);
+  VERIFY_IS_APPROX(m.rowwise().norm(), rnorm);
+  VERIFY_IS_APPROX(m.rowwise().squaredNorm(), rnorm.cwiseAbs2());
+  VERIFY(m.rowwise().minCoeff() == rmin);
+  VERIFY(m.rowwise().maxCoeff() == rmax);
+  VERIFY_IS_APPROX(m.colwise().sum(), csum);
+}
+
+template<typename Scalar> void largePartialRedux(int rows, int cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  MatrixType m = MatrixType::Random(rows+2, cols);
+  checkPartialRedux(m);
+  checkPartialRedux(m.block(1, 0, rows, cols));
+  checkPartialRedux(RowMajorMatrixType(m));
+
+  // few columns, so that the products neither underflow nor overflow
+  int prodCols = std::min(cols, 8);
+  VectorType rprod(rows+2);
+  for(int i = 0; i < rows+2; ++i)
+    rprod(i) = m.row(i).head(prodCols).prod();
+  VERIFY_IS_APPROX(m.leftCols(prodCols).rowwise().prod(), rprod);
+
+  // the result may alias the reduced expression
+  VectorType mean = m.rowwise().mean();
+  m.col(0) = m.rowwise().mean();
+  VERIFY_IS_APPROX(m.col(0), mean);
+
+#ifdef EIGEN_HAS_OPENMP
+  // each output coefficient is reduced by a single thread, in the same order
+  const int threads = omp_get_max_threads();
+  VectorType ref = m.rowwise().sum();
+  for(int t = 1; t <= 4; ++t)
+  {
+    omp_set_num_threads(t);
+    VERIFY(m.rowwise().sum() == ref);
+  }
+  omp_set_num_threads(threads);
+#endif
+}
+
 template<typename VectorType> void lpNorm(const VectorType& v)
 {
   VectorType u = VectorType::Random(v.size());
@@ -164,4 +229,8 @@ void test_array_for_matrix()
     CALL_SUBTEST_5( lpNorm(VectorXf(16)) );
     CALL_SUBTEST_4( lpNorm(VectorXcf(10)) );
   }
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_5( largePartialRedux<float>(ei_random<int>(1,300), ei_random<int>(1,300)) );
+    CALL_SUBTEST_7( largePartialRedux<double>(ei_random<int>(1,300), ei_random<int>(1,300)) );
+  }
 }
@@ -0,0 +1,119 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "main.h"
+#include <Eigen/SVD>
+
+template<typename MatrixType> void bdcsvd_check(const MatrixType& a, unsigned int computationOptions)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> DynamicMatrixType;
+  int rows = a.rows();
+  int cols = a.cols();
+  int diagSize = std::min(rows, cols);
+
+  BDCSVD<MatrixType> svd(a, computationOptions);
+  VERIFY(svd.singularValues().size() == diagSize);
+  for(int i = 1; i < diagSize; ++i)
+    VERIFY(svd.singularValues().coeff(i-1) >= svd.singularValues().coeff(i));
+  VERIFY(svd.singularValues().minCoeff() >= RealScalar(0));
+
+  // compare to the singular values of the reference implementation
+  JacobiSVD<MatrixType> ref(a);
+  VERIFY_IS_APPROX(svd.singularValues(), ref.singularValues());
+
+  if(svd.computeU() && svd.computeV())
+  {
+    int uCols = (computationOptions & ComputeThinU) ? diagSize : rows;
+    int vCols = (computationOptions & ComputeThinV) ? diagSize : cols;
+    VERIFY(svd.matrixU().rows() == rows && svd.matrixU().cols() == uCols);
+    VERIFY(svd.matrixV().rows() == cols && svd.matrixV().cols() == vCols);
+    VERIFY_IS_APPROX(svd.matrixU().adjoint() * svd.matrixU(), DynamicMatrixType::Identity(uCols,uCols));
+    VERIFY_IS_APPROX(svd.matrixV().adjoint() * svd.matrixV(), DynamicMatrixType::Identity(vCols,vCols));
+    VERIFY_IS_APPROX(a, svd.matrixU().leftCols(diagSize)
+                        * svd.singularValues().template cast<Scalar>().asDiagonal()
+                        * svd.matrixV().leftCols(diagSize).adjoint());
+  }
+}
+
+template<typename MatrixType> void bdcsvd(const MatrixType& m)
+{
+  MatrixType a = MatrixType::Random(m.rows(), m.cols());
+  bdcsvd_check(a, ComputeFullU | ComputeFullV);
+  bdcsvd_check(a, ComputeThinU | ComputeThinV);
+  bdcsvd_check(a, ComputeThinU | ComputeFullV);
+  bdcsvd_check(a, 0);
+
+  // rank deficient matrix with repeated singular values
+  typedef Matrix<typename MatrixType::Scalar, Dynamic, Dynamic> DynamicMatrixType;
+  int rank = std::max(1, std::min(m.rows(), m.cols())/3);
+  MatrixType b = DynamicMatrixType::Random(m.rows(), rank) * DynamicMatrixType::Random(rank, m.cols());
+  b.leftCols(rank) = b.rightCols(rank);
+  bdcsvd_check(b, ComputeFullU | ComputeFullV);
+}
+
+template<typename MatrixType> void bdcsvd_empty()
+{
+  MatrixType a;
+  a.resize(0, 4);
+  BDCSVD<MatrixType> svd(a, ComputeFullU | ComputeFullV);
+  VERIFY(svd.singularValues().size() == 0);
+  VERIFY(svd.matrixU().rows() == 0 && svd.matrixU().cols() == 0);
+  VERIFY_IS_APPROX(svd.matrixV(), MatrixType::Identity(4,4));
+
+  svd.compute(a.transpose(), ComputeThinU | ComputeThinV);
+  VERIFY(svd.singularValues().size() == 0);
+  VERIFY(svd.matrixU().rows() == 4 && svd.matrixU().cols() == 0);
+  VERIFY(svd.matrixV().rows() == 0 && svd.matrixV().cols() == 0);
+}
+
+template<typename MatrixType> void bdcsvd_verify_assert()
+{
+  BDCSVD<MatrixType> svd;
+  VERIFY_RAISES_ASSERT(svd.matrixU())
+  VERIFY_RAISES_ASSERT(svd.singularValues())
+  VERIFY_RAISES_ASSERT(svd.matrixV())
+
+  MatrixType a = MatrixType::Random(10,10);
+  svd.compute(a, ComputeThinU);
+  VERIFY_RAISES_ASSERT(svd.matrixV())
+  VERIFY_RAISES_ASSERT(svd.compute(a, ComputeFullU | ComputeThinU))
+}
+
+void test_bdcsvd()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( bdcsvd(Matrix3f()) ));
+    CALL_SUBTEST_2(( bdcsvd(Matrix<double,5,7>()) ));
+    CALL_SUBTEST_3(( bdcsvd(MatrixXf(ei_random<int>(1,15), ei_random<int>(1,15))) ));
+    CALL_SUBTEST_4(( bdcsvd(MatrixXd(ei_random<int>(20,80), ei_random<int>(20,80))) ));
+    CALL_SUBTEST_5(( bdcsvd(MatrixXcd(ei_random<int>(20,60), ei_random<int>(20,60))) ));
+  }
+  // large enough to use the blocked bidiagonalization
+  CALL_SUBTEST_6(( bdcsvd(MatrixXd(400,250)) ));
+  CALL_SUBTEST_7(( bdcsvd(MatrixXcf(160,200)) ));
+
+  CALL_SUBTEST_4( bdcsvd_verify_assert<MatrixXd>() );
+  CALL_SUBTEST_4( bdcsvd_empty<MatrixXd>() );
+}
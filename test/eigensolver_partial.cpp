@@ -0,0 +1,104 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "sparse.h"
+#include <Eigen/Eigenvalues>
+
+template<typename MatrixType, typename DenseMatrixType>
+void eigensolver_partial_check(const MatrixType& a, const DenseMatrixType& refA, int nbEigenvalues)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> DynamicMatrixType;
+
+  PartialSelfAdjointEigenSolver<MatrixType> eig(a, nbEigenvalues);
+  VERIFY(eig.converged());
+  VERIFY(eig.eigenvalues().size() == nbEigenvalues);
+  VERIFY(eig.eigenvectors().rows() == a.rows() && eig.eigenvectors().cols() == nbEigenvalues);
+
+  SelfAdjointEigenSolver<DenseMatrixType> ref(refA, false);
+  VERIFY_IS_APPROX(eig.eigenvalues(), ref.eigenvalues().tail(nbEigenvalues));
+  VERIFY_IS_APPROX(eig.eigenvectors().adjoint() * eig.eigenvectors(), DynamicMatrixType::Identity(nbEigenvalues,nbEigenvalues));
+  VERIFY_IS_APPROX(refA * eig.eigenvectors(), eig.eigenvectors() * eig.eigenvalues().template cast<Scalar>().asDiagonal());
+
+  PartialSelfAdjointEigenSolver<MatrixType> values(a, nbEigenvalues, false);
+  VERIFY_IS_APPROX(values.eigenvalues(), ref.eigenvalues().tail(nbEigenvalues));
+}
+
+template<typename MatrixType> void eigensolver_partial(const MatrixType& m)
+{
+  int size = m.rows();
+  int nbEigenvalues = ei_random<int>(1, std::min(size, 10));
+
+  MatrixType a = MatrixType::Random(size, size);
+  MatrixType symmA = a.adjoint() * a;
+  eigensolver_partial_check(symmA, symmA, nbEigenvalues);
+
+  // indefinite matrix
+  MatrixType b = MatrixType::Random(size, size);
+  MatrixType symmB = b + b.adjoint();
+  eigensolver_partial_check(symmB, symmB, nbEigenvalues);
+
+  // low rank matrix, spanning an invariant Krylov subspace after a few iterations
+  int rank = ei_random<int>(1, 3);
+  MatrixType c = MatrixType::Random(size, rank);
+  MatrixType symmC = c * c.adjoint();
+  eigensolver_partial_check(symmC, symmC, std::min(size, rank+2));
+}
+
+template<typename Scalar> void eigensolver_partial_sparse(int size)
+{
+  typedef Matrix<Scalar, Dynamic, Dynamic> DenseMatrix;
+  DenseMatrix refUp = DenseMatrix::Zero(size, size);
+  SparseMatrix<Scalar> mUp(size, size);
+  initSparse<Scalar>(0.1, refUp, mUp, ForceNonZeroDiag|MakeUpperTriangular);
+  SparseMatrix<Scalar> mS = mUp + SparseMatrix<Scalar>(mUp.transpose());
+  DenseMatrix refS = refUp + refUp.transpose();
+  eigensolver_partial_check(mS, refS, ei_random<int>(1, std::min(size, 10)));
+}
+
+template<typename MatrixType> void eigensolver_partial_verify_assert()
+{
+  PartialSelfAdjointEigenSolver<MatrixType> eig;
+  VERIFY_RAISES_ASSERT(eig.eigenvalues())
+  VERIFY_RAISES_ASSERT(eig.eigenvectors())
+
+  MatrixType a = MatrixType::Random(10,10);
+  eig.compute(a + a.adjoint(), 2, false);
+  VERIFY_RAISES_ASSERT(eig.eigenvectors())
+  VERIFY_RAISES_ASSERT(eig.compute(a, 11))
+}
+
+void test_eigensolver_partial()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    int s = ei_random<int>(1,30);
+    CALL_SUBTEST_1(( eigensolver_partial(MatrixXf(s,s)) ));
+    s = ei_random<int>(20,300);
+    CALL_SUBTEST_2(( eigensolver_partial(MatrixXd(s,s)) ));
+    s = ei_random<int>(20,100);
+    CALL_SUBTEST_3(( eigensolver_partial(MatrixXcd(s,s)) ));
+    CALL_SUBTEST_4(( eigensolver_partial_sparse<double>(ei_random<int>(20,300)) ));
+  }
+
+  CALL_SUBTEST_2( eigensolver_partial_verify_assert<MatrixXd>() );
+}
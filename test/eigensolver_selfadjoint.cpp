@@ -108,11 +108,55 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   VERIFY((symmA * eiSymmGen.eigenvectors()).isApprox(
           symmB * (eiSymmGen.eigenvectors() * eiSymmGen.eigenvalues().asDiagonal()), largerEps));
 
+  // the eigenvalues must not depend on whether the eigenvectors are requested
+  SelfAdjointEigenSolver<MatrixType> eiSymmNoEivecs(symmA, false);
+  VERIFY_IS_APPROX(eiSymm.eigenvalues(), eiSymmNoEivecs.eigenvalues());
+
   MatrixType sqrtSymmA = eiSymm.operatorSqrt();
   VERIFY_IS_APPROX(symmA, sqrtSymmA*sqrtSymmA);
   VERIFY_IS_APPROX(sqrtSymmA, symmA*eiSymm.operatorInverseSqrt());
 }
 
+template<typename MatrixType> void selfadjointeigensolver_deflation(int size)
+{
+  /* matrices with multiple or clustered eigenvalues exercise the deflation
+     steps of the divide-and-conquer algorithm
+  */
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  RealScalar largerEps = 10*test_precision<RealScalar>();
+
+  // rank one matrix: eigenvalue 0 of multiplicity size-1
+  MatrixType ones = MatrixType::Ones(size,size);
+  SelfAdjointEigenSolver<MatrixType> eiOnes(ones);
+  VERIFY((ones * eiOnes.eigenvectors()).isApprox(
+          eiOnes.eigenvectors() * eiOnes.eigenvalues().asDiagonal(), largerEps));
+  VERIFY_IS_UNITARY(eiOnes.eigenvectors());
+  VERIFY_IS_APPROX(eiOnes.eigenvalues()(size-1), RealScalar(size));
+
+  // diagonal matrix with repeated entries: nothing to merge at all
+  MatrixType diag = MatrixType::Zero(size,size);
+  for (int i=0; i<size; ++i)
+    diag(i,i) = Scalar(i%3);
+  SelfAdjointEigenSolver<MatrixType> eiDiag(diag);
+  VERIFY((diag * eiDiag.eigenvectors()).isApprox(
+          eiDiag.eigenvectors() * eiDiag.eigenvalues().asDiagonal(), largerEps));
+  VERIFY_IS_UNITARY(eiDiag.eigenvectors());
+
+  // Wilkinson's W+ matrix has pairs of very close eigenvalues
+  MatrixType wilkinson = MatrixType::Zero(size,size);
+  for (int i=0; i<size; ++i)
+  {
+    wilkinson(i,i) = ei_abs(RealScalar(i) - RealScalar(size-1)/RealScalar(2));
+    if (i>0)
+      wilkinson(i,i-1) = wilkinson(i-1,i) = Scalar(1);
+  }
+  SelfAdjointEigenSolver<MatrixType> eiWilkinson(wilkinson);
+  VERIFY((wilkinson * eiWilkinson.eigenvectors()).isApprox(
+          eiWilkinson.eigenvectors() * eiWilkinson.eigenvalues().asDiagonal(), largerEps));
+  VERIFY_IS_UNITARY(eiWilkinson.eigenvectors());
+}
+
 void test_eigensolver_selfadjoint()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -123,6 +167,12 @@ void test_eigensolver_selfadjoint()
     CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(19,19)) );
     CALL_SUBTEST_5( selfadjointeigensolver(MatrixXcd(17,17)) );
 
+    // large enough to go through the divide-and-conquer path
+    int s = ei_random<int>(33,150);
+    CALL_SUBTEST_9( selfadjointeigensolver(MatrixXd(s,s)) );
+    CALL_SUBTEST_9( selfadjointeigensolver_deflation<MatrixXd>(s) );
+    CALL_SUBTEST_10( selfadjointeigensolver(MatrixXcf(s,s)) );
+
     // some trivial but implementation-wise tricky cases
     CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(1,1)) );
     CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(2,2)) );
@@ -130,6 +180,10 @@ void test_eigensolver_selfadjoint()
     CALL_SUBTEST_7( selfadjointeigensolver(Matrix<double,2,2>()) );
   }
 
+  // large enough to go through the blocked tridiagonalization
+  CALL_SUBTEST_11( selfadjointeigensolver(MatrixXd(200,200)) );
+  CALL_SUBTEST_12( selfadjointeigensolver(MatrixXcf(150,150)) );
+
   // Test problem size constructors
   CALL_SUBTEST_8(SelfAdjointEigenSolver<MatrixXf>(10));
   CALL_SUBTEST_8(Tridiagonalization<MatrixXf>(10));
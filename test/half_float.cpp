@@ -0,0 +1,110 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "main.h"
+
+template<typename Scalar> void reduced_precision_scalar()
+{
+  // conversions round to nearest, ties to even
+  VERIFY(float(Scalar(1.0f)) == 1.0f);
+  VERIFY(float(Scalar(-0.5f)) == -0.5f);
+  VERIFY(float(Scalar(3.0f) * Scalar(0.5f)) == 1.5f);
+  VERIFY(float(-Scalar(2.0f)) == -2.0f);
+  VERIFY(float(Scalar(1.0f) + NumTraits<Scalar>::epsilon()/Scalar(2)) == 1.0f);
+  VERIFY(float(Scalar(1.0f) + NumTraits<Scalar>::epsilon()) > 1.0f);
+  VERIFY(float(NumTraits<Scalar>::highest()) > 60000.f);
+
+  Scalar x = ei_random<Scalar>(Scalar(-4), Scalar(4));
+  VERIFY(Scalar(float(x)).bits() == x.bits());
+  VERIFY(ei_isApprox(ei_sqrt(ei_abs(x)) * ei_sqrt(ei_abs(x)), ei_abs(x)));
+
+  Matrix<Scalar,Dynamic,Dynamic> m = Matrix<Scalar,Dynamic,Dynamic>::Random(7,5);
+  Matrix<float,Dynamic,Dynamic> mf = m.template cast<float>();
+  VERIFY(mf.cwiseAbs().maxCoeff() <= 1.f);
+  VERIFY(mf.template cast<Scalar>().template cast<float>() == mf);
+}
+
+template<typename Scalar> void reduced_precision_product(int rows, int cols, int depth)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,1,Dynamic> RowVectorType;
+  typedef Matrix<float,Dynamic,Dynamic> MatrixXf;
+  typedef Matrix<float,Dynamic,1> VectorXf;
+  // a single rounding of the result to Scalar
+  float prec = 2*float(NumTraits<Scalar>::epsilon());
+
+  MatrixType a = MatrixType::Random(rows, depth), b = MatrixType::Random(depth, cols), c = MatrixType::Random(rows, cols);
+  RowMajorMatrixType ar = a;
+  VectorType v = VectorType::Random(depth), w = VectorType::Random(rows);
+  MatrixXf af = a.template cast<float>(), bf = b.template cast<float>(), cf = c.template cast<float>();
+  VectorXf vf = v.template cast<float>(), wf = w.template cast<float>();
+
+  MatrixXf ref = af * bf;
+  MatrixType res = a * b;
+  VERIFY((res.template cast<float>() - ref).norm() <= prec * ref.norm());
+  RowMajorMatrixType resr(rows, cols);
+  resr.noalias() = ar * b;
+  VERIFY((resr.template cast<float>() - ref).norm() <= prec * ref.norm());
+  res = c;
+  res.noalias() += a * b;
+  VERIFY((res.template cast<float>() - (cf + ref)).norm() <= prec * (cf + ref).norm() + prec * cf.norm());
+
+  VectorXf refv = af * vf;
+  VectorType resv = a * v;
+  VERIFY((resv.template cast<float>() - refv).norm() <= prec * refv.norm());
+  resv = ar * v;
+  VERIFY((resv.template cast<float>() - refv).norm() <= prec * refv.norm());
+  RowVectorType resrv = w.transpose() * a;
+  VectorXf refrv = af.transpose() * wf;
+  VERIFY((resrv.transpose().template cast<float>() - refrv).norm() <= prec * refrv.norm());
+}
+
+template<typename Scalar> void reduced_precision_accumulation()
+{
+  // summing 4096 ones in Scalar would stop at 256 or 2048, the products have to accumulate in float
+  int n = 4096;
+  Matrix<Scalar,Dynamic,Dynamic> ones = Matrix<Scalar,Dynamic,Dynamic>::Constant(40, n, Scalar(1));
+  Matrix<Scalar,Dynamic,Dynamic,RowMajor> onesr = ones;
+  Matrix<Scalar,Dynamic,1> v = Matrix<Scalar,Dynamic,1>::Constant(n, Scalar(1));
+
+  Matrix<Scalar,Dynamic,Dynamic> p = ones * ones.transpose();
+  VERIFY(float(p.minCoeff()) == float(n));
+  VERIFY(float(p.maxCoeff()) == float(n));
+  Matrix<Scalar,Dynamic,1> r = onesr * v;
+  VERIFY(float(r.minCoeff()) == float(n));
+  Matrix<Scalar,1,Dynamic> rt = v.transpose() * ones.transpose();
+  VERIFY(float(rt.maxCoeff()) == float(n));
+}
+
+void test_half_float()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( reduced_precision_scalar<half>() );
+    CALL_SUBTEST_2( reduced_precision_scalar<bfloat16>() );
+    CALL_SUBTEST_1( reduced_precision_product<half>(ei_random<int>(1,320), ei_random<int>(1,320), ei_random<int>(1,600)) );
+    CALL_SUBTEST_2( reduced_precision_product<bfloat16>(ei_random<int>(1,320), ei_random<int>(1,320), ei_random<int>(1,600)) );
+  }
+  CALL_SUBTEST_1( reduced_precision_accumulation<half>() );
+  CALL_SUBTEST_2( reduced_precision_accumulation<bfloat16>() );
+}
@@ -65,6 +65,16 @@ template<typename MatrixType> void householder(const MatrixType& m)
   v1.applyHouseholderOnTheLeft(essential,beta,tmp);
   VERIFY_IS_APPROX(v1.norm(), v2.norm());
 
+  // a vector so small that its squared norm underflows must still be reflected onto its first axis
+  RealScalar tiny = (std::numeric_limits<RealScalar>::min)() / NumTraits<RealScalar>::epsilon();
+  v1 = VectorType::Random(rows) * tiny;
+  v2 = v1;
+  v1.makeHouseholder(essential, beta, alpha);
+  v1.applyHouseholderOnTheLeft(essential,beta,tmp);
+  VERIFY_IS_APPROX((v1 / tiny).norm(), (v2 / tiny).norm());
+  VERIFY_IS_APPROX(ei_abs(alpha / tiny), (v2 / tiny).norm());
+  if(rows>=2) VERIFY_IS_MUCH_SMALLER_THAN((v1.tail(rows-1) / tiny).norm(), (v1 / tiny).norm());
+
   MatrixType m1(rows, cols),
              m2(rows, cols);
 
@@ -86,16 +86,6 @@ struct packet_helper<false,Packet>
 #define REF_MUL(a,b) ((a)*(b))
 #define REF_DIV(a,b) ((a)/(b))
 
-namespace std {
-
-template<> const complex<float>& min(const complex<float>& a, const complex<float>& b)
-{ return a.real() < b.real() ? a : b; }
-
-template<> const complex<float>& max(const complex<float>& a, const complex<float>& b)
-{ return a.real() < b.real() ? b : a; }
-
-}
-
 template<typename Scalar> void packetmath()
 {
   typedef typename ei_packet_traits<Scalar>::type Packet;
@@ -151,9 +141,6 @@ template<typename Scalar> void packetmath()
   if (!ei_is_same_type<Scalar,int>::ret)
     CHECK_CWISE2(REF_DIV,  ei_pdiv);
   #endif
-  CHECK_CWISE2(std::min, ei_pmin);
-  CHECK_CWISE2(std::max, ei_pmax);
-  CHECK_CWISE1(ei_abs, ei_pabs);
   CHECK_CWISE1(ei_negate, ei_pnegate);
 
   for (int i=0; i<PacketSize; ++i)
@@ -173,16 +160,6 @@ template<typename Scalar> void packetmath()
     ref[0] *= data1[i];
   VERIFY(ei_isApprox(ref[0], ei_predux_mul(ei_pload(data1))) && "ei_predux_mul");
 
-  ref[0] = data1[0];
-  for (int i=0; i<PacketSize; ++i)
-    ref[0] = std::min(ref[0],data1[i]);
-  VERIFY(ei_isApprox(ref[0], ei_predux_min(ei_pload(data1))) && "ei_predux_min");
-
-  ref[0] = data1[0];
-  for (int i=0; i<PacketSize; ++i)
-    ref[0] = std::max(ref[0],data1[i]);
-  VERIFY(ei_isApprox(ref[0], ei_predux_max(ei_pload(data1))) && "ei_predux_max");
-
   for (int j=0; j<PacketSize; ++j)
   {
     ref[j] = 0;
@@ -199,6 +176,86 @@ template<typename Scalar> void packetmath()
   VERIFY(areApprox(ref, data2, PacketSize) && "ei_preverse");
 }
 
+template<typename Scalar> void packetmath_notcomplex()
+{
+  typedef typename ei_packet_traits<Scalar>::type Packet;
+  const int PacketSize = ei_packet_traits<Scalar>::size;
+
+  EIGEN_ALIGN16 Scalar data1[ei_packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN16 Scalar data2[ei_packet_traits<Scalar>::size*4];
+  EIGEN_ALIGN16 Scalar ref[ei_packet_traits<Scalar>::size*4];
+
+  for (int i=0; i<PacketSize*4; ++i)
+    data1[i] = ei_random<Scalar>();
+
+  CHECK_CWISE2(std::min, ei_pmin);
+  CHECK_CWISE2(std::max, ei_pmax);
+  CHECK_CWISE1(ei_abs, ei_pabs);
+  CHECK_CWISE1(ei_conj, ei_pconj);
+
+  ref[0] = data1[0];
+  for (int i=0; i<PacketSize; ++i)
+    ref[0] = std::min(ref[0],data1[i]);
+  VERIFY(ei_isApprox(ref[0], ei_predux_min(ei_pload(data1))) && "ei_predux_min");
+
+  ref[0] = data1[0];
+  for (int i=0; i<PacketSize; ++i)
+    ref[0] = std::max(ref[0],data1[i]);
+  VERIFY(ei_isApprox(ref[0], ei_predux_max(ei_pload(data1))) && "ei_predux_max");
+}
+
+template<bool ConjLhs, bool ConjRhs, typename Scalar>
+void test_conj_helper(Scalar* data1, Scalar* data2, Scalar* ref, Scalar* pval)
+{
+  typedef typename ei_packet_traits<Scalar>::type Packet;
+  const int PacketSize = ei_packet_traits<Scalar>::size;
+  ei_conj_if<ConjLhs> cj0;
+  ei_conj_if<ConjRhs> cj1;
+  ei_conj_helper<ConjLhs,ConjRhs> cj;
+
+  for(int i=0;i<PacketSize;++i)
+  {
+    ref[i] = cj0(data1[i]) * cj1(data2[i]);
+    VERIFY(ei_isApprox(ref[i], cj.pmul(data1[i],data2[i])) && "conj_helper pmul");
+  }
+  ei_pstore(pval,cj.pmul(ei_pload(data1),ei_pload(data2)));
+  VERIFY(areApprox(ref, pval, PacketSize) && "conj_helper pmul");
+
+  for(int i=0;i<PacketSize;++i)
+  {
+    Scalar tmp = ref[i];
+    ref[i] += cj0(data1[i]) * cj1(data2[i]);
+    VERIFY(ei_isApprox(ref[i], cj.pmadd(data1[i],data2[i],tmp)) && "conj_helper pmadd");
+  }
+  ei_pstore(pval,cj.pmadd(ei_pload(data1),ei_pload(data2),ei_pload(pval)));
+  VERIFY(areApprox(ref, pval, PacketSize) && "conj_helper pmadd");
+}
+
+template<typename Scalar> void packetmath_complex()
+{
+  typedef typename ei_packet_traits<Scalar>::type Packet;
+  const int PacketSize = ei_packet_traits<Scalar>::size;
+
+  const int size = PacketSize*4;
+  EIGEN_ALIGN16 Scalar data1[PacketSize*4];
+  EIGEN_ALIGN16 Scalar data2[PacketSize*4];
+  EIGEN_ALIGN16 Scalar ref[PacketSize*4];
+  EIGEN_ALIGN16 Scalar pval[PacketSize*4];
+
+  for (int i=0; i<size; ++i)
+  {
+    data1[i] = ei_random<Scalar>() * Scalar(1e2);
+    data2[i] = ei_random<Scalar>() * Scalar(1e2);
+  }
+
+  CHECK_CWISE1(ei_conj, ei_pconj);
+
+  test_conj_helper<false,false> (data1,data2,ref,pval);
+  test_conj_helper<false,true>  (data1,data2,ref,pval);
+  test_conj_helper<true,false>  (data1,data2,ref,pval);
+  test_conj_helper<true,true>   (data1,data2,ref,pval);
+}
+
 template<typename Scalar> void packetmath_real()
 {
   typedef typename ei_packet_traits<Scalar>::type Packet;
@@ -239,9 +296,17 @@ void test_packetmath()
     CALL_SUBTEST_1( packetmath<float>() );
     CALL_SUBTEST_2( packetmath<double>() );
     CALL_SUBTEST_3( packetmath<int>() );
-    CALL_SUBTEST_1( packetmath<std::complex<float> >() );
-    
+    CALL_SUBTEST_4( packetmath<std::complex<float> >() );
+    CALL_SUBTEST_5( packetmath<std::complex<double> >() );
+
+    CALL_SUBTEST_1( packetmath_notcomplex<float>() );
+    CALL_SUBTEST_2( packetmath_notcomplex<double>() );
+    CALL_SUBTEST_3( packetmath_notcomplex<int>() );
+
     CALL_SUBTEST_1( packetmath_real<float>() );
     CALL_SUBTEST_2( packetmath_real<double>() );
+
+    CALL_SUBTEST_4( packetmath_complex<std::complex<float> >() );
+    CALL_SUBTEST_5( packetmath_complex<std::complex<double> >() );
   }
 }
@@ -0,0 +1,158 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+// use a tiny threshold so that the parallel paths are exercised by small objects
+#define EIGEN_PARALLELIZE_ASSIGN
+#define EIGEN_PARALLEL_ASSIGN_THRESHOLD 16
+#include "main.h"
+
+template<typename Dst, typename Src>
+void check_assign(Dst& dst, const Src& src, int traversal)
+{
+  VERIFY(int(ei_assign_traits<Dst,Src>::Traversal)==traversal);
+  typedef Matrix<typename Dst::Scalar,Dynamic,Dynamic> DenseType;
+  DenseType ref(src.rows(), src.cols());
+  for(int j=0; j<src.cols(); ++j)
+    for(int i=0; i<src.rows(); ++i)
+      ref(i,j) = src.coeff(i,j);
+  dst = src;
+  VERIFY_IS_APPROX(DenseType(dst), ref);
+}
+
+template<typename Scalar> void parallel_assign(int rows, int cols)
+{
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrixType;
+  const int size = rows*cols;
+
+  VectorType v1 = VectorType::Random(size), v2 = VectorType::Random(size), v3(size);
+  MatrixType m1 = MatrixType::Random(rows,cols), m2 = MatrixType::Random(rows,cols), m3(rows,cols);
+  RowMatrixType rm1 = RowMatrixType::Random(rows,cols);
+
+  if(ei_packet_traits<Scalar>::size>1)
+  {
+    check_assign(v3, v1.cwiseProduct(v2) + v1, LinearVectorizedTraversal);
+    // unaligned start and end
+    VectorBlock<VectorType> s3 = v3.segment(1,size-2);
+    check_assign(s3, v1.segment(2,size-2) - v2.segment(0,size-2), LinearVectorizedTraversal);
+    Block<MatrixType> b3 = m3.block(1,1,rows-2,cols-1);
+    check_assign(b3, m1.block(0,1,rows-2,cols-1) + m2.block(2,0,rows-2,cols-1), SliceVectorizedTraversal);
+  }
+  check_assign(m3, m1.transpose().transpose() * Scalar(2), ei_assign_traits<MatrixType,MatrixType>::Traversal);
+  check_assign(m3, rm1, DefaultTraversal);
+
+  // compound assignments go through the same paths
+  v3 = v1;
+  v3 += v2;
+  VERIFY_IS_APPROX(v3, v1+v2);
+  m3 = m1;
+  m3.block(1,1,rows-2,cols-1) -= m2.block(1,1,rows-2,cols-1);
+  VERIFY_IS_APPROX(m3.block(1,1,rows-2,cols-1), m1.block(1,1,rows-2,cols-1) - m2.block(1,1,rows-2,cols-1));
+}
+
+template<typename Scalar> void parallel_assign_linspaced(int size)
+{
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  // sequential LinSpaced can only be assigned in order
+  VectorType v(size);
+  v.setLinSpaced(Scalar(-1), Scalar(1), size);
+  VERIFY_IS_APPROX(v, VectorType::LinSpaced(Scalar(-1), Scalar(1), size));
+  // and so are the expressions nesting it
+  Matrix<Scalar,1,Dynamic> r(size);
+  r = VectorType::LinSpaced(Sequential, Scalar(-1), Scalar(1), size).transpose();
+  VERIFY_IS_APPROX(r, v.transpose());
+  r.array() = VectorType::LinSpaced(Sequential, Scalar(-1), Scalar(1), size).transpose().array() * Scalar(2);
+  VERIFY_IS_APPROX(r, Scalar(2) * v.transpose());
+  VectorType w(size+1);
+  w.setLinSpaced(Scalar(-1), Scalar(1), size+1);
+  r = VectorType::LinSpaced(Sequential, Scalar(-1), Scalar(1), size+1).transpose().head(size);
+  VERIFY_IS_APPROX(r, w.head(size).transpose());
+}
+
+// the assignment of an expression calling std::rand() does not depend on the number of threads
+template<typename MatrixType, typename Xpr>
+void check_assign_in_order(MatrixType& m, const Xpr& xpr, unsigned int seed)
+{
+  MatrixType ref;
+#ifdef EIGEN_HAS_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  std::srand(seed);
+  ref = xpr;
+#ifdef EIGEN_HAS_OPENMP
+  omp_set_num_threads(threads);
+#endif
+  std::srand(seed);
+  m = xpr;
+  VERIFY(m == ref);
+}
+
+template<typename Scalar> void parallel_assign_random(int rows, int cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  // Random is not repeatable and is assigned in order, so that it only depends on the seed
+  MatrixType ref(rows,cols), m(rows,cols);
+  const unsigned int seed = ei_random<int>(0,1000);
+  std::srand(seed);
+  for(int j=0; j<cols; ++j)
+    for(int i=0; i<rows; ++i)
+      ref(i,j) = ei_random<Scalar>();
+  std::srand(seed);
+  m = MatrixType::Random(rows,cols);
+  VERIFY(m == ref);
+  std::srand(seed);
+  m = Scalar(2) * MatrixType::Random(rows,cols) + MatrixType::Ones(rows,cols);
+  VERIFY_IS_APPROX(m, Scalar(2) * ref + MatrixType::Ones(rows,cols));
+  // as well as the expressions nesting it, whatever the number of threads
+  check_assign_in_order(m, MatrixType::Random(cols,rows).transpose(), seed);
+  check_assign_in_order(m, (MatrixType::Random(rows,cols).array() * Scalar(2)).matrix(), seed);
+  check_assign_in_order(m, MatrixType::Random(rows+1,cols).topRows(rows), seed);
+}
+
+void parallel_assign_fixed_inner(int cols)
+{
+  Matrix<float,4,Dynamic> m1 = Matrix<float,4,Dynamic>::Random(4,cols), m2(4,cols);
+  check_assign(m2, m1 * 2.f, ei_packet_traits<float>::size==4 ? InnerVectorizedTraversal : LinearTraversal);
+  Matrix<double,3,Dynamic> d1 = Matrix<double,3,Dynamic>::Random(3,cols), d2(3,cols);
+  check_assign(d2, d1.cast<float>().cast<double>(), LinearTraversal);
+}
+
+void test_parallel_assign()
+{
+#ifdef EIGEN_HAS_OPENMP
+  // the parallel paths are only taken with several threads
+  if(omp_get_max_threads() < 2)
+    omp_set_num_threads(2);
+#endif
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( parallel_assign<float>(ei_random<int>(3,200), ei_random<int>(3,200)) ));
+    CALL_SUBTEST_2(( parallel_assign<double>(ei_random<int>(3,200), ei_random<int>(3,200)) ));
+    CALL_SUBTEST_3(( parallel_assign<std::complex<double> >(ei_random<int>(3,100), ei_random<int>(3,100)) ));
+    CALL_SUBTEST_4(( parallel_assign_fixed_inner(ei_random<int>(1,2000)) ));
+    CALL_SUBTEST_1(( parallel_assign_linspaced<float>(ei_random<int>(2,5000)) ));
+    CALL_SUBTEST_2(( parallel_assign_linspaced<double>(ei_random<int>(2,5000)) ));
+    CALL_SUBTEST_1(( parallel_assign_random<float>(ei_random<int>(1,200), ei_random<int>(1,200)) ));
+    CALL_SUBTEST_3(( parallel_assign_random<std::complex<double> >(ei_random<int>(1,100), ei_random<int>(1,100)) ));
+  }
+}
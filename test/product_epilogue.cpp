@@ -0,0 +1,147 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "main.h"
+
+// vectorized activation
+template<typename Scalar> struct relu_op {
+  Scalar operator() (const Scalar& a) const { return std::max(a, Scalar(0)); }
+  template<typename Packet>
+  Packet packetOp(const Packet& a) const { return ei_pmax(a, ei_pset1(Scalar(0))); }
+};
+namespace Eigen {
+template<typename Scalar> struct ei_functor_traits<relu_op<Scalar> >
+{ enum { Cost = NumTraits<Scalar>::AddCost, PacketAccess = true }; };
+}
+
+// activation without packet access, applied coefficient by coefficient by the kernel
+template<typename Scalar> struct clamp_op {
+  Scalar operator() (const Scalar& a) const { return std::min(std::max(a, Scalar(-1)), Scalar(1)); }
+};
+
+template<typename MatrixType, typename Epilogue>
+void epilogue_reference(MatrixType& dst, const MatrixType& prod, const Epilogue& epilogue)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  for(int j=0; j<dst.cols(); ++j)
+    for(int i=0; i<dst.rows(); ++i)
+    {
+      Scalar x = prod(i,j) + epilogue.beta() * dst(i,j);
+      if(epilogue.rowBias()) x += epilogue.rowBias()[i];
+      if(epilogue.colBias()) x += epilogue.colBias()[j];
+      dst(i,j) = epilogue.functor()(x);
+    }
+}
+
+template<typename MatrixType, typename DestType, typename Epilogue>
+void check_epilogue(const MatrixType& a, const MatrixType& b, const DestType& dst0, const Epilogue& epilogue)
+{
+  DestType dst = dst0, ref = dst0;
+  (a*b).evalTo(dst, epilogue);
+  epilogue_reference(ref, DestType(a*b), epilogue);
+  VERIFY_IS_APPROX(dst, ref);
+}
+
+template<typename MatrixType> void product_epilogue(const MatrixType& m, int depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  typedef Matrix<Scalar, Dynamic, Dynamic, RowMajor> RowMajorMatrixType;
+  int rows = m.rows();
+  int cols = m.cols();
+
+  MatrixType a = MatrixType::Random(rows, depth),
+             b = MatrixType::Random(depth, cols),
+             c = MatrixType::Random(rows, cols);
+  VectorType rowBias = VectorType::Random(rows),
+             colBias = VectorType::Random(cols);
+  Scalar beta = ei_random<Scalar>();
+
+  // by default the epilogue overwrites the destination
+  check_epilogue(a, b, c, GemmEpilogue<Scalar>());
+  check_epilogue(a, b, c, GemmEpilogue<Scalar>().setBeta(1));
+  check_epilogue(a, b, c, GemmEpilogue<Scalar>().setBeta(beta));
+  check_epilogue(a, b, c, GemmEpilogue<Scalar>().setBeta(beta).setRowBias(rowBias));
+  check_epilogue(a, b, c, GemmEpilogue<Scalar>().setColBias(colBias));
+  check_epilogue(a, b, c, GemmEpilogue<Scalar>().setBeta(beta).setRowBias(rowBias).setColBias(colBias));
+  check_epilogue(a, b, RowMajorMatrixType(c), GemmEpilogue<Scalar>().setBeta(beta).setRowBias(rowBias).setColBias(colBias));
+
+  // scalar factors of the product
+  MatrixType ref = c;
+  (Scalar(2)*a*b).evalTo(c, GemmEpilogue<Scalar>().setBeta(beta).setRowBias(rowBias));
+  epilogue_reference(ref, MatrixType(Scalar(2)*a*b), GemmEpilogue<Scalar>().setBeta(beta).setRowBias(rowBias));
+  VERIFY_IS_APPROX(c, ref);
+
+  // block of a larger destination and segment of a larger bias
+  MatrixType big = MatrixType::Random(rows+3, cols+2);
+  VectorType bigBias = VectorType::Random(rows+5);
+  ref = big;
+  GemmEpilogue<Scalar> epilogue;
+  epilogue.setBeta(beta).setRowBias(bigBias.segment(2,rows));
+  Block<MatrixType> dst = big.block(1,2,rows,cols);
+  (a*b).evalTo(dst, epilogue);
+  MatrixType refBlock = ref.block(1,2,rows,cols);
+  epilogue_reference(refBlock, MatrixType(a*b), epilogue);
+  ref.block(1,2,rows,cols) = refBlock;
+  VERIFY_IS_APPROX(big, ref);
+}
+
+template<typename MatrixType> void product_epilogue_activation(const MatrixType& m, int depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  typedef Matrix<Scalar, Dynamic, Dynamic, RowMajor> RowMajorMatrixType;
+  int rows = m.rows();
+  int cols = m.cols();
+
+  MatrixType a = MatrixType::Random(rows, depth),
+             b = MatrixType::Random(depth, cols),
+             c = MatrixType::Random(rows, cols);
+  VectorType rowBias = VectorType::Random(rows),
+             colBias = VectorType::Random(cols);
+
+  check_epilogue(a, b, c, GemmEpilogue<Scalar, relu_op<Scalar> >().setRowBias(rowBias));
+  check_epilogue(a, b, c, GemmEpilogue<Scalar, relu_op<Scalar> >().setBeta(Scalar(0.5)).setColBias(colBias));
+  check_epilogue(a, b, RowMajorMatrixType(c), GemmEpilogue<Scalar, relu_op<Scalar> >().setRowBias(rowBias).setColBias(colBias));
+  check_epilogue(a, b, c, GemmEpilogue<Scalar, clamp_op<Scalar> >().setBeta(Scalar(2)).setRowBias(rowBias));
+  check_epilogue(a, b, RowMajorMatrixType(c), GemmEpilogue<Scalar, clamp_op<Scalar> >().setColBias(colBias));
+
+  MatrixType d = c;
+  (a*b).evalTo(d, GemmEpilogue<Scalar, relu_op<Scalar> >());
+  VERIFY(d.minCoeff() >= Scalar(0));
+}
+
+void test_product_epilogue()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( product_epilogue(MatrixXf(ei_random<int>(1,320), ei_random<int>(1,320)), ei_random<int>(1,600)) );
+    CALL_SUBTEST_2( product_epilogue(MatrixXd(ei_random<int>(1,320), ei_random<int>(1,320)), ei_random<int>(1,600)) );
+    CALL_SUBTEST_3( product_epilogue(MatrixXcf(ei_random<int>(1,50), ei_random<int>(1,50)), ei_random<int>(1,50)) );
+    CALL_SUBTEST_4( product_epilogue_activation(MatrixXf(ei_random<int>(1,320), ei_random<int>(1,320)), ei_random<int>(1,600)) );
+    CALL_SUBTEST_5( product_epilogue_activation(MatrixXd(ei_random<int>(1,200), ei_random<int>(1,200)), ei_random<int>(1,300)) );
+  }
+
+  // empty products and products smaller than a register block
+  CALL_SUBTEST_1( product_epilogue(MatrixXf(17,5), 0) );
+  CALL_SUBTEST_2( product_epilogue(MatrixXd(3,1), 1) );
+  CALL_SUBTEST_4( product_epilogue_activation(MatrixXf(9,13), 0) );
+}
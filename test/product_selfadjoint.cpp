@@ -65,6 +65,28 @@ template<typename MatrixType> void product_selfadjoint(const MatrixType& m)
   m2.template selfadjointView<Upper>().rankUpdate(-r1.adjoint(),r2.adjoint()*s3,s1);
   VERIFY_IS_APPROX(m2, (m1 + (-s3*s1) * (r1.adjoint() * r2 + r2.adjoint() * r1)).template triangularView<Upper>().toDenseMatrix());
 
+  // rank2k update
+  MatrixType m5 = MatrixType::Random(rows, cols),
+             m6 = MatrixType::Random(rows, cols);
+  m2 = m1.template triangularView<Lower>();
+  m2.template selfadjointView<Lower>().rankUpdate(m5,m6,s1);
+  VERIFY_IS_APPROX(m2, (m1 + s1 * (m5 * m6.adjoint() + m6 * m5.adjoint())).template triangularView<Lower>().toDenseMatrix());
+
+  m2 = m1.template triangularView<Lower>();
+  m2.template selfadjointView<Lower>().rankUpdate(m5.conjugate(),m6.conjugate());
+  VERIFY_IS_APPROX(m2, (m1 + m5.conjugate() * m6.transpose() + m6.conjugate() * m5.transpose()).template triangularView<Lower>().toDenseMatrix());
+
+  RhsMatrixType m7 = RhsMatrixType::Random(rows,10);
+  m2 = m1.template triangularView<Upper>();
+  m2.template selfadjointView<Upper>().rankUpdate(m4,s3*m7,s2);
+  VERIFY_IS_APPROX(m2, (m1 + (s2*s3) * (m4 * m7.adjoint() + m7 * m4.adjoint())).template triangularView<Upper>().toDenseMatrix());
+
+  // factors with different storage orders
+  Matrix<Scalar, MatrixType::RowsAtCompileTime, Dynamic> m8 = m7;
+  m2 = m1.template triangularView<Lower>();
+  m2.template selfadjointView<Lower>().rankUpdate(m4,m8);
+  VERIFY_IS_APPROX(m2, (m1 + m4 * m7.adjoint() + m7 * m4.adjoint()).template triangularView<Lower>().toDenseMatrix());
+
   if (rows>1)
   {
     m2 = m1.template triangularView<Lower>();
@@ -136,4 +136,8 @@ void test_qr()
 
   // Test problem size constructors
   CALL_SUBTEST_12(HouseholderQR<MatrixXf>(10, 20));
+
+  // large enough for the blocked factorization
+  CALL_SUBTEST_6( qr(MatrixXd(250,200)) );
+  CALL_SUBTEST_8( qr(MatrixXcd(110,130)) );
 }
@@ -0,0 +1,118 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "main.h"
+
+typedef Matrix<unsigned char,Dynamic,Dynamic> MatrixXuc;
+typedef Matrix<signed char,Dynamic,Dynamic> MatrixXsc;
+typedef Matrix<short,Dynamic,Dynamic> MatrixXs;
+typedef Matrix<unsigned char,Dynamic,Dynamic,RowMajor> RowMatrixXuc;
+typedef Matrix<signed char,Dynamic,Dynamic,RowMajor> RowMatrixXsc;
+typedef Matrix<int,Dynamic,Dynamic,RowMajor> RowMatrixXi;
+
+template<typename MatrixType> MatrixType random_integers(int rows, int cols, int low, int high)
+{
+  MatrixType m;
+  m.resize(rows, cols);
+  for(int j=0; j<cols; ++j)
+    for(int i=0; i<rows; ++i)
+      m(i,j) = typename MatrixType::Scalar(ei_random<int>(low,high));
+  return m;
+}
+
+template<typename Scalar> int random_low()  { return std::numeric_limits<Scalar>::min(); }
+template<typename Scalar> int random_high() { return std::numeric_limits<Scalar>::max(); }
+
+template<typename LhsType, typename RhsType, typename DestType>
+void quantized_product(int rows, int cols, int depth)
+{
+  typedef typename LhsType::Scalar LhsScalar;
+  typedef typename RhsType::Scalar RhsScalar;
+
+  LhsType a = random_integers<LhsType>(rows, depth, random_low<LhsScalar>(), random_high<LhsScalar>());
+  RhsType b = random_integers<RhsType>(depth, cols, random_low<RhsScalar>(), random_high<RhsScalar>());
+  MatrixXi ai = a.template cast<int>(), bi = b.template cast<int>();
+  DestType c = DestType::Random(rows, cols), ref;
+
+  // plain product
+  c = a * b;
+  ref = ai * bi;
+  VERIFY_IS_EQUAL(c, ref);
+
+  c.noalias() += a * b;
+  ref *= 2;
+  VERIFY_IS_EQUAL(c, ref);
+
+  // factors through Map
+  Map<Matrix<LhsScalar,Dynamic,Dynamic,LhsType::Flags&RowMajorBit ? RowMajor : ColMajor> > ma(a.data(), rows, depth);
+  Map<Matrix<RhsScalar,Dynamic,Dynamic,RhsType::Flags&RowMajorBit ? RowMajor : ColMajor> > mb(b.data(), depth, cols);
+  c.noalias() = ma * mb;
+  VERIFY_IS_EQUAL(c, DestType(ai * bi));
+
+  // single zero points
+  int za = ei_random<int>(random_low<LhsScalar>(), random_high<LhsScalar>());
+  int zb = ei_random<int>(random_low<RhsScalar>(), random_high<RhsScalar>());
+  (a * b).evalTo(c, GemmZeroPoints().setLhsZeroPoint(za));
+  VERIFY_IS_EQUAL(c, DestType((ai.array()-za).matrix() * bi));
+  (a * b).evalTo(c, GemmZeroPoints().setRhsZeroPoint(zb));
+  VERIFY_IS_EQUAL(c, DestType(ai * (bi.array()-zb).matrix()));
+  (a * b).evalTo(c, GemmZeroPoints().setLhsZeroPoint(za).setRhsZeroPoint(zb));
+  VERIFY_IS_EQUAL(c, DestType((ai.array()-za).matrix() * (bi.array()-zb).matrix()));
+
+  // zero points per row of the lhs and per column of the rhs
+  VectorXi zas = random_integers<VectorXi>(rows, 1, random_low<LhsScalar>(), random_high<LhsScalar>());
+  VectorXi zbs = random_integers<VectorXi>(cols, 1, random_low<RhsScalar>(), random_high<RhsScalar>());
+  MatrixXi ac = ai.colwise() - zas, bc = bi.rowwise() - zbs.transpose();
+  (a * b).evalTo(c, GemmZeroPoints().setLhsZeroPoints(zas).setRhsZeroPoints(zbs));
+  VERIFY_IS_EQUAL(c, DestType(ac * bc));
+  (a * b).evalTo(c, GemmZeroPoints().setLhsZeroPoints(zas).setRhsZeroPoint(zb));
+  VERIFY_IS_EQUAL(c, DestType(ac * (bi.array()-zb).matrix()));
+
+  // zero points and epilogue
+  VectorXi bias = VectorXi::Random(rows);
+  DestType c0 = c;
+  (a * b).evalTo(c, GemmZeroPoints().setLhsZeroPoints(zas).setRhsZeroPoints(zbs), GemmEpilogue<int>().setBeta(3).setRowBias(bias));
+  ref = ac * bc + 3 * c0;
+  ref.colwise() += bias;
+  VERIFY_IS_EQUAL(c, ref);
+}
+
+void test_quantized_product()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    int rows = ei_random<int>(1,320), cols = ei_random<int>(1,320), depth = ei_random<int>(1,800);
+    CALL_SUBTEST_1(( quantized_product<MatrixXuc, MatrixXsc, MatrixXi>(rows, cols, depth) ));
+    CALL_SUBTEST_2(( quantized_product<RowMatrixXsc, MatrixXuc, RowMatrixXi>(rows, cols, depth) ));
+    CALL_SUBTEST_3(( quantized_product<MatrixXs, RowMatrixXsc, MatrixXi>(rows, cols, depth) ));
+    CALL_SUBTEST_4(( quantized_product<RowMatrixXuc, MatrixXs, RowMatrixXi>(rows, cols, depth) ));
+  }
+
+  // empty products and products smaller than a register block
+  CALL_SUBTEST_1(( quantized_product<MatrixXuc, MatrixXsc, MatrixXi>(17, 5, 0) ));
+  CALL_SUBTEST_1(( quantized_product<MatrixXuc, MatrixXsc, MatrixXi>(3, 1, 1) ));
+  CALL_SUBTEST_2(( quantized_product<RowMatrixXsc, MatrixXuc, RowMatrixXi>(9, 2, 3) ));
+
+  // a product of two signed char matrices is quantized by widening one of them
+  MatrixXsc a = random_integers<MatrixXsc>(40, 70, -128, 127), b = random_integers<MatrixXsc>(70, 30, -128, 127);
+  MatrixXi c = a.cast<short>() * b;
+  CALL_SUBTEST_1( VERIFY_IS_EQUAL(c, MatrixXi(a.cast<int>() * b.cast<int>())) );
+}
@@ -0,0 +1,122 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "sparse.h"
+#include <Eigen/SVD>
+
+template<typename MatrixType> void randomizedsvd_check(const MatrixType& a, int rank)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> DynamicMatrixType;
+
+  RandomizedSVD<MatrixType> svd(a, rank);
+  VERIFY(svd.singularValues().size() == rank);
+  VERIFY(svd.matrixU().rows() == a.rows() && svd.matrixU().cols() == rank);
+  VERIFY(svd.matrixV().rows() == a.cols() && svd.matrixV().cols() == rank);
+
+  BDCSVD<MatrixType> ref(a, 0);
+  VERIFY_IS_APPROX(svd.singularValues(), ref.singularValues().head(rank));
+  VERIFY_IS_APPROX(svd.matrixU().adjoint() * svd.matrixU(), DynamicMatrixType::Identity(rank,rank));
+  VERIFY_IS_APPROX(svd.matrixV().adjoint() * svd.matrixV(), DynamicMatrixType::Identity(rank,rank));
+  VERIFY_IS_APPROX(a * svd.matrixV(), svd.matrixU() * svd.singularValues().template cast<Scalar>().asDiagonal());
+  VERIFY_IS_APPROX(a.adjoint() * svd.matrixU(), svd.matrixV() * svd.singularValues().template cast<Scalar>().asDiagonal());
+
+  RandomizedSVD<MatrixType> values(a, rank, 0);
+  VERIFY_IS_APPROX(values.singularValues(), ref.singularValues().head(rank));
+}
+
+template<typename MatrixType> void randomizedsvd(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  int rows = m.rows();
+  int cols = m.cols();
+  int diagSize = std::min(rows, cols);
+
+  // the decomposition is exact when the rank of the matrix does not exceed the number of samples
+  int rank = ei_random<int>(1, std::min(diagSize, 10));
+  int trueRank = std::min(diagSize, rank + ei_random<int>(0, 10));
+  MatrixType u = MatrixType::Random(rows, trueRank);
+  MatrixType v = MatrixType::Random(cols, trueRank);
+  Matrix<RealScalar,Dynamic,1> s(trueRank);
+  for(int i = 0; i < trueRank; ++i)
+    s(i) = RealScalar(1) + RealScalar(i);
+  MatrixType a = u * s.template cast<Scalar>().asDiagonal() * v.adjoint();
+  randomizedsvd_check(a, rank);
+  randomizedsvd_check(MatrixType(a.adjoint()), rank);
+
+  // full rank matrix with fast decaying singular values
+  MatrixType b = MatrixType::Random(rows, diagSize);
+  for(int i = 0; i < diagSize; ++i)
+    b.col(i) *= std::pow(RealScalar(0.1), RealScalar(i));
+  b = b * MatrixType::Random(diagSize, cols);
+  RandomizedSVD<MatrixType> svd;
+  svd.setOversampling(diagSize).compute(b, rank);
+  VERIFY_IS_APPROX(svd.singularValues(), BDCSVD<MatrixType>(b, 0).singularValues().head(rank));
+}
+
+template<typename Scalar> void randomizedsvd_sparse(int rows, int cols)
+{
+  typedef Matrix<Scalar, Dynamic, Dynamic> DenseMatrix;
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrix<Scalar> m(rows, cols);
+  initSparse<Scalar>(0.1, refMat, m);
+
+  // with the same random sketch, the sparse and dense versions must agree
+  int rank = ei_random<int>(1, 10);
+  unsigned int seed = (unsigned int) std::time(NULL);
+  std::srand(seed);
+  RandomizedSVD<SparseMatrix<Scalar> > svd(m, rank);
+  std::srand(seed);
+  RandomizedSVD<DenseMatrix> ref(refMat, rank);
+  VERIFY_IS_APPROX(svd.singularValues(), ref.singularValues());
+  VERIFY_IS_APPROX(svd.matrixU().cwiseAbs(), ref.matrixU().cwiseAbs());
+  VERIFY_IS_APPROX(svd.matrixV().cwiseAbs(), ref.matrixV().cwiseAbs());
+}
+
+template<typename MatrixType> void randomizedsvd_verify_assert()
+{
+  RandomizedSVD<MatrixType> svd;
+  VERIFY_RAISES_ASSERT(svd.matrixU())
+  VERIFY_RAISES_ASSERT(svd.singularValues())
+  VERIFY_RAISES_ASSERT(svd.matrixV())
+
+  MatrixType a = MatrixType::Random(10,10);
+  svd.compute(a, 2, ComputeThinU);
+  VERIFY_RAISES_ASSERT(svd.matrixV())
+  VERIFY_RAISES_ASSERT(svd.compute(a, 2, ComputeFullU))
+  VERIFY_RAISES_ASSERT(svd.compute(a, 11))
+}
+
+void test_randomizedsvd()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( randomizedsvd(MatrixXf(ei_random<int>(1,30), ei_random<int>(1,30))) ));
+    CALL_SUBTEST_2(( randomizedsvd(MatrixXd(ei_random<int>(20,200), ei_random<int>(20,200))) ));
+    CALL_SUBTEST_3(( randomizedsvd(MatrixXcd(ei_random<int>(20,100), ei_random<int>(20,100))) ));
+    CALL_SUBTEST_4(( randomizedsvd_sparse<double>(ei_random<int>(20,300), ei_random<int>(20,300)) ));
+  }
+  CALL_SUBTEST_2(( randomizedsvd(MatrixXd(1000,300)) ));
+
+  CALL_SUBTEST_2( randomizedsvd_verify_assert<MatrixXd>() );
+}
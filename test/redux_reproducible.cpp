@@ -0,0 +1,152 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+// use a tiny threshold so that the parallel paths are exercised by small objects
+#define EIGEN_REDUX_CHUNK_SIZE 1000
+#include "main.h"
+
+// reference sum in extended precision
+template<typename Scalar> struct extended_scalar { typedef long double type; };
+template<> struct extended_scalar<int> { typedef int type; };
+template<typename Real> struct extended_scalar<std::complex<Real> > { typedef std::complex<long double> type; };
+
+template<typename VectorType>
+typename VectorType::Scalar reference_sum(const VectorType& v)
+{
+  typedef typename VectorType::Scalar Scalar;
+  typedef typename extended_scalar<Scalar>::type ExtendedScalar;
+  ExtendedScalar res(0);
+  for(int i = 0; i < v.size(); ++i)
+    res += ExtendedScalar(v.coeff(i));
+  return Scalar(res);
+}
+
+template<typename Scalar> void redux_reproducible(int size)
+{
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  VectorType v1 = VectorType::Random(size), v2 = VectorType::Random(size);
+  Scalar ref = reference_sum(v1);
+  VERIFY_IS_APPROX(v1.sum(Pairwise), ref);
+  VERIFY_IS_APPROX(v1.sum(Kahan), ref);
+  VERIFY_IS_APPROX(v1.dot(v2, Pairwise), v1.dot(v2));
+  VERIFY_IS_APPROX(v1.dot(v2, Kahan), v1.dot(v2));
+  VERIFY_IS_APPROX(v1.squaredNorm(Pairwise), v1.squaredNorm());
+  VERIFY_IS_APPROX(v1.squaredNorm(Kahan), v1.squaredNorm());
+  VERIFY_IS_APPROX(v1.redux(ei_scalar_sum_op<Scalar>(), Pairwise), ref);
+  VERIFY_IS_APPROX((v1+v2).sum(Pairwise), v1.sum()+v2.sum());
+
+  // the result does not depend on the alignment of the data
+  const int packetSize = ei_packet_traits<Scalar>::size;
+  VectorType buffer(size + packetSize);
+  const Scalar pairwiseSum = v1.sum(Pairwise), kahanSum = v1.sum(Kahan), dot = v1.dot(v2, Pairwise);
+  for(int offset = 1; offset < packetSize; ++offset)
+  {
+    buffer.segment(offset, size) = v1;
+    VERIFY(buffer.segment(offset, size).sum(Pairwise) == pairwiseSum);
+    VERIFY(buffer.segment(offset, size).sum(Kahan) == kahanSum);
+    VERIFY(buffer.segment(offset, size).dot(v2, Pairwise) == dot);
+  }
+
+#ifdef EIGEN_HAS_OPENMP
+  // nor on the number of threads
+  const int threads = omp_get_max_threads();
+  for(int t = 1; t <= 4; ++t)
+  {
+    omp_set_num_threads(t);
+    VERIFY(v1.sum(Pairwise) == pairwiseSum);
+    VERIFY(v1.sum(Kahan) == kahanSum);
+    VERIFY(v1.dot(v2, Pairwise) == dot);
+  }
+  omp_set_num_threads(threads);
+#endif
+
+  // empty vectors sum to zero
+  VERIFY(VectorType().sum(Pairwise) == Scalar(0));
+  VERIFY(VectorType().sum(Kahan) == Scalar(0));
+}
+
+template<typename MatrixType> void redux_reproducible_matrix(int rows, int cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,ei_traits<MatrixType>::Options> LargerMatrixType;
+  MatrixType m1 = MatrixType::Random(rows, cols);
+  LargerMatrixType m2 = LargerMatrixType::Random(rows+3, cols+3), m3 = m2;
+  // the sums are compared relatively to the sum of the magnitudes, as they may cancel out
+  RealScalar magnitude = m1.cwiseAbs().sum();
+
+  VERIFY(ei_isMuchSmallerThan(m1.sum(Pairwise) - m1.sum(), magnitude));
+  VERIFY(ei_isMuchSmallerThan(m1.sum(Kahan) - m1.sum(), magnitude));
+  VERIFY_IS_APPROX(m1.squaredNorm(Kahan), m1.squaredNorm());
+  VERIFY_IS_APPROX(m1.col(0).norm(Pairwise), m1.col(0).norm());
+  VERIFY_IS_APPROX(m1.row(0).norm(Kahan), m1.row(0).norm());
+  VERIFY(m1.real().redux(ei_scalar_min_op<RealScalar>(), Pairwise) == m1.real().minCoeff());
+  VERIFY(m1.real().redux(ei_scalar_max_op<RealScalar>(), Pairwise) == m1.real().maxCoeff());
+  VERIFY_IS_APPROX(m1.col(0).cwiseAbs().redux(ei_scalar_product_op<RealScalar>(), Pairwise),
+                   m1.col(0).cwiseAbs().redux(ei_scalar_product_op<RealScalar>()));
+
+  // blocks are reduced inner vector by inner vector, in the same order wherever they start
+  m2.block(1, 2, rows, cols) = m1;
+  m3.block(3, 0, rows, cols) = m1;
+  VERIFY(ei_isMuchSmallerThan(m2.block(1, 2, rows, cols).sum(Pairwise) - m1.sum(), magnitude));
+  VERIFY(ei_isMuchSmallerThan(m2.block(1, 2, rows, cols).sum(Kahan) - m1.sum(), magnitude));
+  VERIFY(m2.block(1, 2, rows, cols).sum(Pairwise) == m3.block(3, 0, rows, cols).sum(Pairwise));
+  VERIFY(m2.block(1, 2, rows, cols).sum(Kahan) == m3.block(3, 0, rows, cols).sum(Kahan));
+
+  // empty blocks, whose inner size may be zero
+  VERIFY(m2.block(0, 0, 0, 3).sum(Kahan) == Scalar(0));
+  VERIFY(m2.block(0, 0, 3, 0).sum(Kahan) == Scalar(0));
+  VERIFY(m2.block(0, 0, 0, 3).squaredNorm(Kahan) == RealScalar(0));
+  VERIFY(m2.block(0, 0, 3, 0).norm(Kahan) == RealScalar(0));
+  VERIFY(m2.row(0).head(0).dot(m3.row(0).head(0), Kahan) == Scalar(0));
+  VERIFY(m2.col(0).head(0).dot(m3.col(0).head(0), Kahan) == Scalar(0));
+}
+
+template<typename Scalar> void redux_reproducible_accuracy(int size)
+{
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  const Scalar eps = NumTraits<Scalar>::epsilon();
+  // many small values added to a large one are lost by a plain recursive summation
+  VectorType v = VectorType::Constant(size, eps / Scalar(4));
+  v(0) = Scalar(1);
+  const long double exact = 1.l + (size - 1) * static_cast<long double>(eps / Scalar(4));
+  VERIFY(ei_abs(v.sum(Kahan) - exact) <= eps);
+  // the error of the pairwise summation grows with the depth of the tree
+  VERIFY(ei_abs(v.sum(Pairwise) - exact) <= Scalar(std::log(double(size))) * eps);
+}
+
+void test_redux_reproducible()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( redux_reproducible<float>(ei_random<int>(1,20000)) ));
+    CALL_SUBTEST_2(( redux_reproducible<double>(ei_random<int>(1,20000)) ));
+    CALL_SUBTEST_3(( redux_reproducible<std::complex<float> >(ei_random<int>(1,10000)) ));
+    CALL_SUBTEST_4(( redux_reproducible<int>(ei_random<int>(1,20000)) ));
+    CALL_SUBTEST_1(( redux_reproducible_matrix<MatrixXf>(ei_random<int>(1,200), ei_random<int>(1,200)) ));
+    CALL_SUBTEST_2(( redux_reproducible_matrix<Matrix<double,Dynamic,Dynamic,RowMajor> >(ei_random<int>(1,200), ei_random<int>(1,200)) ));
+    CALL_SUBTEST_3(( redux_reproducible_matrix<MatrixXcf>(ei_random<int>(1,100), ei_random<int>(1,100)) ));
+    CALL_SUBTEST_5(( redux_reproducible_matrix<Matrix4f>(4, 4) ));
+  }
+  CALL_SUBTEST_1(( redux_reproducible_accuracy<float>(100000) ));
+  CALL_SUBTEST_2(( redux_reproducible_accuracy<double>(100000) ));
+}
@@ -22,6 +22,8 @@
 // License and a copy of the GNU General Public License along with
 // Eigen. If not, see <http://www.gnu.org/licenses/>.
 
+// small chunks to exercise the parallel search
+#define EIGEN_REDUX_CHUNK_SIZE 1000
 #include "main.h"
 
 template<typename MatrixType> void matrixVisitor(const MatrixType& p)
@@ -112,6 +114,115 @@ template<typename VectorType> void vectorVisitor(const VectorType& w)
   VERIFY_IS_APPROX(maxc, v.maxCoeff());
 }
 
+template<typename Derived>
+void checkSearch(const Derived& m)
+{
+  typedef typename Derived::Scalar Scalar;
+  // reference search, column by column, keeping the first extremal coefficient
+  int minrow=0,mincol=0,maxrow=0,maxcol=0;
+  for(int j = 0; j < m.cols(); j++)
+  for(int i = 0; i < m.rows(); i++)
+  {
+    if(m(i,j) < m(minrow,mincol))
+    {
+      minrow = i;
+      mincol = j;
+    }
+    if(m(i,j) > m(maxrow,maxcol))
+    {
+      maxrow = i;
+      maxcol = j;
+    }
+  }
+  int eigen_minrow, eigen_mincol, eigen_maxrow, eigen_maxcol;
+  Scalar eigen_minc = m.minCoeff(&eigen_minrow,&eigen_mincol);
+  Scalar eigen_maxc = m.maxCoeff(&eigen_maxrow,&eigen_maxcol);
+  VERIFY(minrow == eigen_minrow && mincol == eigen_mincol);
+  VERIFY(maxrow == eigen_maxrow && maxcol == eigen_maxcol);
+  VERIFY(eigen_minc == m(minrow,mincol) && eigen_minc == m.minCoeff());
+  VERIFY(eigen_maxc == m(maxrow,maxcol) && eigen_maxc == m.maxCoeff());
+}
+
+template<typename Scalar> void largeVisitor(int size)
+{
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+
+  // few distinct values, so that the extrema are repeated
+  VectorType v(size);
+  for(int i = 0; i < size; ++i)
+    v(i) = Scalar(ei_random<int>(-50,50));
+  checkSearch(v);
+  checkSearch(v.segment(1, size-2));
+  checkSearch(v.cwiseAbs());
+  checkSearch(v.transpose());
+
+  // extrema in the tail of the vector
+  v(size-1) = Scalar(100);
+  v(size-2) = Scalar(-100);
+  checkSearch(v);
+
+  int rows = ei_random<int>(1,200), cols = ei_random<int>(1,200);
+  MatrixType m(rows+2, cols);
+  for(int i = 0; i < m.size(); ++i)
+    m(i) = Scalar(ei_random<int>(-50,50));
+  checkSearch(m);
+  checkSearch(m.block(1, 0, rows, cols));
+
+#ifdef EIGEN_HAS_OPENMP
+  // the position of the first extremal coefficient does not depend on the number of threads
+  const int threads = omp_get_max_threads();
+  for(int t = 1; t <= 4; ++t)
+  {
+    omp_set_num_threads(t);
+    checkSearch(v);
+    checkSearch(m.block(1, 0, rows, cols));
+  }
+  omp_set_num_threads(threads);
+#endif
+}
+
+template<typename VectorType>
+void checkSearchIndex(const VectorType& v)
+{
+  // reference search, comparing each coefficient to the current candidate like the plain visitor
+  int mini = 0, maxi = 0;
+  for(int i = 1; i < v.size(); ++i)
+  {
+    if(v(i) < v(mini)) mini = i;
+    if(v(i) > v(maxi)) maxi = i;
+  }
+  int eigen_mini, eigen_maxi;
+  v.minCoeff(&eigen_mini);
+  v.maxCoeff(&eigen_maxi);
+  VERIFY(mini == eigen_mini);
+  VERIFY(maxi == eigen_maxi);
+}
+
+template<typename Scalar> void nanVisitor(int size)
+{
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  const Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+
+  // a NaN is skipped, even when it makes the packet extremum of its block unordered
+  VectorType v = VectorType::Random(size);
+  v(ei_random<int>(1, size-1)) = nan;
+  checkSearchIndex(v);
+
+  // a NaN at the start of a chunk other than the first one is skipped as well
+  if(size > EIGEN_REDUX_CHUNK_SIZE)
+  {
+    v = VectorType::Random(size);
+    v(EIGEN_REDUX_CHUNK_SIZE) = nan;
+    checkSearchIndex(v);
+  }
+
+  // while a NaN first coefficient is returned
+  v = VectorType::Random(size);
+  v(0) = nan;
+  checkSearchIndex(v);
+}
+
 void test_visitor()
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -128,4 +239,12 @@ void test_visitor()
     CALL_SUBTEST_9( vectorVisitor(RowVectorXd(10)) );
     CALL_SUBTEST_10( vectorVisitor(VectorXf(33)) );
   }
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_6( largeVisitor<int>(ei_random<int>(3,20000)) );
+    CALL_SUBTEST_8( largeVisitor<double>(ei_random<int>(3,20000)) );
+    CALL_SUBTEST_10( largeVisitor<float>(ei_random<int>(3,20000)) );
+    CALL_SUBTEST_8( nanVisitor<double>(ei_random<int>(2,20000)) );
+    CALL_SUBTEST_10( nanVisitor<float>(ei_random<int>(2,500)) );
+    CALL_SUBTEST_10( nanVisitor<float>(ei_random<int>(2,20000)) );
+  }
 }
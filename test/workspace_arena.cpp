@@ -0,0 +1,116 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#define EIGEN_USE_WORKSPACE_ARENA
+#define EIGEN_RUNTIME_NO_MALLOC
+
+#include "main.h"
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+
+template<typename MatrixType> void workspace_arena(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  int size = m.rows();
+
+  MatrixType a = MatrixType::Random(size, size),
+             b = MatrixType::Random(size, size),
+             spd = a * a.adjoint() + MatrixType::Identity(size, size) * Scalar(size),
+             res(size, size), ref(size, size);
+  PartialPivLU<MatrixType> lu(size);
+  LLT<MatrixType> llt(size);
+
+  // the first evaluations enlarge the arena of this thread
+  WorkspaceArena::release();
+  WorkspaceArena::resetStatistics();
+  ref.noalias() = a * b;
+  ref.noalias() += a.adjoint() * b;
+  lu.compute(a);
+  llt.compute(spd);
+  VERIFY(WorkspaceArena::allocationCount() > 0);
+  VERIFY(WorkspaceArena::heapAllocationCount() > 0);
+  VERIFY(WorkspaceArena::peakBytes() > 0);
+  VERIFY(WorkspaceArena::capacity() >= WorkspaceArena::peakBytes());
+
+  // then, the same computations do not use the heap anymore
+  MatrixType luRef = lu.matrixLU(), lltRef = llt.matrixLLT();
+  size_t capacity = WorkspaceArena::capacity();
+  WorkspaceArena::resetStatistics();
+  ei_set_is_malloc_allowed(false);
+  res.noalias() = a * b;
+  res.noalias() += a.adjoint() * b;
+  lu.compute(a);
+  llt.compute(spd);
+  ei_set_is_malloc_allowed(true);
+  VERIFY(WorkspaceArena::allocationCount() > 0);
+  VERIFY(WorkspaceArena::heapAllocationCount() == 0);
+  VERIFY(WorkspaceArena::capacity() == capacity);
+  VERIFY_IS_APPROX(res, ref);
+  VERIFY_IS_APPROX(lu.matrixLU(), luRef);
+  VERIFY_IS_APPROX(llt.matrixLLT(), lltRef);
+
+  // forbidden heap allocations raise an assertion
+  ei_set_is_malloc_allowed(false);
+  VERIFY_RAISES_ASSERT(MatrixType tmp(size, size));
+  ei_set_is_malloc_allowed(true);
+
+  // workspaces carved out of a user buffer
+  size_t bytes = WorkspaceArena::peakBytes();
+  void* buffer = ei_aligned_malloc(bytes);
+  WorkspaceArena::setBuffer(buffer, bytes);
+  WorkspaceArena::resetStatistics();
+  ei_set_is_malloc_allowed(false);
+  res.noalias() = a * b;
+  res.noalias() += a.adjoint() * b;
+  ei_set_is_malloc_allowed(true);
+  VERIFY(WorkspaceArena::heapAllocationCount() == 0);
+  VERIFY(WorkspaceArena::capacity() == bytes);
+  VERIFY_IS_APPROX(res, ref);
+
+  // the workspaces which do not fit in a user buffer are allocated on the heap
+  WorkspaceArena::setBuffer(buffer, 16);
+  WorkspaceArena::resetStatistics();
+  res.noalias() = a * b;
+  VERIFY(WorkspaceArena::heapAllocationCount() > 0);
+  VERIFY(WorkspaceArena::capacity() == 16);
+  VERIFY_IS_APPROX(res, a * b);
+  WorkspaceArena::release();
+  ei_aligned_free(buffer);
+  VERIFY(WorkspaceArena::capacity() == 0);
+
+  // reserve() enlarges the buffer ahead of time
+  WorkspaceArena::reserve(bytes);
+  WorkspaceArena::resetStatistics();
+  res.noalias() = a * b;
+  VERIFY(WorkspaceArena::heapAllocationCount() == 0);
+  VERIFY_IS_APPROX(res, a * b);
+  WorkspaceArena::release();
+}
+
+void test_workspace_arena()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( workspace_arena(MatrixXf(ei_random<int>(100,300), 1)) );
+    CALL_SUBTEST_2( workspace_arena(MatrixXd(ei_random<int>(100,300), 1)) );
+    CALL_SUBTEST_3( workspace_arena(MatrixXcd(ei_random<int>(100,200), 1)) );
+  }
+}
@@ -28,7 +28,15 @@
 namespace Eigen
 {
 
-template<typename Functor> class AutoDiffJacobian : public Functor
+/** \class AutoDiffJacobian
+  * \brief Computes the jacobian of a functor by forward automatic differentiation
+  *
+  * \param Functor the functor type, whose templated operator() is evaluated on AutoDiffScalar inputs
+  * \param MaxInputs when the number of inputs is Dynamic, a bound on it, so that the
+  *                  derivatives are stored in fixed-capacity vectors which are never allocated
+  *                  on the heap. The default is Dynamic, that is VectorX derivatives.
+  */
+template<typename Functor, int MaxInputs = Functor::InputsAtCompileTime> class AutoDiffJacobian : public Functor
 {
 public:
   AutoDiffJacobian() : Functor() {}
@@ -52,7 +60,11 @@ public:
   typedef typename Functor::JacobianType JacobianType;
   typedef typename JacobianType::Scalar Scalar;
 
-  typedef Matrix<Scalar,InputsAtCompileTime,1> DerivativeType;
+  enum {
+    MaxDerivatives = InputsAtCompileTime==Dynamic ? MaxInputs : InputsAtCompileTime
+  };
+
+  typedef Matrix<Scalar,InputsAtCompileTime,1,0,MaxDerivatives,1> DerivativeType;
   typedef AutoDiffScalar<DerivativeType> ActiveScalar;
 
 
@@ -69,6 +81,7 @@ public:
     }
 
     JacobianType& jac = *_jac;
+    ei_assert(MaxDerivatives==Dynamic || this->inputs()<=MaxDerivatives);
 
     ActiveInput ax = x.template cast<ActiveScalar>();
     ActiveValue av(jac.rows());
@@ -0,0 +1,536 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_AUTODIFF_REVERSE_H
+#define EIGEN_AUTODIFF_REVERSE_H
+
+namespace Eigen {
+
+template<typename _Scalar> class AutoDiffReverseScalar;
+
+/** \class AutoDiffTape
+  * \brief Records the operations on AutoDiffReverseScalar for reverse mode automatic differentiation
+  *
+  * \param _Scalar the real scalar type of the values and of the derivatives
+  *
+  * Each operation involving an active AutoDiffReverseScalar appends to the tape a node holding the
+  * indices of its operands and the partial derivatives with respect to them. The nodes are
+  * allocated by blocks which are kept by clear(), so that recording the same computation again
+  * does not allocate any memory. The node 0 is a sink collecting the adjoints of the constants.
+  *
+  * gradient() and jacobian() then propagate the adjoints of the outputs back to the variables,
+  * at a cost proportional to the length of the tape and independent of the number of variables.
+  * jacobian() propagates the adjoints of Batch outputs at once, in fixed-size vectors.
+  *
+  * Example:
+  * \code
+  * AutoDiffTape<double> tape;
+  * typedef AutoDiffReverseScalar<double> AD;
+  * Matrix<AD,Dynamic,1> x(n);
+  * for (int j=0; j<n; ++j)
+  *   x[j] = tape.variable(values[j]);
+  * AD y = (A.cast<AD>() * x).squaredNorm();
+  * VectorXd g;
+  * tape.gradient(y, x, g);
+  * \endcode
+  */
+template<typename _Scalar>
+class AutoDiffTape
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef AutoDiffReverseScalar<Scalar> ActiveScalar;
+
+    enum {
+      BlockBits = 12,
+      BlockSize = 1 << BlockBits,
+      Batch = 2 * ei_packet_traits<Scalar>::size
+    };
+
+    AutoDiffTape() : m_size(0) { record(0, Scalar(0), 0, Scalar(0)); }
+
+    ~AutoDiffTape()
+    {
+      for (size_t k = 0; k < m_blocks.size(); ++k)
+        ei_aligned_free(m_blocks[k]);
+    }
+
+    /** \returns a new variable of value \a value */
+    ActiveScalar variable(const Scalar& value)
+    {
+      return ActiveScalar(value, record(0, Scalar(0), 0, Scalar(0)), this);
+    }
+
+    /** \returns the number of recorded nodes */
+    int size() const { return m_size; }
+
+    /** Forgets the recorded operations and variables, keeping the memory for the next recording. */
+    void clear()
+    {
+      m_size = 0;
+      record(0, Scalar(0), 0, Scalar(0));
+    }
+
+    /** \internal appends a node of operands \a a and \a b, of partial derivatives \a da and \a db
+      * \returns the index of the new node */
+    int record(int a, const Scalar& da, int b, const Scalar& db)
+    {
+      if ((m_size >> BlockBits) == int(m_blocks.size()))
+        m_blocks.push_back(static_cast<Node*>(ei_aligned_malloc(BlockSize*sizeof(Node))));
+      Node& n = node(m_size);
+      n.a = a;
+      n.b = b;
+      n.da = da;
+      n.db = db;
+      return m_size++;
+    }
+
+    /** Computes the gradient \a g of \a y with respect to the variables \a x. */
+    template<typename InputType, typename GradientType>
+    void gradient(const ActiveScalar& y, const InputType& x, GradientType& g)
+    {
+      g.resize(x.size());
+      const int last = y.tape() ? y.index() : 0;
+      ei_assert((y.tape()==0 || y.tape()==this) && "the output was not recorded by this tape");
+      m_adjoints.setZero(last+1);
+      m_adjoints[last] = Scalar(1);
+      for (int i = last; i > 0; --i)
+      {
+        const Scalar adjoint = m_adjoints[i];
+        if (adjoint != Scalar(0))
+        {
+          const Node& n = node(i);
+          m_adjoints[n.a] += n.da * adjoint;
+          m_adjoints[n.b] += n.db * adjoint;
+        }
+      }
+      for (int j = 0; j < x.size(); ++j)
+        g[j] = (x[j].index() > 0 && x[j].index() <= last) ? m_adjoints[x[j].index()] : Scalar(0);
+    }
+
+    /** Computes the jacobian \a jac of the outputs \a y with respect to the variables \a x. */
+    template<typename ValueType, typename InputType, typename JacobianType>
+    void jacobian(const ValueType& y, const InputType& x, JacobianType& jac)
+    {
+      typedef Matrix<Scalar,Batch,1> AdjointPacket;
+      jac.resize(y.size(), x.size());
+      for (int i0 = 0; i0 < y.size(); i0 += Batch)
+      {
+        const int count = std::min<int>(Batch, y.size() - i0);
+        int last = 0;
+        for (int k = 0; k < count; ++k)
+        {
+          ei_assert((y[i0+k].tape()==0 || y[i0+k].tape()==this) && "the output was not recorded by this tape");
+          if (y[i0+k].tape())
+            last = std::max(last, y[i0+k].index());
+        }
+        m_batchAdjoints.setZero(Batch, last+1);
+        for (int k = 0; k < count; ++k)
+          if (y[i0+k].tape())
+            m_batchAdjoints(k, y[i0+k].index()) = Scalar(1);
+
+        Scalar* adjoints = m_batchAdjoints.data();
+        for (int i = last; i > 0; --i)
+        {
+          Map<AdjointPacket,Aligned> adjoint(adjoints + i*Batch);
+          if (adjoint.cwiseAbs().maxCoeff() != Scalar(0))
+          {
+            const Node& n = node(i);
+            Map<AdjointPacket,Aligned>(adjoints + n.a*Batch) += n.da * adjoint;
+            Map<AdjointPacket,Aligned>(adjoints + n.b*Batch) += n.db * adjoint;
+          }
+        }
+
+        for (int j = 0; j < x.size(); ++j)
+        {
+          const int index = x[j].index();
+          for (int k = 0; k < count; ++k)
+            jac(i0+k, j) = (index > 0 && index <= last) ? m_batchAdjoints(k, index) : Scalar(0);
+        }
+      }
+    }
+
+  protected:
+    struct Node
+    {
+      int a, b;
+      Scalar da, db;
+    };
+
+    Node& node(int i) { return m_blocks[i >> BlockBits][i & (BlockSize-1)]; }
+
+    std::vector<Node*> m_blocks;
+    int m_size;
+    Matrix<Scalar,Dynamic,1> m_adjoints;
+    Matrix<Scalar,Batch,Dynamic> m_batchAdjoints;
+
+  private:
+    AutoDiffTape(const AutoDiffTape&);
+    AutoDiffTape& operator=(const AutoDiffTape&);
+};
+
+/** \class AutoDiffReverseScalar
+  * \brief A scalar type replacement recording its operations for reverse mode automatic differentiation
+  *
+  * \param _Scalar the real scalar type of the value
+  *
+  * An AutoDiffReverseScalar is either a constant, or a variable created by AutoDiffTape::variable()
+  * and the results of operations involving it, which are recorded by the same tape. It only stores
+  * its value, its index in the tape and a pointer to the tape, so that it can be used as the scalar
+  * type of Matrix objects and within Eigen expressions, including products and reductions.
+  *
+  * It supports the same global math functions as AutoDiffScalar.
+  *
+  * \sa AutoDiffTape, AutoDiffReverseJacobian
+  */
+template<typename _Scalar>
+class AutoDiffReverseScalar
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef AutoDiffTape<Scalar> Tape;
+
+    /** Default constructor, the scalar is a constant of undefined value. */
+    AutoDiffReverseScalar() : m_index(0), m_tape(0) {}
+
+    /** Conversion from a constant. */
+    AutoDiffReverseScalar(const Scalar& value) : m_value(value), m_index(0), m_tape(0) {}
+
+    /** \internal */
+    AutoDiffReverseScalar(const Scalar& value, int index, Tape* tape) : m_value(value), m_index(index), m_tape(tape) {}
+
+    inline const Scalar& value() const { return m_value; }
+
+    /** \returns the index of the node in the tape, 0 for a constant */
+    inline int index() const { return m_index; }
+
+    /** \returns the tape recording the scalar, or 0 for a constant */
+    inline Tape* tape() const { return m_tape; }
+
+    /** \internal \returns the result of value \a value of a function of \a x of derivative \a dx */
+    static inline AutoDiffReverseScalar unary(const Scalar& value, const AutoDiffReverseScalar& x, const Scalar& dx)
+    {
+      if (x.m_tape==0)
+        return AutoDiffReverseScalar(value);
+      return AutoDiffReverseScalar(value, x.m_tape->record(x.m_index, dx, 0, Scalar(0)), x.m_tape);
+    }
+
+    /** \internal \returns the result of value \a value of a function of \a x and \a y
+      * of partial derivatives \a dx and \a dy */
+    static inline AutoDiffReverseScalar binary(const Scalar& value, const AutoDiffReverseScalar& x, const Scalar& dx,
+                                               const AutoDiffReverseScalar& y, const Scalar& dy)
+    {
+      Tape* tape = x.m_tape ? x.m_tape : y.m_tape;
+      if (tape==0)
+        return AutoDiffReverseScalar(value);
+      ei_assert((x.m_tape==0 || y.m_tape==0 || x.m_tape==y.m_tape) && "mixing variables of different tapes");
+      return AutoDiffReverseScalar(value, tape->record(x.m_index, dx, y.m_index, dy), tape);
+    }
+
+    friend inline AutoDiffReverseScalar operator+(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b)
+    { return binary(a.m_value + b.m_value, a, Scalar(1), b, Scalar(1)); }
+    friend inline AutoDiffReverseScalar operator+(const AutoDiffReverseScalar& a, const Scalar& b)
+    { return unary(a.m_value + b, a, Scalar(1)); }
+    friend inline AutoDiffReverseScalar operator+(const Scalar& a, const AutoDiffReverseScalar& b)
+    { return unary(a + b.m_value, b, Scalar(1)); }
+
+    friend inline AutoDiffReverseScalar operator-(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b)
+    { return binary(a.m_value - b.m_value, a, Scalar(1), b, Scalar(-1)); }
+    friend inline AutoDiffReverseScalar operator-(const AutoDiffReverseScalar& a, const Scalar& b)
+    { return unary(a.m_value - b, a, Scalar(1)); }
+    friend inline AutoDiffReverseScalar operator-(const Scalar& a, const AutoDiffReverseScalar& b)
+    { return unary(a - b.m_value, b, Scalar(-1)); }
+
+    friend inline AutoDiffReverseScalar operator*(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b)
+    { return binary(a.m_value * b.m_value, a, b.m_value, b, a.m_value); }
+    friend inline AutoDiffReverseScalar operator*(const AutoDiffReverseScalar& a, const Scalar& b)
+    { return unary(a.m_value * b, a, b); }
+    friend inline AutoDiffReverseScalar operator*(const Scalar& a, const AutoDiffReverseScalar& b)
+    { return unary(a * b.m_value, b, a); }
+
+    friend inline AutoDiffReverseScalar operator/(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b)
+    {
+      const Scalar q = a.m_value / b.m_value;
+      return binary(q, a, Scalar(1) / b.m_value, b, -q / b.m_value);
+    }
+    friend inline AutoDiffReverseScalar operator/(const AutoDiffReverseScalar& a, const Scalar& b)
+    { return unary(a.m_value / b, a, Scalar(1) / b); }
+    friend inline AutoDiffReverseScalar operator/(const Scalar& a, const AutoDiffReverseScalar& b)
+    {
+      const Scalar q = a / b.m_value;
+      return unary(q, b, -q / b.m_value);
+    }
+
+    inline AutoDiffReverseScalar operator-() const { return unary(-m_value, *this, Scalar(-1)); }
+
+    inline AutoDiffReverseScalar& operator+=(const AutoDiffReverseScalar& other) { return *this = *this + other; }
+    inline AutoDiffReverseScalar& operator+=(const Scalar& other) { return *this = *this + other; }
+    inline AutoDiffReverseScalar& operator-=(const AutoDiffReverseScalar& other) { return *this = *this - other; }
+    inline AutoDiffReverseScalar& operator-=(const Scalar& other) { return *this = *this - other; }
+    inline AutoDiffReverseScalar& operator*=(const AutoDiffReverseScalar& other) { return *this = *this * other; }
+    inline AutoDiffReverseScalar& operator*=(const Scalar& other) { return *this = *this * other; }
+    inline AutoDiffReverseScalar& operator/=(const AutoDiffReverseScalar& other) { return *this = *this / other; }
+    inline AutoDiffReverseScalar& operator/=(const Scalar& other) { return *this = *this / other; }
+
+#define EIGEN_AUTODIFF_REVERSE_COMPARISON(OP) \
+    friend inline bool operator OP(const AutoDiffReverseScalar& a, const AutoDiffReverseScalar& b) { return a.m_value OP b.m_value; } \
+    friend inline bool operator OP(const AutoDiffReverseScalar& a, const Scalar& b) { return a.m_value OP b; } \
+    friend inline bool operator OP(const Scalar& a, const AutoDiffReverseScalar& b) { return a OP b.m_value; }
+
+    EIGEN_AUTODIFF_REVERSE_COMPARISON(==)
+    EIGEN_AUTODIFF_REVERSE_COMPARISON(!=)
+    EIGEN_AUTODIFF_REVERSE_COMPARISON(<)
+    EIGEN_AUTODIFF_REVERSE_COMPARISON(<=)
+    EIGEN_AUTODIFF_REVERSE_COMPARISON(>)
+    EIGEN_AUTODIFF_REVERSE_COMPARISON(>=)
+
+#undef EIGEN_AUTODIFF_REVERSE_COMPARISON
+
+    friend std::ostream & operator << (std::ostream & s, const AutoDiffReverseScalar& a)
+    {
+      return s << a.value();
+    }
+
+  protected:
+    Scalar m_value;
+    int m_index;
+    Tape* m_tape;
+};
+
+template<typename _Scalar> struct NumTraits<AutoDiffReverseScalar<_Scalar> >
+  : GenericNumTraits<AutoDiffReverseScalar<_Scalar> >
+{
+  typedef AutoDiffReverseScalar<_Scalar> Real;
+  enum {
+    IsSigned = 1,
+    ReadCost = 2 * NumTraits<_Scalar>::ReadCost,
+    AddCost = 4 * NumTraits<_Scalar>::AddCost,
+    MulCost = 4 * NumTraits<_Scalar>::MulCost
+  };
+  inline static Real epsilon() { return Real(NumTraits<_Scalar>::epsilon()); }
+  inline static Real dummy_precision() { return Real(NumTraits<_Scalar>::dummy_precision()); }
+  inline static Real highest() { return Real(NumTraits<_Scalar>::highest()); }
+  inline static Real lowest() { return Real(NumTraits<_Scalar>::lowest()); }
+};
+
+/** \internal records the evaluation of \a f at \a x on \a tape, and computes its values \a v and jacobian \a jac */
+template<typename Functor, typename Tape>
+void ei_reverse_jacobian(const Functor& f, Tape& tape, const typename Functor::InputType& x,
+                         typename Functor::ValueType* v, typename Functor::JacobianType& jac)
+{
+  typedef typename Tape::ActiveScalar ActiveScalar;
+  typedef Matrix<ActiveScalar, Functor::InputsAtCompileTime, 1> ActiveInput;
+  typedef Matrix<ActiveScalar, Functor::ValuesAtCompileTime, 1> ActiveValue;
+
+  tape.clear();
+  ActiveInput ax(x.size());
+  for (int j=0; j<x.size(); j++)
+    ax[j] = tape.variable(x[j]);
+  ActiveValue av(jac.rows());
+
+  f(ax, &av);
+
+  for (int i=0; i<jac.rows(); i++)
+    (*v)[i] = av[i].value();
+  tape.jacobian(av, ax, jac);
+}
+
+/** \class AutoDiffReverseJacobian
+  * \brief Computes the jacobian of a functor by reverse automatic differentiation
+  *
+  * This has the same interface as AutoDiffJacobian, the templated operator() of the functor being
+  * evaluated on AutoDiffReverseScalar inputs. The tape is kept from one call to the next.
+  *
+  * \sa AutoDiffAdaptiveJacobian
+  */
+template<typename Functor> class AutoDiffReverseJacobian : public Functor
+{
+public:
+  AutoDiffReverseJacobian() : Functor() {}
+  AutoDiffReverseJacobian(const Functor& f) : Functor(f) {}
+  AutoDiffReverseJacobian(const AutoDiffReverseJacobian& other) : Functor(other) {}
+
+  // forward constructors
+  template<typename T0>
+  AutoDiffReverseJacobian(const T0& a0) : Functor(a0) {}
+  template<typename T0, typename T1>
+  AutoDiffReverseJacobian(const T0& a0, const T1& a1) : Functor(a0, a1) {}
+  template<typename T0, typename T1, typename T2>
+  AutoDiffReverseJacobian(const T0& a0, const T1& a1, const T1& a2) : Functor(a0, a1, a2) {}
+
+  enum {
+    InputsAtCompileTime = Functor::InputsAtCompileTime,
+    ValuesAtCompileTime = Functor::ValuesAtCompileTime
+  };
+
+  typedef typename Functor::InputType InputType;
+  typedef typename Functor::ValueType ValueType;
+  typedef typename Functor::JacobianType JacobianType;
+  typedef typename JacobianType::Scalar Scalar;
+
+  typedef AutoDiffReverseScalar<Scalar> ActiveScalar;
+  typedef AutoDiffTape<Scalar> Tape;
+
+  void operator() (const InputType& x, ValueType* v, JacobianType* _jac=0) const
+  {
+    ei_assert(v!=0);
+    if (!_jac)
+    {
+      Functor::operator()(x, v);
+      return;
+    }
+    ei_reverse_jacobian(static_cast<const Functor&>(*this), m_tape, x, v, *_jac);
+  }
+
+protected:
+  mutable Tape m_tape;
+};
+
+/** \class AutoDiffAdaptiveJacobian
+  * \brief Computes the jacobian of a functor by forward or reverse automatic differentiation
+  *
+  * The forward mode propagates the derivatives with respect to all the inputs through each
+  * operation, while the reverse mode records the operations once and then propagates the adjoints
+  * of each output back. The reverse mode is therefore used when there are fewer values than
+  * inputs, and the forward mode, as AutoDiffJacobian with the same \a MaxInputs, otherwise.
+  * The functor must provide a templated operator() accepting both kinds of active scalars.
+  *
+  * \sa AutoDiffJacobian, AutoDiffReverseJacobian
+  */
+template<typename Functor, int MaxInputs = Functor::InputsAtCompileTime>
+class AutoDiffAdaptiveJacobian : public AutoDiffJacobian<Functor, MaxInputs>
+{
+  typedef AutoDiffJacobian<Functor, MaxInputs> Base;
+public:
+  AutoDiffAdaptiveJacobian() : Base() {}
+  AutoDiffAdaptiveJacobian(const Functor& f) : Base(f) {}
+  AutoDiffAdaptiveJacobian(const AutoDiffAdaptiveJacobian& other) : Base(other) {}
+
+  // forward constructors
+  template<typename T0>
+  AutoDiffAdaptiveJacobian(const T0& a0) : Base(a0) {}
+  template<typename T0, typename T1>
+  AutoDiffAdaptiveJacobian(const T0& a0, const T1& a1) : Base(a0, a1) {}
+  template<typename T0, typename T1, typename T2>
+  AutoDiffAdaptiveJacobian(const T0& a0, const T1& a1, const T1& a2) : Base(a0, a1, a2) {}
+
+  typedef typename Base::InputType InputType;
+  typedef typename Base::ValueType ValueType;
+  typedef typename Base::JacobianType JacobianType;
+  typedef typename Base::Scalar Scalar;
+
+  /** \returns true if the jacobian is computed in reverse mode */
+  bool reverseMode() const { return this->values() < this->inputs(); }
+
+  void operator() (const InputType& x, ValueType* v, JacobianType* _jac=0) const
+  {
+    ei_assert(v!=0);
+    if (_jac && reverseMode())
+      ei_reverse_jacobian(static_cast<const Functor&>(*this), m_tape, x, v, *_jac);
+    else
+      Base::operator()(x, v, _jac);
+  }
+
+protected:
+  mutable AutoDiffTape<Scalar> m_tape;
+};
+
+}
+
+#define EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(FUNC,CODE) \
+  template<typename Scalar> \
+  inline Eigen::AutoDiffReverseScalar<Scalar> FUNC(const Eigen::AutoDiffReverseScalar<Scalar>& x) { \
+    using namespace Eigen; \
+    typedef AutoDiffReverseScalar<Scalar> ReturnType; \
+    CODE; \
+  }
+
+namespace std
+{
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(abs,
+    return ReturnType::unary(std::abs(x.value()), x, x.value() < Scalar(0) ? Scalar(-1) : Scalar(1));)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(sqrt,
+    Scalar sqrtx = std::sqrt(x.value());
+    return ReturnType::unary(sqrtx, x, Scalar(0.5) / sqrtx);)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(cos,
+    return ReturnType::unary(std::cos(x.value()), x, -std::sin(x.value()));)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(sin,
+    return ReturnType::unary(std::sin(x.value()), x, std::cos(x.value()));)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(exp,
+    Scalar expx = std::exp(x.value());
+    return ReturnType::unary(expx, x, expx);)
+
+  EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(log,
+    return ReturnType::unary(std::log(x.value()), x, Scalar(1) / x.value());)
+
+  template<typename Scalar>
+  inline Eigen::AutoDiffReverseScalar<Scalar> pow(const Eigen::AutoDiffReverseScalar<Scalar>& x, Scalar y)
+  {
+    return Eigen::AutoDiffReverseScalar<Scalar>::unary(std::pow(x.value(),y), x, y * std::pow(x.value(),y-1));
+  }
+}
+
+namespace Eigen {
+
+template<typename Scalar>
+inline const AutoDiffReverseScalar<Scalar>& ei_conj(const AutoDiffReverseScalar<Scalar>& x)  { return x; }
+template<typename Scalar>
+inline const AutoDiffReverseScalar<Scalar>& ei_real(const AutoDiffReverseScalar<Scalar>& x)  { return x; }
+template<typename Scalar>
+inline AutoDiffReverseScalar<Scalar> ei_imag(const AutoDiffReverseScalar<Scalar>&)    { return AutoDiffReverseScalar<Scalar>(Scalar(0)); }
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_abs,
+  return ReturnType::unary(ei_abs(x.value()), x, x.value() < Scalar(0) ? Scalar(-1) : Scalar(1));)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_abs2,
+  return ReturnType::unary(ei_abs2(x.value()), x, Scalar(2) * x.value());)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_sqrt,
+  Scalar sqrtx = ei_sqrt(x.value());
+  return ReturnType::unary(sqrtx, x, Scalar(0.5) / sqrtx);)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_cos,
+  return ReturnType::unary(ei_cos(x.value()), x, -ei_sin(x.value()));)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_sin,
+  return ReturnType::unary(ei_sin(x.value()), x, ei_cos(x.value()));)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_exp,
+  Scalar expx = ei_exp(x.value());
+  return ReturnType::unary(expx, x, expx);)
+
+EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY(ei_log,
+  return ReturnType::unary(ei_log(x.value()), x, Scalar(1) / x.value());)
+
+template<typename Scalar>
+inline AutoDiffReverseScalar<Scalar> ei_pow(const AutoDiffReverseScalar<Scalar>& x, Scalar y)
+{ return std::pow(x,y); }
+
+#undef EIGEN_AUTODIFF_REVERSE_DECLARE_GLOBAL_UNARY
+
+}
+
+#endif // EIGEN_AUTODIFF_REVERSE_H
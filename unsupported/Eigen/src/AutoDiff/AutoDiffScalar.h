@@ -63,6 +63,14 @@ void ei_make_coherent(const A& a, const B&b)
   * in that case, the expression template mechanism only occurs at the top Matrix level,
   * while derivatives are computed right away.
   *
+  * The derivatives of each operation are only evaluated when an AutoDiffScalar is assigned to a
+  * variable, so that a whole arithmetic expression is propagated in a single vectorized loop.
+  * With a dynamic-size \a _DerType such as \c VectorXd, each of these variables allocates its
+  * derivatives on the heap. When the number of derivatives is only bounded at compile time, a
+  * fixed-capacity type such as \c Matrix<double,Dynamic,1,0,16,1> avoids any allocation while
+  * keeping aligned, vectorized derivatives (choose a capacity which is a multiple of the packet
+  * size). AutoDiffJacobian uses such a type when given a maximal number of inputs.
+  *
   */
 
 template<typename _DerType, bool Enable> struct ei_auto_diff_special_op;
@@ -210,7 +218,6 @@ class AutoDiffScalar
       return *this;
     }
 
-    template<typename OtherDerType>
     inline const AutoDiffScalar<CwiseUnaryOp<ei_scalar_opposite_op<Scalar>, DerType> >
     operator-() const
     {
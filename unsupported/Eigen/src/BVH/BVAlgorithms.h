@@ -88,19 +88,14 @@ struct ei_intersector_helper2
   Intersector &intersector;
 };
 
-/**  Given two BVH's, runs the query on their cartesian product encapsulated by \a intersector.
-  *  The Intersector type must provide the following members: \code
-     bool intersectVolumeVolume(const BVH1::Volume &v1, const BVH2::Volume &v2) //returns true if product of volumes intersects the query
-     bool intersectVolumeObject(const BVH1::Volume &v1, const BVH2::Object &o2) //returns true if the volume-object product intersects the query
-     bool intersectObjectVolume(const BVH1::Object &o1, const BVH2::Volume &v2) //returns true if the volume-object product intersects the query
-     bool intersectObjectObject(const BVH1::Object &o1, const BVH2::Object &o2) //returns true if the search should terminate immediately
-  \endcode
-  */
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+//processes the children of the pair of nodes (index1, index2) of the tandem descent: the pairs of child volumes whose product
+//intersects the query are pushed onto todo, and the pairs involving objects are resolved immediately
 template<typename BVH1, typename BVH2, typename Intersector>
-void BVIntersect(const BVH1 &tree1, const BVH2 &tree2, Intersector &intersector) //TODO: tandem descent when it makes sense
+bool ei_intersect_pair_children(const BVH1 &tree1, const BVH2 &tree2, Intersector &intersector,
+                                typename BVH1::Index index1, typename BVH2::Index index2,
+                                std::vector<std::pair<typename BVH1::Index, typename BVH2::Index> > &todo)
 {
-  typedef typename BVH1::Index Index1;
-  typedef typename BVH2::Index Index2;
   typedef ei_intersector_helper1<typename BVH1::Volume, typename BVH1::Object, typename BVH2::Object, Intersector> Helper1;
   typedef ei_intersector_helper2<typename BVH2::Volume, typename BVH2::Object, typename BVH1::Object, Intersector> Helper2;
   typedef typename BVH1::VolumeIterator VolIter1;
@@ -113,42 +108,155 @@ void BVIntersect(const BVH1 &tree1, const BVH2 &tree2, Intersector &intersector)
   VolIter2 vBegin2 = VolIter2(), vEnd2 = VolIter2(), vCur2 = VolIter2();
   ObjIter2 oBegin2 = ObjIter2(), oEnd2 = ObjIter2(), oCur2 = ObjIter2();
 
-  std::vector<std::pair<Index1, Index2> > todo(1, std::make_pair(tree1.getRootIndex(), tree2.getRootIndex()));
+  tree1.getChildren(index1, vBegin1, vEnd1, oBegin1, oEnd1);
+  tree2.getChildren(index2, vBegin2, vEnd2, oBegin2, oEnd2);
+
+  for(; vBegin1 != vEnd1; ++vBegin1) { //go through child volumes of first tree
+    const typename BVH1::Volume &vol1 = tree1.getVolume(*vBegin1);
+    for(vCur2 = vBegin2; vCur2 != vEnd2; ++vCur2) { //go through child volumes of second tree
+      if(intersector.intersectVolumeVolume(vol1, tree2.getVolume(*vCur2)))
+        todo.push_back(std::make_pair(*vBegin1, *vCur2));
+    }
+
+    for(oCur2 = oBegin2; oCur2 != oEnd2; ++oCur2) {//go through child objects of second tree
+      Helper1 helper(*oCur2, intersector);
+      if(ei_intersect_helper(tree1, helper, *vBegin1))
+        return true; //intersector said to stop query
+    }
+  }
 
+  for(; oBegin1 != oEnd1; ++oBegin1) { //go through child objects of first tree
+    for(vCur2 = vBegin2; vCur2 != vEnd2; ++vCur2) { //go through child volumes of second tree
+      Helper2 helper(*oBegin1, intersector);
+      if(ei_intersect_helper(tree2, helper, *vCur2))
+        return true; //intersector said to stop query
+    }
+
+    for(oCur2 = oBegin2; oCur2 != oEnd2; ++oCur2) {//go through child objects of second tree
+      if(intersector.intersectObjectObject(*oBegin1, *oCur2))
+        return true; //intersector said to stop query
+    }
+  }
+  return false;
+}
+
+//runs the tandem descent from the pairs of nodes in todo, depth first
+template<typename BVH1, typename BVH2, typename Intersector>
+bool ei_intersect_tandem_helper(const BVH1 &tree1, const BVH2 &tree2, Intersector &intersector,
+                                std::vector<std::pair<typename BVH1::Index, typename BVH2::Index> > &todo)
+{
   while(!todo.empty()) {
-    tree1.getChildren(todo.back().first, vBegin1, vEnd1, oBegin1, oEnd1);
-    tree2.getChildren(todo.back().second, vBegin2, vEnd2, oBegin2, oEnd2);
+    std::pair<typename BVH1::Index, typename BVH2::Index> current = todo.back();
     todo.pop_back();
+    if(ei_intersect_pair_children(tree1, tree2, intersector, current.first, current.second, todo))
+      return true; //intersector said to stop query
+  }
+  return false;
+}
+#endif //not EIGEN_PARSED_BY_DOXYGEN
 
-    for(; vBegin1 != vEnd1; ++vBegin1) { //go through child volumes of first tree
-      const typename BVH1::Volume &vol1 = tree1.getVolume(*vBegin1);
-      for(vCur2 = vBegin2; vCur2 != vEnd2; ++vCur2) { //go through child volumes of second tree
-        if(intersector.intersectVolumeVolume(vol1, tree2.getVolume(*vCur2)))
-          todo.push_back(std::make_pair(*vBegin1, *vCur2));
-      }
+/**  Given two BVH's, runs the query on their cartesian product encapsulated by \a intersector.
+  *  The Intersector type must provide the following members: \code
+     bool intersectVolumeVolume(const BVH1::Volume &v1, const BVH2::Volume &v2) //returns true if product of volumes intersects the query
+     bool intersectVolumeObject(const BVH1::Volume &v1, const BVH2::Object &o2) //returns true if the volume-object product intersects the query
+     bool intersectObjectVolume(const BVH1::Object &o1, const BVH2::Volume &v2) //returns true if the volume-object product intersects the query
+     bool intersectObjectObject(const BVH1::Object &o1, const BVH2::Object &o2) //returns true if the search should terminate immediately
+  \endcode
+  *  Both trees are descended in tandem: the children of a pair of nodes are only visited if the product of their volumes
+  *  intersects the query.  When one of the nodes of a pair is an object, the rest of the other tree is searched for that object alone.
+  */
+template<typename BVH1, typename BVH2, typename Intersector>
+void BVIntersect(const BVH1 &tree1, const BVH2 &tree2, Intersector &intersector)
+{
+  typedef typename BVH1::Index Index1;
+  typedef typename BVH2::Index Index2;
 
-      for(oCur2 = oBegin2; oCur2 != oEnd2; ++oCur2) {//go through child objects of second tree
-        Helper1 helper(*oCur2, intersector);
-        if(ei_intersect_helper(tree1, helper, *vBegin1))
-          return; //intersector said to stop query
-      }
-    }
+  std::vector<std::pair<Index1, Index2> > todo(1, std::make_pair(tree1.getRootIndex(), tree2.getRootIndex()));
+  ei_intersect_tandem_helper(tree1, tree2, intersector, todo);
+}
 
-    for(; oBegin1 != oEnd1; ++oBegin1) { //go through child objects of first tree
-      for(vCur2 = vBegin2; vCur2 != vEnd2; ++vCur2) { //go through child volumes of second tree
-        Helper2 helper(*oBegin1, intersector);
-        if(ei_intersect_helper(tree2, helper, *vCur2))
-          return; //intersector said to stop query
-      }
+/**  Parallel version of BVIntersect(const BVH1 &, const BVH2 &, Intersector &), where \a intersectorsBegin and \a intersectorsEnd
+  *  are random access iterators over as many independent intersectors as threads should be used.
+  *
+  *  The top of the tandem descent is expanded breadth first by the first intersector, and the resulting independent pairs of subtrees
+  *  are then distributed among the threads, each thread using its own intersector.  Every pair of objects intersecting the query
+  *  is thus reported to exactly one of the intersectors, and the results have to be gathered from all of them.  When an intersector
+  *  asks to stop the query, the other threads stop as soon as they are done with their current pair of subtrees.
+  *  Without OpenMP, the first intersector runs the whole query.
+  */
+template<typename BVH1, typename BVH2, typename IntersectorIter>
+void BVIntersect(const BVH1 &tree1, const BVH2 &tree2, IntersectorIter intersectorsBegin, IntersectorIter intersectorsEnd)
+{
+  typedef typename BVH1::Index Index1;
+  typedef typename BVH2::Index Index2;
+  typedef std::pair<Index1, Index2> IndexPair;
+  typedef typename std::iterator_traits<IntersectorIter>::value_type Intersector;
+
+  const int threads = static_cast<int>(intersectorsEnd - intersectorsBegin);
+  ei_assert(threads > 0);
+
+  //expand the descent until there are enough pairs of subtrees to balance the load
+  std::vector<IndexPair> pairs(1, std::make_pair(tree1.getRootIndex(), tree2.getRootIndex())), next;
+  const int minPairs = threads > 1 ? 16 * threads : 1;
+  while(!pairs.empty() && static_cast<int>(pairs.size()) < minPairs) {
+    next.clear();
+    for(int i = 0; i < static_cast<int>(pairs.size()); ++i)
+      if(ei_intersect_pair_children(tree1, tree2, *intersectorsBegin, pairs[i].first, pairs[i].second, next))
+        return; //intersector said to stop query
+    pairs.swap(next);
+  }
 
-      for(oCur2 = oBegin2; oCur2 != oEnd2; ++oCur2) {//go through child objects of second tree
-        if(intersector.intersectObjectObject(*oBegin1, *oCur2))
-          return; //intersector said to stop query
+  //set by the thread whose intersector asks to stop, and read by all of them, in a critical section
+  bool stop = false;
+  const int numPairs = static_cast<int>(pairs.size());
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel num_threads(threads) if(numPairs > 1)
+  #endif
+  {
+    int tid = 0;
+    #ifdef EIGEN_HAS_OPENMP
+    tid = omp_get_thread_num();
+    #endif
+    Intersector &intersector = *(intersectorsBegin + tid);
+    std::vector<IndexPair> todo;
+
+    #ifdef EIGEN_HAS_OPENMP
+    #pragma omp for schedule(dynamic)
+    #endif
+    for(int i = 0; i < numPairs; ++i) {
+      bool stopped;
+      #ifdef EIGEN_HAS_OPENMP
+      #pragma omp critical(ei_bvintersect_stop)
+      #endif
+      stopped = stop;
+      if(stopped)
+        continue;
+      todo.assign(1, pairs[i]);
+      if(ei_intersect_tandem_helper(tree1, tree2, intersector, todo)) {
+        #ifdef EIGEN_HAS_OPENMP
+        #pragma omp critical(ei_bvintersect_stop)
+        #endif
+        stop = true; //intersector said to stop query
       }
     }
   }
 }
 
+/**  Runs the query encapsulated by each of the intersectors of the random access range [\a begin, \a end) on \a tree,
+  *  as BVIntersect(const BVH &, Intersector &) does.  The queries are distributed among threads when OpenMP is enabled,
+  *  and thus must not share any state.
+  */
+template<typename BVH, typename IntersectorIter>
+void BVBatchIntersect(const BVH &tree, IntersectorIter begin, IntersectorIter end)
+{
+  const int count = static_cast<int>(end - begin);
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for schedule(dynamic, 16)
+  #endif
+  for(int i = 0; i < count; ++i)
+    BVIntersect(tree, *(begin + i));
+}
+
 /**  Given a BVH, runs the query encapsulated by \a minimizer.
   *  \returns the minimum value.
   *  The Minimizer type must provide the following members: \code
@@ -198,6 +306,21 @@ typename Minimizer::Scalar ei_minimize_helper(const BVH &tree, Minimizer &minimi
 #endif //not EIGEN_PARSED_BY_DOXYGEN
 
 
+/**  Runs the query encapsulated by each of the minimizers of the random access range [\a begin, \a end) on \a tree,
+  *  as BVMinimize(const BVH &, Minimizer &) does, and writes the minima to the random access output iterator \a minima.
+  *  The queries are distributed among threads when OpenMP is enabled, and thus must not share any state.
+  */
+template<typename BVH, typename MinimizerIter, typename OutputIter>
+void BVBatchMinimize(const BVH &tree, MinimizerIter begin, MinimizerIter end, OutputIter minima)
+{
+  const int count = static_cast<int>(end - begin);
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel for schedule(dynamic, 16)
+  #endif
+  for(int i = 0; i < count; ++i)
+    *(minima + i) = BVMinimize(tree, *(begin + i));
+}
+
 template<typename Volume1, typename Object1, typename Object2, typename Minimizer>
 struct ei_minimizer_helper1
 {
@@ -119,13 +119,13 @@ public:
     ei_get_boxes_helper<ObjectList, VolumeList, BIter>()(objects, boxBegin, boxEnd, objBoxes);
 
     objCenters.reserve(n);
-    boxes.reserve(n - 1);
-    children.reserve(2 * n - 2);
+    boxes.resize(n - 1);
+    children.resize(2 * n - 2);
 
     for(int i = 0; i < n; ++i)
       objCenters.push_back(VIPair(objBoxes[i].center(), i));
 
-    build(objCenters, 0, n, objBoxes, 0); //the recursive part of the algorithm
+    buildTop(objCenters, objBoxes);
 
     ObjectList tmp(n);
     tmp.swap(objects);
@@ -186,41 +186,114 @@ private:
     int dim;
   };
 
-  //Build the part of the tree between objects[from] and objects[to] (not including objects[to]).
-  //This routine partitions the objCenters in [from, to) along the dimension dim, recursively constructs
-  //the two halves, and adds their parent node.  TODO: a cache-friendlier layout
-  void build(VIPairList &objCenters, int from, int to, const VolumeList &objBoxes, int dim)
+  //A range [from, to) of objects whose subtree has its nodes stored from boxes[base] on, its root being the last one.
+  //The nodes of a subtree are stored in postorder, so that the subtree of [from, mid) starts at base and the one of
+  //[mid, to) starts right after it, at base + mid - from - 1.
+  struct BuildRange
+  {
+    BuildRange(int inFrom, int inTo, int inDim, int inBase) : from(inFrom), to(inTo), dim(inDim), base(inBase) {}
+    int from, to, dim, base;
+  };
+
+  //Build the part of the tree between objects[from] and objects[to] (not including objects[to]), storing its nodes
+  //from boxes[base] on.  This routine partitions the objCenters in [from, to) along the dimension dim, recursively
+  //constructs the two halves, and adds their parent node.  TODO: a cache-friendlier layout
+  void build(VIPairList &objCenters, int from, int to, const VolumeList &objBoxes, int dim, int base)
   {
     ei_assert(to - from > 1);
+    int numNodes = (int)objects.size() - 1; //there are objects.size() - 1 tree nodes
+    int root = base + (to - from) - 2;
     if(to - from == 2) {
-      boxes.push_back(objBoxes[objCenters[from].second].merged(objBoxes[objCenters[from + 1].second]));
-      children.push_back(from + (int)objects.size() - 1); //there are objects.size() - 1 tree nodes
-      children.push_back(from + (int)objects.size());
+      boxes[root] = objBoxes[objCenters[from].second].merged(objBoxes[objCenters[from + 1].second]);
+      children[2 * root] = from + numNodes;
+      children[2 * root + 1] = from + 1 + numNodes;
     }
     else if(to - from == 3) {
       int mid = from + 2;
       std::nth_element(objCenters.begin() + from, objCenters.begin() + mid,
                         objCenters.begin() + to, VectorComparator(dim)); //partition
-      build(objCenters, from, mid, objBoxes, (dim + 1) % Dim);
-      int idx1 = (int)boxes.size() - 1;
-      boxes.push_back(boxes[idx1].merged(objBoxes[objCenters[mid].second]));
-      children.push_back(idx1);
-      children.push_back(mid + (int)objects.size() - 1);
+      build(objCenters, from, mid, objBoxes, (dim + 1) % Dim, base);
+      boxes[root] = boxes[base].merged(objBoxes[objCenters[mid].second]);
+      children[2 * root] = base;
+      children[2 * root + 1] = mid + numNodes;
     }
     else {
       int mid = from + (to - from) / 2;
       nth_element(objCenters.begin() + from, objCenters.begin() + mid,
                   objCenters.begin() + to, VectorComparator(dim)); //partition
-      build(objCenters, from, mid, objBoxes, (dim + 1) % Dim);
-      int idx1 = (int)boxes.size() - 1;
-      build(objCenters, mid, to, objBoxes, (dim + 1) % Dim);
-      int idx2 = (int)boxes.size() - 1;
-      boxes.push_back(boxes[idx1].merged(boxes[idx2]));
-      children.push_back(idx1);
-      children.push_back(idx2);
+      build(objCenters, from, mid, objBoxes, (dim + 1) % Dim, base);
+      build(objCenters, mid, to, objBoxes, (dim + 1) % Dim, base + mid - from - 1);
+      linkHalves(BuildRange(from, to, dim, base));
     }
   }
 
+  //Sets the node of a range of at least 4 objects from the roots of the subtrees of its two halves
+  void linkHalves(const BuildRange &range)
+  {
+    int mid = range.from + (range.to - range.from) / 2;
+    int root = range.base + (range.to - range.from) - 2;
+    int idx1 = range.base + (mid - range.from) - 2;
+    int idx2 = root - 1;
+    boxes[root] = boxes[idx1].merged(boxes[idx2]);
+    children[2 * root] = idx1;
+    children[2 * root + 1] = idx2;
+  }
+
+  //Build the whole tree.  With OpenMP, the top levels are split level by level, each level partitioning its ranges in
+  //parallel, until there are enough independent subtrees to be built in parallel.  The nodes of the top levels are
+  //finally set bottom up.
+  void buildTop(VIPairList &objCenters, const VolumeList &objBoxes)
+  {
+    int n = (int)objects.size();
+    std::vector<BuildRange> ranges(1, BuildRange(0, n, 0, 0)), next, splits;
+
+    #ifdef EIGEN_HAS_OPENMP
+    const int minRanges = n >= 4096 ? 8 * omp_get_max_threads() : 1;
+    #else
+    const int minRanges = 1;
+    #endif
+    const int minSplitSize = 1024;
+
+    while((int)ranges.size() < minRanges) {
+      int numRanges = (int)ranges.size();
+      #ifdef EIGEN_HAS_OPENMP
+      #pragma omp parallel for schedule(dynamic)
+      #endif
+      for(int i = 0; i < numRanges; ++i) {
+        const BuildRange &r = ranges[i];
+        if(r.to - r.from >= minSplitSize)
+          nth_element(objCenters.begin() + r.from, objCenters.begin() + r.from + (r.to - r.from) / 2,
+                      objCenters.begin() + r.to, VectorComparator(r.dim)); //partition
+      }
+
+      next.clear();
+      for(int i = 0; i < numRanges; ++i) {
+        const BuildRange &r = ranges[i];
+        if(r.to - r.from >= minSplitSize) {
+          int mid = r.from + (r.to - r.from) / 2;
+          splits.push_back(r);
+          next.push_back(BuildRange(r.from, mid, (r.dim + 1) % Dim, r.base));
+          next.push_back(BuildRange(mid, r.to, (r.dim + 1) % Dim, r.base + mid - r.from - 1));
+        }
+        else
+          next.push_back(r);
+      }
+      if(next.size() == ranges.size())
+        break; //the ranges are too small to be split further
+      ranges.swap(next);
+    }
+
+    int numRanges = (int)ranges.size();
+    #ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic) if(numRanges > 1)
+    #endif
+    for(int i = 0; i < numRanges; ++i)
+      build(objCenters, ranges[i].from, ranges[i].to, objBoxes, ranges[i].dim, ranges[i].base);
+
+    for(int i = (int)splits.size() - 1; i >= 0; --i) //the ranges are split top down, so link them bottom up
+      linkHalves(splits[i]);
+  }
+
   std::vector<int> children; //children of x are children[2x] and children[2x+1], indices bigger than boxes.size() index into objects.
   VolumeList boxes;
   ObjectList objects;
@@ -101,6 +101,16 @@
           if (m_plan==NULL) m_plan = fftwf_plan_dft_2d(n0,n1,src,dst,FFTW_BACKWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
           fftwf_execute_dft( m_plan, src,dst);
       }
+      inline
+      void fwdBatch( complex_type * dst,complex_type * src,int nfft,int howmany,int istride,int idist,int ostride,int odist) {
+          if (m_plan==NULL) m_plan = fftwf_plan_many_dft(1,&nfft,howmany,src,NULL,istride,idist,dst,NULL,ostride,odist,FFTW_FORWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+          fftwf_execute_dft( m_plan, src,dst);
+      }
+      inline
+      void invBatch( complex_type * dst,complex_type * src,int nfft,int howmany,int istride,int idist,int ostride,int odist) {
+          if (m_plan==NULL) m_plan = fftwf_plan_many_dft(1,&nfft,howmany,src,NULL,istride,idist,dst,NULL,ostride,odist,FFTW_BACKWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+          fftwf_execute_dft( m_plan, src,dst);
+      }
 
   };
   template <> 
@@ -143,6 +153,16 @@
           if (m_plan==NULL) m_plan = fftw_plan_dft_2d(n0,n1,src,dst,FFTW_BACKWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
           fftw_execute_dft( m_plan, src,dst);
       }
+      inline
+      void fwdBatch( complex_type * dst,complex_type * src,int nfft,int howmany,int istride,int idist,int ostride,int odist) {
+          if (m_plan==NULL) m_plan = fftw_plan_many_dft(1,&nfft,howmany,src,NULL,istride,idist,dst,NULL,ostride,odist,FFTW_FORWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+          fftw_execute_dft( m_plan, src,dst);
+      }
+      inline
+      void invBatch( complex_type * dst,complex_type * src,int nfft,int howmany,int istride,int idist,int ostride,int odist) {
+          if (m_plan==NULL) m_plan = fftw_plan_many_dft(1,&nfft,howmany,src,NULL,istride,idist,dst,NULL,ostride,odist,FFTW_BACKWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+          fftw_execute_dft( m_plan, src,dst);
+      }
   };
   template <> 
   struct ei_fftw_plan<long double>
@@ -184,6 +204,16 @@
           if (m_plan==NULL) m_plan = fftwl_plan_dft_2d(n0,n1,src,dst,FFTW_BACKWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
           fftwl_execute_dft( m_plan, src,dst);
       }
+      inline
+      void fwdBatch( complex_type * dst,complex_type * src,int nfft,int howmany,int istride,int idist,int ostride,int odist) {
+          if (m_plan==NULL) m_plan = fftwl_plan_many_dft(1,&nfft,howmany,src,NULL,istride,idist,dst,NULL,ostride,odist,FFTW_FORWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+          fftwl_execute_dft( m_plan, src,dst);
+      }
+      inline
+      void invBatch( complex_type * dst,complex_type * src,int nfft,int howmany,int istride,int idist,int ostride,int odist) {
+          if (m_plan==NULL) m_plan = fftwl_plan_many_dft(1,&nfft,howmany,src,NULL,istride,idist,dst,NULL,ostride,odist,FFTW_BACKWARD,FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+          fftwl_execute_dft( m_plan, src,dst);
+      }
   };
 
   template <typename _Scalar>
@@ -196,6 +226,7 @@
       void clear() 
       {
         m_plans.clear();
+        m_batchPlans.clear();
       }
 
       // complex-to-complex forward FFT
@@ -240,6 +271,21 @@
         get_plan(n0,n1,true,dst,src).inv2(ei_fftw_cast(dst), ei_fftw_cast(src) ,n0,n1);
       }
 
+      // howmany complex-to-complex FFTs sharing one plan
+      inline
+      void fwdBatch(Complex * dst, const Complex * src, int nfft, int howmany, int istride, int idist, int ostride, int odist)
+      {
+        get_batch_plan(nfft,howmany,istride,idist,ostride,odist,false,dst,src)
+          .fwdBatch(ei_fftw_cast(dst), ei_fftw_cast(src),nfft,howmany,istride,idist,ostride,odist);
+      }
+
+      inline
+      void invBatch(Complex * dst, const Complex * src, int nfft, int howmany, int istride, int idist, int ostride, int odist)
+      {
+        get_batch_plan(nfft,howmany,istride,idist,ostride,odist,true,dst,src)
+          .invBatch(ei_fftw_cast(dst), ei_fftw_cast(src),nfft,howmany,istride,idist,ostride,odist);
+      }
+
 
   protected:
       typedef ei_fftw_plan<Scalar> PlanData;
@@ -247,6 +293,7 @@
       typedef std::map<int64_t,PlanData> PlanMap;
 
       PlanMap m_plans;
+      std::map<std::vector<int64_t>,PlanData> m_batchPlans;
 
       inline
       PlanData & get_plan(int nfft,bool inverse,void * dst,const void * src)
@@ -265,6 +312,18 @@
           int64_t key = ( ( (((int64_t)n0) << 30)|(n1<<3 ) | (inverse<<2) | (inplace<<1) | aligned ) << 1 ) + 1;
           return m_plans[key];
       }
+
+      inline
+      PlanData & get_batch_plan(int nfft,int howmany,int istride,int idist,int ostride,int odist,bool inverse,void * dst,const void * src)
+      {
+          bool inplace = (dst==src);
+          bool aligned = ( (reinterpret_cast<size_t>(src)&15) | (reinterpret_cast<size_t>(dst)&15) ) == 0;
+          std::vector<int64_t> key(7);
+          key[0] = nfft; key[1] = howmany;
+          key[2] = istride; key[3] = idist; key[4] = ostride; key[5] = odist;
+          key[6] = (inverse<<2) | (inplace<<1) | aligned;
+          return m_batchPlans[key];
+      }
   };
 /* vim: set filetype=cpp et sw=2 ts=2 ai: */
 
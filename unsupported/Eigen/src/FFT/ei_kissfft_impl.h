@@ -27,15 +27,47 @@
   // This FFT implementation was derived from kissfft http:sourceforge.net/projects/kissfft
   // Copyright 2003-2009 Mark Borgerding
 
-template <typename _Scalar>
+/** \internal
+  * Transforms of at least this size have their independent sub-transforms, and the butterflies
+  * recombining them, computed in parallel when OpenMP is enabled. 2D transforms of at least
+  * this many values distribute their rows and columns over the threads. The default is 16384.
+  */
+#ifndef EIGEN_FFT_PARALLEL_THRESHOLD
+#define EIGEN_FFT_PARALLEL_THRESHOLD 16384
+#endif
+
+/** \internal
+  * Transforms having a prime factor larger than this are computed by Bluestein's algorithm, as a
+  * convolution through power of two FFTs, instead of O(p^2) generic butterflies. The default is 64.
+  */
+#ifndef EIGEN_FFT_BLUESTEIN_THRESHOLD
+#define EIGEN_FFT_BLUESTEIN_THRESHOLD 64
+#endif
+
+template <typename _Scalar, bool _Vectorize = (ei_packet_traits<_Scalar>::size%2==0)>
 struct ei_kiss_cpx_fft
 {
   typedef _Scalar Scalar;
   typedef std::complex<Scalar> Complex;
+  typedef typename ei_packet_traits<Scalar>::type Packet;
+  enum {
+    Vectorize = _Vectorize,
+    PacketSize = ei_packet_traits<Scalar>::size,
+    // number of interleaved complex values held by a packet
+    ComplexPerPacket = PacketSize>1 ? PacketSize/2 : 1
+  };
   std::vector<Complex> m_twiddles;
   std::vector<int> m_stageRadix;
   std::vector<int> m_stageRemainder;
-  std::vector<Complex> m_scratchBuf;
+  // per stage twiddles of the packet butterflies, stored for each non-trivial leg as the real
+  // parts duplicated (wr,wr) followed by the signed imaginary parts (-wi,wi)
+  std::vector<Scalar, aligned_allocator<Scalar> > m_packetTwiddles;
+  std::vector<int> m_packetTwiddleOffset;
+  // Bluestein's algorithm: the chirp exp(-+i*pi*k^2/nfft), and the spectrum of the convolution
+  // filter scaled by 1/m_twiddles.size(), the twiddles and stages being those of the power of two
+  // transform computing the convolution. Both are empty for the mixed radix algorithm.
+  std::vector<Complex> m_chirp;
+  std::vector<Complex> m_filterSpectrum;
   bool m_inverse;
 
   inline
@@ -66,11 +98,128 @@ struct ei_kiss_cpx_fft
       n /= p;
       m_stageRadix.push_back(p);
       m_stageRemainder.push_back(n);
-      if ( p > 5 )
-        m_scratchBuf.resize(p); // scratchbuf will be needed in bfly_generic
     }while(n>1);
   }
 
+  // the largest prime factor of the size of the transform
+  int max_radix() const { return *std::max_element(m_stageRadix.begin(),m_stageRadix.end()); }
+
+  // switches the plan to Bluestein's algorithm, writing the DFT as the convolution
+  //   X_k = c_k sum_n (x_n c_n) conj(c_{k-n}), c_n = exp(-+i*pi*n^2/nfft)
+  // which is computed by a forward FFT of power of two size, the inverse FFT being
+  // obtained by conjugating the input and output of the forward one.
+  void make_bluestein(int nfft,bool inverse)
+  {
+    int size = 1;
+    while (size < 2*nfft-1)
+      size <<= 1;
+
+    m_chirp.resize(nfft);
+    const Scalar pi = acos( (Scalar) -1);
+    const Scalar sign = inverse ? 1 : -1;
+    int k2 = 0; // k^2 modulo 2*nfft, which keeps the phase accurate
+    for (int k=0;k<nfft;++k) {
+      m_chirp[k] = exp( Complex(0,sign*pi*Scalar(k2)/nfft) );
+      k2 += 2*k+1;
+      if (k2 >= 2*nfft)
+        k2 -= 2*nfft;
+    }
+
+    m_stageRadix.clear();
+    m_stageRemainder.clear();
+    // the direction is carried by the chirp, the power of two transform is always forward
+    make_twiddles(size,false);
+    factorize(size);
+    make_packet_twiddles();
+
+    std::vector<Complex> filter(size,Complex(0));
+    filter[0] = conj(m_chirp[0]);
+    for (int k=1;k<nfft;++k)
+      filter[k] = filter[size-k] = conj(m_chirp[k]);
+    m_filterSpectrum.resize(size);
+    radix_transform(&m_filterSpectrum[0], &filter[0]);
+    for (int k=0;k<size;++k)
+      m_filterSpectrum[k] /= Scalar(size);
+  }
+
+  // lays out the twiddles of the radix-2 and radix-4 stages for the packet butterflies
+  void make_packet_twiddles()
+  {
+    int nstages = static_cast<int>(m_stageRadix.size());
+    m_packetTwiddleOffset.assign(nstages,-1);
+    if (!Vectorize)
+      return;
+    int total = 0;
+    for (int s=0;s<nstages;++s) {
+      int p = m_stageRadix[s];
+      int m = m_stageRemainder[s];
+      if ( (p==2 || p==4) && m%ComplexPerPacket==0 ) {
+        m_packetTwiddleOffset[s] = total;
+        total += 4*m*(p-1);
+      }
+    }
+    m_packetTwiddles.resize(total);
+    size_t fstride = 1;
+    for (int s=0;s<nstages;++s) {
+      int p = m_stageRadix[s];
+      int m = m_stageRemainder[s];
+      if (m_packetTwiddleOffset[s]>=0) {
+        Scalar * tw = &m_packetTwiddles[m_packetTwiddleOffset[s]];
+        for (int q=1;q<p;++q,tw+=4*m) {
+          for (int k=0;k<m;++k) {
+            const Complex & w = m_twiddles[q*k*fstride];
+            tw[2*k] = tw[2*k+1] = w.real();
+            tw[2*m+2*k] = -w.imag();
+            tw[2*m+2*k+1] = w.imag();
+          }
+        }
+      }
+      fstride *= p;
+    }
+  }
+
+  template <typename _Src>
+    inline
+    void transform(Complex * xout, const _Src * xin)
+    {
+      if (m_chirp.empty())
+        radix_transform(xout,xin);
+      else
+        bluestein(xout,xin);
+    }
+
+  template <typename _Src>
+    void bluestein(Complex * xout, const _Src * xin)
+    {
+      const int nfft = static_cast<int>(m_chirp.size());
+      const int size = static_cast<int>(m_twiddles.size());
+      std::vector<Complex> a(size,Complex(0));
+      std::vector<Complex> b(size);
+      for (int k=0;k<nfft;++k)
+        a[k] = m_chirp[k] * Complex(xin[k]);
+      radix_transform(&b[0], &a[0]);
+      for (int k=0;k<size;++k)
+        a[k] = conj(b[k] * m_filterSpectrum[k]);
+      radix_transform(&b[0], &a[0]);
+      for (int k=0;k<nfft;++k)
+        xout[k] = m_chirp[k] * conj(b[k]);
+    }
+
+  // the mixed radix transform of size m_twiddles.size()
+  template <typename _Src>
+    inline
+    void radix_transform(Complex * xout, const _Src * xin)
+    {
+#ifdef EIGEN_HAS_OPENMP
+      if ( m_twiddles.size()>=EIGEN_FFT_PARALLEL_THRESHOLD && m_stageRadix.size()>1
+           && omp_get_max_threads()>1 && !omp_in_parallel() ) {
+        work_parallel(xout,xin);
+        return;
+      }
+#endif
+      work(0, xout, xin, 1,1);
+    }
+
   template <typename _Src>
     inline
     void work( int stage,Complex * xout, const _Src * xin, size_t fstride,size_t in_stride)
@@ -98,19 +247,135 @@ struct ei_kiss_cpx_fft
       xout=Fout_beg;
 
       // recombine the p smaller DFTs 
+      butterfly(stage,xout,fstride,0,m);
+    }
+
+#ifdef EIGEN_HAS_OPENMP
+  // Splits the first stages into enough independent sub-transforms to keep all the threads busy,
+  // computes them in parallel, and then recombines them stage by stage, distributing the
+  // butterflies of each stage over the threads.
+  template <typename _Src>
+    void work_parallel(Complex * xout, const _Src * xin)
+    {
+      const int nstages = static_cast<int>(m_stageRadix.size());
+      const int nbTasks = 4*omp_get_max_threads();
+      std::vector<int> fstrides(1,1);
+      int depth = 0;
+      while (depth+1<nstages && fstrides[depth]<nbTasks) {
+        fstrides.push_back(fstrides[depth]*m_stageRadix[depth]);
+        ++depth;
+      }
+      const int count = fstrides[depth];
+      const int len = m_stageRemainder[depth-1];
+
+      #pragma omp parallel for schedule(dynamic)
+      for (int j=0;j<count;++j) {
+        // the mixed radix digits of j select the sub-transform of each stage, the one of stage s
+        // starting at input sample q_s * fstrides[s]
+        int r = j;
+        size_t offset = 0;
+        for (int s=depth-1;s>=0;--s) {
+          offset += (r % m_stageRadix[s]) * fstrides[s];
+          r /= m_stageRadix[s];
+        }
+        work(depth, xout + j*len, xin + offset, count, 1);
+      }
+
+      for (int s=depth-1;s>=0;--s) {
+        const int p = m_stageRadix[s];
+        const int m = m_stageRemainder[s];
+        const int groups = fstrides[s];
+        int chunkSize = (m + std::max(1,nbTasks/groups) - 1) / std::max(1,nbTasks/groups);
+        chunkSize = ((chunkSize + ComplexPerPacket - 1) / ComplexPerPacket) * ComplexPerPacket;
+        const int chunks = (m + chunkSize - 1) / chunkSize;
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int t=0;t<groups*chunks;++t) {
+          int k0 = (t%chunks)*chunkSize;
+          butterfly(s, xout + (t/chunks)*p*m, fstrides[s], k0, std::min(m,k0+chunkSize));
+        }
+      }
+    }
+#endif
+
+  // recombines the p DFTs of size m of the given stage for the indices k0 <= k < k1
+  inline
+    void butterfly(int stage, Complex * Fout, const size_t fstride, int k0, int k1)
+    {
+      int p = m_stageRadix[stage];
+      int m = m_stageRemainder[stage];
+      const bool packet = Vectorize && m_packetTwiddleOffset[stage]>=0;
       switch (p) {
-        case 2: bfly2(xout,fstride,m); break;
-        case 3: bfly3(xout,fstride,m); break;
-        case 4: bfly4(xout,fstride,m); break;
-        case 5: bfly5(xout,fstride,m); break;
-        default: bfly_generic(xout,fstride,m,p); break;
+        case 2:
+          if (packet) pbfly2(Fout,&m_packetTwiddles[m_packetTwiddleOffset[stage]],m,k0,k1);
+          else bfly2(Fout,fstride,m,k0,k1);
+          break;
+        case 3: bfly3(Fout,fstride,m,k0,k1); break;
+        case 4:
+          if (packet) pbfly4(Fout,&m_packetTwiddles[m_packetTwiddleOffset[stage]],m,k0,k1);
+          else bfly4(Fout,fstride,m,k0,k1);
+          break;
+        case 5: bfly5(Fout,fstride,m,k0,k1); break;
+        default: bfly_generic(Fout,fstride,m,p,k0,k1); break;
       }
     }
 
+  // multiplies the interleaved complex numbers of a by the twiddles given by
+  // their duplicated real parts and their signed imaginary parts
+  static EIGEN_STRONG_INLINE Packet pcplxmul(const Packet& a, const Packet& twRe, const Packet& twIm)
+  {
+    return ei_padd(ei_pmul(a,twRe), ei_pmul(ei_pcplxflip(a),twIm));
+  }
+
   inline
-    void bfly2( Complex * Fout, const size_t fstride, int m)
+    void pbfly2( Complex * Fout, const Scalar * tw, int m, int k0, int k1)
     {
-      for (int k=0;k<m;++k) {
+      Scalar * f0 = reinterpret_cast<Scalar*>(Fout);
+      Scalar * f1 = reinterpret_cast<Scalar*>(Fout+m);
+      const Scalar * twIm = tw + 2*m;
+      for (int i=2*k0;i<2*k1;i+=PacketSize) {
+        Packet a = ei_ploadu(f0+i);
+        Packet t = pcplxmul(ei_ploadu(f1+i), ei_pload(tw+i), ei_pload(twIm+i));
+        ei_pstoreu(f1+i, ei_psub(a,t));
+        ei_pstoreu(f0+i, ei_padd(a,t));
+      }
+    }
+
+  inline
+    void pbfly4( Complex * Fout, const Scalar * tw, int m, int k0, int k1)
+    {
+      Scalar * f0 = reinterpret_cast<Scalar*>(Fout);
+      Scalar * f1 = reinterpret_cast<Scalar*>(Fout+m);
+      Scalar * f2 = reinterpret_cast<Scalar*>(Fout+2*m);
+      Scalar * f3 = reinterpret_cast<Scalar*>(Fout+3*m);
+      const Scalar * tw1 = tw;
+      const Scalar * tw2 = tw + 4*m;
+      const Scalar * tw3 = tw + 8*m;
+      // multiplying by -i (or i for the inverse) swaps the real and imaginary parts and negates one of them
+      EIGEN_ALIGN16 Scalar sign[PacketSize];
+      for (int i=0;i<PacketSize;++i)
+        sign[i] = ((i%2==0) != m_inverse) ? Scalar(1) : Scalar(-1);
+      const Packet rot = ei_pload(sign);
+      for (int i=2*k0;i<2*k1;i+=PacketSize) {
+        Packet s0 = pcplxmul(ei_ploadu(f1+i), ei_pload(tw1+i), ei_pload(tw1+2*m+i));
+        Packet s1 = pcplxmul(ei_ploadu(f2+i), ei_pload(tw2+i), ei_pload(tw2+2*m+i));
+        Packet s2 = pcplxmul(ei_ploadu(f3+i), ei_pload(tw3+i), ei_pload(tw3+2*m+i));
+        Packet a = ei_ploadu(f0+i);
+        Packet s5 = ei_psub(a,s1);
+        a = ei_padd(a,s1);
+        Packet s3 = ei_padd(s0,s2);
+        Packet s4 = ei_pmul(ei_pcplxflip(ei_psub(s0,s2)),rot);
+        ei_pstoreu(f2+i, ei_psub(a,s3));
+        ei_pstoreu(f0+i, ei_padd(a,s3));
+        ei_pstoreu(f1+i, ei_padd(s5,s4));
+        ei_pstoreu(f3+i, ei_psub(s5,s4));
+      }
+    }
+
+  inline
+    void bfly2( Complex * Fout, const size_t fstride, int m, int k0, int k1)
+    {
+      for (int k=k0;k<k1;++k) {
         Complex t = Fout[m+k] * m_twiddles[k*fstride];
         Fout[m+k] = Fout[k] - t;
         Fout[k] += t;
@@ -118,11 +383,11 @@ struct ei_kiss_cpx_fft
     }
 
   inline
-    void bfly4( Complex * Fout, const size_t fstride, const size_t m)
+    void bfly4( Complex * Fout, const size_t fstride, const size_t m, int k0, int k1)
     {
       Complex scratch[6];
       int negative_if_inverse = m_inverse * -2 +1;
-      for (size_t k=0;k<m;++k) {
+      for (size_t k=k0;k<size_t(k1);++k) {
         scratch[0] = Fout[k+m] * m_twiddles[k*fstride];
         scratch[1] = Fout[k+2*m] * m_twiddles[k*fstride*2];
         scratch[2] = Fout[k+3*m] * m_twiddles[k*fstride*3];
@@ -141,16 +406,18 @@ struct ei_kiss_cpx_fft
     }
 
   inline
-    void bfly3( Complex * Fout, const size_t fstride, const size_t m)
+    void bfly3( Complex * Fout, const size_t fstride, const size_t m, int k0, int k1)
     {
-      size_t k=m;
+      size_t k=k1-k0;
       const size_t m2 = 2*m;
       Complex *tw1,*tw2;
       Complex scratch[5];
       Complex epi3;
       epi3 = m_twiddles[fstride*m];
 
-      tw1=tw2=&m_twiddles[0];
+      Fout += k0;
+      tw1=&m_twiddles[k0*fstride];
+      tw2=&m_twiddles[2*k0*fstride];
 
       do{
         scratch[1]=Fout[m] * *tw1;
@@ -170,7 +437,7 @@ struct ei_kiss_cpx_fft
     }
 
   inline
-    void bfly5( Complex * Fout, const size_t fstride, const size_t m)
+    void bfly5( Complex * Fout, const size_t fstride, const size_t m, int k0, int k1)
     {
       Complex *Fout0,*Fout1,*Fout2,*Fout3,*Fout4;
       size_t u;
@@ -181,14 +448,14 @@ struct ei_kiss_cpx_fft
       ya = twiddles[fstride*m];
       yb = twiddles[fstride*2*m];
 
-      Fout0=Fout;
+      Fout0=Fout+k0;
       Fout1=Fout0+m;
       Fout2=Fout0+2*m;
       Fout3=Fout0+3*m;
       Fout4=Fout0+4*m;
 
       tw=twiddles;
-      for ( u=0; u<m; ++u ) {
+      for ( u=k0; u<size_t(k1); ++u ) {
         scratch[0] = *Fout0;
 
         scratch[1]  = *Fout1 * tw[u*fstride];
@@ -241,16 +508,19 @@ struct ei_kiss_cpx_fft
         Complex * Fout,
         const size_t fstride,
         int m,
-        int p
+        int p,
+        int k0,
+        int k1
         )
     {
       int u,k,q1,q;
       Complex * twiddles = &m_twiddles[0];
       Complex t;
       int Norig = static_cast<int>(m_twiddles.size());
-      Complex * scratchbuf = &m_scratchBuf[0];
+      // local scratch buffer, so that several threads can share the plan
+      Complex * scratchbuf = ei_aligned_stack_new(Complex,p);
 
-      for ( u=0; u<m; ++u ) {
+      for ( u=k0; u<k1; ++u ) {
         k=u;
         for ( q1=0 ; q1<p ; ++q1 ) {
           scratchbuf[q1] = Fout[ k  ];
@@ -270,35 +540,129 @@ struct ei_kiss_cpx_fft
           k += m;
         }
       }
+      ei_aligned_stack_delete(Complex,scratchbuf,p);
     }
 };
 
-template <typename _Scalar>
+/** \internal
+  * Lock guarding the plan cache of ei_kissfft_impl, so that an FFT object can be shared by threads
+  * which are not OpenMP threads. It is a POSIX mutex when available, an OpenMP lock otherwise, and
+  * without either the plans must not be created by several threads at once. A copy is a new lock.
+  */
+class ei_kissfft_mutex
+{
+  public:
+    ei_kissfft_mutex() { init(); }
+    ei_kissfft_mutex(const ei_kissfft_mutex&) { init(); }
+    ei_kissfft_mutex& operator=(const ei_kissfft_mutex&) { return *this; }
+
+#if defined(EIGEN_KISSFFT_HAS_PTHREAD)
+    ~ei_kissfft_mutex() { pthread_mutex_destroy(&m_mutex); }
+    void lock() { pthread_mutex_lock(&m_mutex); }
+    void unlock() { pthread_mutex_unlock(&m_mutex); }
+  protected:
+    void init() { pthread_mutex_init(&m_mutex, 0); }
+    pthread_mutex_t m_mutex;
+#elif defined(EIGEN_HAS_OPENMP)
+    ~ei_kissfft_mutex() { omp_destroy_lock(&m_mutex); }
+    void lock() { omp_set_lock(&m_mutex); }
+    void unlock() { omp_unset_lock(&m_mutex); }
+  protected:
+    void init() { omp_init_lock(&m_mutex); }
+    omp_lock_t m_mutex;
+#else
+    void lock() {}
+    void unlock() {}
+  protected:
+    void init() {}
+#endif
+};
+
+/** \internal holds \a mutex for the lifetime of the object */
+class ei_kissfft_lock
+{
+  public:
+    ei_kissfft_lock(ei_kissfft_mutex & mutex) : m_mutex(mutex) { m_mutex.lock(); }
+    ~ei_kissfft_lock() { m_mutex.unlock(); }
+  protected:
+    ei_kissfft_mutex & m_mutex;
+  private:
+    ei_kissfft_lock(const ei_kissfft_lock&);
+    ei_kissfft_lock& operator=(const ei_kissfft_lock&);
+};
+
+template <typename _Scalar, bool _Vectorize = (ei_packet_traits<_Scalar>::size%2==0)>
 struct ei_kissfft_impl
 {
   typedef _Scalar Scalar;
   typedef std::complex<Scalar> Complex;
 
+  ei_kissfft_impl() : m_measure(false) {}
+
   void clear() 
   {
+    ei_kissfft_lock lock(m_plansMutex);
     m_plans.clear();
     m_realTwiddles.clear();
   }
 
+  // When enabled, the plans of the sizes having a prime factor larger than 5 time both the
+  // mixed radix and Bluestein's algorithm, keep the fastest, and record the choice in the wisdom.
+  void setMeasure(bool measure) { m_measure = measure; }
+
+  // writes the measured choices, one "nfft algorithm" line per size
+  void exportWisdom(std::ostream & os) const
+  {
+    ei_kissfft_lock lock(m_plansMutex);
+    for (std::map<int,int>::const_iterator it=m_wisdom.begin();it!=m_wisdom.end();++it)
+      os << it->first << " " << it->second << "\n";
+  }
+
+  // reads choices written by exportWisdom(), they apply to the plans created afterwards
+  bool importWisdom(std::istream & is)
+  {
+    ei_kissfft_lock lock(m_plansMutex);
+    int nfft, algorithm;
+    while (is >> nfft >> algorithm) {
+      if (nfft<1 || (algorithm!=MixedRadix && algorithm!=Bluestein))
+        return false;
+      m_wisdom[nfft] = algorithm;
+    }
+    return is.eof();
+  }
+
   inline
     void fwd( Complex * dst,const Complex *src,int nfft)
     {
-      get_plan(nfft,false).work(0, dst, src, 1,1);
+      get_plan(nfft,false).transform(dst, src);
     }
 
+  // 2D complex-to-complex FFT of n0 rows of n1 contiguous values
   inline
     void fwd2( Complex * dst,const Complex *src,int n0,int n1)
     {
+      transform2(get_plan(n0,false),get_plan(n1,false),dst,src,n0,n1);
     }
 
+  // inverse 2D complex-to-complex
   inline
     void inv2( Complex * dst,const Complex *src,int n0,int n1)
     {
+      transform2(get_plan(n0,true),get_plan(n1,true),dst,src,n0,n1);
+    }
+
+  // howmany complex-to-complex FFTs of size nfft, the k-th one reading src[k*idist+i*istride]
+  // and writing dst[k*odist+i*ostride]
+  inline
+    void fwdBatch( Complex * dst,const Complex *src,int nfft,int howmany,int istride,int idist,int ostride,int odist)
+    {
+      transform_batch(get_plan(nfft,false),dst,src,nfft,howmany,istride,idist,ostride,odist);
+    }
+
+  inline
+    void invBatch( Complex * dst,const Complex *src,int nfft,int howmany,int istride,int idist,int ostride,int odist)
+    {
+      transform_batch(get_plan(nfft,true),dst,src,nfft,howmany,istride,idist,ostride,odist);
     }
 
   // real-to-complex forward FFT
@@ -310,9 +674,9 @@ struct ei_kissfft_impl
     {
       if ( nfft&3  ) {
         // use generic mode for odd
-        m_tmpBuf1.resize(nfft);
-        get_plan(nfft,false).work(0, &m_tmpBuf1[0], src, 1,1);
-        std::copy(m_tmpBuf1.begin(),m_tmpBuf1.begin()+(nfft>>1)+1,dst );
+        std::vector<Complex> tmpBuf(nfft);
+        get_plan(nfft,false).transform(&tmpBuf[0], src);
+        std::copy(tmpBuf.begin(),tmpBuf.begin()+(nfft>>1)+1,dst );
       }else{
         int ncfft = nfft>>1;
         int ncfft2 = nfft>>2;
@@ -341,7 +705,7 @@ struct ei_kissfft_impl
   inline
     void inv(Complex * dst,const Complex  *src,int nfft)
     {
-      get_plan(nfft,true).work(0, dst, src, 1,1);
+      get_plan(nfft,true).transform(dst, src);
     }
 
   // half-complex to scalar
@@ -349,61 +713,171 @@ struct ei_kissfft_impl
     void inv( Scalar * dst,const Complex * src,int nfft) 
     {
       if (nfft&3) {
-        m_tmpBuf1.resize(nfft);
-        m_tmpBuf2.resize(nfft);
-        std::copy(src,src+(nfft>>1)+1,m_tmpBuf1.begin() );
+        std::vector<Complex> tmpBuf1(nfft), tmpBuf2(nfft);
+        std::copy(src,src+(nfft>>1)+1,tmpBuf1.begin() );
         for (int k=1;k<(nfft>>1)+1;++k)
-          m_tmpBuf1[nfft-k] = conj(m_tmpBuf1[k]);
-        inv(&m_tmpBuf2[0],&m_tmpBuf1[0],nfft);
+          tmpBuf1[nfft-k] = conj(tmpBuf1[k]);
+        inv(&tmpBuf2[0],&tmpBuf1[0],nfft);
         for (int k=0;k<nfft;++k)
-          dst[k] = m_tmpBuf2[k].real();
+          dst[k] = tmpBuf2[k].real();
       }else{
         // optimized version for multiple of 4
         int ncfft = nfft>>1;
         int ncfft2 = nfft>>2;
         Complex * rtw = real_twiddles(ncfft2);
-        m_tmpBuf1.resize(ncfft);
-        m_tmpBuf1[0] = Complex( src[0].real() + src[ncfft].real(), src[0].real() - src[ncfft].real() );
+        std::vector<Complex> tmpBuf1(ncfft);
+        tmpBuf1[0] = Complex( src[0].real() + src[ncfft].real(), src[0].real() - src[ncfft].real() );
         for (int k = 1; k <= ncfft / 2; ++k) {
           Complex fk = src[k];
           Complex fnkc = conj(src[ncfft-k]);
           Complex fek = fk + fnkc;
           Complex tmp = fk - fnkc;
           Complex fok = tmp * conj(rtw[k-1]);
-          m_tmpBuf1[k] = fek + fok;
-          m_tmpBuf1[ncfft-k] = conj(fek - fok);
+          tmpBuf1[k] = fek + fok;
+          tmpBuf1[ncfft-k] = conj(fek - fok);
         }
-        get_plan(ncfft,true).work(0, reinterpret_cast<Complex*>(dst), &m_tmpBuf1[0], 1,1);
+        get_plan(ncfft,true).transform(reinterpret_cast<Complex*>(dst), &tmpBuf1[0]);
       }
     }
 
   protected:
-  typedef ei_kiss_cpx_fft<Scalar> PlanData;
+  typedef ei_kiss_cpx_fft<Scalar,_Vectorize> PlanData;
   typedef std::map<int,PlanData> PlanMap;
+  enum { MixedRadix = 0, Bluestein = 1 };
 
   PlanMap m_plans;
   std::map<int, std::vector<Complex> > m_realTwiddles;
-  std::vector<Complex> m_tmpBuf1;
-  std::vector<Complex> m_tmpBuf2;
+  std::map<int,int> m_wisdom;
+  bool m_measure;
+  mutable ei_kissfft_mutex m_plansMutex;
 
   inline
     int PlanKey(int nfft, bool isinverse) const { return (nfft<<1) | int(isinverse); }
 
+  // Applies the plan to howmany sequences by strips of consecutive sequences. When the input or
+  // the output is strided, a strip is gathered into contiguous lines, which is a cache-blocked
+  // transpose for interleaved sequences, and its transforms are scattered back. The strips are
+  // distributed over the threads for large enough batches. src and dst must either be the same
+  // array, with the same strides, or not overlap.
+  static void transform_batch(PlanData & plan, Complex * dst, const Complex * src, int nfft, int howmany,
+                              int istride, int idist, int ostride, int odist)
+  {
+    const bool gather = istride!=1 || src==dst;
+    const bool scatter = ostride!=1;
+    const int strip = (gather || scatter) ? 16 : 1;
+    const int nstrips = (howmany + strip - 1) / strip;
+#ifdef EIGEN_HAS_OPENMP
+    const bool parallel = nstrips>1 && size_t(nfft)*howmany >= EIGEN_FFT_PARALLEL_THRESHOLD;
+    #pragma omp parallel if(parallel)
+#endif
+    {
+      std::vector<Complex> gathered(gather ? strip*nfft : 0);
+      std::vector<Complex> transformed(scatter ? strip*nfft : 0);
+#ifdef EIGEN_HAS_OPENMP
+      #pragma omp for schedule(dynamic)
+#endif
+      for (int s=0;s<nstrips;++s) {
+        const int k0 = s*strip;
+        const int width = std::min(strip,howmany-k0);
+        const Complex * in = src + std::ptrdiff_t(k0)*idist;
+        Complex * out = dst + std::ptrdiff_t(k0)*odist;
+        if (gather && istride==1)
+          for (int j=0;j<width;++j)
+            std::copy(in + std::ptrdiff_t(j)*idist, in + std::ptrdiff_t(j)*idist + nfft, &gathered[j*nfft]);
+        else if (gather)
+          for (int i=0;i<nfft;++i)
+            for (int j=0;j<width;++j)
+              gathered[j*nfft+i] = in[std::ptrdiff_t(j)*idist+std::ptrdiff_t(i)*istride];
+        for (int j=0;j<width;++j)
+          plan.transform(scatter ? &transformed[j*nfft] : out + std::ptrdiff_t(j)*odist,
+                         gather ? &gathered[j*nfft] : in + std::ptrdiff_t(j)*idist);
+        if (scatter)
+          for (int i=0;i<nfft;++i)
+            for (int j=0;j<width;++j)
+              out[std::ptrdiff_t(j)*odist+std::ptrdiff_t(i)*ostride] = transformed[j*nfft+i];
+      }
+    }
+  }
+
+  // transforms the n0 contiguous rows, and then the n1 interleaved columns
+  static void transform2(PlanData & colPlan, PlanData & rowPlan, Complex * dst, const Complex * src, int n0, int n1)
+  {
+    transform_batch(rowPlan,dst,src,n1,n0,1,n1,1,n1);
+    transform_batch(colPlan,dst,dst,n0,n1,n1,1,n1,1);
+  }
+
+  // The plans are created while holding m_plansMutex, and are not modified afterwards, so that
+  // several threads can share them.
   inline
     PlanData & get_plan(int nfft, bool inverse)
     {
+      ei_kissfft_lock lock(m_plansMutex);
       // TODO look for PlanKey(nfft, ! inverse) and conjugate the twiddles
       PlanData & pd = m_plans[ PlanKey(nfft,inverse) ];
       if ( pd.m_twiddles.size() == 0 ) {
         pd.make_twiddles(nfft,inverse);
         pd.factorize(nfft);
+        if (choose_algorithm(pd,nfft,inverse)==Bluestein)
+          pd.make_bluestein(nfft,inverse);
+        else
+          pd.make_packet_twiddles();
       }
       return pd;
     }
 
+  // only the sizes needing generic butterflies have a choice of algorithm
+  int choose_algorithm(const PlanData & pd, int nfft, bool inverse)
+  {
+    if (pd.max_radix() <= 5)
+      return MixedRadix;
+    std::map<int,int>::const_iterator it = m_wisdom.find(nfft);
+    if (it != m_wisdom.end())
+      return it->second;
+    if (!m_measure)
+      return pd.max_radix() > EIGEN_FFT_BLUESTEIN_THRESHOLD ? Bluestein : MixedRadix;
+
+    PlanData mixedRadix = pd;
+    mixedRadix.make_packet_twiddles();
+    PlanData bluestein = pd;
+    bluestein.make_bluestein(nfft,inverse);
+    int algorithm = time_plan(bluestein,nfft) < time_plan(mixedRadix,nfft) ? Bluestein : MixedRadix;
+    m_wisdom[nfft] = algorithm;
+    return algorithm;
+  }
+
+  // the average duration of a transform, repeated for at least 10ms or 1000 times
+  static double time_plan(PlanData & plan, int nfft)
+  {
+    std::vector<Complex> in(nfft,Complex(1)), out(nfft);
+    int runs = 0;
+    double start = wall_time(), elapsed;
+    do {
+      plan.transform(&out[0],&in[0]);
+      elapsed = wall_time() - start;
+    } while (++runs<1000 && elapsed<0.01);
+    return elapsed/runs;
+  }
+
+  // Elapsed real time in seconds. The transforms may run their sub-transforms in parallel, so
+  // that the processor time of std::clock() would be summed over the threads.
+  static double wall_time()
+  {
+#if defined(EIGEN_HAS_OPENMP)
+    return omp_get_wtime();
+#elif defined(EIGEN_KISSFFT_HAS_PTHREAD)
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return double(tv.tv_sec) + 1e-6*double(tv.tv_usec);
+#else
+    // the C runtime of MSVC measures real time with clock()
+    return double(std::clock())/CLOCKS_PER_SEC;
+#endif
+  }
+
   inline
     Complex * real_twiddles(int ncfft2)
     {
+      ei_kissfft_lock lock(m_plansMutex);
       std::vector<Complex> & twidref = m_realTwiddles[ncfft2];// creates new if not there
       if ( (int)twidref.size() != ncfft2 ) {
         twidref.resize(ncfft2);
@@ -0,0 +1,260 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_MAPPED_MATRIX_FILE_H
+#define EIGEN_MAPPED_MATRIX_FILE_H
+
+/** \ingroup MatrixFile_Module
+  *
+  * \class MappedMatrixFile
+  *
+  * \brief A matrix file mapped in memory
+  *
+  * This class maps a file written by writeMatrixFile() in memory, and returns a Map or a
+  * MappedSparseMatrix over the payload of the file. Nothing is copied when the file is opened: the
+  * pages of the file are loaded by the operating system when they are first accessed, and they are
+  * shared with the other processes mapping the same file. The returned objects
+  * reference the mapping, and thus must not be used after the MappedMatrixFile is destroyed.
+  *
+  * By default the mapping is private: the coefficients can be modified, but the modifications
+  * are neither written to the file nor seen by other processes, and only the modified pages are
+  * copied. If \a writable is true, the modifications are written back to the file.
+  *
+  * When the file is opened, its header is checked against the size of the file. The index arrays
+  * of a sparse matrix are read as well, in O(outerSize + nonZeros), to check that the outer index
+  * is nondecreasing and that the inner indices are within the inner size, so that a corrupted file
+  * cannot make the iterators of the mapped matrix read out of bounds. The coefficients are not read.
+  *
+  * On the platforms without mmap() the file is read into an aligned buffer, which is written
+  * back to the file when it is closed if \a writable is true.
+  *
+  * Note that the sizes of a mapped matrix are limited by the int indices of Eigen.
+  *
+  * \sa writeMatrixFile()
+  */
+class MappedMatrixFile
+{
+  public:
+    /** Maps the file \a filename in memory. Use isOpen() to check whether this succeeded. */
+    explicit MappedMatrixFile(const std::string& filename, bool writable = false)
+      : m_data(0), m_size(0)
+    {
+      open(filename, writable);
+      if(m_data && !checkHeader())
+        close();
+    }
+
+    ~MappedMatrixFile() { close(); }
+
+    /** \returns whether the file was successfully mapped and holds a valid matrix file */
+    bool isOpen() const { return m_data!=0; }
+
+    int rows() const { return int(header().rows); }
+    int cols() const { return int(header().cols); }
+    /** \returns the number of stored coefficients, i.e., rows()*cols() for a dense matrix */
+    int nonZeros() const { return int(header().nonZeros); }
+    bool isSparse() const { return (header().flags & MatrixFileSparse)!=0; }
+    bool isRowMajor() const { return (header().flags & MatrixFileRowMajor)!=0; }
+
+    /** \returns whether the file holds a matrix which can be mapped by map<MatrixType>(), i.e., a dense matrix
+      * of the scalar type, the storage order and the compile time sizes of \a MatrixType */
+    template<typename MatrixType> bool holds() const
+    {
+      typedef typename MatrixType::Scalar Scalar;
+      enum { IsRowMajor = int(MatrixType::Flags)&RowMajorBit ? 1 : 0 };
+      return isOpen() && !isSparse() && hasScalar<Scalar>()
+          && (isRowMajor()==bool(IsRowMajor) || MatrixType::IsVectorAtCompileTime)
+          && (MatrixType::RowsAtCompileTime==Dynamic || MatrixType::RowsAtCompileTime==rows())
+          && (MatrixType::ColsAtCompileTime==Dynamic || MatrixType::ColsAtCompileTime==cols());
+    }
+
+    /** \returns whether the file holds a sparse matrix which can be mapped by mapSparse<SparseMatrixType>(),
+      * i.e., a sparse matrix of the scalar type and the storage order of \a SparseMatrixType */
+    template<typename SparseMatrixType> bool holdsSparse() const
+    {
+      typedef typename SparseMatrixType::Scalar Scalar;
+      enum { IsRowMajor = int(SparseMatrixType::Flags)&RowMajorBit ? 1 : 0 };
+      return isOpen() && isSparse() && hasScalar<Scalar>() && isRowMajor()==bool(IsRowMajor);
+    }
+
+    /** \returns a Map of type \a MatrixType over the coefficients of the file, which must hold such a matrix.
+      * \sa holds() */
+    template<typename MatrixType> Map<MatrixType, Aligned> map()
+    {
+      typedef typename MatrixType::Scalar Scalar;
+      ei_assert(holds<MatrixType>() && "the file does not hold a dense matrix of this type");
+      return Map<MatrixType, Aligned>(reinterpret_cast<Scalar*>(m_data + header().valuesOffset), rows(), cols());
+    }
+
+    /** \returns a MappedSparseMatrix over the compressed storage of the file, which must hold a sparse matrix
+      * of the scalar type and the storage order of \a SparseMatrixType.
+      * \sa holdsSparse() */
+    template<typename SparseMatrixType>
+    MappedSparseMatrix<typename SparseMatrixType::Scalar, int(SparseMatrixType::Flags)&RowMajorBit> mapSparse()
+    {
+      typedef typename SparseMatrixType::Scalar Scalar;
+      ei_assert(holdsSparse<SparseMatrixType>() && "the file does not hold a sparse matrix of this type");
+      return MappedSparseMatrix<Scalar, int(SparseMatrixType::Flags)&RowMajorBit>(rows(), cols(), nonZeros(),
+               reinterpret_cast<int*>(m_data + header().outerIndexOffset),
+               reinterpret_cast<int*>(m_data + header().innerIndexOffset),
+               reinterpret_cast<Scalar*>(m_data + header().valuesOffset));
+    }
+
+  protected:
+    // a mapping cannot be shared
+    MappedMatrixFile(const MappedMatrixFile&);
+    MappedMatrixFile& operator=(const MappedMatrixFile&);
+
+    const ei_matrix_file_header& header() const
+    {
+      ei_assert(isOpen());
+      return *reinterpret_cast<const ei_matrix_file_header*>(m_data);
+    }
+
+    template<typename Scalar> bool hasScalar() const
+    {
+      return header().scalarType==(unsigned int)(ei_matrix_file_scalar<Scalar>::Id) && header().scalarSize==sizeof(Scalar);
+    }
+
+    // checks that \a count elements of \a elementSize bytes starting at \a offset lie within the file,
+    // without overflowing on a corrupted header
+    bool fitsInFile(long long offset, long long count, std::size_t elementSize) const
+    {
+      const long long size = m_size;
+      if(offset<0 || offset>size || count<0)
+        return false;
+      return count <= (size - offset) / (long long)(elementSize);
+    }
+
+    // checks that the header is valid and that the payload lies within the file
+    bool checkHeader() const
+    {
+      if(m_size<sizeof(ei_matrix_file_header))
+        return false;
+      const ei_matrix_file_header& h = header();
+      if(std::memcmp(h.magic, ei_matrix_file_header::magicString(), 8)!=0
+         || h.byteOrder!=(unsigned int)(ei_matrix_file_header::ByteOrderMark)
+         || h.version>(unsigned int)(ei_matrix_file_header::Version))
+        return false;
+      const long long maxIndex = std::numeric_limits<int>::max();
+      if(h.rows<0 || h.cols<0 || h.rows>maxIndex || h.cols>maxIndex || h.nonZeros<0 || h.nonZeros>maxIndex)
+        return false;
+      // the arrays are mapped with their natural alignment, at least
+      if(h.valuesOffset%16!=0 || h.outerIndexOffset%sizeof(int)!=0 || h.innerIndexOffset%sizeof(int)!=0)
+        return false;
+      // nonZeros is at most INT_MAX so that the comparisons below cannot overflow
+      if(h.scalarSize==0 || !fitsInFile(h.valuesOffset, h.nonZeros, h.scalarSize))
+        return false;
+      if(h.flags & MatrixFileSparse)
+      {
+        const long long outerSize = (h.flags & MatrixFileRowMajor) ? h.rows : h.cols;
+        if(!fitsInFile(h.outerIndexOffset, outerSize+1, sizeof(int))
+           || !fitsInFile(h.innerIndexOffset, h.nonZeros, sizeof(int)))
+          return false;
+        // the outer index must span exactly the stored coefficients, in order
+        const int* outerIndex = reinterpret_cast<const int*>(m_data + h.outerIndexOffset);
+        if(outerIndex[0]!=0 || outerIndex[outerSize]!=h.nonZeros)
+          return false;
+        for(long long j=0; j<outerSize; ++j)
+          if(outerIndex[j+1]<outerIndex[j])
+            return false;
+        const long long innerSize = (h.flags & MatrixFileRowMajor) ? h.cols : h.rows;
+        const int* innerIndex = reinterpret_cast<const int*>(m_data + h.innerIndexOffset);
+        for(long long k=0; k<h.nonZeros; ++k)
+          if(innerIndex[k]<0 || innerIndex[k]>=innerSize)
+            return false;
+      }
+      else if(h.nonZeros!=h.rows*h.cols)
+        return false;
+      return true;
+    }
+
+#ifdef EIGEN_MATRIX_FILE_HAS_MMAP
+    void open(const std::string& filename, bool writable)
+    {
+      int fd = ::open(filename.c_str(), writable ? O_RDWR : O_RDONLY);
+      if(fd<0)
+        return;
+      struct stat info;
+      if(::fstat(fd, &info)==0 && info.st_size>0)
+      {
+        // a private mapping is copied on write, so that the coefficients can be modified in both cases
+        void* data = ::mmap(0, std::size_t(info.st_size), PROT_READ | PROT_WRITE, writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+        if(data!=MAP_FAILED)
+        {
+          m_data = static_cast<char*>(data);
+          m_size = std::size_t(info.st_size);
+        }
+      }
+      // the mapping remains valid after the file is closed
+      ::close(fd);
+    }
+
+    void close()
+    {
+      if(m_data)
+        ::munmap(m_data, m_size);
+      m_data = 0;
+      m_size = 0;
+    }
+#else
+    void open(const std::string& filename, bool writable)
+    {
+      std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+      if(!stream)
+        return;
+      stream.seekg(0, std::ios::end);
+      std::size_t size = std::size_t(stream.tellg());
+      stream.seekg(0, std::ios::beg);
+      if(size==0)
+        return;
+      m_data = static_cast<char*>(ei_aligned_malloc(size));
+      m_size = size;
+      if(!stream.read(m_data, std::streamsize(size)))
+        close();
+      else if(writable)
+        m_filename = filename;
+    }
+
+    // the content of a writable file is written back when it is closed
+    void close()
+    {
+      if(m_data && !m_filename.empty())
+      {
+        std::ofstream stream(m_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.write(m_data, std::streamsize(m_size));
+      }
+      ei_aligned_free(m_data);
+      m_data = 0;
+      m_size = 0;
+      m_filename.clear();
+    }
+#endif
+
+    char* m_data;
+    std::size_t m_size;
+#ifndef EIGEN_MATRIX_FILE_HAS_MMAP
+    std::string m_filename;
+#endif
+};
+
+#endif // EIGEN_MAPPED_MATRIX_FILE_H
@@ -0,0 +1,227 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_MATRIX_FILE_FORMAT_H
+#define EIGEN_MATRIX_FILE_FORMAT_H
+
+/** \ingroup MatrixFile_Module
+  * Alignment in bytes of the arrays stored in a matrix file, which is a multiple of the
+  * alignment required by the vectorized code and of the size of a cache line. */
+enum { MatrixFileAlignment = 64 };
+
+/** \ingroup MatrixFile_Module
+  * Bits of the flags of a matrix file */
+enum {
+  MatrixFileRowMajor = 0x1,  ///< the matrix is stored in row major order
+  MatrixFileSparse = 0x2     ///< the payload is a compressed sparse matrix
+};
+
+/** \internal
+  * Header of a matrix file. All the offsets are in bytes from the start of the file.
+  * The byte order mark is written as 0x01020304 by the host, and the fields after the magic
+  * are naturally aligned so that the header has the same layout with all the usual compilers.
+  */
+struct ei_matrix_file_header
+{
+  char magic[8];                // "EIGENMAT"
+  unsigned int byteOrder;       // 0x01020304
+  unsigned int version;         // 1
+  unsigned int scalarType;      // see ei_matrix_file_scalar
+  unsigned int scalarSize;      // sizeof(Scalar)
+  unsigned int flags;           // MatrixFileRowMajor | MatrixFileSparse
+  unsigned int alignment;       // MatrixFileAlignment when the file was written
+  long long rows;
+  long long cols;
+  long long nonZeros;           // rows*cols for a dense matrix
+  long long valuesOffset;       // coefficients, or values of a sparse matrix
+  long long outerIndexOffset;   // outer index of a sparse matrix, outerSize+1 int
+  long long innerIndexOffset;   // inner indices of a sparse matrix, nonZeros int
+
+  static const char* magicString() { return "EIGENMAT"; }
+  enum { ByteOrderMark = 0x01020304, Version = 1 };
+
+  ei_matrix_file_header()
+  {
+    std::memset(this, 0, sizeof(ei_matrix_file_header));
+    std::memcpy(magic, magicString(), 8);
+    byteOrder = ByteOrderMark;
+    version = Version;
+    alignment = MatrixFileAlignment;
+  }
+
+  // rounds up \a offset to the alignment of the arrays of the payload
+  static long long align(long long offset)
+  {
+    return ((offset + MatrixFileAlignment - 1) / MatrixFileAlignment) * MatrixFileAlignment;
+  }
+};
+
+/** \internal identifier of the scalar type of a matrix file; it is not defined for the unsupported types */
+template<typename Scalar> struct ei_matrix_file_scalar;
+
+#define EIGEN_MAKE_MATRIX_FILE_SCALAR(TYPE,ID) \
+  template<> struct ei_matrix_file_scalar<TYPE> { enum { Id = ID }; };
+
+EIGEN_MAKE_MATRIX_FILE_SCALAR(float, 1)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(double, 2)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(std::complex<float>, 3)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(std::complex<double>, 4)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(int, 5)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(short, 6)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(signed char, 7)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(unsigned char, 8)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(half, 9)
+EIGEN_MAKE_MATRIX_FILE_SCALAR(bfloat16, 10)
+
+#undef EIGEN_MAKE_MATRIX_FILE_SCALAR
+
+/** \internal writes zeros to \a stream from \a pos up to \a offset */
+inline void ei_matrix_file_pad(std::ostream& stream, long long& pos, long long offset)
+{
+  static const char zeros[MatrixFileAlignment] = { 0 };
+  ei_assert(offset>=pos && offset-pos<=MatrixFileAlignment);
+  stream.write(zeros, std::streamsize(offset-pos));
+  pos = offset;
+}
+
+/** \internal writes \a count elements of \a data to \a stream */
+template<typename T>
+inline void ei_matrix_file_write(std::ostream& stream, long long& pos, const T* data, std::size_t count)
+{
+  stream.write(reinterpret_cast<const char*>(data), std::streamsize(count*sizeof(T)));
+  pos += count*sizeof(T);
+}
+
+/** \ingroup MatrixFile_Module
+  *
+  * Writes the dense matrix or expression \a m to the file \a filename, in the storage order of \a m.
+  * \returns false if the file could not be written.
+  *
+  * \sa class MappedMatrixFile
+  */
+template<typename Derived>
+bool writeMatrixFile(const std::string& filename, const MatrixBase<Derived>& m)
+{
+  typedef typename Derived::Scalar Scalar;
+  enum { IsRowMajor = int(Derived::Flags)&RowMajorBit ? 1 : 0 };
+
+  std::ofstream stream(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!stream)
+    return false;
+
+  ei_matrix_file_header header;
+  header.scalarType = ei_matrix_file_scalar<Scalar>::Id;
+  header.scalarSize = sizeof(Scalar);
+  header.flags = IsRowMajor ? MatrixFileRowMajor : 0;
+  header.rows = m.rows();
+  header.cols = m.cols();
+  header.nonZeros = header.rows * header.cols;
+  header.valuesOffset = ei_matrix_file_header::align(sizeof(ei_matrix_file_header));
+
+  long long pos = 0;
+  ei_matrix_file_write(stream, pos, &header, 1);
+  ei_matrix_file_pad(stream, pos, header.valuesOffset);
+
+  // the expression is evaluated one inner vector at a time
+  const int outerSize = IsRowMajor ? m.rows() : m.cols();
+  const int innerSize = IsRowMajor ? m.cols() : m.rows();
+  Matrix<Scalar,Dynamic,1> inner(innerSize);
+  for(int j=0; j<outerSize && stream; ++j)
+  {
+    if(IsRowMajor)
+      inner = m.row(j).transpose();
+    else
+      inner = m.col(j);
+    ei_matrix_file_write(stream, pos, inner.data(), innerSize);
+  }
+
+  return bool(stream);
+}
+
+/** \ingroup MatrixFile_Module
+  *
+  * Writes the sparse matrix or expression \a m to the file \a filename, in the compressed
+  * storage of its storage order, i.e., CSC for a column major matrix and CSR for a row major one.
+  * \returns false if the file could not be written.
+  *
+  * \sa class MappedMatrixFile
+  */
+template<typename Derived>
+bool writeMatrixFile(const std::string& filename, const SparseMatrixBase<Derived>& m)
+{
+  typedef typename Derived::Scalar Scalar;
+  typedef typename Derived::InnerIterator InnerIterator;
+  enum { IsRowMajor = int(Derived::Flags)&RowMajorBit ? 1 : 0 };
+
+  std::ofstream stream(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!stream)
+    return false;
+
+  // the outer index is computed first since the offsets of the arrays depend on the number of non zeros
+  const int outerSize = m.outerSize();
+  std::vector<int> outerIndex(outerSize+1);
+  outerIndex[0] = 0;
+  for(int j=0; j<outerSize; ++j)
+  {
+    int count = 0;
+    for(InnerIterator it(m.derived(), j); it; ++it)
+      ++count;
+    outerIndex[j+1] = outerIndex[j] + count;
+  }
+  const int nnz = outerIndex[outerSize];
+
+  ei_matrix_file_header header;
+  header.scalarType = ei_matrix_file_scalar<Scalar>::Id;
+  header.scalarSize = sizeof(Scalar);
+  header.flags = MatrixFileSparse | (IsRowMajor ? MatrixFileRowMajor : 0);
+  header.rows = m.rows();
+  header.cols = m.cols();
+  header.nonZeros = nnz;
+  header.outerIndexOffset = ei_matrix_file_header::align(sizeof(ei_matrix_file_header));
+  header.innerIndexOffset = ei_matrix_file_header::align(header.outerIndexOffset + (outerSize+1)*sizeof(int));
+  header.valuesOffset = ei_matrix_file_header::align(header.innerIndexOffset + nnz*sizeof(int));
+
+  long long pos = 0;
+  ei_matrix_file_write(stream, pos, &header, 1);
+  ei_matrix_file_pad(stream, pos, header.outerIndexOffset);
+  ei_matrix_file_write(stream, pos, &outerIndex[0], outerSize+1);
+
+  ei_matrix_file_pad(stream, pos, header.innerIndexOffset);
+  for(int j=0; j<outerSize && stream; ++j)
+    for(InnerIterator it(m.derived(), j); it; ++it)
+    {
+      const int index = it.index();
+      ei_matrix_file_write(stream, pos, &index, 1);
+    }
+
+  ei_matrix_file_pad(stream, pos, header.valuesOffset);
+  for(int j=0; j<outerSize && stream; ++j)
+    for(InnerIterator it(m.derived(), j); it; ++it)
+    {
+      const Scalar value = it.value();
+      ei_matrix_file_write(stream, pos, &value, 1);
+    }
+
+  return bool(stream);
+}
+
+#endif // EIGEN_MATRIX_FILE_FORMAT_H
@@ -34,12 +34,25 @@
   * \brief Class for computing the matrix exponential.
   * \tparam MatrixType type of the argument of the exponential,
   * expected to be an instantiation of the Matrix class template.
+  *
+  * The powers of the argument and the other intermediate matrices
+  * are kept as members, so that computing the exponential of several
+  * matrices of the same size with one object, via
+  * compute(const MatrixType&, ResultType&), does not allocate any
+  * new workspace after the first call.
   */
 template <typename MatrixType>
 class MatrixExponential {
 
   public:
 
+    /** \brief Default constructor.
+      *
+      * The argument has to be given to
+      * compute(const MatrixType&, ResultType&).
+      */
+    MatrixExponential();
+
     /** \brief Constructor.
       * 
       * The class stores a reference to \p M, so it should not be
@@ -56,6 +69,17 @@ class MatrixExponential {
     template <typename ResultType> 
     void compute(ResultType &result);
 
+    /** \brief Computes the matrix exponential of another matrix.
+      *
+      * The workspace of previous calls is reused when \p M has the
+      * same size.
+      *
+      * \param[in]  M       matrix whose exponential is to be computed.
+      * \param[out] result  the matrix exponential of \p M.
+      */
+    template <typename ResultType>
+    void compute(const MatrixType &M, ResultType &result);
+
   private:
 
     // Prevent copying
@@ -128,11 +152,14 @@ class MatrixExponential {
      */
     void computeUV(float);
 
+    /** \brief Binds \p M and resizes the workspace to its size. */
+    void init(const MatrixType &M);
+
     typedef typename ei_traits<MatrixType>::Scalar Scalar;
     typedef typename NumTraits<Scalar>::Real RealScalar;
 
-    /** \brief Reference to matrix whose exponential is to be computed. */
-    const MatrixType& m_M;
+    /** \brief Pointer to matrix whose exponential is to be computed. */
+    const MatrixType* m_M;
 
     /** \brief Even-degree terms in numerator of Pad&eacute; approximant. */
     MatrixType m_U;
@@ -146,9 +173,24 @@ class MatrixExponential {
     /** \brief Used for temporary storage. */
     MatrixType m_tmp2;
 
+    /** \brief Square of the argument of the Pad&eacute; approximant. */
+    MatrixType m_A2;
+
+    /** \brief Fourth power of the argument of the Pad&eacute; approximant. */
+    MatrixType m_A4;
+
+    /** \brief Sixth power of the argument of the Pad&eacute; approximant. */
+    MatrixType m_A6;
+
+    /** \brief \c m_M scaled by \f$ 2^{-\mbox{squarings}} \f$. */
+    MatrixType m_scaled;
+
     /** \brief Identity matrix of the same size as \c m_M. */
     MatrixType m_Id;
 
+    /** \brief LU decomposition of the denominator of the Pad&eacute; approximant. */
+    PartialPivLU<MatrixType> m_lu;
+
     /** \brief Number of squarings required in the last step. */
     int m_squarings;
 
@@ -157,29 +199,61 @@ class MatrixExponential {
 };
 
 template <typename MatrixType>
-MatrixExponential<MatrixType>::MatrixExponential(const MatrixType &M) :
-  m_M(M),
-  m_U(M.rows(),M.cols()),
-  m_V(M.rows(),M.cols()),
-  m_tmp1(M.rows(),M.cols()),
-  m_tmp2(M.rows(),M.cols()),
-  m_Id(MatrixType::Identity(M.rows(), M.cols())),
+MatrixExponential<MatrixType>::MatrixExponential() :
+  m_M(0),
   m_squarings(0),
-  m_l1norm(static_cast<float>(M.cwiseAbs().colwise().sum().maxCoeff()))
+  m_l1norm(0)
 {
   /* empty body */
 }
 
+template <typename MatrixType>
+MatrixExponential<MatrixType>::MatrixExponential(const MatrixType &M) :
+  m_M(0),
+  m_squarings(0),
+  m_l1norm(0)
+{
+  init(M);
+}
+
+template <typename MatrixType>
+void MatrixExponential<MatrixType>::init(const MatrixType &M)
+{
+  ei_assert(M.rows() == M.cols());
+  if (m_M == 0 || m_Id.rows() != M.rows() || m_Id.cols() != M.cols()) {
+    m_U.resize(M.rows(),M.cols());
+    m_V.resize(M.rows(),M.cols());
+    m_tmp1.resize(M.rows(),M.cols());
+    m_tmp2.resize(M.rows(),M.cols());
+    m_Id = MatrixType::Identity(M.rows(), M.cols());
+  }
+  m_M = &M;
+  m_squarings = 0;
+  m_l1norm = static_cast<float>(M.cwiseAbs().colwise().sum().maxCoeff());
+}
+
 template <typename MatrixType>
 template <typename ResultType> 
 void MatrixExponential<MatrixType>::compute(ResultType &result)
 {
+  ei_assert(m_M != 0 && "MatrixExponential is not initialized.");
   computeUV(RealScalar());
   m_tmp1 = m_U + m_V;	// numerator of Pade approximant
   m_tmp2 = -m_U + m_V;	// denominator of Pade approximant
-  result = m_tmp2.partialPivLu().solve(m_tmp1);
-  for (int i=0; i<m_squarings; i++)
-    result *= result;		// undo scaling by repeated squaring
+  m_U = m_lu.compute(m_tmp2).solve(m_tmp1);
+  for (int i=0; i<m_squarings; i++) {
+    m_V.noalias() = m_U * m_U;	// undo scaling by repeated squaring
+    m_U.swap(m_V);
+  }
+  result = m_U;
+}
+
+template <typename MatrixType>
+template <typename ResultType>
+void MatrixExponential<MatrixType>::compute(const MatrixType &M, ResultType &result)
+{
+  init(M);
+  compute(result);
 }
 
 template <typename MatrixType>
@@ -196,23 +270,23 @@ template <typename MatrixType>
 EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade5(const MatrixType &A)
 {
   const Scalar b[] = {30240., 15120., 3360., 420., 30., 1.};
-  MatrixType A2 = A * A;
-  m_tmp1.noalias() = A2 * A2;
-  m_tmp2 = b[5]*m_tmp1 + b[3]*A2 + b[1]*m_Id;
+  m_A2.noalias() = A * A;
+  m_tmp1.noalias() = m_A2 * m_A2;
+  m_tmp2 = b[5]*m_tmp1 + b[3]*m_A2 + b[1]*m_Id;
   m_U.noalias() = A * m_tmp2;
-  m_V = b[4]*m_tmp1 + b[2]*A2 + b[0]*m_Id;
+  m_V = b[4]*m_tmp1 + b[2]*m_A2 + b[0]*m_Id;
 }
 
 template <typename MatrixType>
 EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade7(const MatrixType &A)
 {
   const Scalar b[] = {17297280., 8648640., 1995840., 277200., 25200., 1512., 56., 1.};
-  MatrixType A2 = A * A;
-  MatrixType A4 = A2 * A2;
-  m_tmp1.noalias() = A4 * A2;
-  m_tmp2 = b[7]*m_tmp1 + b[5]*A4 + b[3]*A2 + b[1]*m_Id;
+  m_A2.noalias() = A * A;
+  m_A4.noalias() = m_A2 * m_A2;
+  m_tmp1.noalias() = m_A4 * m_A2;
+  m_tmp2 = b[7]*m_tmp1 + b[5]*m_A4 + b[3]*m_A2 + b[1]*m_Id;
   m_U.noalias() = A * m_tmp2;
-  m_V = b[6]*m_tmp1 + b[4]*A4 + b[2]*A2 + b[0]*m_Id;
+  m_V = b[6]*m_tmp1 + b[4]*m_A4 + b[2]*m_A2 + b[0]*m_Id;
 }
 
 template <typename MatrixType>
@@ -220,13 +294,13 @@ EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade9(const MatrixType &
 {
   const Scalar b[] = {17643225600., 8821612800., 2075673600., 302702400., 30270240.,
   		      2162160., 110880., 3960., 90., 1.};
-  MatrixType A2 = A * A;
-  MatrixType A4 = A2 * A2;
-  MatrixType A6 = A4 * A2;
-  m_tmp1.noalias() = A6 * A2;
-  m_tmp2 = b[9]*m_tmp1 + b[7]*A6 + b[5]*A4 + b[3]*A2 + b[1]*m_Id;
+  m_A2.noalias() = A * A;
+  m_A4.noalias() = m_A2 * m_A2;
+  m_A6.noalias() = m_A4 * m_A2;
+  m_tmp1.noalias() = m_A6 * m_A2;
+  m_tmp2 = b[9]*m_tmp1 + b[7]*m_A6 + b[5]*m_A4 + b[3]*m_A2 + b[1]*m_Id;
   m_U.noalias() = A * m_tmp2;
-  m_V = b[8]*m_tmp1 + b[6]*A6 + b[4]*A4 + b[2]*A2 + b[0]*m_Id;
+  m_V = b[8]*m_tmp1 + b[6]*m_A6 + b[4]*m_A4 + b[2]*m_A2 + b[0]*m_Id;
 }
 
 template <typename MatrixType>
@@ -235,30 +309,30 @@ EIGEN_STRONG_INLINE void MatrixExponential<MatrixType>::pade13(const MatrixType
   const Scalar b[] = {64764752532480000., 32382376266240000., 7771770303897600.,
   		      1187353796428800., 129060195264000., 10559470521600., 670442572800.,
   		      33522128640., 1323241920., 40840800., 960960., 16380., 182., 1.};
-  MatrixType A2 = A * A;
-  MatrixType A4 = A2 * A2;
-  m_tmp1.noalias() = A4 * A2;
-  m_V = b[13]*m_tmp1 + b[11]*A4 + b[9]*A2; // used for temporary storage
+  m_A2.noalias() = A * A;
+  m_A4.noalias() = m_A2 * m_A2;
+  m_tmp1.noalias() = m_A4 * m_A2;
+  m_V = b[13]*m_tmp1 + b[11]*m_A4 + b[9]*m_A2; // used for temporary storage
   m_tmp2.noalias() = m_tmp1 * m_V;
-  m_tmp2 += b[7]*m_tmp1 + b[5]*A4 + b[3]*A2 + b[1]*m_Id;
+  m_tmp2 += b[7]*m_tmp1 + b[5]*m_A4 + b[3]*m_A2 + b[1]*m_Id;
   m_U.noalias() = A * m_tmp2;
-  m_tmp2 = b[12]*m_tmp1 + b[10]*A4 + b[8]*A2;
+  m_tmp2 = b[12]*m_tmp1 + b[10]*m_A4 + b[8]*m_A2;
   m_V.noalias() = m_tmp1 * m_tmp2;
-  m_V += b[6]*m_tmp1 + b[4]*A4 + b[2]*A2 + b[0]*m_Id;
+  m_V += b[6]*m_tmp1 + b[4]*m_A4 + b[2]*m_A2 + b[0]*m_Id;
 }
 
 template <typename MatrixType>
 void MatrixExponential<MatrixType>::computeUV(float)
 {
   if (m_l1norm < 4.258730016922831e-001) {
-    pade3(m_M);
+    pade3(*m_M);
   } else if (m_l1norm < 1.880152677804762e+000) {
-    pade5(m_M);
+    pade5(*m_M);
   } else {
     const float maxnorm = 3.925724783138660f;
     m_squarings = std::max(0, (int)ceil(log2(m_l1norm / maxnorm)));
-    MatrixType A = m_M / std::pow(Scalar(2), Scalar(static_cast<RealScalar>(m_squarings)));
-    pade7(A);
+    m_scaled = *m_M / std::pow(Scalar(2), Scalar(static_cast<RealScalar>(m_squarings)));
+    pade7(m_scaled);
   }
 }
 
@@ -266,18 +340,18 @@ template <typename MatrixType>
 void MatrixExponential<MatrixType>::computeUV(double)
 {
   if (m_l1norm < 1.495585217958292e-002) {
-    pade3(m_M);
+    pade3(*m_M);
   } else if (m_l1norm < 2.539398330063230e-001) {
-    pade5(m_M);
+    pade5(*m_M);
   } else if (m_l1norm < 9.504178996162932e-001) {
-    pade7(m_M);
+    pade7(*m_M);
   } else if (m_l1norm < 2.097847961257068e+000) {
-    pade9(m_M);
+    pade9(*m_M);
   } else {
     const double maxnorm = 5.371920351148152;
     m_squarings = std::max(0, (int)ceil(log2(m_l1norm / maxnorm)));
-    MatrixType A = m_M / std::pow(Scalar(2), Scalar(m_squarings));
-    pade13(A);
+    m_scaled = *m_M / std::pow(Scalar(2), Scalar(m_squarings));
+    pade13(m_scaled);
   }
 }
 
@@ -0,0 +1,263 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_MATRIX_EXPONENTIAL_ACTION
+#define EIGEN_MATRIX_EXPONENTIAL_ACTION
+
+/** \internal \returns in \p mu the shift trace(A)/n and in \p norm the 1-norm
+  * of \f$ A - \mu I \f$ for a dense matrix \p A. The shift is dropped when it
+  * does not reduce the 1-norm.
+  */
+template <typename Derived>
+void ei_matrix_exponential_action_norm(const MatrixBase<Derived>& A,
+                                       typename ei_traits<Derived>::Scalar& mu,
+                                       typename NumTraits<typename ei_traits<Derived>::Scalar>::Real& norm)
+{
+  typedef typename ei_traits<Derived>::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const int size = A.rows();
+  mu = A.trace() / Scalar(RealScalar(size));
+  RealScalar shiftedNorm = 0;
+  norm = 0;
+  for (int j = 0; j < size; ++j) {
+    RealScalar sum = 0, shiftedSum = 0;
+    for (int i = 0; i < size; ++i) {
+      sum += ei_abs(A.coeff(i,j));
+      shiftedSum += ei_abs(i == j ? A.coeff(i,j) - mu : A.coeff(i,j));
+    }
+    norm = std::max(norm, sum);
+    shiftedNorm = std::max(shiftedNorm, shiftedSum);
+  }
+  if (shiftedNorm < norm)
+    norm = shiftedNorm;
+  else
+    mu = Scalar(0);
+}
+
+/** \internal sparse version of ei_matrix_exponential_action_norm(); only the
+  * stored coefficients are visited.
+  */
+template <typename Derived>
+void ei_matrix_exponential_action_norm(const SparseMatrixBase<Derived>& A,
+                                       typename ei_traits<Derived>::Scalar& mu,
+                                       typename NumTraits<typename ei_traits<Derived>::Scalar>::Real& norm)
+{
+  typedef typename ei_traits<Derived>::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const int size = A.rows();
+  Matrix<RealScalar,Dynamic,1> offDiagonal = Matrix<RealScalar,Dynamic,1>::Zero(size);
+  Matrix<Scalar,Dynamic,1> diagonal = Matrix<Scalar,Dynamic,1>::Zero(size);
+  for (int k = 0; k < A.outerSize(); ++k)
+    for (typename Derived::InnerIterator it(A.derived(), k); it; ++it) {
+      if (it.row() == it.col())
+        diagonal.coeffRef(it.col()) += it.value();
+      else
+        offDiagonal.coeffRef(it.col()) += ei_abs(it.value());
+    }
+  mu = diagonal.sum() / Scalar(RealScalar(size));
+  norm = (offDiagonal + diagonal.cwiseAbs()).maxCoeff();
+  RealScalar shiftedNorm = (offDiagonal + (diagonal.array() - mu).matrix().cwiseAbs()).maxCoeff();
+  if (shiftedNorm < norm)
+    norm = shiftedNorm;
+  else
+    mu = Scalar(0);
+}
+
+/** \ingroup MatrixFunctions_Module
+  * \brief Class for computing the action of the matrix exponential on vectors.
+  *
+  * \tparam MatrixType  type of the operator \f$ A \f$; either a dense Matrix
+  * or a SparseMatrix, or anything else providing \c A*v products, \c rows()
+  * and an overload of ei_matrix_exponential_action_norm().
+  * \tparam VectorType  type of the vectors \f$ v \f$, defaults to a dynamic
+  * column vector. Use a dynamic matrix to act on several vectors at once.
+  *
+  * This class computes \f$ \exp(tA) v \f$ without ever forming
+  * \f$ \exp(tA) \f$, using the truncated Taylor series algorithm with
+  * scaling of:
+  * Awad H. Al-Mohy and Nicholas J. Higham, "Computing the action of the
+  * matrix exponential, with an application to exponential integrators",
+  * <em>SIAM J. Sci. Comput.</em>, <b>33</b>:488&ndash;511, 2011.
+  *
+  * The operator is shifted by \f$ \mu = \mbox{trace}(A)/n \f$ whenever
+  * this reduces its 1-norm. The degree \f$ m \f$ of the Taylor polynomial
+  * and the number of steps \f$ s \f$ are selected from \f$ t\|A-\mu I\|_1 \f$
+  * such that the backward error does not exceed the unit round-off; the
+  * cost is \f$ ms \f$ products with \f$ A \f$ at most, and less when the
+  * series converges early. The norm of \f$ A \f$ is computed once in the
+  * constructor and the vector workspace is kept between calls, so
+  * evaluating the action for many values of \f$ t \f$ is cheap.
+  *
+  * \note \p MatrixType has to be a matrix of \c float, \c double,
+  * \c complex<float> or \c complex<double> .
+  */
+template <typename MatrixType,
+          typename VectorType = Matrix<typename ei_traits<MatrixType>::Scalar, Dynamic, 1> >
+class MatrixExponentialAction
+{
+  public:
+
+    typedef typename ei_traits<MatrixType>::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+
+    /** \brief Constructor.
+      *
+      * The class stores a reference to \p A, so it should not be
+      * changed (or destroyed) while the object is used.
+      *
+      * \param[in] A  square operator whose exponential is applied.
+      */
+    MatrixExponentialAction(const MatrixType& A);
+
+    /** \brief Computes \f$ \exp(tA) v \f$.
+      *
+      * \param[in]  t       scaling of the operator.
+      * \param[in]  v       vector (or block of vectors) the exponential is applied to.
+      * \param[out] result  \f$ \exp(tA) v \f$; may be the same object as \p v.
+      */
+    template <typename RhsType, typename ResultType>
+    void compute(const Scalar& t, const RhsType& v, ResultType& result);
+
+    /** \returns the degree of the Taylor polynomial used by the last call to compute(). */
+    int degree() const { return m_degree; }
+
+    /** \returns the number of scaling steps used by the last call to compute(). */
+    int steps() const { return m_steps; }
+
+  private:
+
+    // Prevent copying
+    MatrixExponentialAction(const MatrixExponentialAction&);
+    MatrixExponentialAction& operator=(const MatrixExponentialAction&);
+
+    /** \brief Selects \c m_degree and \c m_steps for \f$ \|tA\|_1 \f$ = \p tnorm.
+      *
+      * The argument \p theta lists the largest norm for which the Taylor
+      * polynomials of degree 5, 10, ..., 55 are accurate to unit round-off.
+      */
+    void selectParameters(RealScalar tnorm, const RealScalar* theta);
+
+    /** \brief Selects parameters for double precision. */
+    void selectParameters(RealScalar tnorm, double);
+
+    /** \brief Selects parameters for single precision. */
+    void selectParameters(RealScalar tnorm, float);
+
+    /** \brief Reference to the operator. */
+    const MatrixType& m_A;
+
+    /** \brief Shift applied to the operator. */
+    Scalar m_mu;
+
+    /** \brief 1-norm of the shifted operator. */
+    RealScalar m_l1norm;
+
+    /** \brief Partial sum of the Taylor series. */
+    VectorType m_F;
+
+    /** \brief Current term of the Taylor series. */
+    VectorType m_b;
+
+    /** \brief Used for temporary storage. */
+    VectorType m_tmp;
+
+    int m_degree;
+    int m_steps;
+};
+
+template <typename MatrixType, typename VectorType>
+MatrixExponentialAction<MatrixType,VectorType>::MatrixExponentialAction(const MatrixType& A) :
+  m_A(A),
+  m_degree(0),
+  m_steps(0)
+{
+  ei_assert(A.rows() == A.cols());
+  ei_matrix_exponential_action_norm(A, m_mu, m_l1norm);
+}
+
+template <typename MatrixType, typename VectorType>
+void MatrixExponentialAction<MatrixType,VectorType>::selectParameters(RealScalar tnorm, const RealScalar* theta)
+{
+  m_degree = 0;
+  m_steps = 1;
+  if (tnorm == RealScalar(0))
+    return;
+  int bestCost = std::numeric_limits<int>::max();
+  for (int k = 0; k < 11; ++k) {
+    const RealScalar steps = std::ceil(tnorm / theta[k]);
+    if (steps * (5*k+5) >= RealScalar(bestCost))
+      continue;
+    m_degree = 5*k+5;
+    m_steps = std::max(1, int(steps));
+    bestCost = m_degree * m_steps;
+  }
+}
+
+template <typename MatrixType, typename VectorType>
+void MatrixExponentialAction<MatrixType,VectorType>::selectParameters(RealScalar tnorm, double)
+{
+  static const RealScalar theta[] = { 2.4e-3, 1.4e-1, 6.4e-1, 1.4, 2.4, 3.5, 4.7, 6.0, 7.2, 8.5, 9.9 };
+  selectParameters(tnorm, theta);
+}
+
+template <typename MatrixType, typename VectorType>
+void MatrixExponentialAction<MatrixType,VectorType>::selectParameters(RealScalar tnorm, float)
+{
+  static const RealScalar theta[] = { 1.3e-1, 1.0, 2.2, 3.6, 4.9, 6.3, 7.7, 9.1, 11.0, 12.0, 13.0 };
+  selectParameters(tnorm, theta);
+}
+
+template <typename MatrixType, typename VectorType>
+template <typename RhsType, typename ResultType>
+void MatrixExponentialAction<MatrixType,VectorType>::compute(const Scalar& t, const RhsType& v, ResultType& result)
+{
+  ei_assert(v.rows() == m_A.cols());
+  selectParameters(ei_abs(t) * m_l1norm, RealScalar());
+  const RealScalar tol = NumTraits<RealScalar>::epsilon();
+  const Scalar eta = std::exp(t * m_mu / Scalar(RealScalar(m_steps)));
+  const bool shifted = m_mu != Scalar(0);
+
+  m_F = v;
+  m_b = m_F;
+  for (int i = 0; i < m_steps; ++i) {
+    RealScalar c1 = m_b.cwiseAbs().maxCoeff();
+    for (int j = 1; j <= m_degree; ++j) {
+      // next Taylor term: t/(s*j) (A - mu I) b
+      m_tmp.noalias() = m_A * m_b;
+      if (shifted)
+        m_tmp -= m_mu * m_b;
+      m_b.swap(m_tmp);
+      m_b *= t / Scalar(RealScalar(m_steps * j));
+      const RealScalar c2 = m_b.cwiseAbs().maxCoeff();
+      m_F += m_b;
+      if (c1 + c2 <= tol * m_F.cwiseAbs().maxCoeff())
+        break;
+      c1 = c2;
+    }
+    if (shifted)
+      m_F *= eta;
+    m_b = m_F;
+  }
+  result = m_F;
+}
+
+#endif // EIGEN_MATRIX_EXPONENTIAL_ACTION
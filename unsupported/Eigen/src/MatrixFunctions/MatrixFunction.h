@@ -365,15 +365,28 @@ void MatrixFunction<MatrixType,1>::swapEntriesInSchur(int index)
   * diagonal part of #m_T, with the blocking given by #m_blockStart. The
   * result is stored in #m_fT. The off-diagonal parts of #m_fT are set
   * to zero.
+  *
+  * The diagonal blocks are independent. When OpenMP is enabled they
+  * are distributed over the threads, so the stem function #m_f has
+  * to be thread-safe.
   */
 template <typename MatrixType>
 void MatrixFunction<MatrixType,1>::computeBlockAtomic()
 { 
   m_fT.resize(m_T.rows(), m_T.cols());
   m_fT.setZero();
-  MatrixFunctionAtomic<DynMatrixType> mfa(m_f);
-  for (int i = 0; i < m_clusterSize.rows(); ++i) {
-    block(m_fT, i, i) = mfa.compute(block(m_T, i, i));
+  const int numClusters = m_clusterSize.rows();
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel if(numClusters > 1)
+#endif
+  {
+    MatrixFunctionAtomic<DynMatrixType> mfa(m_f);
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp for schedule(dynamic)
+#endif
+    for (int i = 0; i < numClusters; ++i) {
+      block(m_fT, i, i) = mfa.compute(block(m_T, i, i));
+    }
   }
 }
 
@@ -390,22 +403,35 @@ Block<MatrixType> MatrixFunction<MatrixType,1>::block(const MatrixType& A, int i
   * equals #m_f applied to #m_T) has already been computed and computes
   * the part above the block diagonal. The part below the diagonal is
   * zero, because #m_T is upper triangular.
+  *
+  * The blocks are computed one block superdiagonal after the other.
+  * The blocks on one superdiagonal only depend on blocks closer to the
+  * diagonal, so they are computed in parallel when OpenMP is enabled.
+  * The right-hand side of each Sylvester equation is formed with two
+  * matrix-matrix products over the contiguous block row and column.
   */
 template <typename MatrixType>
 void MatrixFunction<MatrixType,1>::computeOffDiagonal()
 { 
-  for (int diagIndex = 1; diagIndex < m_clusterSize.rows(); diagIndex++) {
-    for (int blockIndex = 0; blockIndex < m_clusterSize.rows() - diagIndex; blockIndex++) {
+  const int numClusters = m_clusterSize.rows();
+  for (int diagIndex = 1; diagIndex < numClusters; diagIndex++) {
+#ifdef EIGEN_HAS_OPENMP
+    #pragma omp parallel for schedule(dynamic) if(numClusters - diagIndex > 1)
+#endif
+    for (int blockIndex = 0; blockIndex < numClusters - diagIndex; blockIndex++) {
       // compute (blockIndex, blockIndex+diagIndex) block
-      DynMatrixType A = block(m_T, blockIndex, blockIndex);
-      DynMatrixType B = -block(m_T, blockIndex+diagIndex, blockIndex+diagIndex);
-      DynMatrixType C = block(m_fT, blockIndex, blockIndex) * block(m_T, blockIndex, blockIndex+diagIndex);
-      C -= block(m_T, blockIndex, blockIndex+diagIndex) * block(m_fT, blockIndex+diagIndex, blockIndex+diagIndex);
-      for (int k = blockIndex + 1; k < blockIndex + diagIndex; k++) {
-	C += block(m_fT, blockIndex, k) * block(m_T, k, blockIndex+diagIndex);
-	C -= block(m_T, blockIndex, k) * block(m_fT, k, blockIndex+diagIndex);
-      }
-      block(m_fT, blockIndex, blockIndex+diagIndex) = solveTriangularSylvester(A, B, C);
+      const int i = blockIndex, j = blockIndex + diagIndex;
+      const int rowStart = m_blockStart(i), rows = m_clusterSize(i);
+      const int colStart = m_blockStart(j), cols = m_clusterSize(j);
+      DynMatrixType A = block(m_T, i, i);
+      DynMatrixType B = -block(m_T, j, j);
+      // C = \sum_{k=i}^{j-1} fT_{ik} T_{kj} - \sum_{k=i+1}^{j} T_{ik} fT_{kj}
+      DynMatrixType C(rows, cols);
+      C.noalias() = m_fT.block(rowStart, rowStart, rows, colStart - rowStart)
+                  * m_T.block(rowStart, colStart, colStart - rowStart, cols);
+      C.noalias() -= m_T.block(rowStart, rowStart + rows, rows, colStart + cols - rowStart - rows)
+                   * m_fT.block(rowStart + rows, colStart, colStart + cols - rowStart - rows, cols);
+      block(m_fT, i, j) = solveTriangularSylvester(A, B, C);
     }
   }
 }
@@ -432,6 +458,11 @@ void MatrixFunction<MatrixType,1>::computeOffDiagonal()
   * zero (otherwise the Sylvester equation does not have a unique
   * solution). In that case, these equations can be evaluated in the
   * order \f$ i=m,\ldots,1 \f$ and \f$ j=1,\ldots,n \f$.
+  *
+  * The implementation works on panels of columns of X. The contribution
+  * of the panels already computed is subtracted with one matrix-matrix
+  * product, and the columns within a panel are obtained one after the
+  * other by solving the triangular system \f$ (A + B_{jj} I) x_j = c_j \f$.
   */
 template <typename MatrixType>
 typename MatrixFunction<MatrixType,1>::DynMatrixType MatrixFunction<MatrixType,1>::solveTriangularSylvester(
@@ -446,32 +477,22 @@ typename MatrixFunction<MatrixType,1>::DynMatrixType MatrixFunction<MatrixType,1
   ei_assert(C.rows() == A.rows());
   ei_assert(C.cols() == B.rows());
 
-  int m = A.rows();
-  int n = B.rows();
-  DynMatrixType X(m, n);
-
-  for (int i = m - 1; i >= 0; --i) {
-    for (int j = 0; j < n; ++j) {
-
-      // Compute AX = \sum_{k=i+1}^m A_{ik} X_{kj}
-      Scalar AX;
-      if (i == m - 1) {
-	AX = 0; 
-      } else {
-	Matrix<Scalar,1,1> AXmatrix = A.row(i).tail(m-1-i) * X.col(j).tail(m-1-i);
-	AX = AXmatrix(0,0);
-      }
-
-      // Compute XB = \sum_{k=1}^{j-1} X_{ik} B_{kj}
-      Scalar XB;
-      if (j == 0) {
-	XB = 0; 
-      } else {
-	Matrix<Scalar,1,1> XBmatrix = X.row(i).head(j) * B.col(j).head(j);
-	XB = XBmatrix(0,0);
-      }
-
-      X(i,j) = (C(i,j) - AX - XB) / (A(i,i) + B(j,j));
+  const int m = A.rows();
+  const int n = B.rows();
+  const int panelSize = 16;
+  DynMatrixType X = C;
+  DynMatrixType shiftedA = A;
+
+  for (int j0 = 0; j0 < n; j0 += panelSize) {
+    const int panelCols = std::min(panelSize, n - j0);
+    if (j0 > 0)
+      X.block(0, j0, m, panelCols).noalias() -= X.block(0, 0, m, j0) * B.block(0, j0, j0, panelCols);
+    for (int j = j0; j < j0 + panelCols; ++j) {
+      if (j > j0)
+        X.col(j).noalias() -= X.block(0, j0, m, j - j0) * B.col(j).segment(j0, j - j0);
+      shiftedA.diagonal() = A.diagonal();
+      shiftedA.diagonal().array() += B(j,j);
+      shiftedA.template triangularView<Upper>().solveInPlace(X.col(j));
     }
   }
   return X;
@@ -125,6 +125,7 @@ private:
     int n;
     int m;
     FVectorType wa1, wa2, wa3, wa4;
+    ColPivHouseholderQR<JacobianType> qrfac;
 
     Scalar par, sum;
     Scalar temp, temp1, temp2;
@@ -229,7 +230,7 @@ LevenbergMarquardt<FunctorType,Scalar>::minimizeOneStep(FVectorType  &x)
 
     /* compute the qr factorization of the jacobian. */
     wa2 = fjac.colwise().blueNorm();
-    ColPivHouseholderQR<JacobianType> qrfac(fjac);
+    qrfac.compute(fjac);
     fjac = qrfac.matrixQR();
     permutation = qrfac.colsPermutation();
 
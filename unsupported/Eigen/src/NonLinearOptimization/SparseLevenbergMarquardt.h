@@ -0,0 +1,379 @@
+// -*- coding: utf-8
+// vim: set fileencoding=utf-8
+
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef EIGEN_SPARSELEVENBERGMARQUARDT__H
+#define EIGEN_SPARSELEVENBERGMARQUARDT__H
+
+/**
+  * \ingroup NonLinearOptimization_Module
+  * \brief Performs non linear optimization over a non-linear function with a sparse
+  * jacobian, using a variant of the Levenberg Marquardt algorithm.
+  *
+  * The functor provides operator()(x, fvec) and df(x, fjac), where \c fjac is a column major
+  * SparseMatrix<Scalar> holding the m x n jacobian. Each step solves the damped normal equations
+  * \f$ (J^T J + \lambda D^2) p = -J^T f \f$ using a SparseLDLT factorization, where \f$ D \f$
+  * holds the column norms of the jacobian as in LevenbergMarquardt.
+  *
+  * The nonzero pattern of the jacobian is assumed to be the same at every step: the pattern of
+  * \f$ J^T J \f$ and its symbolic factorization are computed on the first step only, and are
+  * recomputed only if df() returns another pattern. After that, the steps do not allocate
+  * memory besides the temporary buffers of the sparse factorization.
+  *
+  * Unlike LevenbergMarquardt, which is a port of minpack controlling a trust region radius,
+  * the damping parameter \f$ \lambda \f$ is directly updated from the ratio of the actual to
+  * the predicted reduction (Nielsen's rule). The convergence tests and the returned status are
+  * the same.
+  */
+template<typename FunctorType, typename Scalar=double>
+class SparseLevenbergMarquardt
+{
+public:
+    SparseLevenbergMarquardt(FunctorType &_functor)
+        : functor(_functor) { nfev = njev = iter = 0;  fnorm = gnorm = 0.; }
+
+    struct Parameters {
+        Parameters()
+            : tau(Scalar(1e-3))
+            , maxfev(400)
+            , ftol(ei_sqrt(NumTraits<Scalar>::epsilon()))
+            , xtol(ei_sqrt(NumTraits<Scalar>::epsilon()))
+            , gtol(Scalar(0.)) {}
+        Scalar tau;   // initial damping parameter
+        int maxfev;   // maximum number of function evaluation
+        Scalar ftol;
+        Scalar xtol;
+        Scalar gtol;
+    };
+
+    typedef Matrix< Scalar, Dynamic, 1 > FVectorType;
+    typedef SparseMatrix< Scalar > JacobianType;
+
+    LevenbergMarquardtSpace::Status minimize(FVectorType &x);
+    LevenbergMarquardtSpace::Status minimizeInit(FVectorType &x);
+    LevenbergMarquardtSpace::Status minimizeOneStep(FVectorType &x);
+
+    void resetParameters(void) { parameters = Parameters(); }
+
+    Parameters parameters;
+    FVectorType  fvec, diag;
+    JacobianType fjac;
+    int nfev;
+    int njev;
+    int iter;
+    Scalar fnorm, gnorm;
+
+    Scalar lm_param(void) { return lambda; }
+private:
+    bool samePattern() const;
+    void analyzePattern();
+    void computeNormalEquations();
+
+    FunctorType &functor;
+    int n;
+    int m;
+    FVectorType wa1, wa2, wa4, grad, jtjDiag;
+    JacobianType normal; // upper triangular part of J^T J + lambda D^2
+    SparseLDLT<JacobianType> ldlt;
+    VectorXi patternOuter, patternInner;
+    VectorXi rowStart, rowEntries; // the nonzeros of fjac, row by row
+    VectorXi products; // position in normal of the product of two nonzeros of a row
+    VectorXi diagPos;
+
+    Scalar lambda, nu;
+    Scalar ratio;
+    Scalar pnorm, xnorm, fnorm1, actred, prered;
+};
+
+template<typename FunctorType, typename Scalar>
+LevenbergMarquardtSpace::Status
+SparseLevenbergMarquardt<FunctorType,Scalar>::minimize(FVectorType  &x)
+{
+    LevenbergMarquardtSpace::Status status = minimizeInit(x);
+    if (status==LevenbergMarquardtSpace::ImproperInputParameters)
+        return status;
+    do {
+        status = minimizeOneStep(x);
+    } while (status==LevenbergMarquardtSpace::Running);
+    return status;
+}
+
+template<typename FunctorType, typename Scalar>
+LevenbergMarquardtSpace::Status
+SparseLevenbergMarquardt<FunctorType,Scalar>::minimizeInit(FVectorType  &x)
+{
+    n = x.size();
+    m = functor.values();
+
+    wa1.resize(n); wa2.resize(n); grad.resize(n); jtjDiag.resize(n);
+    wa4.resize(m);
+    fvec.resize(m);
+    diag.resize(n);
+
+    /* Function Body */
+    nfev = 0;
+    njev = 0;
+
+    /*     check the input parameters for errors. */
+    if (n <= 0 || m < n || parameters.ftol < 0. || parameters.xtol < 0. || parameters.gtol < 0. || parameters.maxfev <= 0 || parameters.tau <= 0.)
+        return LevenbergMarquardtSpace::ImproperInputParameters;
+
+    /*     evaluate the function at the starting point */
+    /*     and calculate its norm. */
+    nfev = 1;
+    if ( functor(x, fvec) < 0)
+        return LevenbergMarquardtSpace::UserAsked;
+    fnorm = fvec.stableNorm();
+
+    /*     initialize levenberg-marquardt parameter and iteration counter. */
+    lambda = parameters.tau;
+    nu = 2.;
+    iter = 1;
+
+    return LevenbergMarquardtSpace::NotStarted;
+}
+
+template<typename FunctorType, typename Scalar>
+LevenbergMarquardtSpace::Status
+SparseLevenbergMarquardt<FunctorType,Scalar>::minimizeOneStep(FVectorType  &x)
+{
+    assert(x.size()==n); // check the caller is not cheating us
+
+    /* calculate the jacobian matrix. */
+    int df_ret = functor.df(x, fjac);
+    if (df_ret<0)
+        return LevenbergMarquardtSpace::UserAsked;
+    if (df_ret>0)
+        // numerical diff, we evaluated the function df_ret times
+        nfev += df_ret;
+    else njev++;
+    ei_assert(fjac.rows()==m && fjac.cols()==n);
+
+    /* form the upper triangular part of J^T J and the gradient J^T fvec, */
+    /* the symbolic analysis being only done when the pattern changes. */
+    if (!samePattern())
+        analyzePattern();
+    computeNormalEquations();
+
+    /* scale according to the norms of the columns of the jacobian, */
+    /* keeping the largest norms seen so far. */
+    for (int j = 0; j < n; ++j) {
+        const Scalar colnorm = ei_sqrt(jtjDiag[j]);
+        if (iter == 1)
+            diag[j] = (colnorm==0.)? 1. : colnorm;
+        else
+            diag[j] = std::max(diag[j], colnorm);
+    }
+    if (iter == 1)
+        xnorm = diag.cwiseProduct(x).stableNorm();
+
+    /* compute the norm of the scaled gradient. */
+    gnorm = 0.;
+    if (fnorm != 0.)
+        for (int j = 0; j < n; ++j)
+            if (jtjDiag[j] != 0.)
+                gnorm = std::max(gnorm, ei_abs(grad[j] / fnorm / ei_sqrt(jtjDiag[j])));
+
+    /* test for convergence of the gradient norm. */
+    if (gnorm <= parameters.gtol)
+        return LevenbergMarquardtSpace::CosinusTooSmall;
+
+    Scalar* normalValues = normal._valuePtr();
+    do {
+
+        /* solve the damped normal equations for the direction p, */
+        /* and compute x + p and the norm of the scaled p. */
+        for (int j = 0; j < n; ++j)
+            normalValues[diagPos[j]] = jtjDiag[j] + lambda * ei_abs2(diag[j]);
+        if (ldlt._numeric(normal)) {
+            wa1 = -grad;
+            ldlt.solveInPlace(wa1);
+            wa2 = x + wa1;
+            pnorm = diag.cwiseProduct(wa1).stableNorm();
+
+            /* evaluate the function at x + p and calculate its norm. */
+            if ( functor(wa2, wa4) < 0)
+                return LevenbergMarquardtSpace::UserAsked;
+            ++nfev;
+            fnorm1 = wa4.stableNorm();
+
+            /* compute the scaled actual and predicted reductions. */
+            actred = -1.;
+            if (Scalar(.1) * fnorm1 < fnorm)
+                actred = 1. - ei_abs2(fnorm1 / fnorm);
+            prered = (lambda * ei_abs2(pnorm) - wa1.dot(grad)) / ei_abs2(fnorm);
+            ratio = 0.;
+            if (prered != 0.)
+                ratio = actred / prered;
+        }
+        else {
+            /* the damped system is numerically singular, increase lambda */
+            actred = prered = pnorm = ratio = 0.;
+        }
+
+        /* update the damping parameter. */
+        if (ratio >= Scalar(1e-4)) {
+            lambda *= std::max(Scalar(1./3.), Scalar(1.) - ei_abs2(Scalar(2.)*ratio - Scalar(1.)) * (Scalar(2.)*ratio - Scalar(1.)));
+            nu = 2.;
+
+            /* successful iteration. update x, fvec, and their norms. */
+            x = wa2;
+            fvec = wa4;
+            xnorm = diag.cwiseProduct(x).stableNorm();
+            fnorm = fnorm1;
+            ++iter;
+        }
+        else {
+            lambda *= nu;
+            nu *= 2.;
+        }
+
+        /* tests for convergence. */
+        if (prered != 0.) {
+            if (ei_abs(actred) <= parameters.ftol && prered <= parameters.ftol && Scalar(.5) * ratio <= 1. && pnorm <= parameters.xtol * xnorm)
+                return LevenbergMarquardtSpace::RelativeErrorAndReductionTooSmall;
+            if (ei_abs(actred) <= parameters.ftol && prered <= parameters.ftol && Scalar(.5) * ratio <= 1.)
+                return LevenbergMarquardtSpace::RelativeReductionTooSmall;
+            if (pnorm <= parameters.xtol * xnorm)
+                return LevenbergMarquardtSpace::RelativeErrorTooSmall;
+        }
+
+        /* tests for termination and stringent tolerances. */
+        if (nfev >= parameters.maxfev)
+            return LevenbergMarquardtSpace::TooManyFunctionEvaluation;
+        if (prered != 0. && ei_abs(actred) <= NumTraits<Scalar>::epsilon() && prered <= NumTraits<Scalar>::epsilon() && Scalar(.5) * ratio <= 1.)
+            return LevenbergMarquardtSpace::FtolTooSmall;
+        if ((prered != 0. && pnorm <= NumTraits<Scalar>::epsilon() * xnorm) || lambda >= NumTraits<Scalar>::highest() / nu)
+            return LevenbergMarquardtSpace::XtolTooSmall;
+        if (gnorm <= NumTraits<Scalar>::epsilon())
+            return LevenbergMarquardtSpace::GtolTooSmall;
+
+    } while (ratio < Scalar(1e-4));
+
+    return LevenbergMarquardtSpace::Running;
+}
+
+template<typename FunctorType, typename Scalar>
+bool SparseLevenbergMarquardt<FunctorType,Scalar>::samePattern() const
+{
+    if (patternOuter.size()!=n+1 || rowStart.size()!=m+1 || fjac.nonZeros()!=patternInner.size())
+        return false;
+    return std::equal(patternOuter.data(), patternOuter.data()+n+1, fjac._outerIndexPtr())
+        && std::equal(patternInner.data(), patternInner.data()+patternInner.size(), fjac._innerIndexPtr());
+}
+
+template<typename FunctorType, typename Scalar>
+void SparseLevenbergMarquardt<FunctorType,Scalar>::analyzePattern()
+{
+    const int nnz = fjac.nonZeros();
+    const int* Jp = fjac._outerIndexPtr();
+    const int* Ji = fjac._innerIndexPtr();
+    patternOuter.resize(n+1);
+    patternInner.resize(nnz);
+    std::copy(Jp, Jp+n+1, patternOuter.data());
+    std::copy(Ji, Ji+nnz, patternInner.data());
+
+    /* transpose the pattern of fjac, the nonzeros of a row being sorted by column */
+    rowStart.setZero(m+1);
+    for (int p = 0; p < nnz; ++p)
+        ++rowStart[Ji[p]+1];
+    for (int i = 0; i < m; ++i)
+        rowStart[i+1] += rowStart[i];
+    VectorXi next = rowStart.head(m);
+    VectorXi entryCol(nnz);
+    rowEntries.resize(nnz);
+    for (int j = 0; j < n; ++j)
+        for (int p = Jp[j]; p < Jp[j+1]; ++p) {
+            rowEntries[next[Ji[p]]++] = p;
+            entryCol[p] = j;
+        }
+
+    /* pattern of the upper triangular part of J^T J, with the whole diagonal */
+    std::vector<std::vector<int> > cols(n);
+    int nproducts = 0;
+    for (int j = 0; j < n; ++j)
+        cols[j].push_back(j);
+    for (int i = 0; i < m; ++i)
+        for (int a = rowStart[i]; a < rowStart[i+1]; ++a)
+            for (int b = a; b < rowStart[i+1]; ++b, ++nproducts)
+                cols[entryCol[rowEntries[b]]].push_back(entryCol[rowEntries[a]]);
+    int normalNonZeros = 0;
+    for (int j = 0; j < n; ++j) {
+        std::sort(cols[j].begin(), cols[j].end());
+        cols[j].erase(std::unique(cols[j].begin(), cols[j].end()), cols[j].end());
+        normalNonZeros += static_cast<int>(cols[j].size());
+    }
+    normal.resize(n, n);
+    normal.reserve(normalNonZeros);
+    for (int j = 0; j < n; ++j) {
+        normal.startVec(j);
+        for (size_t k = 0; k < cols[j].size(); ++k)
+            normal.insertBack(j, cols[j][k]) = 0.;
+    }
+    normal.finalize();
+
+    /* where the product of two nonzeros of a row is accumulated */
+    const int* Np = normal._outerIndexPtr();
+    const int* Ni = normal._innerIndexPtr();
+    products.resize(nproducts);
+    int k = 0;
+    for (int i = 0; i < m; ++i)
+        for (int a = rowStart[i]; a < rowStart[i+1]; ++a)
+            for (int b = a; b < rowStart[i+1]; ++b) {
+                const int col = entryCol[rowEntries[b]];
+                products[k++] = static_cast<int>(std::lower_bound(Ni+Np[col], Ni+Np[col+1], entryCol[rowEntries[a]]) - Ni);
+            }
+    diagPos.resize(n);
+    for (int j = 0; j < n; ++j)
+        diagPos[j] = Np[j+1]-1;
+
+    ldlt._symbolic(normal);
+}
+
+template<typename FunctorType, typename Scalar>
+void SparseLevenbergMarquardt<FunctorType,Scalar>::computeNormalEquations()
+{
+    const int* Jp = fjac._outerIndexPtr();
+    const int* Ji = fjac._innerIndexPtr();
+    const Scalar* Jx = fjac._valuePtr();
+    Scalar* Nx = normal._valuePtr();
+
+    std::fill(Nx, Nx+normal.nonZeros(), Scalar(0.));
+    int k = 0;
+    for (int i = 0; i < m; ++i)
+        for (int a = rowStart[i]; a < rowStart[i+1]; ++a) {
+            const Scalar va = Jx[rowEntries[a]];
+            for (int b = a; b < rowStart[i+1]; ++b)
+                Nx[products[k++]] += va * Jx[rowEntries[b]];
+        }
+    for (int j = 0; j < n; ++j) {
+        jtjDiag[j] = Nx[diagPos[j]];
+        Scalar sum = 0.;
+        for (int p = Jp[j]; p < Jp[j+1]; ++p)
+            sum += Jx[p] * fvec[Ji[p]];
+        grad[j] = sum;
+    }
+}
+
+#endif // EIGEN_SPARSELEVENBERGMARQUARDT__H
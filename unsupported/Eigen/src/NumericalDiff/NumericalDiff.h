@@ -44,6 +44,15 @@ enum NumericalDiffMode {
   * http://en.wikipedia.org/wiki/Numerical_differentiation
   *
   * Currently only "Forward" and "Central" scheme are implemented.
+  *
+  * Two options reduce the cost of a Jacobian:
+  *  - setParallel() evaluates the perturbed points concurrently when OpenMP is enabled, each
+  *    thread working on its own copy of the functor, which must therefore be copyable and
+  *    must not share mutable state between copies.
+  *  - setSparsityPattern() declares the entries of the Jacobian which can be nonzero. The
+  *    columns are then grouped so that the columns of a group have no nonzero row in common,
+  *    and all the columns of a group are estimated from the same perturbed point (the
+  *    Curtis-Powell-Reid method with a greedy coloring). The other entries are set to zero.
   */
 template<typename _Functor, NumericalDiffMode mode=Forward>
 class NumericalDiff : public _Functor
@@ -55,43 +64,87 @@ public:
     typedef typename Functor::ValueType ValueType;
     typedef typename Functor::JacobianType JacobianType;
 
-    NumericalDiff(Scalar _epsfcn=0.) : Functor(), epsfcn(_epsfcn) {}
-    NumericalDiff(const Functor& f, Scalar _epsfcn=0.) : Functor(f), epsfcn(_epsfcn) {}
+    NumericalDiff(Scalar _epsfcn=0.) : Functor(), epsfcn(_epsfcn), m_parallel(false) {}
+    NumericalDiff(const Functor& f, Scalar _epsfcn=0.) : Functor(f), epsfcn(_epsfcn), m_parallel(false) {}
 
     // forward constructors
     template<typename T0>
-        NumericalDiff(const T0& a0) : Functor(a0), epsfcn(0) {}
+        NumericalDiff(const T0& a0) : Functor(a0), epsfcn(0), m_parallel(false) {}
     template<typename T0, typename T1>
-        NumericalDiff(const T0& a0, const T1& a1) : Functor(a0, a1), epsfcn(0) {}
+        NumericalDiff(const T0& a0, const T1& a1) : Functor(a0, a1), epsfcn(0), m_parallel(false) {}
     template<typename T0, typename T1, typename T2>
-        NumericalDiff(const T0& a0, const T1& a1, const T1& a2) : Functor(a0, a1, a2), epsfcn(0) {}
+        NumericalDiff(const T0& a0, const T1& a1, const T1& a2) : Functor(a0, a1, a2), epsfcn(0), m_parallel(false) {}
 
     enum {
         InputsAtCompileTime = Functor::InputsAtCompileTime,
         ValuesAtCompileTime = Functor::ValuesAtCompileTime
     };
 
+    /** Enables or disables the concurrent evaluation of the perturbed points. */
+    void setParallel(bool parallel) { m_parallel = parallel; }
+
+    /** Declares the possibly nonzero entries of the Jacobian as the nonzeros of \a pattern, which
+      * can be any sparse matrix providing an InnerIterator, e.g. a SparseMatrix<bool>.
+      */
+    template<typename PatternType>
+    void setSparsityPattern(const PatternType& pattern)
+    {
+        const int n = pattern.cols();
+        m_patternRows.assign(n, std::vector<int>());
+        for (int k = 0; k < pattern.outerSize(); ++k)
+            for (typename PatternType::InnerIterator it(pattern, k); it; ++it)
+                m_patternRows[it.col()].push_back(it.row());
+
+        // greedy coloring, the columns having the most nonzeros first
+        std::vector<std::pair<int,int> > order(n);
+        for (int j = 0; j < n; ++j)
+            order[j] = std::make_pair(-static_cast<int>(m_patternRows[j].size()), j);
+        std::sort(order.begin(), order.end());
+        std::vector<std::vector<int> > rowColors(pattern.rows());
+        std::vector<int> forbidden;
+        m_groups.clear();
+        for (int k = 0; k < n; ++k) {
+            const int j = order[k].second;
+            forbidden.assign(m_groups.size()+1, 0);
+            for (size_t r = 0; r < m_patternRows[j].size(); ++r) {
+                const std::vector<int>& colors = rowColors[m_patternRows[j][r]];
+                for (size_t c = 0; c < colors.size(); ++c)
+                    forbidden[colors[c]] = 1;
+            }
+            const int color = static_cast<int>(std::find(forbidden.begin(), forbidden.end(), 0) - forbidden.begin());
+            if (color == static_cast<int>(m_groups.size()))
+                m_groups.push_back(std::vector<int>());
+            m_groups[color].push_back(j);
+            for (size_t r = 0; r < m_patternRows[j].size(); ++r)
+                rowColors[m_patternRows[j][r]].push_back(color);
+        }
+    }
+
+    /** Removes the sparsity pattern, all the entries of the Jacobian are estimated again. */
+    void clearSparsityPattern() { m_patternRows.clear(); m_groups.clear(); }
+
+    /** \returns the number of perturbed points needed by one Jacobian in Forward mode, that is
+      * the number of columns or, with a sparsity pattern, the number of groups of columns.
+      */
+    int groups(int n) const { return m_groups.empty() ? n : static_cast<int>(m_groups.size()); }
+
     /**
       * return the number of evaluation of functor
      */
     int df(const InputType& _x, JacobianType &jac) const
     {
-        /* Local variables */
-        Scalar h;
-        int nfev=0;
         const int n = _x.size();
+        const int ngroups = groups(n);
         const Scalar eps = ei_sqrt((std::max(epsfcn,NumTraits<Scalar>::epsilon() )));
-        ValueType val1, val2;
-        InputType x = _x;
-        // TODO : we should do this only if the size is not already known
-        val1.resize(Functor::values());
-        val2.resize(Functor::values());
+        ValueType val0;
+        int nfev=0;
 
         // initialization
         switch(mode) {
             case Forward:
                 // compute f(x)
-                Functor::operator()(x, val1); nfev++;
+                val0.resize(Functor::values());
+                Functor::operator()(_x, val0); nfev++;
                 break;
             case Central:
                 // do nothing
@@ -99,37 +152,82 @@ public:
             default:
                 assert(false);
         };
+        if (!m_groups.empty())
+            jac.setZero();
 
-        // Function Body
-        for (int j = 0; j < n; ++j) {
-            h = eps * ei_abs(x[j]);
-            if (h == 0.) {
-                h = eps;
+#ifdef EIGEN_HAS_OPENMP
+        if (m_parallel && ngroups > 1) {
+            #pragma omp parallel
+            {
+                const Functor functor(*this);
+                InputType x = _x;
+                ValueType val1, val2;
+                #pragma omp for schedule(dynamic)
+                for (int g = 0; g < ngroups; ++g)
+                    evalGroup(functor, g, eps, _x, x, val0, val1, val2, jac);
             }
-            switch(mode) {
-                case Forward:
-                    x[j] += h;
-                    Functor::operator()(x, val2);
-                    nfev++;
-                    x[j] = _x[j];
-                    jac.col(j) = (val2-val1)/h;
-                    break;
-                case Central:
-                    x[j] += h;
-                    Functor::operator()(x, val2); nfev++;
-                    x[j] -= 2*h;
-                    Functor::operator()(x, val1); nfev++;
-                    x[j] = _x[j];
-                    jac.col(j) = (val2-val1)/(2*h);
-                    break;
-                default:
-                    assert(false);
-            };
         }
-        return nfev;
+        else
+#endif
+        {
+            InputType x = _x;
+            ValueType val1, val2;
+            for (int g = 0; g < ngroups; ++g)
+                evalGroup(*this, g, eps, _x, x, val0, val1, val2, jac);
+        }
+        return nfev + (mode==Central ? 2 : 1) * ngroups;
     }
+
 private:
+    int groupSize(int g) const { return m_groups.empty() ? 1 : static_cast<int>(m_groups[g].size()); }
+    int groupColumn(int g, int k) const { return m_groups.empty() ? g : m_groups[g][k]; }
+
+    // estimates the columns of the group g, x being equal to _x on entry and on exit
+    void evalGroup(const Functor& functor, int g, Scalar eps, const InputType& _x, InputType& x,
+                   const ValueType& val0, ValueType& val1, ValueType& val2, JacobianType& jac) const
+    {
+        val1.resize(functor.values());
+        val2.resize(functor.values());
+        for (int k = 0; k < groupSize(g); ++k) {
+            const int j = groupColumn(g, k);
+            x[j] += step(eps, _x[j]);
+        }
+        functor(x, val2);
+        if (mode==Central) {
+            for (int k = 0; k < groupSize(g); ++k) {
+                const int j = groupColumn(g, k);
+                x[j] = _x[j] - step(eps, _x[j]);
+            }
+            functor(x, val1);
+        }
+        const ValueType& minus = mode==Central ? val1 : val0;
+        for (int k = 0; k < groupSize(g); ++k) {
+            const int j = groupColumn(g, k);
+            x[j] = _x[j];
+            const Scalar h = (mode==Central ? 2 : 1) * step(eps, _x[j]);
+            if (m_groups.empty())
+                jac.col(j) = (val2-minus)/h;
+            else
+                for (size_t r = 0; r < m_patternRows[j].size(); ++r) {
+                    const int i = m_patternRows[j][r];
+                    jac(i,j) = (val2[i]-minus[i])/h;
+                }
+        }
+    }
+
+    static Scalar step(Scalar eps, Scalar xj)
+    {
+        Scalar h = eps * ei_abs(xj);
+        if (h == 0.) {
+            h = eps;
+        }
+        return h;
+    }
+
     Scalar epsfcn;
+    bool m_parallel;
+    std::vector<std::vector<int> > m_patternRows;
+    std::vector<std::vector<int> > m_groups;
 };
 
 //vim: ai ts=4 sts=4 et sw=4
@@ -172,6 +172,42 @@ struct TreeTest
     BVIntersect(tree, vTree, i2);
 
     VERIFY(i1.count == i2.count);
+
+    std::vector<BallPointStuff<Dim> > i3(4);
+    BVIntersect(tree, vTree, i3.begin(), i3.end());
+
+    int count = 0;
+    for(int i = 0; i < (int)i3.size(); ++i)
+      count += i3[i].count;
+    VERIFY(i1.count == count);
+  }
+
+  void testBatch()
+  {
+    BallTypeList b;
+    for(int i = 0; i < 5000; ++i) { //large enough to build the tree in parallel
+        b.push_back(BallType(VectorType::Random(), 0.1 * ei_random(0., 1.)));
+    }
+    KdBVH<double, Dim, BallType> tree(b.begin(), b.end());
+
+    std::vector<BallPointStuff<Dim> > i1, i2;
+    for(int i = 0; i < 100; ++i)
+      i2.push_back(BallPointStuff<Dim>(VectorType::Random()));
+    i1 = i2;
+
+    BVBatchIntersect(tree, i2.begin(), i2.end());
+    std::vector<double> m2(i2.size());
+    BVBatchMinimize(tree, i2.begin(), i2.end(), m2.begin());
+
+    for(int i = 0; i < (int)i1.size(); ++i) {
+      double m1 = std::numeric_limits<double>::max();
+      for(int j = 0; j < (int)b.size(); ++j) {
+        i1[i].intersectObject(b[j]);
+        m1 = std::min(m1, i1[i].minimumOnObject(b[j]));
+      }
+      VERIFY(i1[i].count == i2[i].count);
+      VERIFY_IS_APPROX(m1, m2[i]);
+    }
   }
 
   void testMinimize2()
@@ -212,6 +248,7 @@ void test_BVH()
     CALL_SUBTEST(test2.testMinimize1());
     CALL_SUBTEST(test2.testIntersect2());
     CALL_SUBTEST(test2.testMinimize2());
+    CALL_SUBTEST(test2.testBatch());
 #endif
 
 #ifdef EIGEN_TEST_PART_2
@@ -220,6 +257,7 @@ void test_BVH()
     CALL_SUBTEST(test3.testMinimize1());
     CALL_SUBTEST(test3.testIntersect2());
     CALL_SUBTEST(test3.testMinimize2());
+    CALL_SUBTEST(test3.testBatch());
 #endif
 
 #ifdef EIGEN_TEST_PART_3
@@ -228,6 +266,7 @@ void test_BVH()
     CALL_SUBTEST(test4.testMinimize1());
     CALL_SUBTEST(test4.testIntersect2());
     CALL_SUBTEST(test4.testMinimize2());
+    CALL_SUBTEST(test4.testBatch());
 #endif
   }
 }
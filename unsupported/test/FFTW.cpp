@@ -24,6 +24,7 @@
 
 #include "main.h"
 #include <unsupported/Eigen/FFT>
+#include <sstream>
 
 template <typename T> 
 std::complex<T> RandomCpx() { return std::complex<T>( (T)(rand()/(T)RAND_MAX - .5), (T)(rand()/(T)RAND_MAX - .5) ); }
@@ -195,7 +196,31 @@ void test_complex(int nfft)
   test_complex_generic<StdVectorContainer,T>(nfft);
   test_complex_generic<EigenVectorContainer,T>(nfft);
 }
-/*
+#if !defined(EIGEN_FFTW_DEFAULT) && !defined(EIGEN_MKL_DEFAULT)
+// compares the packet butterflies, and the parallel transform of large sizes,
+// with the scalar path of kissfft
+template <typename T>
+void test_complex_kiss_paths(int nfft)
+{
+    typedef typename FFT<T>::Complex Complex;
+    FFT<T> fft;
+    FFT<T, ei_kissfft_impl<T,false> > ref;
+
+    vector<Complex> inbuf(nfft);
+    vector<Complex> outbuf, refbuf, buf3;
+    for (int k=0;k<nfft;++k)
+        inbuf[k]= Complex( (T)(rand()/(double)RAND_MAX - .5), (T)(rand()/(double)RAND_MAX - .5) );
+    fft.fwd( outbuf , inbuf);
+    ref.fwd( refbuf , inbuf);
+    VERIFY( dif_rmse(outbuf,refbuf) < test_precision<T>()  );
+
+    fft.inv( buf3 , outbuf);
+    ref.inv( refbuf , outbuf);
+    VERIFY( dif_rmse(buf3,refbuf) < test_precision<T>()  );
+    VERIFY( dif_rmse(inbuf,buf3) < test_precision<T>()  );
+}
+#endif
+
 template <typename T,int nrows,int ncols>
 void test_complex2d()
 {
@@ -223,8 +248,153 @@ void test_complex2d()
     VERIFY( (src-src2).norm() < test_precision<T>() );
     VERIFY( (dst-dst2).norm() < test_precision<T>() );
 }
-*/
 
+template <typename T>
+void test_complex2d_matrix(int nrows,int ncols)
+{
+    typedef typename Eigen::FFT<T>::Complex Complex;
+    typedef Eigen::Matrix<Complex,Dynamic,Dynamic> ComplexMatrix;
+    FFT<T> fft;
+    ComplexMatrix src = ComplexMatrix::Random(nrows,ncols);
+
+    // reference: 1D transforms of the columns, then of the rows
+    ComplexMatrix ref(nrows,ncols);
+    for (int k=0;k<ncols;k++) {
+        Eigen::Matrix<Complex,Dynamic,1> tmpOut;
+        fft.fwd( tmpOut,src.col(k) );
+        ref.col(k) = tmpOut;
+    }
+    for (int k=0;k<nrows;k++) {
+        Eigen::Matrix<Complex,1,Dynamic> tmpOut;
+        fft.fwd( tmpOut,ref.row(k) );
+        ref.row(k) = tmpOut;
+    }
+
+    ComplexMatrix dst, src2;
+    fft.fwd2(dst,src);
+    VERIFY( (dst-ref).norm() < test_precision<T>()*ref.norm() );
+    fft.inv2(src2,dst);
+    VERIFY( (src2-src).norm() < test_precision<T>()*src.norm() );
+
+    // real input, row-major output, and a strided block
+    Eigen::Matrix<T,Dynamic,Dynamic> realSrc = src.real();
+    Eigen::Matrix<Complex,Dynamic,Dynamic,RowMajor> dstRowMajor;
+    fft.fwd2(dstRowMajor,realSrc);
+    fft.fwd2(dst,realSrc.template cast<Complex>());
+    VERIFY( (dstRowMajor-dst).norm() < test_precision<T>()*dst.norm() );
+
+    ComplexMatrix big = ComplexMatrix::Random(nrows+3,ncols+2);
+    big.block(1,2,nrows,ncols) = src;
+    fft.fwd2(dst,big.block(1,2,nrows,ncols));
+    VERIFY( (dst-ref).norm() < test_precision<T>()*ref.norm() );
+
+    // in place
+    dst = src;
+    fft.fwd2(dst.data(),dst.data(),ncols,nrows);
+    VERIFY( (dst-ref).norm() < test_precision<T>()*ref.norm() );
+}
+
+
+template <typename T>
+void test_complex_batch(int nfft,int howmany)
+{
+    typedef typename Eigen::FFT<T>::Complex Complex;
+    typedef Eigen::Matrix<Complex,Dynamic,Dynamic> ComplexMatrix;
+    FFT<T> fft;
+    ComplexMatrix src = ComplexMatrix::Random(nfft,howmany);
+    ComplexMatrix dst, back;
+
+    fft.fwdColwise(dst,src);
+    for (int k=0;k<howmany;++k) {
+        Eigen::Matrix<Complex,Dynamic,1> ref;
+        fft.fwd(ref,src.col(k));
+        VERIFY( (dst.col(k)-ref).norm() < test_precision<T>()*ref.norm() );
+    }
+    fft.invColwise(back,dst);
+    VERIFY( (back-src).norm() < test_precision<T>()*src.norm() );
+
+    // strided transforms
+    ComplexMatrix srcT = src.transpose();
+    ComplexMatrix dstT;
+    fft.fwdRowwise(dstT,srcT);
+    VERIFY( (dstT-dst.transpose()).norm() < test_precision<T>()*dst.norm() );
+    fft.invRowwise(back,dstT);
+    VERIFY( (back-srcT).norm() < test_precision<T>()*src.norm() );
+
+    // real input and row-major output
+    Eigen::Matrix<T,Dynamic,Dynamic> realSrc = src.real();
+    Eigen::Matrix<Complex,Dynamic,Dynamic,RowMajor> dstRowMajor;
+    fft.fwdColwise(dstRowMajor,realSrc);
+    fft.fwdColwise(dst,realSrc.template cast<Complex>());
+    VERIFY( (dstRowMajor-dst).norm() < test_precision<T>()*dst.norm() );
+
+    // in place
+    ComplexMatrix inPlace = src;
+    fft.fwdColwise(inPlace,inPlace);
+    fft.fwdColwise(dst,src);
+    VERIFY( (inPlace-dst).norm() < test_precision<T>()*dst.norm() );
+
+    // interleaved output through the pointer API
+    vector<Complex> interleaved(nfft*howmany);
+    fft.fwdBatch(&interleaved[0],src.data(),nfft,howmany,1,nfft,howmany,1);
+    VERIFY( (Eigen::Map<ComplexMatrix>(&interleaved[0],howmany,nfft)-dst.transpose()).norm() < test_precision<T>()*dst.norm() );
+}
+
+#ifdef EIGEN_HAS_OPENMP
+// several threads creating and using the plans of a shared FFT object
+template <typename T>
+void test_concurrent_plans()
+{
+    typedef typename FFT<T>::Complex Complex;
+    const int count = 24;
+    FFT<T> shared, ref;
+    vector<vector<Complex> > in(count), out(count);
+    for (int k=0;k<count;++k) {
+        in[k].resize(32+3*(k%8));
+        for (size_t i=0;i<in[k].size();++i)
+            in[k][i] = RandomCpx<T>();
+    }
+    #pragma omp parallel for num_threads(4)
+    for (int k=0;k<count;++k)
+        shared.fwd(out[k],in[k]);
+    for (int k=0;k<count;++k) {
+        vector<Complex> expected;
+        ref.fwd(expected,in[k]);
+        VERIFY( dif_rmse(out[k],expected) < test_precision<T>() );
+    }
+}
+#endif
+
+#if !defined(EIGEN_FFTW_DEFAULT) && !defined(EIGEN_MKL_DEFAULT)
+template <typename T>
+void test_kiss_wisdom(int nfft)
+{
+    typedef typename FFT<T>::Complex Complex;
+    vector<Complex> in(nfft), measured, imported;
+    for (int k=0;k<nfft;++k)
+        in[k] = RandomCpx<T>();
+
+    FFT<T> fft;
+    fft.impl().setMeasure(true);
+    fft.fwd(measured,in);
+    VERIFY( fft_rmse(measured,in) < test_precision<T>() );
+    std::stringstream wisdom;
+    fft.impl().exportWisdom(wisdom);
+    int size = 0, algorithm = -1;
+    wisdom >> size >> algorithm;
+    VERIFY( size==nfft && (algorithm==0 || algorithm==1) );
+
+    wisdom.clear();
+    wisdom.seekg(0);
+    FFT<T> fft2;
+    VERIFY( fft2.impl().importWisdom(wisdom) );
+    fft2.fwd(imported,in);
+    VERIFY( dif_rmse(measured,imported) < test_precision<T>() );
+
+    std::stringstream bad("12 7\n");
+    VERIFY( !fft2.impl().importWisdom(bad) );
+}
+#endif
 
 void test_return_by_value(int len)
 {
@@ -248,8 +418,10 @@ void test_FFTW()
     cout << "testing return-by-value\n";
     CALL_SUBTEST( test_return_by_value(32) );
     cout << "testing complex\n";
-  //CALL_SUBTEST( ( test_complex2d<float,4,8> () ) ); CALL_SUBTEST( ( test_complex2d<double,4,8> () ) );
-  //CALL_SUBTEST( ( test_complex2d<long double,4,8> () ) );
+  CALL_SUBTEST( ( test_complex2d<float,4,8> () ) ); CALL_SUBTEST( ( test_complex2d<double,4,8> () ) );
+  CALL_SUBTEST( ( test_complex2d<long double,4,8> () ) );
+  CALL_SUBTEST( test_complex2d_matrix<float>(24,40) ); CALL_SUBTEST( test_complex2d_matrix<double>(33,17) );
+  CALL_SUBTEST( test_complex2d_matrix<float>(256,96) ); CALL_SUBTEST( test_complex2d_matrix<double>(150,210) );
   CALL_SUBTEST( test_complex<float>(32) ); CALL_SUBTEST( test_complex<double>(32) ); CALL_SUBTEST( test_complex<long double>(32) );
   CALL_SUBTEST( test_complex<float>(256) ); CALL_SUBTEST( test_complex<double>(256) ); CALL_SUBTEST( test_complex<long double>(256) );
   CALL_SUBTEST( test_complex<float>(3*8) ); CALL_SUBTEST( test_complex<double>(3*8) ); CALL_SUBTEST( test_complex<long double>(3*8) );
@@ -257,6 +429,24 @@ void test_FFTW()
   CALL_SUBTEST( test_complex<float>(2*3*4) ); CALL_SUBTEST( test_complex<double>(2*3*4) ); CALL_SUBTEST( test_complex<long double>(2*3*4) );
   CALL_SUBTEST( test_complex<float>(2*3*4*5) ); CALL_SUBTEST( test_complex<double>(2*3*4*5) ); CALL_SUBTEST( test_complex<long double>(2*3*4*5) );
   CALL_SUBTEST( test_complex<float>(2*3*4*5*7) ); CALL_SUBTEST( test_complex<double>(2*3*4*5*7) ); CALL_SUBTEST( test_complex<long double>(2*3*4*5*7) );
+  CALL_SUBTEST( test_complex<float>(1031) ); CALL_SUBTEST( test_complex<double>(1031) ); CALL_SUBTEST( test_complex<long double>(1031) );
+  CALL_SUBTEST( test_complex<float>(2*3*127) ); CALL_SUBTEST( test_complex<double>(2*3*127) ); CALL_SUBTEST( test_complex<long double>(2*3*127) );
+
+#if !defined(EIGEN_FFTW_DEFAULT) && !defined(EIGEN_MKL_DEFAULT)
+  CALL_SUBTEST( test_complex_kiss_paths<float>(2*4*4*4) ); CALL_SUBTEST( test_complex_kiss_paths<double>(2*4*4*4) );
+  CALL_SUBTEST( test_complex_kiss_paths<float>(1<<15) ); CALL_SUBTEST( test_complex_kiss_paths<double>(1<<16) );
+  CALL_SUBTEST( test_complex_kiss_paths<float>(3*5*4096) ); CALL_SUBTEST( test_complex_kiss_paths<double>(7*11*512) );
+#endif
+
+    cout << "testing batches\n";
+  CALL_SUBTEST( test_complex_batch<float>(32,20) ); CALL_SUBTEST( test_complex_batch<double>(3*5*7,9) );
+  CALL_SUBTEST( test_complex_batch<float>(256,100) ); CALL_SUBTEST( test_complex_batch<double>(1031,3) );
+#ifdef EIGEN_HAS_OPENMP
+  CALL_SUBTEST( test_concurrent_plans<float>() ); CALL_SUBTEST( test_concurrent_plans<double>() );
+#endif
+#if !defined(EIGEN_FFTW_DEFAULT) && !defined(EIGEN_MKL_DEFAULT)
+  CALL_SUBTEST( test_kiss_wisdom<double>(61*64) ); CALL_SUBTEST( test_kiss_wisdom<float>(67*3) );
+#endif
 
     cout << "testing scalar\n";
   CALL_SUBTEST( test_scalar<float>(32) ); CALL_SUBTEST( test_scalar<double>(32) ); CALL_SUBTEST( test_scalar<long double>(32) );
@@ -264,4 +454,6 @@ void test_FFTW()
   CALL_SUBTEST( test_scalar<float>(50) ); CALL_SUBTEST( test_scalar<double>(50) ); CALL_SUBTEST( test_scalar<long double>(50) );
   CALL_SUBTEST( test_scalar<float>(256) ); CALL_SUBTEST( test_scalar<double>(256) ); CALL_SUBTEST( test_scalar<long double>(256) );
   CALL_SUBTEST( test_scalar<float>(2*3*4*5*7) ); CALL_SUBTEST( test_scalar<double>(2*3*4*5*7) ); CALL_SUBTEST( test_scalar<long double>(2*3*4*5*7) );
+  CALL_SUBTEST( test_scalar<float>(1009) ); CALL_SUBTEST( test_scalar<double>(1009) ); CALL_SUBTEST( test_scalar<long double>(1009) );
+  CALL_SUBTEST( test_scalar<float>(8*131) ); CALL_SUBTEST( test_scalar<double>(8*131) ); CALL_SUBTEST( test_scalar<long double>(8*131) );
 }
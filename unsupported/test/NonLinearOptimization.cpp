@@ -5,6 +5,7 @@
 
 #include <stdio.h>
 
+#define EIGEN_RUNTIME_NO_MALLOC
 #include "main.h"
 #include <unsupported/Eigen/NonLinearOptimization>
 
@@ -1797,6 +1798,121 @@ void testNistEckerle4(void)
   VERIFY_IS_APPROX(x[2], 4.5154121844E+02);
 }
 
+// lmder_functor, with the jacobian stored in a sparse matrix
+struct sparse_lmder_functor : lmder_functor
+{
+    int df(const VectorXd &x, SparseMatrix<double> &fjac) const
+    {
+        MatrixXd dense(values(), inputs());
+        lmder_functor::df(x, dense);
+        fjac.resize(values(), inputs());
+        for (int j = 0; j < inputs(); j++)
+        {
+            fjac.startVec(j);
+            for (int i = 0; i < values(); i++)
+                fjac.insertBack(j,i) = dense(i,j);
+        }
+        fjac.finalize();
+        return 0;
+    }
+};
+
+void testSparseLmder()
+{
+    const int n=3;
+    int info;
+    VectorXd x;
+
+    /* the following starting values provide a rough fit. */
+    x.setConstant(n, 1.);
+
+    // do the computation
+    sparse_lmder_functor functor;
+    SparseLevenbergMarquardt<sparse_lmder_functor> lm(functor);
+    info = lm.minimize(x);
+
+    // check return values
+    VERIFY(info>=1 && info<=4);
+
+    // check norm
+    VERIFY_IS_APPROX(lm.fvec.blueNorm(), 0.09063596);
+
+    // check x
+    VectorXd x_ref(n);
+    x_ref << 0.08241058, 1.133037, 2.343695;
+    VERIFY_IS_APPROX(x, x_ref);
+}
+
+// the extended rosenbrock function, whose jacobian is block diagonal,
+// and more residuals pulling x towards its neighbours
+struct sparse_rosenbrock_functor : Functor<double>
+{
+    sparse_rosenbrock_functor(int n): Functor<double>(n,2*n-1) {}
+    int operator()(const VectorXd &x, VectorXd &fvec) const
+    {
+        const int n = inputs();
+        for (int i = 0; i < n; i += 2)
+        {
+            fvec[i] = 10.*(x[i+1] - x[i]*x[i]);
+            fvec[i+1] = 1. - x[i];
+        }
+        for (int i = 0; i < n-1; i++)
+            fvec[n+i] = 1e-2*(x[i+1] - x[i]);
+        return 0;
+    }
+
+    int df(const VectorXd &x, SparseMatrix<double> &fjac) const
+    {
+        const int n = inputs();
+        fjac.resize(values(), n);
+        fjac.reserve(4*n);
+        for (int j = 0; j < n; j++)
+        {
+            fjac.startVec(j);
+            if (j%2==0)
+            {
+                fjac.insertBack(j,j) = -20.*x[j];
+                fjac.insertBack(j,j+1) = -1.;
+            }
+            else
+                fjac.insertBack(j,j-1) = 10.;
+            if (j>0)
+                fjac.insertBack(j,n+j-1) = 1e-2;
+            if (j<n-1)
+                fjac.insertBack(j,n+j) = -1e-2;
+        }
+        fjac.finalize();
+        return 0;
+    }
+};
+
+void testSparseRosenbrock()
+{
+    const int n = 2*ei_random<int>(10,200);
+    VectorXd x(n);
+    for (int i = 0; i < n; i += 2)
+    {
+        x[i] = -1.2;
+        x[i+1] = 1.;
+    }
+
+    sparse_rosenbrock_functor functor(n);
+    SparseLevenbergMarquardt<sparse_rosenbrock_functor> lm(functor);
+    int info = lm.minimize(x);
+
+    VERIFY(info>=1 && info<=4);
+    VERIFY(lm.fvec.norm() < 1e-8);
+    VERIFY_IS_APPROX(x, VectorXd::Ones(n));
+
+    // the same jacobian pattern is reused by another minimization, whose steps do not allocate
+    x.setConstant(2.);
+    ei_set_is_malloc_allowed(false);
+    info = lm.minimize(x);
+    ei_set_is_malloc_allowed(true);
+    VERIFY(info>=1 && info<=4);
+    VERIFY_IS_APPROX(x, VectorXd::Ones(n));
+}
+
 void test_NonLinearOptimization()
 {
     // Tests using the examples provided by (c)minpack
@@ -1811,6 +1927,8 @@ void test_NonLinearOptimization()
     CALL_SUBTEST_3(testLmstr());
     CALL_SUBTEST_3(testLmdif1());
     CALL_SUBTEST_3(testLmdif());
+    CALL_SUBTEST_3(testSparseLmder());
+    CALL_SUBTEST_3(testSparseRosenbrock());
 
     // NIST tests, level of difficulty = "Lower"
     CALL_SUBTEST_4(testNistMisra1a());
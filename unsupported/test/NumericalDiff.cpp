@@ -6,6 +6,7 @@
 #include <stdio.h>
 
 #include "main.h"
+#include <Eigen/Sparse>
 #include <unsupported/Eigen/NumericalDiff>
     
 // Generic functor
@@ -107,8 +108,103 @@ void test_central()
     VERIFY_IS_APPROX(jac, actual_jac);
 }
 
+// the broyden tridiagonal function, whose jacobian is banded
+struct tridiagonal_functor : Functor<double>
+{
+    tridiagonal_functor(int n): Functor<double>(n,n) {}
+    int operator()(const VectorXd &x, VectorXd &fvec) const
+    {
+        const int n = x.size();
+        for (int i = 0; i < n; i++)
+        {
+            fvec[i] = (3. - 2.*x[i])*x[i] + 1.;
+            if (i > 0) fvec[i] -= x[i-1];
+            if (i < n-1) fvec[i] -= 2.*x[i+1];
+        }
+        return 0;
+    }
+
+    int actual_df(const VectorXd &x, MatrixXd &fjac) const
+    {
+        const int n = x.size();
+        fjac.setZero();
+        for (int i = 0; i < n; i++)
+        {
+            fjac(i,i) = 3. - 4.*x[i];
+            if (i > 0) fjac(i,i-1) = -1.;
+            if (i < n-1) fjac(i,i+1) = -2.;
+        }
+        return 0;
+    }
+
+    SparseMatrix<bool> pattern() const
+    {
+        const int n = inputs();
+        SparseMatrix<bool> p(n,n);
+        for (int j = 0; j < n; j++)
+        {
+            p.startVec(j);
+            for (int i = std::max(j-1,0); i <= std::min(j+1,n-1); i++)
+                p.insertBack(j,i) = true;
+        }
+        p.finalize();
+        return p;
+    }
+};
+
+template<NumericalDiffMode mode> void test_parallel()
+{
+    VectorXd x(3);
+    MatrixXd jac(15,3);
+    MatrixXd ref_jac(15,3);
+    x << 0.082, 1.13, 2.35;
+
+    NumericalDiff<my_functor,mode> numDiff;
+    int nfev = numDiff.df(x, ref_jac);
+    numDiff.setParallel(true);
+    VERIFY_IS_EQUAL(numDiff.df(x, jac), nfev);
+    VERIFY_IS_APPROX(jac, ref_jac);
+}
+
+template<NumericalDiffMode mode> void test_sparse_pattern()
+{
+    const int n = ei_random<int>(10,60);
+    VectorXd x = VectorXd::Random(n);
+    MatrixXd jac(n,n);
+    MatrixXd ref_jac(n,n);
+    MatrixXd actual_jac(n,n);
+    tridiagonal_functor functor(n);
+    functor.actual_df(x, actual_jac);
+
+    NumericalDiff<tridiagonal_functor,mode> numDiff(functor);
+    int nfev = numDiff.df(x, ref_jac);
+    VERIFY_IS_EQUAL(nfev, (mode==Central ? 2*n : n+1));
+
+    // a tridiagonal pattern needs three groups of columns
+    numDiff.setSparsityPattern(functor.pattern());
+    VERIFY_IS_EQUAL(numDiff.groups(n), 3);
+    nfev = numDiff.df(x, jac);
+    VERIFY_IS_EQUAL(nfev, (mode==Central ? 6 : 4));
+    VERIFY_IS_APPROX(jac, ref_jac);
+    VERIFY_IS_APPROX(jac, actual_jac);
+
+    numDiff.setParallel(true);
+    jac.setRandom();
+    numDiff.df(x, jac);
+    VERIFY_IS_APPROX(jac, ref_jac);
+
+    numDiff.clearSparsityPattern();
+    VERIFY_IS_EQUAL(numDiff.groups(n), n);
+}
+
 void test_NumericalDiff()
 {
     CALL_SUBTEST(test_forward());
     CALL_SUBTEST(test_central());
+    CALL_SUBTEST(test_parallel<Forward>());
+    CALL_SUBTEST(test_parallel<Central>());
+    for(int i = 0; i < g_repeat; i++) {
+        CALL_SUBTEST(test_sparse_pattern<Forward>());
+        CALL_SUBTEST(test_sparse_pattern<Central>());
+    }
 }
@@ -111,7 +111,7 @@ struct TestFunc1
   }
 };
 
-template<typename Func> void forward_jacobian(const Func& f)
+template<typename Func, typename AutoDiffJacobianType> void forward_jacobian_check(const Func& f)
 {
     typename Func::InputType x = Func::InputType::Random(f.inputs());
     typename Func::ValueType y(f.values()), yref(f.values());
@@ -125,7 +125,7 @@ template<typename Func> void forward_jacobian(const Func& f)
 
     j.setZero();
     y.setZero();
-    AutoDiffJacobian<Func> autoj(f);
+    AutoDiffJacobianType autoj(f);
     autoj(x, &y, &j);
 //     std::cerr << y.transpose() << "\n\n";;
 //     std::cerr << j << "\n\n";;
@@ -134,6 +134,79 @@ template<typename Func> void forward_jacobian(const Func& f)
     VERIFY_IS_APPROX(j, jref);
 }
 
+template<typename Func> void forward_jacobian(const Func& f)
+{
+    forward_jacobian_check<Func, AutoDiffJacobian<Func> >(f);
+}
+
+// derivatives stored in fixed-capacity vectors
+template<typename Func> void forward_jacobian_fixed_capacity(const Func& f)
+{
+    forward_jacobian_check<Func, AutoDiffJacobian<Func,4> >(f);
+}
+
+template<typename Func> void reverse_jacobian(const Func& f)
+{
+    forward_jacobian_check<Func, AutoDiffReverseJacobian<Func> >(f);
+}
+
+template<typename Func> void adaptive_jacobian(const Func& f)
+{
+    VERIFY(AutoDiffAdaptiveJacobian<Func>(f).reverseMode() == (f.values() < f.inputs()));
+    forward_jacobian_check<Func, AutoDiffAdaptiveJacobian<Func> >(f);
+}
+
+template<typename Scalar> void reverse_gradient(int size)
+{
+    typedef AutoDiffReverseScalar<Scalar> AD;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+
+    MatrixType a = MatrixType::Random(size,size);
+    AutoDiffTape<Scalar> tape;
+    VectorType g;
+    int tapeSize = 0;
+    for (int k = 0; k < 2; ++k)
+    {
+        VectorType x = VectorType::Random(size);
+        tape.clear();
+        Matrix<AD,Dynamic,1> ax(size);
+        for (int j = 0; j < size; ++j)
+            ax[j] = tape.variable(x[j]);
+
+        // f(x) = |A x|^2 + sum(x) + sum(sin(x)) / |x|
+        Matrix<AD,Dynamic,1> ay = a.template cast<AD>() * ax;
+        AD sinsum(Scalar(0));
+        for (int j = 0; j < size; ++j)
+            sinsum += std::sin(ax[j]);
+        AD y = ay.squaredNorm() + ax.sum() + sinsum / ax.norm();
+        tape.gradient(y, ax, g);
+
+        VectorType ref = Scalar(2) * a.transpose() * (a * x) + VectorType::Ones(size);
+        ref += x.array().cos().matrix() / x.norm() - x.array().sin().sum() / (x.norm()*x.squaredNorm()) * x;
+        VERIFY_IS_APPROX(y.value(), (a*x).squaredNorm() + x.sum() + x.array().sin().sum() / x.norm());
+        VERIFY_IS_APPROX(g, ref);
+
+        // the same computation is recorded again
+        if (k==0)
+            tapeSize = tape.size();
+        VERIFY_IS_EQUAL(tape.size(), tapeSize);
+
+        // jacobian of several outputs
+        MatrixType jac;
+        tape.jacobian(ay, ax, jac);
+        VERIFY_IS_APPROX(jac, a);
+    }
+
+    // constants have a zero gradient
+    tape.clear();
+    Matrix<AD,Dynamic,1> ax(size);
+    for (int j = 0; j < size; ++j)
+        ax[j] = tape.variable(Scalar(1));
+    tape.gradient(AD(Scalar(3)) * AD(Scalar(2)), ax, g);
+    VERIFY_IS_EQUAL(g, VectorType::Zero(size));
+}
+
 void test_autodiff_scalar()
 {
   std::cerr << foo<float>(1,2) << "\n";
@@ -143,6 +216,17 @@ void test_autodiff_scalar()
   foo<AD>(ax,ay);
   std::cerr << foo<AD>(ax,ay).value() << " <> "
             << foo<AD>(ax,ay).derivatives().transpose() << "\n\n";
+
+  typedef Matrix<float,Dynamic,1,0,4,1> FixedCapacityDer;
+  typedef AutoDiffScalar<FixedCapacityDer> FixedCapacityAD;
+  FixedCapacityAD bx(1,2,0);
+  FixedCapacityAD by(2,2,1);
+  FixedCapacityAD r = foo<FixedCapacityAD>(bx,by);
+  VERIFY_IS_APPROX(r.value(), foo<AD>(ax,ay).value());
+  VERIFY_IS_APPROX(Vector2f(r.derivatives()), Vector2f(foo<AD>(ax,ay).derivatives()));
+  r = -bx * by;
+  VERIFY_IS_APPROX(r.value(), -2.f);
+  VERIFY_IS_APPROX(Vector2f(r.derivatives()), Vector2f(-2,-1));
 }
 
 void test_autodiff_jacobian()
@@ -153,6 +237,24 @@ void test_autodiff_jacobian()
     CALL_SUBTEST(( forward_jacobian(TestFunc1<double,3,2>()) ));
     CALL_SUBTEST(( forward_jacobian(TestFunc1<double,3,3>()) ));
     CALL_SUBTEST(( forward_jacobian(TestFunc1<double>(3,3)) ));
+    CALL_SUBTEST(( forward_jacobian_fixed_capacity(TestFunc1<double>(3,3)) ));
+    CALL_SUBTEST(( forward_jacobian_fixed_capacity(TestFunc1<double>(2,3)) ));
+    CALL_SUBTEST(( forward_jacobian_fixed_capacity(TestFunc1<double,3,2>()) ));
+    CALL_SUBTEST(( reverse_jacobian(TestFunc1<double,2,2>()) ));
+    CALL_SUBTEST(( reverse_jacobian(TestFunc1<double,2,3>()) ));
+    CALL_SUBTEST(( reverse_jacobian(TestFunc1<double,3,2>()) ));
+    CALL_SUBTEST(( reverse_jacobian(TestFunc1<double>(3,3)) ));
+    CALL_SUBTEST(( adaptive_jacobian(TestFunc1<double,3,2>()) ));
+    CALL_SUBTEST(( adaptive_jacobian(TestFunc1<double,2,3>()) ));
+    CALL_SUBTEST(( adaptive_jacobian(TestFunc1<double>(3,2)) ));
+  }
+}
+
+void test_autodiff_reverse()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST(( reverse_gradient<double>(ei_random<int>(1,60)) ));
+    CALL_SUBTEST(( reverse_gradient<float>(ei_random<int>(1,20)) ));
   }
 }
 
@@ -160,5 +262,6 @@ void test_autodiff()
 {
     test_autodiff_scalar();
     test_autodiff_jacobian();
+    test_autodiff_reverse();
 }
 
@@ -24,6 +24,7 @@
 
 #include "main.h"
 #include <unsupported/Eigen/MatrixFunctions>
+#include <Eigen/Sparse>
 
 double binom(int n, int k)
 {
@@ -142,6 +143,87 @@ void randomTest(const MatrixType& m, double tol)
   }
 }
 
+template<typename MatrixType>
+void testReuse(const MatrixType& m, double tol)
+{
+  typedef typename NumTraits<typename ei_traits<MatrixType>::Scalar>::Real RealScalar;
+  MatrixExponential<MatrixType> me;
+  MatrixType A, B;
+  for (int i = 0; i < 3; i++) {
+    // alternate sizes and norms to go through all Pade approximants
+    int size = (i == 1) ? m.rows() + 2 : m.rows();
+    A = MatrixType::Random(size, size) * ei_random<RealScalar>(0.01, 20.);
+    me.compute(A, B);
+    std::cout << "testReuse: error expm = " << relerr(B, A.exp().eval()) << "\n";
+    VERIFY(B.isApprox(A.exp().eval(), static_cast<RealScalar>(tol)));
+  }
+}
+
+template<typename MatrixType>
+void testAction(const MatrixType& m, double tol)
+{
+  typedef typename ei_traits<MatrixType>::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  int size = m.rows();
+  MatrixType A = MatrixType::Random(size, size) * ei_random<RealScalar>(0.1, 5.);
+  A.diagonal().array() += ei_random<Scalar>();
+  VectorType v = VectorType::Random(size), w;
+
+  MatrixExponentialAction<MatrixType> expmv(A);
+  const RealScalar ts[] = { 0., 1e-3, 0.5, 1., -2., 4. };
+  for (int i = 0; i < 6; i++) {
+    expmv.compute(ts[i], v, w);
+    VectorType ref = MatrixType(ts[i] * A).exp() * v;
+    std::cout << "testAction: t = " << ts[i] << "   error expmv = " << relerr(w, ref) << "\n";
+    VERIFY(w.isApprox(ref, static_cast<RealScalar>(tol)));
+  }
+
+  // block of vectors, result aliasing the argument
+  typedef Matrix<Scalar, Dynamic, Dynamic> BlockType;
+  BlockType V = BlockType::Random(size, 3);
+  BlockType ref = A.exp() * V;
+  MatrixExponentialAction<MatrixType, BlockType> expmV(A);
+  expmV.compute(1, V, V);
+  VERIFY(V.isApprox(ref, static_cast<RealScalar>(tol)));
+}
+
+template<typename Scalar>
+void testActionSparse(int size, double tol)
+{
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> DenseMatrix;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+
+  // generator of a birth-death Markov chain: columns sum to zero
+  DenseMatrix Q = DenseMatrix::Zero(size, size);
+  for (int i = 0; i < size-1; i++) {
+    Q(i+1,i) = ei_random<RealScalar>(0.5, 2.);
+    Q(i,i+1) = ei_random<RealScalar>(0.5, 2.);
+  }
+  Q.diagonal() = -Q.colwise().sum().transpose();
+  SparseMatrix<Scalar> sQ(size, size);
+  sQ.reserve(3*size);
+  for (int j = 0; j < size; j++) {
+    sQ.startVec(j);
+    for (int i = std::max(0, j-1); i <= std::min(size-1, j+1); i++)
+      sQ.insertBack(j,i) = Q(i,j);
+  }
+  sQ.finalize();
+
+  VectorType p = VectorType::Zero(size), q;
+  p(0) = 1;
+  MatrixExponentialAction<SparseMatrix<Scalar> > expmv(sQ);
+  const RealScalar ts[] = { 0.1, 1., 10. };
+  for (int i = 0; i < 3; i++) {
+    expmv.compute(ts[i], p, q);
+    VectorType ref = DenseMatrix(ts[i] * Q).exp() * p;
+    std::cout << "testActionSparse: t = " << ts[i] << "   error expmv = " << relerr(q, ref) << "\n";
+    VERIFY(q.isApprox(ref, static_cast<RealScalar>(tol)));
+    VERIFY_IS_APPROX(q.sum(), Scalar(1));
+  }
+}
+
 void test_matrix_exponential()
 {
   CALL_SUBTEST_2(test2dRotation<double>(1e-13));
@@ -158,4 +240,9 @@ void test_matrix_exponential()
   CALL_SUBTEST_5(randomTest(Matrix3cf(), 1e-4));
   CALL_SUBTEST_1(randomTest(Matrix4f(), 1e-4));
   CALL_SUBTEST_6(randomTest(MatrixXf(8,8), 1e-4));
+  CALL_SUBTEST_4(testReuse(MatrixXd(8,8), 1e-13));
+  CALL_SUBTEST_8(testAction(MatrixXd(20,20), 1e-12));
+  CALL_SUBTEST_8(testAction(MatrixXcd(12,12), 1e-12));
+  CALL_SUBTEST_6(testAction(MatrixXf(10,10), 1e-4));
+  CALL_SUBTEST_8(testActionSparse<double>(60, 1e-11));
 }
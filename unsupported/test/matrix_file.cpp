@@ -0,0 +1,254 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// Eigen is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or (at your option) any later version.
+//
+// Alternatively, you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as
+// published by the Free Software Foundation; either version 2 of
+// the License, or (at your option) any later version.
+//
+// Eigen is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License or the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License and a copy of the GNU General Public License along with
+// Eigen. If not, see <http://www.gnu.org/licenses/>.
+
+#include "sparse.h"
+#include <unsupported/Eigen/MatrixFile>
+#include <cstdio>
+
+static const char* g_filename = "matrix_file_test.bin";
+
+template<typename MatrixType> void matrix_file_dense(const MatrixType& m)
+{
+  typedef Matrix<int, MatrixType::RowsAtCompileTime, MatrixType::ColsAtCompileTime, MatrixType::Options> OtherScalarType;
+  int rows = m.rows();
+  int cols = m.cols();
+
+  MatrixType m1 = MatrixType::Random(rows, cols),
+             m2 = MatrixType::Random(rows, cols);
+
+  VERIFY(writeMatrixFile(g_filename, m1));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY(file.isOpen());
+    VERIFY(!file.isSparse());
+    VERIFY_IS_EQUAL(file.rows(), rows);
+    VERIFY_IS_EQUAL(file.cols(), cols);
+    VERIFY(file.template holds<MatrixType>());
+    VERIFY(!file.template holds<OtherScalarType>());
+
+    Map<MatrixType,Aligned> map = file.template map<MatrixType>();
+    VERIFY((std::size_t(map.data()) % 16) == 0);
+    VERIFY_IS_EQUAL(MatrixType(map), m1);
+
+    // the default mapping is private
+    map.setZero();
+  }
+  {
+    MappedMatrixFile file(g_filename, true);
+    Map<MatrixType,Aligned> map = file.template map<MatrixType>();
+    VERIFY_IS_EQUAL(MatrixType(map), m1);
+
+    // a writable mapping writes the modifications back to the file
+    map = m2;
+  }
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY_IS_EQUAL(MatrixType(file.template map<MatrixType>()), m2);
+  }
+
+  // expressions are evaluated while they are written
+  VERIFY(writeMatrixFile(g_filename, m1 + m2));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY_IS_APPROX(MatrixType(file.template map<MatrixType>()), MatrixType(m1 + m2));
+  }
+}
+
+template<typename MatrixType> void matrix_file_storage_order(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrixType;
+  MatrixType m1 = MatrixType::Random(m.rows(), m.cols());
+
+  VERIFY(writeMatrixFile(g_filename, m1));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY(!file.isRowMajor());
+    VERIFY(!file.template holds<RowMajorMatrixType>());
+  }
+
+  VERIFY(writeMatrixFile(g_filename, RowMajorMatrixType(m1)));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY(file.isRowMajor());
+    VERIFY(!file.template holds<MatrixType>());
+    VERIFY_IS_EQUAL(MatrixType(file.template map<RowMajorMatrixType>()), m1);
+  }
+
+  // a block of a larger matrix
+  VERIFY(writeMatrixFile(g_filename, m1.block(1, 1, m1.rows()-1, m1.cols()-1)));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY_IS_EQUAL(MatrixType(file.template map<MatrixType>()), MatrixType(m1.block(1, 1, m1.rows()-1, m1.cols()-1)));
+  }
+}
+
+template<typename Scalar> void matrix_file_sparse(int rows, int cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef SparseMatrix<Scalar,RowMajor> RowMajorSparseMatrixType;
+
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType m(rows, cols);
+  initSparse<Scalar>(0.1, refMat, m);
+
+  VERIFY(writeMatrixFile(g_filename, m));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY(file.isOpen());
+    VERIFY(file.isSparse());
+    VERIFY(!file.isRowMajor());
+    VERIFY_IS_EQUAL(file.nonZeros(), m.nonZeros());
+    VERIFY(file.template holdsSparse<SparseMatrixType>());
+    VERIFY(!file.template holdsSparse<RowMajorSparseMatrixType>());
+    VERIFY(!file.template holds<DenseMatrix>());
+    VERIFY_IS_APPROX(file.template mapSparse<SparseMatrixType>().toDense(), refMat);
+  }
+
+  RowMajorSparseMatrixType rm = m;
+  VERIFY(writeMatrixFile(g_filename, rm));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY(file.isRowMajor());
+    VERIFY(file.template holdsSparse<RowMajorSparseMatrixType>());
+    VERIFY_IS_APPROX(file.template mapSparse<RowMajorSparseMatrixType>().toDense(), refMat);
+  }
+
+  // the dense matrix has the same coefficients
+  VERIFY(writeMatrixFile(g_filename, refMat));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY(!file.template holdsSparse<SparseMatrixType>());
+    VERIFY_IS_APPROX(DenseMatrix(file.template map<DenseMatrix>()), refMat);
+  }
+}
+
+// rewrites the header of the file with \a header, keeping the payload
+void overwriteHeader(const ei_matrix_file_header& header)
+{
+  std::ifstream in(g_filename, std::ios::in | std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  content.replace(0, sizeof(ei_matrix_file_header), reinterpret_cast<const char*>(&header), sizeof(ei_matrix_file_header));
+  std::ofstream out(g_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  out.write(content.data(), content.size());
+}
+
+ei_matrix_file_header readHeader()
+{
+  ei_matrix_file_header header;
+  std::ifstream in(g_filename, std::ios::in | std::ios::binary);
+  in.read(reinterpret_cast<char*>(&header), sizeof(ei_matrix_file_header));
+  return header;
+}
+
+// overwrites the int stored at \a offset in the file with \a value
+void overwriteInt(long long offset, int value)
+{
+  std::fstream stream(g_filename, std::ios::in | std::ios::out | std::ios::binary);
+  stream.seekp(offset);
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(int));
+}
+
+void matrix_file_invalid()
+{
+  std::remove(g_filename);
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+
+  // a file which does not start with a header
+  {
+    std::ofstream stream(g_filename, std::ios::out | std::ios::binary);
+    stream << "this is not a matrix file, but it is longer than the header of a matrix file..........";
+  }
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+
+  // a truncated file
+  MatrixXf m = MatrixXf::Random(20, 20);
+  VERIFY(writeMatrixFile(g_filename, m));
+  {
+    MappedMatrixFile file(g_filename);
+    VERIFY(file.isOpen());
+  }
+  {
+    std::ifstream in(g_filename, std::ios::in | std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream out(g_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size()-4);
+  }
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+
+  // offsets and sizes crafted so that offset + size overflows
+  VERIFY(writeMatrixFile(g_filename, m));
+  ei_matrix_file_header header = readHeader();
+  header.valuesOffset = (std::numeric_limits<long long>::max() / 16) * 16;
+  overwriteHeader(header);
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+  header = readHeader();
+  header.valuesOffset = MatrixFileAlignment;
+  header.scalarSize = std::numeric_limits<unsigned int>::max();
+  overwriteHeader(header);
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+
+  // a sparse matrix whose outer index does not end at the number of non zeros
+  SparseMatrix<float> sm(20, 20);
+  MatrixXf refMat = MatrixXf::Zero(20, 20);
+  initSparse<float>(0.2, refMat, sm, ForceNonZeroDiag);
+  VERIFY(writeMatrixFile(g_filename, sm));
+  VERIFY(MappedMatrixFile(g_filename).isOpen());
+  header = readHeader();
+  header.nonZeros -= 1;
+  overwriteHeader(header);
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+
+  // a sparse matrix whose outer index decreases
+  VERIFY(writeMatrixFile(g_filename, sm));
+  header = readHeader();
+  overwriteInt(header.outerIndexOffset + 10*sizeof(int), 0);
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+
+  // a sparse matrix with an inner index out of bounds
+  VERIFY(writeMatrixFile(g_filename, sm));
+  header = readHeader();
+  overwriteInt(header.innerIndexOffset, 20);
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+  VERIFY(writeMatrixFile(g_filename, sm));
+  overwriteInt(header.innerIndexOffset + (header.nonZeros-1)*sizeof(int), -1);
+  VERIFY(!MappedMatrixFile(g_filename).isOpen());
+}
+
+void test_matrix_file()
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( matrix_file_dense(MatrixXf(ei_random<int>(1,200), ei_random<int>(1,200))) );
+    CALL_SUBTEST_2( matrix_file_dense(Matrix<double,Dynamic,Dynamic,RowMajor>(ei_random<int>(1,200), ei_random<int>(1,200))) );
+    CALL_SUBTEST_3( matrix_file_dense(MatrixXcd(ei_random<int>(1,50), ei_random<int>(1,50))) );
+    CALL_SUBTEST_4( matrix_file_dense(Matrix4f()) );
+    CALL_SUBTEST_4( matrix_file_dense(VectorXd(ei_random<int>(1,1000))) );
+    CALL_SUBTEST_5( matrix_file_storage_order(MatrixXf(ei_random<int>(2,200), ei_random<int>(2,200))) );
+    CALL_SUBTEST_6( matrix_file_sparse<double>(ei_random<int>(1,200), ei_random<int>(1,200)) );
+    CALL_SUBTEST_6( matrix_file_sparse<std::complex<float> >(ei_random<int>(1,100), ei_random<int>(1,100)) );
+  }
+  CALL_SUBTEST_7( matrix_file_invalid() );
+  std::remove(g_filename);
+}
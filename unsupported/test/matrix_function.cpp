@@ -172,6 +172,24 @@ void testMatrixType(const MatrixType& m)
   }
 }
 
+// Many well separated eigenvalues lead to many small atomic blocks
+// and long block superdiagonals in MatrixFunction.h.
+template<typename MatrixType>
+void testManyClusters(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  const int size = m.rows();
+  MatrixType diag = MatrixType::Zero(size, size);
+  for (int i = 0; i < size; ++i)
+    diag(i, i) = Scalar(RealScalar(i % 7) * RealScalar(0.5)) + ei_random<Scalar>() * Scalar(RealScalar(0.01));
+  MatrixType A = MatrixType::Random(size, size);
+  HouseholderQR<MatrixType> QRofA(A);
+  A = QRofA.householderQ().inverse() * diag * QRofA.householderQ();
+  testMatrixExponential(A);
+  testHyperbolicFunctions(A);
+}
+
 void test_matrix_function()
 {
   CALL_SUBTEST_1(testMatrixType(Matrix<float,1,1>()));
@@ -181,4 +199,7 @@ void test_matrix_function()
   CALL_SUBTEST_5(testMatrixType(Matrix<double,5,5,RowMajor>()));
   CALL_SUBTEST_6(testMatrixType(Matrix4cd()));
   CALL_SUBTEST_7(testMatrixType(MatrixXd(13,13)));
+  CALL_SUBTEST_8(testMatrixType(MatrixXd(60,60)));
+  CALL_SUBTEST_8(testManyClusters(MatrixXd(70,70)));
+  CALL_SUBTEST_8(testManyClusters(MatrixXcd(40,40)));
 }